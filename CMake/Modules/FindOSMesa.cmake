@@ -0,0 +1,32 @@
+# - Try to find OSMesa, the Mesa offscreen rendering library
+# Once done this will define
+#
+# OSMESA_FOUND - system has OSMesa
+# OSMESA_INCLUDE_DIR
+# OSMESA_LIBRARY
+#
+# $OSMESADIR is an environment variable used
+# for finding OSMesa.
+
+INCLUDE(FindPackageHandleStandardArgs)
+
+FIND_PATH(OSMESA_INCLUDE_DIR GL/osmesa.h
+PATHS $ENV{OSMESADIR}
+PATH_SUFFIXES include
+)
+FIND_LIBRARY(OSMESA_LIBRARY
+NAMES OSMesa osmesa
+PATHS $ENV{OSMESADIR}
+PATH_SUFFIXES lib
+)
+
+# Handle the REQUIRED argument and set OSMESA_FOUND
+FIND_PACKAGE_HANDLE_STANDARD_ARGS(OSMesa DEFAULT_MSG
+OSMESA_LIBRARY
+OSMESA_INCLUDE_DIR
+)
+
+MARK_AS_ADVANCED(
+OSMESA_INCLUDE_DIR
+OSMESA_LIBRARY
+)
@@ -10,6 +10,9 @@ settings_defaults.video_defaults.full_screen = false
 settings_defaults.video_defaults.screen_resx = 800
 settings_defaults.video_defaults.screen_resy = 600
 settings_defaults.video_defaults.smooth_graphics = true
+settings_defaults.video_defaults.vsync = true
+settings_defaults.video_defaults.frame_rate_limit = 60
+settings_defaults.video_defaults.fixed_update_step = 0
 
 settings_defaults.audio_defaults = {}
 settings_defaults.audio_defaults.music_vol = 70
@@ -8,6 +8,9 @@ settings.video_settings.full_screen = false
 settings.video_settings.screen_resx = 800
 settings.video_settings.screen_resy = 600
 settings.video_settings.smooth_graphics = true
+settings.video_settings.vsync = true
+settings.video_settings.frame_rate_limit = 60
+settings.video_settings.fixed_update_step = 0
 
 settings.audio_settings = {}
 settings.audio_settings.music_vol = 70
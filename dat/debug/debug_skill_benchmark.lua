@@ -0,0 +1,29 @@
+-- Sets up the skill benchmark run by the --benchmark-skills option.
+-- The benchmark_skill_id skill is executed by the first character on the first enemy,
+-- through its battle effect table and through BenchmarkSkillBattleExecute(), which does the same in Lua.
+
+-- Sword Slash
+benchmark_skill_id = 1;
+
+function BenchmarkSkillsSetup()
+    GlobalManager:AddCharacter(BRONANN);
+
+    local battle = vt_battle.BattleMode();
+    battle:AddEnemy(1, 0, 0);
+
+    ModeManager:Push(battle, false, false);
+end
+
+-- The Sword Slash battle script, as it was before using a battle effect table.
+function BenchmarkSkillBattleExecute(user, target)
+    local target_actor = target:GetActor();
+
+    if (vt_battle.CalculateStandardEvasion(target) == false) then
+        -- Normal +0 attack
+        target_actor:RegisterDamage(vt_battle.CalculatePhysicalDamage(user, target), target);
+        AudioManager:PlaySound("snd/swordslice1.wav");
+    else
+        target_actor:RegisterMiss(true);
+        AudioManager:PlaySound("snd/sword_swipe.wav");
+    end
+end
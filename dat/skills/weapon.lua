@@ -23,9 +23,18 @@
 -- {action_name}: The sprite action played before executing the battle scripted function.
 -- {target_type}: The type of target the skill affects, which may be an attack point, actor, or party.
 --
--- Each skill entry requires a function called {BattleExecute} to be defined. This function implements the
--- execution of the skill in battle, dealing damage, causing status changes, playing sounds, and animating
--- sprites.
+-- Each skill entry requires either a {battle_effect} table or a function called {BattleExecute} to be defined.
+-- The {battle_effect} table describes the standard attacks, which are executed without calling any script:
+-- {damage_type}: GLOBAL_DAMAGE_PHYSICAL or GLOBAL_DAMAGE_MAGICAL (optional, no damage is dealt otherwise)
+-- {damage_adder}: The attack added to the user attack (optional, 0 by default)
+-- {damage_multiplier}: The damage multiplier, used instead of the damage adder (optional, 1.0 by default)
+-- {evade_adder}: The evasion added to the target evasion, in percent (optional, 0 by default)
+-- {status}, {status_intensity}: The status change applied on the target when hit (optional)
+-- {status_chance}: The chance to apply the status change, in percent (optional, 100 by default)
+-- {hit_sound}, {miss_sound}: The sounds played when the target is hit or missed (optional)
+--
+-- The {BattleExecute} function implements the execution of the bespoke skills in battle, dealing damage,
+-- causing status changes, playing sounds, and animating sprites.
 ------------------------------------------------------------------------------]]
 
 -- common functions
@@ -66,18 +75,11 @@ skills[1] = {
 	action_name = "attack",
 	target_type = vt_global.GameGlobal.GLOBAL_TARGET_FOE,
 
-	BattleExecute = function(user, target)
-		target_actor = target:GetActor();
-
-		if (vt_battle.CalculateStandardEvasion(target) == false) then
-			-- Normal +0 attack
-			target_actor:RegisterDamage(vt_battle.CalculatePhysicalDamage(user, target), target);
-			AudioManager:PlaySound("snd/swordslice1.wav");
-		else
-			target_actor:RegisterMiss(true);
-			AudioManager:PlaySound("snd/sword_swipe.wav");
-		end
-	end,
+	battle_effect = {
+		damage_type = vt_global.GameGlobal.GLOBAL_DAMAGE_PHYSICAL,
+		hit_sound = "snd/swordslice1.wav",
+		miss_sound = "snd/sword_swipe.wav"
+	},
 
 	animation_scripts = {
 		[BRONANN] = "dat/battles/characters_animations/bronann_attack.lua",
@@ -94,18 +96,12 @@ skills[2] = {
 	action_name = "attack",
 	target_type = vt_global.GameGlobal.GLOBAL_TARGET_FOE_POINT,
 
-	BattleExecute = function(user, target)
-		target_actor = target:GetActor();
-
-		if (vt_battle.CalculateStandardEvasion(target) == false) then
-			target_actor:RegisterDamage(vt_battle.CalculatePhysicalDamageMultiplier(user, target, 1.75), target);
-			AudioManager:PlaySound("snd/swordslice1.wav");
-		else
-			target_actor:RegisterMiss(true);
-			AudioManager:PlaySound("snd/sword_swipe.wav");
-		end
-
-	end,
+	battle_effect = {
+		damage_type = vt_global.GameGlobal.GLOBAL_DAMAGE_PHYSICAL,
+		damage_multiplier = 1.75,
+		hit_sound = "snd/swordslice1.wav",
+		miss_sound = "snd/sword_swipe.wav"
+	},
 
 	animation_scripts = {
 		[BRONANN] = "dat/battles/characters_animations/bronann_attack.lua",
@@ -153,23 +149,15 @@ skills[4] = {
 	action_name = "attack",
 	target_type = vt_global.GameGlobal.GLOBAL_TARGET_FOE_POINT,
 
-	BattleExecute = function(user, target)
-		target_actor = target:GetActor();
-
-		if (vt_battle.CalculateStandardEvasionAdder(target, 8.5) == false) then
-            local effect_duration = user:GetVigor() * 2000;
-            if (effect_duration < 15000) then effect_duration = 15000 end
-            target_actor:RegisterStatusChange(vt_global.GameGlobal.GLOBAL_STATUS_AGILITY_LOWER,
-                                          vt_global.GameGlobal.GLOBAL_INTENSITY_POS_GREATER,
-                                          effect_duration);
-
-			target_actor:RegisterDamage(vt_battle.CalculatePhysicalDamageAdder(user, target, 20), target);
-			AudioManager:PlaySound("snd/swordslice2.wav");
-		else
-			target_actor:RegisterMiss(true);
-			AudioManager:PlaySound("snd/sword_swipe.wav");
-		end
-	end,
+	battle_effect = {
+		damage_type = vt_global.GameGlobal.GLOBAL_DAMAGE_PHYSICAL,
+		damage_adder = 20,
+		evade_adder = 8.5,
+		status = vt_global.GameGlobal.GLOBAL_STATUS_AGILITY_LOWER,
+		status_intensity = vt_global.GameGlobal.GLOBAL_INTENSITY_POS_GREATER,
+		hit_sound = "snd/swordslice2.wav",
+		miss_sound = "snd/sword_swipe.wav"
+	},
 
 	animation_scripts = {
 		[BRONANN] = "dat/battles/characters_animations/bronann_attack.lua",
@@ -187,17 +175,12 @@ skills[5] = {
 	action_name = "attack",
 	target_type = vt_global.GameGlobal.GLOBAL_TARGET_FOE,
 
-	BattleExecute = function(user, target)
-		target_actor = target:GetActor();
-
-		if (vt_battle.CalculateStandardEvasion(target) == false) then
-			target_actor:RegisterDamage(vt_battle.CalculatePhysicalDamageAdder(user, target, 5), target);
-			AudioManager:PlaySound("snd/crossbow.ogg");
-		else
-			target_actor:RegisterMiss(true);
-			AudioManager:PlaySound("snd/crossbow_miss.ogg");
-		end
-	end,
+	battle_effect = {
+		damage_type = vt_global.GameGlobal.GLOBAL_DAMAGE_PHYSICAL,
+		damage_adder = 5,
+		hit_sound = "snd/crossbow.ogg",
+		miss_sound = "snd/crossbow_miss.ogg"
+	},
 
 	animation_scripts = {
 		[KALYA] = "dat/battles/characters_animations/kalya_attack.lua"
@@ -214,17 +197,12 @@ skills[6] = {
 	action_name = "attack",
 	target_type = vt_global.GameGlobal.GLOBAL_TARGET_FOE_POINT,
 
-	BattleExecute = function(user, target)
-		target_actor = target:GetActor();
-
-		if (vt_battle.CalculateStandardEvasion(target) == false) then
-			target_actor:RegisterDamage(vt_battle.CalculatePhysicalDamageAdder(user, target, 5), target);
-			AudioManager:PlaySound("snd/swordslice2.wav");
-		else
-			target_actor:RegisterMiss(true);
-			AudioManager:PlaySound("snd/missed_target.wav");
-		end
-	end
+	battle_effect = {
+		damage_type = vt_global.GameGlobal.GLOBAL_DAMAGE_PHYSICAL,
+		damage_adder = 5,
+		hit_sound = "snd/swordslice2.wav",
+		miss_sound = "snd/missed_target.wav"
+	}
 }
 
 skills[999] = {
@@ -293,16 +271,11 @@ skills[1001] = {
 	cooldown_time = 500,
 	target_type = vt_global.GameGlobal.GLOBAL_TARGET_FOE_POINT,
 
-	BattleExecute = function(user, target)
-		target_actor = target:GetActor();
-
-		if (vt_battle.CalculateStandardEvasion(target) == false) then
-			target_actor:RegisterDamage(vt_battle.CalculatePhysicalDamageAdder(user, target, 10), target);
-			AudioManager:PlaySound("snd/slime_attack.wav");
-		else
-			target_actor:RegisterMiss(true);
-		end
-	end
+	battle_effect = {
+		damage_type = vt_global.GameGlobal.GLOBAL_DAMAGE_PHYSICAL,
+		damage_adder = 10,
+		hit_sound = "snd/slime_attack.wav"
+	}
 }
 
 skills[1002] = {
@@ -312,16 +285,11 @@ skills[1002] = {
 	cooldown_time = 0,
 	target_type = vt_global.GameGlobal.GLOBAL_TARGET_FOE_POINT,
 
-	BattleExecute = function(user, target)
-		target_actor = target:GetActor();
-
-		if (vt_battle.CalculateStandardEvasion(target) == false) then
-			target_actor:RegisterDamage(vt_battle.CalculatePhysicalDamageAdder(user, target, 13), target);
-			AudioManager:PlaySound("snd/spider_attack.wav");
-		else
-			target_actor:RegisterMiss(true);
-		end
-	end
+	battle_effect = {
+		damage_type = vt_global.GameGlobal.GLOBAL_DAMAGE_PHYSICAL,
+		damage_adder = 13,
+		hit_sound = "snd/spider_attack.wav"
+	}
 }
 
 skills[1003] = {
@@ -331,16 +299,11 @@ skills[1003] = {
 	cooldown_time = 0,
 	target_type = vt_global.GameGlobal.GLOBAL_TARGET_FOE_POINT,
 
-	BattleExecute = function(user, target)
-		target_actor = target:GetActor();
-
-		if (vt_battle.CalculateStandardEvasion(target) == false) then
-			target_actor:RegisterDamage(vt_battle.CalculatePhysicalDamageAdder(user, target, 14), target);
-			AudioManager:PlaySound("snd/snake_attack.wav");
-		else
-			target_actor:RegisterMiss(true);
-		end
-	end
+	battle_effect = {
+		damage_type = vt_global.GameGlobal.GLOBAL_DAMAGE_PHYSICAL,
+		damage_adder = 14,
+		hit_sound = "snd/snake_attack.wav"
+	}
 }
 
 skills[1004] = {
@@ -373,24 +336,13 @@ skills[1005] = {
 	cooldown_time = 0,
 	target_type = vt_global.GameGlobal.GLOBAL_TARGET_FOE_POINT,
 
-	BattleExecute = function(user, target)
-		target_actor = target:GetActor();
-
-		if (vt_battle.CalculateStandardEvasion(target) == false) then
-            target_actor = target:GetActor();
-            local effect_duration = user:GetVigor() * 2000;
-            if (effect_duration < 15000) then effect_duration = 15000 end
-            target_actor:RegisterStatusChange(vt_global.GameGlobal.GLOBAL_STATUS_AGILITY_LOWER,
-                                              vt_global.GameGlobal.GLOBAL_INTENSITY_POS_LESSER,
-                                              effect_duration);
-
-            -- The damages are applied after the potential effects, so that a potential target death handles the effect removal properly
-			target_actor:RegisterDamage(vt_battle.CalculatePhysicalDamageAdder(user, target, 6), target);
-			AudioManager:PlaySound("snd/snake_attack.wav");
-		else
-			target_actor:RegisterMiss(true);
-		end
-	end
+	battle_effect = {
+		damage_type = vt_global.GameGlobal.GLOBAL_DAMAGE_PHYSICAL,
+		damage_adder = 6,
+		status = vt_global.GameGlobal.GLOBAL_STATUS_AGILITY_LOWER,
+		status_intensity = vt_global.GameGlobal.GLOBAL_INTENSITY_POS_LESSER,
+		hit_sound = "snd/snake_attack.wav"
+	}
 }
 
 skills[1006] = {
@@ -400,16 +352,11 @@ skills[1006] = {
 	cooldown_time = 0,
 	target_type = vt_global.GameGlobal.GLOBAL_TARGET_FOE_POINT,
 
-	BattleExecute = function(user, target)
-		target_actor = target:GetActor();
-
-		if (vt_battle.CalculateStandardEvasion(target) == false) then
-			target_actor:RegisterDamage(vt_battle.CalculatePhysicalDamageAdder(user, target, 20), target);
-			AudioManager:PlaySound("snd/skeleton_attack.wav");
-		else
-			target_actor:RegisterMiss(true);
-		end
-	end
+	battle_effect = {
+		damage_type = vt_global.GameGlobal.GLOBAL_DAMAGE_PHYSICAL,
+		damage_adder = 20,
+		hit_sound = "snd/skeleton_attack.wav"
+	}
 }
 
 skills[1007] = {
@@ -443,14 +390,9 @@ skills[1008] = {
     cooldown_time = 0,
     target_type = vt_global.GameGlobal.GLOBAL_TARGET_FOE_POINT,
 
-    BattleExecute = function(user, target)
-        target_actor = target:GetActor();
-
-        if (vt_battle.CalculateStandardEvasion(target) == false) then
-            target_actor:RegisterDamage(vt_battle.CalculatePhysicalDamageAdder(user, target, 20), target);
-            AudioManager:PlaySound("snd/growl1_IFartInUrGeneralDirection_freesound.wav");
-        else
-            target_actor:RegisterMiss(true);
-        end
-    end
+    battle_effect = {
+        damage_type = vt_global.GameGlobal.GLOBAL_DAMAGE_PHYSICAL,
+        damage_adder = 20,
+        hit_sound = "snd/growl1_IFartInUrGeneralDirection_freesound.wav"
+    }
 }
@@ -103,11 +103,11 @@ void BindCommonCode()
                     .def("IncrementObjectCount", &GameGlobal::IncrementObjectCount)
                     .def("DecrementObjectCount", &GameGlobal::DecrementObjectCount)
                     .def("DoesEventGroupExist", &GameGlobal::DoesEventGroupExist)
-                    .def("DoesEventExist", &GameGlobal::DoesEventExist)
+                    .def("DoesEventExist", (bool(GameGlobal:: *)(const std::string &, const std::string &) const) &GameGlobal::DoesEventExist)
                     .def("AddNewEventGroup", &GameGlobal::AddNewEventGroup)
                     .def("GetEventGroup", &GameGlobal::GetEventGroup)
-                    .def("GetEventValue", &GameGlobal::GetEventValue)
-                    .def("SetEventValue", &GameGlobal::SetEventValue)
+                    .def("GetEventValue", (int32(GameGlobal:: *)(const std::string &, const std::string &) const) &GameGlobal::GetEventValue)
+                    .def("SetEventValue", (void(GameGlobal:: *)(const std::string &, const std::string &, int32)) &GameGlobal::SetEventValue)
                     .def("GetNumberEventGroups", &GameGlobal::GetNumberEventGroups)
                     .def("GetNumberEvents", &GameGlobal::GetNumberEvents)
                     .def("SetMapDataFilename", (void(GameGlobal:: *)(const std::string &)) &GameGlobal::SetMapDataFilename)
@@ -153,6 +153,10 @@ void BindCommonCode()
                         luabind::value("GLOBAL_SKILL_WEAPON", GLOBAL_SKILL_WEAPON),
                         luabind::value("GLOBAL_SKILL_MAGIC", GLOBAL_SKILL_MAGIC),
                         luabind::value("GLOBAL_SKILL_SPECIAL", GLOBAL_SKILL_SPECIAL),
+                        // Skill damage type constants
+                        luabind::value("GLOBAL_DAMAGE_INVALID", GLOBAL_DAMAGE_INVALID),
+                        luabind::value("GLOBAL_DAMAGE_PHYSICAL", GLOBAL_DAMAGE_PHYSICAL),
+                        luabind::value("GLOBAL_DAMAGE_MAGICAL", GLOBAL_DAMAGE_MAGICAL),
                         // Elemental type constants
                         luabind::value("GLOBAL_ELEMENTAL_FIRE", GLOBAL_ELEMENTAL_FIRE),
                         luabind::value("GLOBAL_ELEMENTAL_WATER", GLOBAL_ELEMENTAL_WATER),
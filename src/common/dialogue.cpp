@@ -267,7 +267,7 @@ void CommonDialogueWindow::Draw()
     }
 
     VideoManager->MoveRelative(0.0f, 5.0f);
-    _blink_time += SystemManager->GetUpdateTime();
+    _blink_time += SystemManager->GetFrameTime();
     if(_blink_time > 500) {
         _blink_time -= 500;
         _blink_state = _blink_state ? false : true;
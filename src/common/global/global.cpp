@@ -46,28 +46,18 @@ void GlobalEventGroup::AddNewEvent(const std::string &event_name, int32 event_va
                                        << _group_name << std::endl;
         return;
     }
-    _events.insert(std::make_pair(event_name, event_value));
+    _events.Insert(InternString(event_name), event_value);
 }
 
 int32 GlobalEventGroup::GetEvent(const std::string &event_name)
 {
-    std::map<std::string, int32>::iterator event_iter = _events.find(event_name);
-    if(event_iter == _events.end()) {
+    const int32 *event_value = _events.Find(FindStringSymbol(event_name));
+    if(!event_value) {
         IF_PRINT_WARNING(GLOBAL_DEBUG) << "an event with the specified name \"" << event_name << "\" did not exist in this group: "
                                        << _group_name << std::endl;
         return 0;
     }
-    return event_iter->second;
-}
-
-void GlobalEventGroup::SetEvent(const std::string &event_name, int32 event_value)
-{
-    std::map<std::string, int32>::iterator event_iter = _events.find(event_name);
-    if(event_iter == _events.end()) {
-        AddNewEvent(event_name, event_value);
-        return;
-    }
-    event_iter->second = event_value;
+    return *event_value;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -78,6 +68,7 @@ GameGlobal::GameGlobal() :
     _game_slot_id(0),
     _drunes(0),
     _max_experience_level(100),
+    _inventory_count(0),
     _x_save_map_position(0),
     _y_save_map_position(0),
     _world_map_image(NULL),
@@ -199,6 +190,17 @@ bool GameGlobal::_LoadGlobalScripts()
     }
     _status_effects_script.OpenTable("status_effects");
 
+    // Read the object and skill definitions once for all the instances
+    _definitions.LoadObjectDefinitions(_items_script, GLOBAL_OBJECT_ITEM);
+    _definitions.LoadObjectDefinitions(_weapons_script, GLOBAL_OBJECT_WEAPON);
+    _definitions.LoadObjectDefinitions(_head_armor_script, GLOBAL_OBJECT_HEAD_ARMOR);
+    _definitions.LoadObjectDefinitions(_torso_armor_script, GLOBAL_OBJECT_TORSO_ARMOR);
+    _definitions.LoadObjectDefinitions(_arm_armor_script, GLOBAL_OBJECT_ARM_ARMOR);
+    _definitions.LoadObjectDefinitions(_leg_armor_script, GLOBAL_OBJECT_LEG_ARMOR);
+    _definitions.LoadSkillDefinitions(_weapon_skills_script);
+    _definitions.LoadSkillDefinitions(_magic_skills_script);
+    _definitions.LoadSkillDefinitions(_special_skills_script);
+
     if(!_map_sprites_script.OpenFile("dat/actors/map_sprites.lua")
             || !_map_sprites_script.OpenTable("sprites"))
         return false;
@@ -222,10 +224,11 @@ bool GameGlobal::_LoadGlobalScripts()
 void GameGlobal::ClearAllData()
 {
     // Delete all inventory objects
-    for(std::map<uint32, GlobalObject *>::iterator it = _inventory.begin(); it != _inventory.end(); ++it) {
-        delete it->second;
+    for(uint32 i = 0; i < _inventory.size(); ++i) {
+        delete _inventory[i].object;
     }
     _inventory.clear();
+    _inventory_count = 0;
     _inventory_items.clear();
     _inventory_weapons.clear();
     _inventory_head_armor.clear();
@@ -234,6 +237,9 @@ void GameGlobal::ClearAllData()
     _inventory_leg_armor.clear();
     _inventory_shards.clear();
 
+    for(uint32 i = 0; i < _inventory_listeners.size(); ++i)
+        _inventory_listeners[i]->InventoryCleared();
+
     // Delete all characters
     for(std::map<uint32, GlobalCharacter *>::iterator it = _characters.begin(); it != _characters.end(); ++it) {
         delete it->second;
@@ -243,15 +249,15 @@ void GameGlobal::ClearAllData()
     _active_party.RemoveAllActors();
 
     // Delete all event groups
-    for(std::map<std::string, GlobalEventGroup *>::iterator it = _event_groups.begin(); it != _event_groups.end(); ++it) {
-        delete(it->second);
+    for(uint32 i = 0; i < _event_groups.Size(); ++i) {
+        delete(_event_groups.GetValue(i));
     }
-    _event_groups.clear();
+    _event_groups.Clear();
 
     //clear the quest log
-    for(std::map<std::string, QuestLogEntry *>::iterator itr = _quest_log_entries.begin(); itr != _quest_log_entries.end(); ++itr)
-        delete itr->second;
-    _quest_log_entries.clear();
+    for(uint32 i = 0; i < _quest_log_entries.Size(); ++i)
+        delete _quest_log_entries.GetValue(i);
+    _quest_log_entries.Clear();
 
     // Clear the save location
     UnsetSaveLocation();
@@ -409,41 +415,29 @@ void GameGlobal::SwapCharactersByIndex(uint32 first_index, uint32 second_index)
 void GameGlobal::AddToInventory(uint32 obj_id, uint32 obj_count)
 {
     // If the object is already in the inventory, increment the count of the object
-    if(_inventory.find(obj_id) != _inventory.end()) {
-        _inventory[obj_id]->IncrementCount(obj_count);
+    GlobalObject *object = GetInventoryObject(obj_id);
+    if(object) {
+        object->IncrementCount(obj_count);
+        _NotifyInventoryChanged(obj_id);
         return;
     }
 
     // Otherwise create a new object instance and add it to the inventory
     if((obj_id > 0 && obj_id <= MAX_ITEM_ID)
         || (obj_id > MAX_SHARD_ID && obj_id <= MAX_KEY_ITEM_ID)) {
-        GlobalItem *new_obj = new GlobalItem(obj_id, obj_count);
-        _inventory.insert(std::make_pair(obj_id, new_obj));
-        _inventory_items.push_back(new_obj);
+        _AddToInventory(new GlobalItem(obj_id, obj_count), _inventory_items);
     } else if((obj_id > MAX_ITEM_ID) && (obj_id <= MAX_WEAPON_ID)) {
-        GlobalWeapon *new_obj = new GlobalWeapon(obj_id, obj_count);
-        _inventory.insert(std::make_pair(obj_id, new_obj));
-        _inventory_weapons.push_back(new_obj);
+        _AddToInventory(new GlobalWeapon(obj_id, obj_count), _inventory_weapons);
     } else if((obj_id > MAX_WEAPON_ID) && (obj_id <= MAX_HEAD_ARMOR_ID)) {
-        GlobalArmor *new_obj = new GlobalArmor(obj_id, obj_count);
-        _inventory.insert(std::make_pair(obj_id, new_obj));
-        _inventory_head_armor.push_back(new_obj);
+        _AddToInventory(new GlobalArmor(obj_id, obj_count), _inventory_head_armor);
     } else if((obj_id > MAX_HEAD_ARMOR_ID) && (obj_id <= MAX_TORSO_ARMOR_ID)) {
-        GlobalArmor *new_obj = new GlobalArmor(obj_id, obj_count);
-        _inventory.insert(std::make_pair(obj_id, new_obj));
-        _inventory_torso_armor.push_back(new_obj);
+        _AddToInventory(new GlobalArmor(obj_id, obj_count), _inventory_torso_armor);
     } else if((obj_id > MAX_TORSO_ARMOR_ID) && (obj_id <= MAX_ARM_ARMOR_ID)) {
-        GlobalArmor *new_obj = new GlobalArmor(obj_id, obj_count);
-        _inventory.insert(std::make_pair(obj_id, new_obj));
-        _inventory_arm_armor.push_back(new_obj);
+        _AddToInventory(new GlobalArmor(obj_id, obj_count), _inventory_arm_armor);
     } else if((obj_id > MAX_ARM_ARMOR_ID) && (obj_id <= MAX_LEG_ARMOR_ID)) {
-        GlobalArmor *new_obj = new GlobalArmor(obj_id, obj_count);
-        _inventory.insert(std::make_pair(obj_id, new_obj));
-        _inventory_leg_armor.push_back(new_obj);
+        _AddToInventory(new GlobalArmor(obj_id, obj_count), _inventory_leg_armor);
     } else if((obj_id > MAX_LEG_ARMOR_ID) && (obj_id <= MAX_SHARD_ID)) {
-// 		GlobalShard *new_obj = new GlobalShard(obj_id, obj_count);
-// 		_inventory.insert(std::make_pair(obj_id, new_obj));
-// 		_inventory_shards.push_back(new_obj);
+// 		_AddToInventory(new GlobalShard(obj_id, obj_count), _inventory_shards);
     } else {
         IF_PRINT_WARNING(GLOBAL_DEBUG) << "attempted to add invalid object to inventory with id: " << obj_id << std::endl;
     }
@@ -462,42 +456,30 @@ void GameGlobal::AddToInventory(GlobalObject *object)
     uint32 obj_count = object->GetCount();
 
     // If an instance of the same object is already inside the inventory, just increment the count and delete the object
-    if(_inventory.find(obj_id) != _inventory.end()) {
-        _inventory[obj_id]->IncrementCount(obj_count);
+    GlobalObject *inventory_object = GetInventoryObject(obj_id);
+    if(inventory_object) {
+        inventory_object->IncrementCount(obj_count);
         delete object;
+        _NotifyInventoryChanged(obj_id);
         return;
     }
 
     // Figure out which type of object this is, cast it to the correct type, and add it to the inventory
     if((obj_id > 0 && obj_id <= MAX_ITEM_ID)
         || (obj_id > MAX_SHARD_ID && obj_id <= MAX_KEY_ITEM_ID)) {
-        GlobalItem *new_obj = dynamic_cast<GlobalItem *>(object);
-        _inventory.insert(std::make_pair(obj_id, new_obj));
-        _inventory_items.push_back(new_obj);
+        _AddToInventory(dynamic_cast<GlobalItem *>(object), _inventory_items);
     } else if((obj_id > MAX_ITEM_ID) && (obj_id <= MAX_WEAPON_ID)) {
-        GlobalWeapon *new_obj = dynamic_cast<GlobalWeapon *>(object);
-        _inventory.insert(std::make_pair(obj_id, new_obj));
-        _inventory_weapons.push_back(new_obj);
+        _AddToInventory(dynamic_cast<GlobalWeapon *>(object), _inventory_weapons);
     } else if((obj_id > MAX_WEAPON_ID) && (obj_id <= MAX_HEAD_ARMOR_ID)) {
-        GlobalArmor *new_obj = dynamic_cast<GlobalArmor *>(object);
-        _inventory.insert(std::make_pair(obj_id, new_obj));
-        _inventory_head_armor.push_back(new_obj);
+        _AddToInventory(dynamic_cast<GlobalArmor *>(object), _inventory_head_armor);
     } else if((obj_id > MAX_HEAD_ARMOR_ID) && (obj_id <= MAX_TORSO_ARMOR_ID)) {
-        GlobalArmor *new_obj = dynamic_cast<GlobalArmor *>(object);
-        _inventory.insert(std::make_pair(obj_id, new_obj));
-        _inventory_torso_armor.push_back(new_obj);
+        _AddToInventory(dynamic_cast<GlobalArmor *>(object), _inventory_torso_armor);
     } else if((obj_id > MAX_TORSO_ARMOR_ID) && (obj_id <= MAX_ARM_ARMOR_ID)) {
-        GlobalArmor *new_obj = dynamic_cast<GlobalArmor *>(object);
-        _inventory.insert(std::make_pair(obj_id, new_obj));
-        _inventory_arm_armor.push_back(new_obj);
+        _AddToInventory(dynamic_cast<GlobalArmor *>(object), _inventory_arm_armor);
     } else if((obj_id > MAX_ARM_ARMOR_ID) && (obj_id <= MAX_LEG_ARMOR_ID)) {
-        GlobalArmor *new_obj = dynamic_cast<GlobalArmor *>(object);
-        _inventory.insert(std::make_pair(obj_id, new_obj));
-        _inventory_leg_armor.push_back(new_obj);
+        _AddToInventory(dynamic_cast<GlobalArmor *>(object), _inventory_leg_armor);
     } else if((obj_id > MAX_LEG_ARMOR_ID) && (obj_id <= MAX_SHARD_ID)) {
-// 		GlobalShard *new_obj = dynamic_cast<GlobalShard*>(object);
-// 		_inventory.insert(std::make_pair(obj_id, new_obj));
-// 		_inventory_shards.push_back(new_obj);
+// 		_AddToInventory(dynamic_cast<GlobalShard *>(object), _inventory_shards);
     } else {
         IF_PRINT_WARNING(GLOBAL_DEBUG) << "attempted to add invalid object to inventory with id: " << obj_id << std::endl;
         delete object;
@@ -508,7 +490,7 @@ void GameGlobal::AddToInventory(GlobalObject *object)
 
 void GameGlobal::RemoveFromInventory(uint32 obj_id)
 {
-    if(_inventory.find(obj_id) == _inventory.end()) {
+    if(!IsObjectInInventory(obj_id)) {
         IF_PRINT_WARNING(GLOBAL_DEBUG) << "attempted to remove an object from inventory that didn't exist with id: " << obj_id << std::endl;
         return;
     }
@@ -545,7 +527,7 @@ void GameGlobal::RemoveFromInventory(uint32 obj_id)
 
 GlobalObject *GameGlobal::RetrieveFromInventory(uint32 obj_id, bool all_counts)
 {
-    if(_inventory.find(obj_id) == _inventory.end()) {
+    if(!IsObjectInInventory(obj_id)) {
         IF_PRINT_WARNING(GLOBAL_DEBUG) << "attempted to retrieve an object from inventory that didn't exist with id: " << obj_id << std::endl;
         return NULL;
     }
@@ -593,12 +575,14 @@ GlobalObject *GameGlobal::RetrieveFromInventory(uint32 obj_id, bool all_counts)
 void GameGlobal::IncrementObjectCount(uint32 obj_id, uint32 count)
 {
     // Do nothing if the item does not exist in the inventory
-    if(_inventory.find(obj_id) == _inventory.end()) {
+    GlobalObject *object = GetInventoryObject(obj_id);
+    if(object == NULL) {
         IF_PRINT_WARNING(GLOBAL_DEBUG) << "attempted to increment count for an object that was not present in the inventory: " << obj_id << std::endl;
         return;
     }
 
-    _inventory[obj_id]->IncrementCount(count);
+    object->IncrementCount(count);
+    _NotifyInventoryChanged(obj_id);
 }
 
 
@@ -606,22 +590,70 @@ void GameGlobal::IncrementObjectCount(uint32 obj_id, uint32 count)
 void GameGlobal::DecrementObjectCount(uint32 obj_id, uint32 count)
 {
     // Do nothing if the item does not exist in the inventory
-    if(_inventory.find(obj_id) == _inventory.end()) {
+    GlobalObject *object = GetInventoryObject(obj_id);
+    if(object == NULL) {
         IF_PRINT_WARNING(GLOBAL_DEBUG) << "attempted to decrement count for an object that was not present in the inventory: " << obj_id << std::endl;
         return;
     }
 
     // Print a warning if the amount to decrement by exceeds the object's current count
-    if(count > _inventory[obj_id]->GetCount()) {
+    if(count > object->GetCount()) {
         IF_PRINT_WARNING(GLOBAL_DEBUG) << "amount to decrement count by exceeded available count: " << obj_id << std::endl;
     }
 
     // Decrement the number of objects so long as the number to decrement by does not equal or exceed the count
-    if(count < _inventory[obj_id]->GetCount())
-        _inventory[obj_id]->DecrementCount(count);
+    if(count < object->GetCount()) {
+        object->DecrementCount(count);
+        _NotifyInventoryChanged(obj_id);
+    }
     // Otherwise remove the object from the inventory completely
-    else
+    else {
         RemoveFromInventory(obj_id);
+    }
+}
+
+
+
+void GameGlobal::GetInventoryObjects(std::vector<GlobalObject *> &objects) const
+{
+    objects.clear();
+    objects.reserve(_inventory_count);
+    objects.insert(objects.end(), _inventory_items.begin(), _inventory_items.end());
+    objects.insert(objects.end(), _inventory_weapons.begin(), _inventory_weapons.end());
+    objects.insert(objects.end(), _inventory_head_armor.begin(), _inventory_head_armor.end());
+    objects.insert(objects.end(), _inventory_torso_armor.begin(), _inventory_torso_armor.end());
+    objects.insert(objects.end(), _inventory_arm_armor.begin(), _inventory_arm_armor.end());
+    objects.insert(objects.end(), _inventory_leg_armor.begin(), _inventory_leg_armor.end());
+    objects.insert(objects.end(), _inventory_shards.begin(), _inventory_shards.end());
+}
+
+
+
+void GameGlobal::AddInventoryListener(GlobalInventoryListener *listener)
+{
+    if(listener == NULL)
+        return;
+
+    if(std::find(_inventory_listeners.begin(), _inventory_listeners.end(), listener) == _inventory_listeners.end())
+        _inventory_listeners.push_back(listener);
+}
+
+
+
+void GameGlobal::RemoveInventoryListener(GlobalInventoryListener *listener)
+{
+    std::vector<GlobalInventoryListener *>::iterator it =
+        std::find(_inventory_listeners.begin(), _inventory_listeners.end(), listener);
+    if(it != _inventory_listeners.end())
+        _inventory_listeners.erase(it);
+}
+
+
+
+void GameGlobal::_NotifyInventoryChanged(uint32 obj_id)
+{
+    for(uint32 i = 0; i < _inventory_listeners.size(); ++i)
+        _inventory_listeners[i]->InventoryChanged(obj_id);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -630,15 +662,16 @@ void GameGlobal::DecrementObjectCount(uint32 obj_id, uint32 count)
 
 bool GameGlobal::DoesEventExist(const std::string &group_name, const std::string &event_name) const
 {
-    std::map<std::string, GlobalEventGroup *>::const_iterator group_iter = _event_groups.find(group_name);
-    if(group_iter == _event_groups.end())
-        return false;
+    return DoesEventExist(FindStringSymbol(group_name), FindStringSymbol(event_name));
+}
 
-    std::map<std::string, int32>::const_iterator event_iter = group_iter->second->GetEvents().find(event_name);
-    if(event_iter == group_iter->second->GetEvents().end())
+bool GameGlobal::DoesEventExist(uint32 group_symbol, uint32 event_symbol) const
+{
+    GlobalEventGroup *const *group = _event_groups.Find(group_symbol);
+    if(!group)
         return false;
 
-    return true;
+    return ((*group)->FindEvent(event_symbol) != NULL);
 }
 
 
@@ -652,58 +685,66 @@ void GameGlobal::AddNewEventGroup(const std::string &group_name)
     }
 
     GlobalEventGroup *geg = new GlobalEventGroup(group_name);
-    _event_groups.insert(std::make_pair(group_name, geg));
+    _event_groups.Insert(InternString(group_name), geg);
 }
 
 
 
 GlobalEventGroup *GameGlobal::GetEventGroup(const std::string &group_name) const
 {
-    std::map<std::string, GlobalEventGroup *>::const_iterator group_iter = _event_groups.find(group_name);
-    if(group_iter == _event_groups.end()) {
+    GlobalEventGroup *const *group = _event_groups.Find(FindStringSymbol(group_name));
+    if(!group) {
         IF_PRINT_WARNING(GLOBAL_DEBUG) << "could not find any event group by the requested name: " << group_name << std::endl;
         return NULL;
     }
-    return (group_iter->second);
+    return *group;
 }
 
 
 
 int32 GameGlobal::GetEventValue(const std::string &group_name, const std::string &event_name) const
 {
-    std::map<std::string, GlobalEventGroup *>::const_iterator group_iter = _event_groups.find(group_name);
-    if(group_iter == _event_groups.end())
+    return GetEventValue(FindStringSymbol(group_name), FindStringSymbol(event_name));
+}
+
+int32 GameGlobal::GetEventValue(uint32 group_symbol, uint32 event_symbol) const
+{
+    GlobalEventGroup *const *group = _event_groups.Find(group_symbol);
+    if(!group)
         return 0;
 
-    std::map<std::string, int32>::const_iterator event_iter = group_iter->second->GetEvents().find(event_name);
-    if(event_iter == group_iter->second->GetEvents().end())
+    const int32 *event_value = (*group)->FindEvent(event_symbol);
+    if(!event_value)
         return 0;
 
-    return event_iter->second;
+    return *event_value;
 }
 
 void GameGlobal::SetEventValue(const std::string &group_name, const std::string &event_name, int32 event_value)
 {
-    GlobalEventGroup *geg = 0;
-    std::map<std::string, GlobalEventGroup *>::const_iterator group_iter = _event_groups.find(group_name);
-    if(group_iter == _event_groups.end()) {
-        geg = new GlobalEventGroup(group_name);
-        _event_groups.insert(std::make_pair(group_name, geg));
-    } else {
-        geg = group_iter->second;
-    }
+    SetEventValue(InternString(group_name), InternString(event_name), event_value);
+}
+
+void GameGlobal::SetEventValue(uint32 group_symbol, uint32 event_symbol, int32 event_value)
+{
+    if(group_symbol == INVALID_SYMBOL || event_symbol == INVALID_SYMBOL)
+        return;
 
-    geg->SetEvent(event_name, event_value);
+    GlobalEventGroup *&geg = _event_groups[group_symbol];
+    if(!geg)
+        geg = new GlobalEventGroup(GetSymbolString(group_symbol));
+
+    geg->SetEvent(event_symbol, event_value);
 }
 
 uint32 GameGlobal::GetNumberEvents(const std::string &group_name) const
 {
-    std::map<std::string, GlobalEventGroup *>::const_iterator group_iter = _event_groups.find(group_name);
-    if(group_iter == _event_groups.end()) {
+    GlobalEventGroup *const *group = _event_groups.Find(FindStringSymbol(group_name));
+    if(!group) {
         IF_PRINT_WARNING(GLOBAL_DEBUG) << "could not find any event group by the requested name: " << group_name << std::endl;
         return 0;
     }
-    return group_iter->second->GetNumberEvents();
+    return (*group)->GetNumberEvents();
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -714,10 +755,10 @@ static QuestLogInfo _empty_quest_log_info;
 
 QuestLogInfo& GameGlobal::GetQuestInfo(const std::string &quest_id)
 {
-    std::map<std::string, QuestLogInfo>::iterator itr = _quest_log_info.find(quest_id);
-    if(itr == _quest_log_info.end())
+    QuestLogInfo *info = _quest_log_info.Find(FindStringSymbol(quest_id));
+    if(!info)
         return _empty_quest_log_info;
-    return itr->second;
+    return *info;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -750,102 +791,108 @@ void GameGlobal::NewGame()
 
 bool GameGlobal::SaveGame(const std::string &filename, uint32 slot_id, uint32 x_position, uint32 y_position)
 {
-    WriteScriptDescriptor file;
-    if(file.OpenFile(filename) == false) {
+    // Makes sure a pending autosave doesn't get written after this save.
+    _save_file_writer.Finish();
+
+    SaveGameWriter header_data;
+    SaveGameWriter file;
+    _CaptureSaveGame(x_position, y_position, header_data, file);
+
+    if(!WriteSaveGameFile(filename, header_data.GetData(), file.GetData()))
         return false;
-    }
 
-    // Open the save_game1 table
-    file.WriteLine("save_game1 = {");
+    // Store the game slot the game is coming from.
+    _game_slot_id = slot_id;
+
+    return true;
+} // bool GameGlobal::SaveGame(string& filename)
+
+void GameGlobal::AutoSave()
+{
+    SaveGameWriter header_data;
+    SaveGameWriter file;
+    _CaptureSaveGame(0, 0, header_data, file);
+
+    _save_file_writer.Write(GetSaveGameFilename(AUTOSAVE_SLOT_ID), header_data.GetData(), file.GetData());
+}
 
-    // Save simple play data
-    file.InsertNewLine();
-    file.WriteLine("map_data_filename = \"" + _map_data_filename + "\",");
-    file.WriteLine("map_script_filename = \"" + _map_script_filename + "\",");
+void GameGlobal::_CaptureSaveGame(uint32 x_position, uint32 y_position, SaveGameWriter &header_data, SaveGameWriter &file)
+{
+    // The preview header
+    SaveGameHeader header;
+    header.map_data_filename = _map_data_filename;
+    header.map_script_filename = _map_script_filename;
     //! \note Coords are in map tiles
-    file.WriteLine("location_x = " + NumberToString(x_position) + ",");
-    file.WriteLine("location_y = " + NumberToString(y_position) + ",");
-    file.WriteLine("play_hours = " + NumberToString(SystemManager->GetPlayHours()) + ",");
-    file.WriteLine("play_minutes = " + NumberToString(SystemManager->GetPlayMinutes()) + ",");
-    file.WriteLine("play_seconds = " + NumberToString(SystemManager->GetPlaySeconds()) + ",");
-    file.WriteLine("drunes = " + NumberToString(_drunes) + ",");
+    header.location_x = x_position;
+    header.location_y = y_position;
+    header.play_hours = SystemManager->GetPlayHours();
+    header.play_minutes = SystemManager->GetPlayMinutes();
+    header.play_seconds = SystemManager->GetPlaySeconds();
+    header.drunes = _drunes;
+    for(uint32 i = 0; i < SAVE_GAME_HEADER_CHARACTERS && i < _ordered_characters.size(); ++i) {
+        SaveGameCharacter character;
+        character.id = _ordered_characters[i]->GetID();
+        character.experience_level = _ordered_characters[i]->GetExperienceLevel();
+        character.hit_points = _ordered_characters[i]->GetHitPoints();
+        character.max_hit_points = _ordered_characters[i]->GetMaxHitPoints();
+        character.skill_points = _ordered_characters[i]->GetSkillPoints();
+        character.max_skill_points = _ordered_characters[i]->GetMaxSkillPoints();
+        header.characters.push_back(character);
+    }
+
+    header.Write(header_data);
 
     // Save the inventory (object id + object count pairs)
     // NOTE: This does not save any weapons/armor that are equipped on the characters. That data
     // is stored alongside the character data when it is saved
-    _SaveInventory(file, "items", _inventory_items);
-    _SaveInventory(file, "weapons", _inventory_weapons);
-    _SaveInventory(file, "head_armor", _inventory_head_armor);
-    _SaveInventory(file, "torso_armor", _inventory_torso_armor);
-    _SaveInventory(file, "arm_armor", _inventory_arm_armor);
-    _SaveInventory(file, "leg_armor", _inventory_leg_armor);
-    _SaveInventory(file, "shards", _inventory_shards);
-
-    // ----- (5) Save character data
-    file.InsertNewLine();
-    file.WriteLine("characters = {");
-    // First save the order of the characters in the party
-    file.WriteLine("\t[\"order\"] = {");
-    for(uint32 i = 0; i < _ordered_characters.size(); ++i) {
-        if(i == 0)
-            file.WriteLine("\t\t" + NumberToString(_ordered_characters[i]->GetID()), false);
-        else
-            file.WriteLine(", " + NumberToString(_ordered_characters[i]->GetID()), false);
-    }
-    file.WriteLine("\n\t},"); // order
-
-    // Now save each individual character's data
-    for(uint32 i = 0; i < _ordered_characters.size(); i++) {
-        if((i + 1) == _ordered_characters.size())
-            _SaveCharacter(file, _ordered_characters[i], true);
-        else
-            _SaveCharacter(file, _ordered_characters[i], false);
-    }
-    file.WriteLine("},"); // characters
-
-    // ----- (6) Save event data
-    file.InsertNewLine();
-    file.WriteLine("event_groups = {");
-    for(std::map<std::string, GlobalEventGroup *>::iterator it = _event_groups.begin(); it != _event_groups.end(); ++it) {
-        _SaveEvents(file, it->second);
-    }
-    file.WriteLine("},");
-    file.InsertNewLine();
-
-    // ------ (7) Save quest log
-    file.WriteLine("quest_log = {");
-    for(std::map<std::string, QuestLogEntry *>::const_iterator itr = _quest_log_entries.begin(); itr != _quest_log_entries.end(); ++itr)
-        _SaveQuests(file, itr->second);
-    file.WriteLine("},");
-    file.InsertNewLine();
-
-    // ------ (8) Save World Map
+    _SaveInventory(file, _inventory_items);
+    _SaveInventory(file, _inventory_weapons);
+    _SaveInventory(file, _inventory_head_armor);
+    _SaveInventory(file, _inventory_torso_armor);
+    _SaveInventory(file, _inventory_arm_armor);
+    _SaveInventory(file, _inventory_leg_armor);
+    _SaveInventory(file, _inventory_shards);
+
+    // Save the characters data, in the party order
+    file.WriteUInt32(_ordered_characters.size());
+    for(uint32 i = 0; i < _ordered_characters.size(); i++)
+        _SaveCharacter(file, _ordered_characters[i]);
+
+    // Save event data
+    file.WriteUInt32(_event_groups.Size());
+    for(uint32 i = 0; i < _event_groups.Size(); ++i)
+        _SaveEvents(file, _event_groups.GetValue(i));
+
+    // Save quest log
+    file.WriteUInt32(_quest_log_entries.Size());
+    for(uint32 i = 0; i < _quest_log_entries.Size(); ++i)
+        _SaveQuests(file, _quest_log_entries.GetValue(i));
+
+    // Save World Map
     _SaveWorldMap(file);
 
-    // ----- (8) Report any errors detected from the previous write operations
-    if(file.IsErrorDetected()) {
-        if(GLOBAL_DEBUG) {
-            PRINT_WARNING << "one or more errors occurred while writing the save game file - they are listed below" << std::endl;
-            std::cerr << file.GetErrorMessages() << std::endl;
-            file.ClearErrors();
-        }
-    }
-
-    file.InsertNewLine();
-    file.WriteLine("} -- save_game1"); //save_game1
+    // The map entrance, used to place the character when not loading at a save point.
+    file.WriteString(_previous_location);
+} // void GameGlobal::_CaptureSaveGame(...)
 
-    file.CloseFile();
 
-    // Store the game slot the game is coming from.
-    _game_slot_id = slot_id;
 
-    return true;
-} // bool GameGlobal::SaveGame(string& filename)
+bool GameGlobal::LoadGame(const std::string &filename, uint32 slot_id)
+{
+    // Makes sure the autosave file is complete.
+    _save_file_writer.Finish();
 
+    if(IsBinarySaveGame(filename)) {
+        if(!_LoadBinaryGame(filename))
+            return false;
 
+        // Store the game slot the game is coming from.
+        _game_slot_id = slot_id;
+        return true;
+    }
 
-bool GameGlobal::LoadGame(const std::string &filename, uint32 slot_id)
-{
+    // The older versions saved the games as Lua files, imported here.
+    // They are saved in the binary format the next time the game is saved.
     ReadScriptDescriptor file;
     if(!file.OpenFile(filename))
         return false;
@@ -1057,200 +1104,104 @@ void GameGlobal::GetEmoteOffset(float &x, float &y, const std::string &emote_id,
 // GameGlobal class - Private Methods
 ////////////////////////////////////////////////////////////////////////////////
 
-void GameGlobal::_SaveCharacter(WriteScriptDescriptor &file, GlobalCharacter *character, bool last)
+void GameGlobal::_SaveCharacter(SaveGameWriter &file, GlobalCharacter *character)
 {
-    if(file.IsFileOpen() == false) {
-        IF_PRINT_WARNING(GLOBAL_DEBUG) << "the file provided in the function argument was not open" << std::endl;
-        return;
-    }
     if(character == NULL) {
         IF_PRINT_WARNING(GLOBAL_DEBUG) << "function received a NULL character pointer argument" << std::endl;
+        file.WriteUInt32(GLOBAL_CHARACTER_INVALID);
         return;
     }
 
-    file.WriteLine("\t[" + NumberToString(character->GetID()) + "] = {");
+    file.WriteUInt32(character->GetID());
 
     // Store whether the character is available
-    file.WriteLine("\t\tenabled = " + std::string(character->IsEnabled() ? "true" : "false") + ",");
+    file.WriteBool(character->IsEnabled());
 
     // ----- (1): Write out the character's stats
-    file.WriteLine("\t\texperience_level = " + NumberToString(character->GetExperienceLevel()) + ",");
-    file.WriteLine("\t\texperience_points = " + NumberToString(character->GetExperiencePoints()) + ",");
-    file.WriteLine("\t\texperience_points_next = " + NumberToString(character->GetExperienceForNextLevel()) + ", ");
-
-    file.WriteLine("\t\tmax_hit_points = " + NumberToString(character->GetMaxHitPoints()) + ",");
-    file.WriteLine("\t\thit_points = " + NumberToString(character->GetHitPoints()) + ",");
-    file.WriteLine("\t\tmax_skill_points = " + NumberToString(character->GetMaxSkillPoints()) + ",");
-    file.WriteLine("\t\tskill_points = " + NumberToString(character->GetSkillPoints()) + ",");
-
-    file.WriteLine("\t\tstrength = " + NumberToString(character->GetStrength()) + ",");
-    file.WriteLine("\t\tvigor = " + NumberToString(character->GetVigor()) + ",");
-    file.WriteLine("\t\tfortitude = " + NumberToString(character->GetFortitude()) + ",");
-    file.WriteLine("\t\tprotection = " + NumberToString(character->GetProtection()) + ",");
-    file.WriteLine("\t\tagility = " + NumberToString(character->GetAgility()) + ",");
-    file.WriteLine("\t\tevade = " + NumberToString(character->GetEvade()) + ",");
-
-    // ----- (2): Write out the character's equipment
-    uint32 weapon_id = 0;
-    uint32 head_id = 0;
-    uint32 torso_id = 0;
-    uint32 arm_id = 0;
-    uint32 leg_id = 0;
-    GlobalObject *obj_tmp = NULL;
-
-    obj_tmp = character->GetWeaponEquipped();
-    if(obj_tmp != NULL)
-        weapon_id = obj_tmp->GetID();
-
-    obj_tmp = character->GetHeadArmorEquipped();
-    if(obj_tmp != NULL)
-        head_id = obj_tmp->GetID();
-
-    obj_tmp = character->GetTorsoArmorEquipped();
-    if(obj_tmp != NULL)
-        torso_id = obj_tmp->GetID();
-
-    obj_tmp = character->GetArmArmorEquipped();
-    if(obj_tmp != NULL)
-        arm_id = obj_tmp->GetID();
-
-    obj_tmp = character->GetLegArmorEquipped();
-    if(obj_tmp != NULL)
-        leg_id = obj_tmp->GetID();
-
-    file.InsertNewLine();
-    file.WriteLine("\t\tequipment = {");
-    file.WriteLine("\t\t\tweapon = " + NumberToString(weapon_id) + ",");
-    file.WriteLine("\t\t\thead_armor = " + NumberToString(head_id) + ",");
-    file.WriteLine("\t\t\ttorso_armor = " + NumberToString(torso_id) + ",");
-    file.WriteLine("\t\t\tarm_armor = " + NumberToString(arm_id) + ",");
-    file.WriteLine("\t\t\tleg_armor = " + NumberToString(leg_id));
-    file.WriteLine("\t\t},");
+    file.WriteUInt32(character->GetExperienceLevel());
+    file.WriteUInt32(character->GetExperiencePoints());
+    file.WriteInt32(character->GetExperienceForNextLevel());
+
+    file.WriteUInt32(character->GetMaxHitPoints());
+    file.WriteUInt32(character->GetHitPoints());
+    file.WriteUInt32(character->GetMaxSkillPoints());
+    file.WriteUInt32(character->GetSkillPoints());
+
+    file.WriteUInt32(character->GetStrength());
+    file.WriteUInt32(character->GetVigor());
+    file.WriteUInt32(character->GetFortitude());
+    file.WriteUInt32(character->GetProtection());
+    file.WriteUInt32(character->GetAgility());
+    file.WriteFloat(character->GetEvade());
+
+    // ----- (2): Write out the character's equipment, 0 standing for no equipment
+    GlobalObject *equipment[5] = {
+        character->GetWeaponEquipped(),
+        character->GetHeadArmorEquipped(),
+        character->GetTorsoArmorEquipped(),
+        character->GetArmArmorEquipped(),
+        character->GetLegArmorEquipped()
+    };
+    for(uint32 i = 0; i < 5; ++i)
+        file.WriteUInt32(equipment[i] ? equipment[i]->GetID() : 0);
 
     // ----- (3): Write out the character's skills
-    std::vector<GlobalSkill *>* skill_vector;
-
-    file.InsertNewLine();
-    file.WriteLine("\t\tweapon_skills = {");
-    skill_vector = character->GetWeaponSkills();
-    for(uint32 i = 0; i < skill_vector->size(); i++) {
-        if(i == 0)
-            file.WriteLine("\t\t\t", false);
-        else
-            file.WriteLine(", ", false);
-        file.WriteLine(NumberToString(skill_vector->at(i)->GetID()), false);
+    std::vector<GlobalSkill *> *skill_vectors[3] = {
+        character->GetWeaponSkills(),
+        character->GetMagicSkills(),
+        character->GetSpecialSkills()
+    };
+    for(uint32 i = 0; i < 3; ++i) {
+        file.WriteUInt32(skill_vectors[i]->size());
+        for(uint32 j = 0; j < skill_vectors[i]->size(); ++j)
+            file.WriteUInt32(skill_vectors[i]->at(j)->GetID());
     }
-    file.WriteLine("\n\t\t},");
+} // void GameGlobal::_SaveCharacter(SaveGameWriter& file, GlobalCharacter* character)
 
-    file.InsertNewLine();
-    file.WriteLine("\t\tmagic_skills = {");
-    skill_vector = character->GetMagicSkills();
-    for(uint32 i = 0; i < skill_vector->size(); i++) {
-        if(i == 0)
-            file.WriteLine("\t\t\t", false);
-        else
-            file.WriteLine(", ", false);
-        file.WriteLine(NumberToString(skill_vector->at(i)->GetID()), false);
-    }
-    file.WriteLine("\n\t\t},");
 
-    file.InsertNewLine();
-    file.WriteLine("\t\tspecial_skills = {");
-    skill_vector = character->GetSpecialSkills();
-    for(uint32 i = 0; i < skill_vector->size(); i++) {
-        if(i == 0)
-            file.WriteLine("\t\t\t", false);
-        else
-            file.WriteLine(", ", false);
-        file.WriteLine(NumberToString(skill_vector->at(i)->GetID()), false);
-    }
-    file.WriteLine("\n\t\t}");
 
-    if(last)
-        file.WriteLine("\t}");
-    else
-        file.WriteLine("\t},");
-} // void GameGlobal::_SaveCharacter(WriteScriptDescriptor& file, GlobalCharacter* character, bool last)
-
-
-
-void GameGlobal::_SaveEvents(WriteScriptDescriptor &file, GlobalEventGroup *event_group)
+void GameGlobal::_SaveEvents(SaveGameWriter &file, GlobalEventGroup *event_group)
 {
-    if(file.IsFileOpen() == false) {
-        IF_PRINT_WARNING(GLOBAL_DEBUG) << "the file provided in the function argument was not open" << std::endl;
-        return;
-    }
     if(event_group == NULL) {
         IF_PRINT_WARNING(GLOBAL_DEBUG) << "function received a NULL event group pointer argument" << std::endl;
+        file.WriteString(std::string());
+        file.WriteUInt32(0);
         return;
     }
 
-    file.WriteLine("\t" + event_group->GetGroupName() + " = {");
-
-    uint32 i = 0;
-    for(std::map<std::string, int32>::const_iterator it = event_group->GetEvents().begin(); it != event_group->GetEvents().end(); ++it) {
-        if(it == event_group->GetEvents().begin())
-            file.WriteLine("\t\t", false);
-        else
-            file.WriteLine(", ", false);
-
-        // Add a new line every 4 entries for better readability and debugging
-        if ((i > 0) && !(i % 4)) {
-            file.InsertNewLine();
-            file.WriteLine("\t\t", false);
-        }
-
-        file.WriteLine("[\"" + it->first + "\"] = " + NumberToString(it->second), false);
+    file.WriteString(event_group->GetGroupName());
 
-        ++i;
+    const SymbolMap<int32> &events = event_group->GetEvents();
+    file.WriteUInt32(events.Size());
+    for(uint32 i = 0; i < events.Size(); ++i) {
+        file.WriteString(GetSymbolString(events.GetSymbol(i)));
+        file.WriteInt32(events.GetValue(i));
     }
-    file.WriteLine("\n\t},");
-
 }
 
-void GameGlobal::_SaveQuests(WriteScriptDescriptor &file, const QuestLogEntry *quest_log_entry)
+void GameGlobal::_SaveQuests(SaveGameWriter &file, const QuestLogEntry *quest_log_entry)
 {
-    if(file.IsFileOpen() == false)
-    {
-        IF_PRINT_WARNING(GLOBAL_DEBUG) << "the file provided in the function argument was not open" << std::endl;
-        return;
-    }
-
     if(quest_log_entry == NULL)
     {
         IF_PRINT_WARNING(GLOBAL_DEBUG) << "_SaveQuests function received a NULL quest log entry pointer argument" << std::endl;
+        file.WriteString(std::string());
+        file.WriteUInt32(0);
+        file.WriteBool(false);
         return;
     }
 
-    // Start writting
-    file.WriteLine("\t" + quest_log_entry->GetQuestId() + " = {", false);
-    // Write the quest log number. this is written as a string because loading needs a uniform type of data in the array
-    file.WriteLine("\"" + NumberToString(quest_log_entry->GetQuestLogNumber()) + "\", ", false);
-    // Write the "false" or "true" string if this entry has been read or not
-    const std::string is_read(quest_log_entry->IsRead() ? "true" : "false");
-    file.WriteLine("\"" + is_read + "\"", false);
-    // End writing
-    file.WriteLine("},");
-
+    file.WriteString(quest_log_entry->GetQuestId());
+    file.WriteUInt32(quest_log_entry->GetQuestLogNumber());
+    file.WriteBool(quest_log_entry->IsRead());
 }
 
-void GameGlobal::_SaveWorldMap(vt_script::WriteScriptDescriptor &file)
+void GameGlobal::_SaveWorldMap(SaveGameWriter &file)
 {
-    if(!file.IsFileOpen()) {
-        IF_PRINT_WARNING(GLOBAL_DEBUG) << "the file provided in the function argument was not open" << std::endl;
-        return;
-    }
-
-    //write the world map filename
-    file.WriteLine("world_map = \"" + GetWorldMapFilename() + "\",");
-    file.InsertNewLine();
+    file.WriteString(GetWorldMapFilename());
 
-    //write the viewable locations
-    file.WriteLine("viewable_locations = {");
+    file.WriteUInt32(_viewable_world_locations.size());
     for(uint32 i = 0; i < _viewable_world_locations.size(); ++i)
-        file.WriteLine("\t\"" + _viewable_world_locations[i]+"\",");
-    file.WriteLine("}");
-
+        file.WriteString(_viewable_world_locations[i]);
 }
 
 void GameGlobal::_LoadInventory(ReadScriptDescriptor &file, const std::string &category_name)
@@ -1466,6 +1417,185 @@ void GameGlobal::_LoadWorldMap(vt_script::ReadScriptDescriptor &file)
         ShowWorldLocation(location_ids[i]);
 }
 
+bool GameGlobal::_LoadBinaryGame(const std::string &filename)
+{
+    std::string header_data;
+    std::string body_data;
+    if(!ReadSaveGameFile(filename, header_data, &body_data)) {
+        PRINT_ERROR << "Couldn't open the savegame " << filename << std::endl;
+        return false;
+    }
+
+    SaveGameHeader header;
+    SaveGameReader header_reader(header_data);
+    if(!header.Read(header_reader)) {
+        PRINT_ERROR << "Invalid savegame header in " << filename << std::endl;
+        return false;
+    }
+
+    ClearAllData();
+
+    _map_data_filename = header.map_data_filename;
+    _map_script_filename = header.map_script_filename;
+    _x_save_map_position = header.location_x;
+    _y_save_map_position = header.location_y;
+    SystemManager->SetPlayTime(header.play_hours, header.play_minutes, header.play_seconds);
+    _drunes = header.drunes;
+
+    SaveGameReader file(body_data);
+
+    // Load the seven inventory categories
+    for(uint32 i = 0; i < 7; ++i)
+        _LoadInventory(file);
+
+    // Load characters into the party in the correct order
+    uint32 num_characters = file.ReadUInt32();
+    for(uint32 i = 0; i < num_characters && file.IsValid(); ++i)
+        _LoadCharacter(file);
+
+    if (_characters.empty()) {
+        PRINT_ERROR << "No characters were added by save game file: " << filename << std::endl;
+        return false;
+    }
+
+    uint32 num_event_groups = file.ReadUInt32();
+    for(uint32 i = 0; i < num_event_groups && file.IsValid(); ++i)
+        _LoadEvents(file);
+
+    uint32 num_quests = file.ReadUInt32();
+    for(uint32 i = 0; i < num_quests && file.IsValid(); ++i)
+        _LoadQuests(file);
+
+    _LoadWorldMap(file);
+
+    // The map entrance, used to place the character when not loading at a save point.
+    _previous_location = file.ReadString();
+
+    if(!file.IsValid() || !file.IsAtEnd()) {
+        PRINT_ERROR << "Invalid savegame data in " << filename << std::endl;
+        return false;
+    }
+    return true;
+} // bool GameGlobal::_LoadBinaryGame(const std::string &filename)
+
+void GameGlobal::_LoadInventory(SaveGameReader &file)
+{
+    uint32 num_objects = file.ReadUInt32();
+    for(uint32 i = 0; i < num_objects && file.IsValid(); ++i) {
+        uint32 object_id = file.ReadUInt32();
+        uint32 count = file.ReadUInt32();
+        if(file.IsValid())
+            AddToInventory(object_id, count);
+    }
+}
+
+void GameGlobal::_LoadCharacter(SaveGameReader &file)
+{
+    // Only the id is written for invalid characters, see _SaveCharacter().
+    uint32 id = file.ReadUInt32();
+    if(!file.IsValid() || id == GLOBAL_CHARACTER_INVALID)
+        return;
+
+    bool enabled = file.ReadBool();
+    if(!file.IsValid())
+        return;
+
+    // Create a new GlobalCharacter object using the provided id
+    // This loads all of the character's "static" data, such as their name, etc.
+    GlobalCharacter *character = new GlobalCharacter(id, false);
+    character->Enable(enabled);
+
+    // Read in all of the character's stats data
+    character->SetExperienceLevel(file.ReadUInt32());
+    character->SetExperiencePoints(file.ReadUInt32());
+    character->_experience_for_next_level = file.ReadInt32();
+
+    character->SetMaxHitPoints(file.ReadUInt32());
+    character->SetHitPoints(file.ReadUInt32());
+    character->SetMaxSkillPoints(file.ReadUInt32());
+    character->SetSkillPoints(file.ReadUInt32());
+
+    character->SetStrength(file.ReadUInt32());
+    character->SetVigor(file.ReadUInt32());
+    character->SetFortitude(file.ReadUInt32());
+    character->SetProtection(file.ReadUInt32());
+    character->SetAgility(file.ReadUInt32());
+    character->SetEvade(file.ReadFloat());
+
+    // Equip the objects on the character as long as valid equipment IDs were read
+    uint32 equip_id = file.ReadUInt32();
+    if(equip_id != 0)
+        character->EquipWeapon(new GlobalWeapon(equip_id));
+    equip_id = file.ReadUInt32();
+    if(equip_id != 0)
+        character->EquipHeadArmor(new GlobalArmor(equip_id));
+    equip_id = file.ReadUInt32();
+    if(equip_id != 0)
+        character->EquipTorsoArmor(new GlobalArmor(equip_id));
+    equip_id = file.ReadUInt32();
+    if(equip_id != 0)
+        character->EquipArmArmor(new GlobalArmor(equip_id));
+    equip_id = file.ReadUInt32();
+    if(equip_id != 0)
+        character->EquipLegArmor(new GlobalArmor(equip_id));
+
+    // The weapon, magic and special skills
+    for(uint32 i = 0; i < 3; ++i) {
+        uint32 num_skills = file.ReadUInt32();
+        for(uint32 j = 0; j < num_skills && file.IsValid(); ++j)
+            character->AddSkill(file.ReadUInt32());
+    }
+
+    AddCharacter(character);
+} // void GameGlobal::_LoadCharacter(SaveGameReader& file)
+
+void GameGlobal::_LoadEvents(SaveGameReader &file)
+{
+    std::string group_name = file.ReadString();
+    uint32 num_events = file.ReadUInt32();
+
+    GlobalEventGroup *new_group = NULL;
+    if(!group_name.empty()) {
+        AddNewEventGroup(group_name);
+        new_group = GetEventGroup(group_name);
+    }
+
+    for(uint32 i = 0; i < num_events && file.IsValid(); ++i) {
+        std::string event_name = file.ReadString();
+        int32 event_value = file.ReadInt32();
+        if(new_group && file.IsValid())
+            new_group->AddNewEvent(event_name, event_value);
+    }
+}
+
+void GameGlobal::_LoadQuests(SaveGameReader &file)
+{
+    std::string quest_id = file.ReadString();
+    uint32 quest_log_number = file.ReadUInt32();
+    bool is_read = file.ReadBool();
+    if(quest_id.empty() || !file.IsValid())
+        return;
+
+    if(!_AddQuestLog(quest_id, quest_log_number, is_read))
+    {
+        IF_PRINT_WARNING(GLOBAL_DEBUG) << "save file has duplicate quest log id entries" << std::endl;
+        return;
+    }
+
+    //update the quest log count value if the current number is greater
+    if(_quest_log_count < quest_log_number)
+        _quest_log_count = quest_log_number;
+}
+
+void GameGlobal::_LoadWorldMap(SaveGameReader &file)
+{
+    SetWorldMap(file.ReadString());
+
+    uint32 num_locations = file.ReadUInt32();
+    for(uint32 i = 0; i < num_locations && file.IsValid(); ++i)
+        ShowWorldLocation(file.ReadString());
+}
+
 bool GameGlobal::_LoadWorldLocationsScript(const std::string &world_locations_filename)
 {
     _world_map_locations.clear();
@@ -1523,7 +1653,7 @@ bool GameGlobal::_LoadWorldLocationsScript(const std::string &world_locations_fi
 bool GameGlobal::_LoadQuestsScript(const std::string& quests_script_filename)
 {
     // First clear the existing quests entries in case of a reloading.
-    _quest_log_info.clear();
+    _quest_log_info.Clear();
 
     vt_script::ReadScriptDescriptor quests_script;
     if(!quests_script.OpenFile(quests_script_filename)) {
@@ -1557,7 +1687,8 @@ bool GameGlobal::_LoadQuestsScript(const std::string& quests_script_filename)
         quests_script.ReadStringVector(quest_id, quest_info);
 
         // Check for an existing quest entry
-        if(_quest_log_info.find(quest_id) != _quest_log_info.end()) {
+        uint32 quest_symbol = InternString(quest_id);
+        if(_quest_log_info.Find(quest_symbol) != NULL) {
             PRINT_WARNING << "Duplicate quests defined in the 'quests' table of file: "
                 << quests_script_filename << std::endl;
             continue;
@@ -1572,7 +1703,7 @@ bool GameGlobal::_LoadQuestsScript(const std::string& quests_script_filename)
                                      quest_info[3], quest_info[4],
                                      MakeUnicodeString(quest_info[5]), quest_info[6],
                                      MakeUnicodeString(quest_info[7]), quest_info[8]);
-            _quest_log_info[quest_id] = info;
+            _quest_log_info.Insert(quest_symbol, info);
         }
         //malformed quest log
         else
@@ -29,8 +29,10 @@
 #include "engine/script/script_write.h"
 
 #include "global_actors.h"
+#include "global_definitions.h"
 #include "global_effects.h"
 #include "global_objects.h"
+#include "global_save.h"
 #include "global_skills.h"
 #include "global_utils.h"
 
@@ -85,9 +87,8 @@ public:
     *** \param event_name The name of the event to check for
     *** \return True if the event name was found in the group, false if it was not
     **/
-    bool DoesEventExist(const std::string &event_name) {
-        if(_events.find(event_name) != _events.end()) return true;
-        else return false;
+    bool DoesEventExist(const std::string &event_name) const {
+        return (_events.Find(vt_utils::FindStringSymbol(event_name)) != NULL);
     }
 
     /** \brief Adds a new event to the group
@@ -110,11 +111,24 @@ public:
     *** \param event_value The value to set for the event.
     *** \note If the event by the given name is not found, the event group will be created.
     **/
-    void SetEvent(const std::string &event_name, int32 event_value);
+    void SetEvent(const std::string &event_name, int32 event_value) {
+        _events[vt_utils::InternString(event_name)] = event_value;
+    }
+
+    //! \brief Symbol based versions of the methods above, for the callers keeping the interned event names.
+    //@{
+    const int32 *FindEvent(uint32 event_symbol) const {
+        return _events.Find(event_symbol);
+    }
+
+    void SetEvent(uint32 event_symbol, int32 event_value) {
+        _events[event_symbol] = event_value;
+    }
+    //@}
 
     //! \brief Returns the number of events currently stored within the group
     uint32 GetNumberEvents() const {
-        return _events.size();
+        return _events.Size();
     }
 
     //! \brief Returns a copy of the name of this group
@@ -123,7 +137,7 @@ public:
     }
 
     //! \brief Returns an immutable reference to the private _events container
-    const std::map<std::string, int32>& GetEvents() const {
+    const vt_utils::SymbolMap<int32>& GetEvents() const {
         return _events;
     }
 
@@ -132,11 +146,11 @@ private:
     std::string _group_name;
 
     /** \brief The map container for all the events in the group
-    *** The string is the name of the event, which is unique within the group. The integer value
+    *** The key is the interned name of the event, which is unique within the group. The integer value
     *** represents the event's state and can take on multiple meanings depending on the context
     *** of this specific event.
     **/
-    std::map<std::string, int32> _events;
+    vt_utils::SymbolMap<int32> _events;
 }; // class GlobalEventGroup
 
 /** ****************************************************************************
@@ -315,6 +329,29 @@ public:
     vt_video::StillImage _image;
 };
 
+/** ****************************************************************************
+*** \brief An interface for the classes displaying the inventory content
+***
+*** The listeners are told about every inventory change, so that they can update
+*** only the changed entries of their lists instead of building them again.
+*** The notifications can come in the middle of an inventory operation, so that
+*** the listeners should only note the changes, and apply them later.
+*** ***************************************************************************/
+class GlobalInventoryListener
+{
+public:
+    virtual ~GlobalInventoryListener()
+    {}
+
+    /** \brief Called when an object was added to or removed from the inventory, or when its count changed
+    *** \param obj_id The id of the changed object.
+    **/
+    virtual void InventoryChanged(uint32 obj_id) = 0;
+
+    //! \brief Called when the whole inventory was cleared.
+    virtual void InventoryCleared() = 0;
+};
+
 /** ****************************************************************************
 *** \brief Retains all the state information about the active game
 ***
@@ -476,17 +513,44 @@ public:
     *** \param id The id of the object (item, weapon, armor, etc.) to check for
     *** \return True if the object was found in the inventor, or false if it was not found
     **/
-    bool IsObjectInInventory(uint32 id) {
-        return (_inventory.find(id) != _inventory.end());
+    bool IsObjectInInventory(uint32 id) const {
+        return (GetInventoryObject(id) != NULL);
     }
 
     /** \brief Gives how many of a given item is in the inventory
     *** \param id The id of the object (item, weapon, armor, etc.) to check for
     *** \return The number of the object found in the inventory
     **/
-    uint32 HowManyObjectsInInventory(uint32 id) {
-        return (_inventory.find(id) != _inventory.end()) ? _inventory.at(id)->GetCount() : 0;
+    uint32 HowManyObjectsInInventory(uint32 id) const {
+        GlobalObject *object = GetInventoryObject(id);
+        return object ? object->GetCount() : 0;
     }
+
+    /** \brief Returns an object of the inventory
+    *** \param id The id of the object (item, weapon, armor, etc.) to get
+    *** \return The object, or NULL when it isn't in the inventory
+    **/
+    GlobalObject *GetInventoryObject(uint32 id) const {
+        return (id < _inventory.size()) ? _inventory[id].object : NULL;
+    }
+
+    //! \brief Tells whether the inventory contains no object.
+    bool IsInventoryEmpty() const {
+        return (_inventory_count == 0);
+    }
+
+    /** \brief Gives all the objects of the inventory
+    *** \param objects Filled with the objects, by category and in the order of each category.
+    **/
+    void GetInventoryObjects(std::vector<GlobalObject *> &objects) const;
+
+    /** \brief Registers a listener told about every inventory change
+    *** \note The listener must be removed before being destroyed.
+    **/
+    void AddInventoryListener(GlobalInventoryListener *listener);
+
+    //! \brief Unregisters an inventory listener.
+    void RemoveInventoryListener(GlobalInventoryListener *listener);
     //@}
 
     //! \name Event Group Methods
@@ -496,7 +560,7 @@ public:
     *** \return True if the event group name was found, false if it was not
     **/
     bool DoesEventGroupExist(const std::string &group_name) const {
-        return (_event_groups.find(group_name) != _event_groups.end());
+        return (_event_groups.Find(vt_utils::FindStringSymbol(group_name)) != NULL);
     }
 
     /** \brief Determines if an event of a given name exists within a given group
@@ -542,9 +606,22 @@ public:
     **/
     void SetEventValue(const std::string &group_name, const std::string &event_name, int32 event_value);
 
+    /** \name Symbol based event methods
+    *** These behave as the methods above, with the group and event names interned
+    *** through vt_utils::InternString(), sparing the string hashing to the callers
+    *** querying the same events over and over.
+    **/
+    //@{
+    bool DoesEventExist(uint32 group_symbol, uint32 event_symbol) const;
+
+    int32 GetEventValue(uint32 group_symbol, uint32 event_symbol) const;
+
+    void SetEventValue(uint32 group_symbol, uint32 event_symbol, int32 event_value);
+    //@}
+
     //! \brief Returns the number of event groups stored in the class
     uint32 GetNumberEventGroups() const {
-        return _event_groups.size();
+        return _event_groups.Size();
     }
 
     /** \brief Returns the number of events for a specified group name
@@ -560,11 +637,11 @@ public:
     //! and the current game event values.
     bool IsQuestCompleted(const std::string &quest_id)
     {
-        if (_quest_log_info.find(quest_id) == _quest_log_info.end())
+        const QuestLogInfo *info = _quest_log_info.Find(vt_utils::FindStringSymbol(quest_id));
+        if (!info)
             return false;
-        const QuestLogInfo info = _quest_log_info[quest_id];
 
-        return (GetEventValue(info._completion_event_group, info._completion_event_name) == 1);
+        return (GetEventValue(info->_completion_event_group, info->_completion_event_name) == 1);
     }
 
     /** \brief adds a new quest log entry into the quest log entries table
@@ -581,7 +658,7 @@ public:
     **/
     uint32 GetNumberQuestLogEntries() const
     {
-        return _quest_log_entries.size();
+        return _quest_log_entries.Size();
     }
 
     /** \brief get a list of all the currently active quest log entries
@@ -590,10 +667,9 @@ public:
     std::vector<QuestLogEntry *> GetActiveQuestIds() const
     {
         std::vector<QuestLogEntry *> keys;
-        for(std::map<std::string, QuestLogEntry *>::const_iterator itr = _quest_log_entries.begin();
-                itr != _quest_log_entries.end(); ++itr) {
-            if (itr->second)
-                keys.push_back(itr->second);
+        for(uint32 i = 0; i < _quest_log_entries.Size(); ++i) {
+            if (_quest_log_entries.GetValue(i))
+                keys.push_back(_quest_log_entries.GetValue(i));
         }
         return keys;
     }
@@ -759,7 +835,7 @@ public:
     //! \brief Executes function NewGame() from global script
     void NewGame();
 
-    /** \brief Saves all global data to a saved game file
+    /** \brief Saves all global data to a binary saved game file
     *** \param filename The filename of the saved game file where to write the data to
     *** \param slot_id The game slot id used for the save menu.
     *** \param positions When used in a save point, the save map tile positions are given there.
@@ -767,8 +843,20 @@ public:
     **/
     bool SaveGame(const std::string &filename, uint32 slot_id, uint32 x_position = 0, uint32 y_position = 0);
 
+    /** \brief Saves all global data to the autosave file in the background
+    *** The game data is copied right away, so that it can change while the file is written.
+    *** \note The autosave doesn't change the game slot id, so that the next saves default to the slot used before.
+    **/
+    void AutoSave();
+
+    //! \brief Returns the number of autosave files written so far, the autosave being written in the background.
+    uint32 GetAutoSaveWriteCount() {
+        return _save_file_writer.GetWrittenFileCount();
+    }
+
     /** \brief Loads all global data from a saved game file
-    *** \param filename The filename of the saved game file where to read the data from
+    *** \param filename The filename of the saved game file where to read the data from.
+    *** Both the binary saved games and the Lua ones written by the older versions are supported.
     *** \param slot_id The save slot the file correspond to. Used to set the correct cursor position
     *** when further saving.
     *** \return True if the game was successfully loaded, false if it was not
@@ -853,10 +941,6 @@ public:
         return &_active_party;
     }
 
-    std::map<uint32, GlobalObject *>* GetInventory() {
-        return &_inventory;
-    }
-
     std::vector<GlobalItem *>* GetInventoryItems() {
         return &_inventory_items;
     }
@@ -928,6 +1012,16 @@ public:
     vt_script::ReadScriptDescriptor &GetMapSpriteScript() {
         return _map_sprites_script;
     }
+
+    //! \brief Returns the definition of an object, read once from the object scripts.
+    const private_global::ObjectDefinition *GetObjectDefinition(uint32 id) const {
+        return _definitions.GetObjectDefinition(id);
+    }
+
+    //! \brief Returns the definition of a skill, read once from the skill scripts.
+    const private_global::SkillDefinition *GetSkillDefinition(uint32 id) const {
+        return _definitions.GetSkillDefinition(id);
+    }
     //@}
 
     //! \brief loads the emotes used for character feelings expression in the given lua file.
@@ -993,6 +1087,9 @@ private:
     //! \brief The map location the character is com from. Used to make the new map know where to make the character appear.
     std::string _previous_location;
 
+    //! \brief Writes the autosave files in the background.
+    private_global::SaveGameFileWriter _save_file_writer;
+
     /** \brief Stores the previous and current map names appearing on screen at intro time.
     *** This is used to know whether we have to display it, as we won't when it's the same location name than the previous map.
     **/
@@ -1017,17 +1114,39 @@ private:
     **/
     GlobalParty _active_party;
 
-    /** \brief Retains a list of all of the objects currently stored in the player's inventory
-    *** This map is used to quickly check if an item is in the inventory or not. The key to the map is the object's
-    *** identification number. When an object is added to the inventory, if it already exists then the object counter
-    *** is simply increased instead of adding an entire new class object. When the object count becomes zero, the object
-    *** is removed from the inventory. Duplicates of all objects are retained in the various inventory containers below.
+    //! \brief An entry of the inventory index.
+    struct InventorySlot {
+        InventorySlot() :
+            object(NULL),
+            position(0)
+        {}
+
+        //! \brief The object in the inventory, or NULL when there is none.
+        GlobalObject *object;
+
+        //! \brief The position of the object in its inventory container below.
+        uint32 position;
+    };
+
+    /** \brief Retains all of the objects currently stored in the player's inventory, indexed by id
+    *** This index is used to find an object of the inventory in constant time. It only grows up to the
+    *** greatest id ever added. When an object is added to the inventory, if it already exists then the
+    *** object counter is simply increased instead of adding an entire new class object. When the object
+    *** count becomes zero, the object is removed from the inventory. The same objects are retained in
+    *** the various inventory containers below.
     **/
-    std::map<uint32, GlobalObject *> _inventory;
+    std::vector<InventorySlot> _inventory;
+
+    //! \brief The number of objects in the inventory.
+    uint32 _inventory_count;
+
+    //! \brief The listeners told about the inventory changes.
+    std::vector<GlobalInventoryListener *> _inventory_listeners;
 
     /** \brief Inventory containers
     *** These vectors contain the inventory of the entire party. The vectors are sorted according to the player's personal preferences.
     *** When a new object is added to the inventory, by default it will be placed at the end of the vector.
+    *** Removing an object keeps the order of the other ones.
     **/
     //@{
     std::vector<GlobalItem *>     _inventory_items;
@@ -1087,17 +1206,20 @@ private:
     vt_script::ReadScriptDescriptor _map_treasures_script;
     //@}
 
+    //! \brief The object and skill definitions, read from the scripts above.
+    private_global::GlobalDefinitions _definitions;
+
     /** \brief The container which stores all of the groups of events that have occured in the game
-    *** The name of each GlobalEventGroup object serves as its key in this map data structure.
+    *** The interned name of each GlobalEventGroup object serves as its key in this map data structure.
     **/
-    std::map<std::string, GlobalEventGroup *> _event_groups;
+    vt_utils::SymbolMap<GlobalEventGroup *> _event_groups;
 
-    /** \brief The container which stores the quest log entries in the game. the quest log key
+    /** \brief The container which stores the quest log entries in the game. the interned quest log key
     *** acts as the key for this quest
     *** \note due to a limitation with OptionBoxes, we can only currently only support 255
     *** entries. Please be careful about this limitation
     **/
-    std::map<std::string, QuestLogEntry *> _quest_log_entries;
+    vt_utils::SymbolMap<QuestLogEntry *> _quest_log_entries;
 
     /** \brief the container which stores all the available world locations in the game.
     *** the world_location_id acts as the key
@@ -1117,8 +1239,8 @@ private:
     //! \brief The map continaing the four sprite direction offsets (x and y value).
     std::map<std::string, std::vector<std::pair<float, float> > > _emotes_offsets;
 
-    //! \brief a map of the quest string ids to their info
-    std::map<std::string, QuestLogInfo> _quest_log_info;
+    //! \brief a map of the interned quest string ids to their info
+    vt_utils::SymbolMap<QuestLogInfo> _quest_log_info;
 
     // ----- Global media files
     //! \brief member storing all the common media files.
@@ -1126,6 +1248,20 @@ private:
 
     // ----- Private methods
 
+    /** \brief A helper template function that adds a new object to the inventory
+    *** \param object The object to add, deleted when invalid
+    *** \param inv The vector container of the appropriate inventory type
+    **/
+    template <class T> void _AddToInventory(T *object, std::vector<T *>& inv);
+
+    /** \brief A helper template function that removes an object from the inventory index and container
+    *** \param obj_id The ID of the object to remove from the inventory
+    *** \param inv The vector container of the appropriate inventory type
+    *** \return The object removed, or NULL if it was not found
+    *** \note The object isn't deleted.
+    **/
+    template <class T> T *_TakeFromInventory(uint32 obj_id, std::vector<T *>& inv);
+
     /** \brief A helper template function that finds and removes an object from the inventory
     *** \param obj_id The ID of the object to remove from the inventory
     *** \param inv The vector container of the appropriate inventory type
@@ -1141,28 +1277,38 @@ private:
     **/
     template <class T> T *_RetrieveFromInventory(uint32 obj_id, std::vector<T *>& inv, bool all_counts);
 
-    /** \brief A helper function to GameGlobal::SaveGame() that stores the contents of a type of inventory to the saved game file
-    *** \param file A reference to the open and valid file where to write the inventory list
-    *** \param name The name under which this set of inventory data should be categorized (ie "items", "weapons", etc)
+    /** \brief A helper function to GameGlobal::SaveGame() that stores the contents of a type of inventory to the saved game data
+    *** \param file The saved game data where to write the inventory list
     *** \param inv A reference to the inventory vector to store
     *** \note The class type T must be a derived class of GlobalObject
     **/
-    template <class T> void _SaveInventory(vt_script::WriteScriptDescriptor &file, const std::string &name, std::vector<T *>& inv);
+    template <class T> void _SaveInventory(private_global::SaveGameWriter &file, std::vector<T *>& inv);
 
-    /** \brief A helper function to GameGlobal::SaveGame() that writes character data to the saved game file
-    *** \param file A reference to the open and valid file where to write the character data
+    //! \brief Tells the inventory listeners about an object change.
+    void _NotifyInventoryChanged(uint32 obj_id);
+
+    /** \brief Copies all the global data into saved game data
+    *** \param x_position, y_position The save point map tile position, or 0 when not saving from a save point.
+    *** \param header Where to write the preview header data.
+    *** \param file Where to write the saved game data.
+    *** This only writes to memory buffers, so that the files can be written later on in another thread.
+    **/
+    void _CaptureSaveGame(uint32 x_position, uint32 y_position,
+                          private_global::SaveGameWriter &header, private_global::SaveGameWriter &file);
+
+    /** \brief A helper function to GameGlobal::SaveGame() that writes character data to the saved game data
+    *** \param file The saved game data where to write the character data
     *** \param objects A ponter to the character whose data should be saved
-    *** \param last Set to true if this is the final character that needs to be saved
     *** This method will need to be called once for each character in the player's party
     **/
-    void _SaveCharacter(vt_script::WriteScriptDescriptor &file, GlobalCharacter *character, bool last);
+    void _SaveCharacter(private_global::SaveGameWriter &file, GlobalCharacter *character);
 
-    /** \brief A helper function to GameGlobal::SaveGame() that writes a group of event data to the saved game file
-    *** \param file A reference to the open and valid file where to write the event data
+    /** \brief A helper function to GameGlobal::SaveGame() that writes a group of event data to the saved game data
+    *** \param file The saved game data where to write the event data
     *** \param event_group A pointer to the group of events to store
     *** This method will need to be called once for each GlobalEventGroup contained by this class.
     **/
-    void _SaveEvents(vt_script::WriteScriptDescriptor &file, GlobalEventGroup *event_group);
+    void _SaveEvents(private_global::SaveGameWriter &file, GlobalEventGroup *event_group);
 
     /** \brief adds a new quest log entry into the quest log entries table. also updates the quest log number
     *** \param quest_id for the quest
@@ -1174,24 +1320,31 @@ private:
                       uint32 quest_log_number,
                       bool is_read = false)
     {
-        if(_quest_log_entries.find(quest_id) != _quest_log_entries.end())
+        uint32 quest_symbol = vt_utils::InternString(quest_id);
+        if(_quest_log_entries.Find(quest_symbol) != NULL)
             return false;
-        _quest_log_entries[quest_id] = new QuestLogEntry(quest_id,
-                                                         quest_log_number,
-                                                         is_read);
+        _quest_log_entries.Insert(quest_symbol, new QuestLogEntry(quest_id,
+                                                                  quest_log_number,
+                                                                  is_read));
         return true;
     }
 
     /** \brief Helper function that saves the Quest Log entries. this is called from SaveGame()
-    *** \param file Reference to open and valid file set for writting the data
+    *** \param file The saved game data where to write the entry
     *** \param the quest log entry we wish to write
     **/
-    void _SaveQuests(vt_script::WriteScriptDescriptor &file, const QuestLogEntry *quest_log_entry);
+    void _SaveQuests(private_global::SaveGameWriter &file, const QuestLogEntry *quest_log_entry);
 
     /** \brief saves the world map information. this is called from SaveGame()
-    *** \param file Reference to open and valid file for writting the data
+    *** \param file The saved game data where to write the world map information
     **/
-    void _SaveWorldMap(vt_script::WriteScriptDescriptor &file);
+    void _SaveWorldMap(private_global::SaveGameWriter &file);
+
+    /** \brief A helper function to LoadGame() that loads a binary saved game file
+    *** \param filename The binary saved game file
+    *** \return True if the game was successfully loaded
+    **/
+    bool _LoadBinaryGame(const std::string &filename);
 
     /** \brief A helper function to GameGlobal::LoadGame() that restores the contents of the inventory from a saved game file
     *** \param file A reference to the open and valid file from where to read the inventory list
@@ -1223,6 +1376,19 @@ private:
     **/
     void _LoadWorldMap(vt_script::ReadScriptDescriptor &file);
 
+    //! \brief Binary saved game versions of the loading helpers above, reading what the saving helpers wrote.
+    //@{
+    void _LoadInventory(private_global::SaveGameReader &file);
+
+    void _LoadCharacter(private_global::SaveGameReader &file);
+
+    void _LoadEvents(private_global::SaveGameReader &file);
+
+    void _LoadQuests(private_global::SaveGameReader &file);
+
+    void _LoadWorldMap(private_global::SaveGameReader &file);
+    //@}
+
     /** \brief Helper function called by LoadGlobalScripts() that (re)loads each world location from the script into the world location entry map
     *** \param file Path to the file to world locations script
     *** \return true if succesfully loaded
@@ -1244,73 +1410,95 @@ private:
 // Template Function Definitions
 //-----------------------------------------------------------------------------
 
-template <class T> bool GameGlobal::_RemoveFromInventory(uint32 obj_id, std::vector<T *>& inv)
+template <class T> void GameGlobal::_AddToInventory(T *object, std::vector<T *>& inv)
 {
-    for(typename std::vector<T *>::iterator i = inv.begin(); i != inv.end(); i++) {
-        if((*i)->GetID() == obj_id) {
-            // Delete the object, remove it from the vector container, and remove it from the _inventory map
-            delete _inventory[obj_id];
-            inv.erase(i);
-            _inventory.erase(obj_id);
-            return true;
-        }
+    if(object == NULL || !object->IsValid()) {
+        IF_PRINT_WARNING(GLOBAL_DEBUG) << "attempted to add an invalid object to the inventory" << std::endl;
+        delete object;
+        return;
     }
 
-    return false;
+    uint32 obj_id = object->GetID();
+    if(obj_id >= _inventory.size())
+        _inventory.resize(obj_id + 1);
+
+    _inventory[obj_id].object = object;
+    _inventory[obj_id].position = inv.size();
+    inv.push_back(object);
+    ++_inventory_count;
+
+    _NotifyInventoryChanged(obj_id);
+} // template <class T> void GameGlobal::_AddToInventory(T* object, std::vector<T*>& inv)
+
+
+
+template <class T> T *GameGlobal::_TakeFromInventory(uint32 obj_id, std::vector<T *>& inv)
+{
+    if(obj_id >= _inventory.size() || _inventory[obj_id].object == NULL)
+        return NULL;
+
+    uint32 position = _inventory[obj_id].position;
+    if(position >= inv.size() || inv[position]->GetID() != obj_id)
+        return NULL;
+
+    T *object = inv[position];
+    inv.erase(inv.begin() + position);
+
+    // Only the positions of the following objects changed.
+    for(uint32 i = position; i < inv.size(); ++i)
+        _inventory[inv[i]->GetID()].position = i;
+
+    _inventory[obj_id] = InventorySlot();
+    --_inventory_count;
+
+    _NotifyInventoryChanged(obj_id);
+    return object;
+} // template <class T> T* GameGlobal::_TakeFromInventory(uint32 obj_id, std::vector<T*>& inv)
+
+
+
+template <class T> bool GameGlobal::_RemoveFromInventory(uint32 obj_id, std::vector<T *>& inv)
+{
+    T *object = _TakeFromInventory(obj_id, inv);
+    if(object == NULL)
+        return false;
+
+    delete object;
+    return true;
 } // template <class T> bool GameGlobal::_RemoveFromInventory(uint32 obj_id, std::vector<T*>& inv)
 
 
 
 template <class T> T *GameGlobal::_RetrieveFromInventory(uint32 obj_id, std::vector<T *>& inv, bool all_counts)
 {
-    for(typename std::vector<T *>::iterator i = inv.begin(); i != inv.end(); i++) {
-        if((*i)->GetID() == obj_id) {
-            T *return_object;
-            if(all_counts == true || _inventory[obj_id]->GetCount() == 1) {
-                return_object = *i;
-                _inventory.erase(obj_id);
-                inv.erase(i);
-            } else {
-                return_object = new T(**i);
-                return_object->SetCount(1);
-                _inventory[obj_id]->DecrementCount();
-            }
-            return return_object;
-        }
-    }
+    if(obj_id >= _inventory.size() || _inventory[obj_id].object == NULL)
+        return NULL;
 
-    return NULL;
-} // template <class T> T* GameGlobal::_RetrieveFromInventory(uint32 obj_id, std::vector<T*>& inv, bool all_counts)
+    if(all_counts == true || _inventory[obj_id].object->GetCount() == 1)
+        return _TakeFromInventory(obj_id, inv);
 
+    uint32 position = _inventory[obj_id].position;
+    if(position >= inv.size() || inv[position]->GetID() != obj_id)
+        return NULL;
 
+    T *return_object = new T(*inv[position]);
+    return_object->SetCount(1);
+    inv[position]->DecrementCount();
 
-template <class T> void GameGlobal::_SaveInventory(vt_script::WriteScriptDescriptor &file, const std::string &name, std::vector<T *>& inv)
-{
-    if(file.IsFileOpen() == false) {
-        IF_PRINT_WARNING(GLOBAL_DEBUG) << "failed because the argument file was not open" << std::endl;
-        return;
-    }
+    _NotifyInventoryChanged(obj_id);
+    return return_object;
+} // template <class T> T* GameGlobal::_RetrieveFromInventory(uint32 obj_id, std::vector<T*>& inv, bool all_counts)
 
-    file.InsertNewLine();
-    file.WriteLine(name + " = {");
-    for(uint32 i = 0; i < inv.size(); i++) {
-        if(i == 0)
-            file.WriteLine("\t", false);
-        else
-            file.WriteLine(", ", false);
 
-        // Add a new line every 10 entries for better readability and debugging
-        if ((i > 0) && !(i % 10)) {
-            file.InsertNewLine();
-            file.WriteLine("\t", false);
-        }
 
-        file.WriteLine("[" + vt_utils::NumberToString(inv[i]->GetID()) + "] = "
-                       + vt_utils::NumberToString(inv[i]->GetCount()), false);
+template <class T> void GameGlobal::_SaveInventory(private_global::SaveGameWriter &file, std::vector<T *>& inv)
+{
+    file.WriteUInt32(inv.size());
+    for(uint32 i = 0; i < inv.size(); i++) {
+        file.WriteUInt32(inv[i]->GetID());
+        file.WriteUInt32(inv[i]->GetCount());
     }
-    file.InsertNewLine();
-    file.WriteLine("},");
-} // template <class T> void GameGlobal::_SaveInventory(vt_script::WriteScriptDescriptor& file, std::string name, std::vector<T*>& inv)
+} // template <class T> void GameGlobal::_SaveInventory(private_global::SaveGameWriter& file, std::vector<T*>& inv)
 
 } // namespace vt_global
 
@@ -0,0 +1,420 @@
+////////////////////////////////////////////////////////////////////////////////
+//            Copyright (C) 2013 by Bertram (Valyria Tear)
+//                         All Rights Reserved
+//
+// This code is licensed under the GNU GPL version 2. It is free software
+// and you may modify it and/or redistribute it under the terms of this license.
+// See http://www.gnu.org/copyleft/gpl.html for details.
+////////////////////////////////////////////////////////////////////////////////
+
+/** ****************************************************************************
+*** \file    global_definitions.cpp
+*** \author  Yohann Ferreira, yohann ferreira orange fr
+*** \brief   Source file for the object and skill definitions
+*** ***************************************************************************/
+
+#include "global_definitions.h"
+
+#include "engine/script/script_read.h"
+
+using namespace vt_utils;
+using namespace vt_script;
+using namespace vt_video;
+
+namespace vt_global
+{
+
+namespace private_global
+{
+
+//! \brief The maximum number of shard slots of an equipment.
+static const uint32 MAX_SHARD_SLOTS = 5;
+
+void GlobalDefinitions::LoadObjectDefinitions(ReadScriptDescriptor &script, GLOBAL_OBJECT object_type)
+{
+    std::vector<uint32> ids;
+    script.ReadTableKeys(ids);
+
+    for(uint32 i = 0; i < ids.size(); ++i) {
+        uint32 id = ids[i];
+        if(id == 0 || id >= OBJECT_ID_EXCEEDS) {
+            PRINT_WARNING << "invalid object id in definition file: " << id << std::endl;
+            continue;
+        }
+
+        ObjectDefinition &definition = _GetObjectSlot(id);
+        if(!script.OpenTable(id))
+            continue;
+
+        _ReadObjectDefinition(script, object_type, definition);
+        script.CloseTable(); // id
+
+        if(script.IsErrorDetected()) {
+            PRINT_WARNING << "one or more errors occurred while reading object data: " << id
+                          << " - they are listed below" << std::endl << script.GetErrorMessages() << std::endl;
+            script.ClearErrors();
+            continue;
+        }
+        definition.id = id;
+    }
+}
+
+void GlobalDefinitions::LoadSkillDefinitions(ReadScriptDescriptor &script)
+{
+    std::vector<uint32> ids;
+    script.ReadTableKeys(ids);
+
+    for(uint32 i = 0; i < ids.size(); ++i) {
+        uint32 id = ids[i];
+        if(id == 0 || id > MAX_SPECIAL_SKILL_ID) {
+            PRINT_WARNING << "invalid skill id in definition file: " << id << std::endl;
+            continue;
+        }
+
+        SkillDefinition &definition = _GetSkillSlot(id);
+        if(!script.OpenTable(id))
+            continue;
+
+        // The skill type is given by its id range
+        if(id <= MAX_WEAPON_SKILL_ID)
+            definition.type = GLOBAL_SKILL_WEAPON;
+        else if(id <= MAX_MAGIC_SKILL_ID)
+            definition.type = GLOBAL_SKILL_MAGIC;
+        else
+            definition.type = GLOBAL_SKILL_SPECIAL;
+
+        _ReadSkillDefinition(script, definition);
+        script.CloseTable(); // id
+
+        if(script.IsErrorDetected()) {
+            PRINT_WARNING << "One or more errors occurred while reading skill data: " << id
+                          << " - they are listed below:" << std::endl << script.GetErrorMessages() << std::endl;
+            script.ClearErrors();
+            continue;
+        }
+        definition.id = id;
+    }
+}
+
+ObjectDefinition &GlobalDefinitions::_GetObjectSlot(uint32 id)
+{
+    if(id >= _object_indices.size())
+        _object_indices.resize(id + 1, -1);
+
+    // The definition is reset in place, since the object instances point to it.
+    if(_object_indices[id] >= 0) {
+        ObjectDefinition &definition = _objects[_object_indices[id]];
+        definition = ObjectDefinition();
+        return definition;
+    }
+
+    _object_indices[id] = _objects.size();
+    _objects.push_back(ObjectDefinition());
+    return _objects.back();
+}
+
+SkillDefinition &GlobalDefinitions::_GetSkillSlot(uint32 id)
+{
+    if(id >= _skill_indices.size())
+        _skill_indices.resize(id + 1, -1);
+
+    // The definition is reset in place, since the skill instances point to it.
+    if(_skill_indices[id] >= 0) {
+        SkillDefinition &definition = _skills[_skill_indices[id]];
+        definition = SkillDefinition();
+        return definition;
+    }
+
+    _skill_indices[id] = _skills.size();
+    _skills.push_back(SkillDefinition());
+    return _skills.back();
+}
+
+void GlobalDefinitions::_ReadObjectDefinition(ReadScriptDescriptor &script, GLOBAL_OBJECT object_type,
+                                              ObjectDefinition &definition)
+{
+    definition.name = MakeUnicodeString(script.ReadString("name"));
+    definition.description = MakeUnicodeString(script.ReadString("description"));
+    definition.price = script.ReadUInt("standard_price");
+    _ReadTradeConditions(script, definition);
+    std::string icon_file = script.ReadString("icon");
+    if(script.DoesBoolExist("key_item"))
+        definition.is_key_item = script.ReadBool("key_item");
+    if(!definition.icon_image.Load(icon_file)) {
+        PRINT_WARNING << "failed to load icon image for item: " << icon_file << std::endl;
+
+        // try a default icon in that case
+        definition.icon_image.Load("img/icons/battle/default_special.png");
+    }
+
+    switch(object_type) {
+    case GLOBAL_OBJECT_ITEM:
+        definition.target_type = static_cast<GLOBAL_TARGET>(script.ReadInt("target_type"));
+        definition.warmup_time = script.ReadUInt("warmup_time");
+        definition.cooldown_time = script.ReadUInt("cooldown_time");
+        definition.battle_use_function = script.ReadFunctionPointer("BattleUse");
+        definition.field_use_function = script.ReadFunctionPointer("FieldUse");
+        break;
+
+    case GLOBAL_OBJECT_WEAPON:
+        _ReadElementalEffects(script, definition);
+        _ReadStatusEffects(script, definition);
+        definition.physical_attack = script.ReadUInt("physical_attack");
+        definition.magical_attack = script.ReadUInt("magical_attack");
+        definition.usable_by = script.ReadUInt("usable_by");
+        definition.shard_slots = script.ReadUInt("slots");
+
+        // Load the possible battle ammo animated image filename.
+        definition.ammo_image_file = script.ReadString("battle_ammo_animation_file");
+
+        // Load the weapon battle animation info
+        if(script.DoesTableExist("battle_animations"))
+            _ReadWeaponBattleAnimations(script, definition);
+        break;
+
+    case GLOBAL_OBJECT_HEAD_ARMOR:
+    case GLOBAL_OBJECT_TORSO_ARMOR:
+    case GLOBAL_OBJECT_ARM_ARMOR:
+    case GLOBAL_OBJECT_LEG_ARMOR:
+        _ReadElementalEffects(script, definition);
+        _ReadStatusEffects(script, definition);
+        definition.physical_defense = script.ReadUInt("physical_defense");
+        definition.magical_defense = script.ReadUInt("magical_defense");
+        definition.usable_by = script.ReadUInt("usable_by");
+        definition.shard_slots = script.ReadUInt("slots");
+        break;
+
+    default:
+        break;
+    }
+
+    // Only permit a max of 5 shards for equipment
+    if(definition.shard_slots > MAX_SHARD_SLOTS) {
+        definition.shard_slots = MAX_SHARD_SLOTS;
+        PRINT_WARNING << "More than 5 shards declared in item: " << icon_file << std::endl;
+    }
+}
+
+void GlobalDefinitions::_ReadTradeConditions(ReadScriptDescriptor &script, ObjectDefinition &definition)
+{
+    if(!script.DoesTableExist("trade_conditions"))
+        return;
+
+    std::vector<uint32> temp;
+    script.ReadTableKeys("trade_conditions", temp);
+
+    if(temp.empty())
+        return;
+
+    script.OpenTable("trade_conditions");
+
+    for(uint32 i = 0; i < temp.size(); ++i) {
+        uint32 key = temp[i];
+        uint32 quantity = script.ReadInt(key);
+
+        // Set the trade price
+        if(key == 0)
+            definition.trade_price = quantity;
+        else // Or the conditions.
+            definition.trade_conditions.push_back(std::pair<uint32, uint32>(key, quantity));
+    }
+
+    script.CloseTable(); // trade_conditions
+}
+
+void GlobalDefinitions::_ReadElementalEffects(ReadScriptDescriptor &script, ObjectDefinition &definition)
+{
+    if(!script.DoesTableExist("elemental_effects"))
+        return;
+
+    std::vector<int32> elemental_effects;
+    script.ReadTableKeys("elemental_effects", elemental_effects);
+
+    if(elemental_effects.empty())
+        return;
+
+    script.OpenTable("elemental_effects");
+
+    for(uint32 i = 0; i < elemental_effects.size(); ++i) {
+
+        int32 key = elemental_effects[i];
+        if(key <= GLOBAL_ELEMENTAL_INVALID || key >= GLOBAL_ELEMENTAL_TOTAL)
+            continue;
+
+        int32 intensity = script.ReadInt(key);
+        if(intensity <= GLOBAL_INTENSITY_INVALID || intensity >= GLOBAL_INTENSITY_TOTAL)
+            continue;
+
+        definition.elemental_effects.push_back(std::pair<GLOBAL_ELEMENTAL, GLOBAL_INTENSITY>((GLOBAL_ELEMENTAL)key, (GLOBAL_INTENSITY)intensity));
+    }
+
+    script.CloseTable(); // elemental_effects
+}
+
+void GlobalDefinitions::_ReadStatusEffects(ReadScriptDescriptor &script, ObjectDefinition &definition)
+{
+    if(!script.DoesTableExist("status_effects"))
+        return;
+
+    std::vector<int32> status_effects;
+    script.ReadTableKeys("status_effects", status_effects);
+
+    if(status_effects.empty())
+        return;
+
+    script.OpenTable("status_effects");
+
+    for(uint32 i = 0; i < status_effects.size(); ++i) {
+
+        int32 key = status_effects[i];
+        if(key <= GLOBAL_STATUS_INVALID || key >= GLOBAL_STATUS_TOTAL)
+            continue;
+
+        int32 intensity = script.ReadInt(key);
+        // Note: The intensity of a status effect can only be positive
+        if(intensity < GLOBAL_INTENSITY_NEUTRAL || intensity >= GLOBAL_INTENSITY_TOTAL)
+            continue;
+
+        // Check whether an opposite effect exists.
+        bool effect_replaced = false;
+        GLOBAL_STATUS opposite_effect = GetOppositeStatusEffect((GLOBAL_STATUS) key);
+        for(uint32 j = 0; j < definition.status_effects.size(); ++j) {
+            if(definition.status_effects[j].first != opposite_effect)
+                continue;
+
+            PRINT_WARNING << "The item (icon: " << definition.icon_image.GetFilename()
+                          << ") has opposing passive status effects." << std::endl;
+            effect_replaced = true;
+            break;
+        }
+
+        if(effect_replaced)
+            continue;
+
+        definition.status_effects.push_back(std::pair<GLOBAL_STATUS, GLOBAL_INTENSITY>((GLOBAL_STATUS)key, (GLOBAL_INTENSITY)intensity));
+    }
+
+    script.CloseTable(); // status_effects
+}
+
+void GlobalDefinitions::_ReadWeaponBattleAnimations(ReadScriptDescriptor &script, ObjectDefinition &definition)
+{
+    // The character id keys
+    std::vector<uint32> char_ids;
+
+    script.ReadTableKeys("battle_animations", char_ids);
+    if(char_ids.empty())
+        return;
+
+    if(!script.OpenTable("battle_animations"))
+        return;
+
+    for(uint32 i = 0; i < char_ids.size(); ++i) {
+        uint32 char_id = char_ids[i];
+
+        // Read all the animation aliases
+        std::vector<std::string> anim_aliases;
+        script.ReadTableKeys(char_id, anim_aliases);
+
+        if(anim_aliases.empty())
+            continue;
+
+        if(!script.OpenTable(char_id))
+            continue;
+
+        for(uint32 j = 0; j < anim_aliases.size(); ++j) {
+            const std::string &anim_alias = anim_aliases[j];
+            definition.weapon_animations[char_id][anim_alias] = script.ReadString(anim_alias);
+        }
+
+        script.CloseTable(); // char_id
+    }
+
+    script.CloseTable(); // battle_animations
+}
+
+void GlobalDefinitions::_ReadSkillDefinition(ReadScriptDescriptor &script, SkillDefinition &definition)
+{
+    definition.name = MakeUnicodeString(script.ReadString("name"));
+    if(script.DoesStringExist("description"))
+        definition.description = MakeUnicodeString(script.ReadString("description"));
+    if(script.DoesStringExist("icon"))
+        definition.icon_filename = script.ReadString("icon");
+    definition.sp_required = script.ReadUInt("sp_required");
+    definition.warmup_time = script.ReadUInt("warmup_time");
+    definition.cooldown_time = script.ReadUInt("cooldown_time");
+    definition.warmup_action_name = script.ReadString("warmup_action_name");
+    definition.action_name = script.ReadString("action_name");
+    definition.target_type = static_cast<GLOBAL_TARGET>(script.ReadInt("target_type"));
+
+    definition.battle_execute_function = script.ReadFunctionPointer("BattleExecute");
+    definition.field_execute_function = script.ReadFunctionPointer("FieldExecute");
+    _ReadSkillBattleEffect(script, definition);
+
+    // Read all the battle animation scripts linked to this skill, if any
+    if(script.DoesTableExist("animation_scripts")) {
+        std::vector<uint32> characters_ids;
+        script.ReadTableKeys("animation_scripts", characters_ids);
+        script.OpenTable("animation_scripts");
+        for(uint32 i = 0; i < characters_ids.size(); ++i) {
+            definition.animation_scripts[characters_ids[i]] = script.ReadString(characters_ids[i]);
+        }
+        script.CloseTable(); // animation_scripts table
+    }
+}
+
+void GlobalDefinitions::_ReadSkillBattleEffect(ReadScriptDescriptor &script, SkillDefinition &definition)
+{
+    if(!script.DoesTableExist("battle_effect"))
+        return;
+
+    // The battle execute function is used rather than the effect when both are given.
+    if(definition.battle_execute_function.is_valid()) {
+        PRINT_WARNING << "Skill with both a battle effect and a BattleExecute function, the effect is ignored: "
+                      << MakeStandardString(definition.name) << std::endl;
+        return;
+    }
+
+    SkillBattleEffect &effect = definition.battle_effect;
+    script.OpenTable("battle_effect");
+
+    if(script.DoesIntExist("damage_type")) {
+        int32 damage_type = script.ReadInt("damage_type");
+        if(damage_type > GLOBAL_DAMAGE_INVALID && damage_type < GLOBAL_DAMAGE_TOTAL)
+            effect.damage_type = static_cast<GLOBAL_DAMAGE>(damage_type);
+        else
+            PRINT_WARNING << "Invalid skill damage type: " << damage_type << std::endl;
+    }
+    if(script.DoesIntExist("damage_adder"))
+        effect.damage_adder = script.ReadInt("damage_adder");
+    if(script.DoesFloatExist("damage_multiplier"))
+        effect.damage_multiplier = script.ReadFloat("damage_multiplier");
+    if(script.DoesFloatExist("evade_adder"))
+        effect.evade_adder = script.ReadFloat("evade_adder");
+
+    if(script.DoesIntExist("status")) {
+        int32 status = script.ReadInt("status");
+        int32 intensity = script.ReadInt("status_intensity");
+        if(status > GLOBAL_STATUS_INVALID && status < GLOBAL_STATUS_TOTAL
+                && intensity > GLOBAL_INTENSITY_INVALID && intensity < GLOBAL_INTENSITY_TOTAL) {
+            effect.status = static_cast<GLOBAL_STATUS>(status);
+            effect.status_intensity = static_cast<GLOBAL_INTENSITY>(intensity);
+        } else {
+            PRINT_WARNING << "Invalid skill status effect: " << status << ", intensity: " << intensity << std::endl;
+        }
+    }
+    if(script.DoesFloatExist("status_chance"))
+        effect.status_chance = script.ReadFloat("status_chance");
+
+    if(script.DoesStringExist("hit_sound"))
+        effect.hit_sound = script.ReadString("hit_sound");
+    if(script.DoesStringExist("miss_sound"))
+        effect.miss_sound = script.ReadString("miss_sound");
+
+    script.CloseTable(); // battle_effect table
+    effect.valid = true;
+}
+
+} // namespace private_global
+
+} // namespace vt_global
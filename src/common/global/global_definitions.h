@@ -0,0 +1,268 @@
+////////////////////////////////////////////////////////////////////////////////
+//            Copyright (C) 2013 by Bertram (Valyria Tear)
+//                         All Rights Reserved
+//
+// This code is licensed under the GNU GPL version 2. It is free software
+// and you may modify it and/or redistribute it under the terms of this license.
+// See http://www.gnu.org/copyleft/gpl.html for details.
+////////////////////////////////////////////////////////////////////////////////
+
+/** ****************************************************************************
+*** \file    global_definitions.h
+*** \author  Yohann Ferreira, yohann ferreira orange fr
+*** \brief   Header file for the object and skill definitions
+***
+*** The data of the objects and skills is read once from their definition
+*** scripts when the global scripts are loaded. The object and skill instances
+*** then only point to their definition, rather than reading the scripts again.
+*** ***************************************************************************/
+
+#ifndef __GLOBAL_DEFINITIONS_HEADER__
+#define __GLOBAL_DEFINITIONS_HEADER__
+
+#include "global_utils.h"
+
+#include "engine/video/image.h"
+#include "engine/script/script.h"
+
+#include <deque>
+
+namespace vt_script {
+class ReadScriptDescriptor;
+}
+
+namespace vt_global
+{
+
+namespace private_global
+{
+
+/** ****************************************************************************
+*** \brief The data shared by all the instances of an object.
+***
+*** The members specific to an object type are left to their default value
+*** for the other types.
+*** ***************************************************************************/
+struct ObjectDefinition {
+    ObjectDefinition() :
+        id(0),
+        is_key_item(false),
+        price(0),
+        trade_price(0),
+        target_type(GLOBAL_TARGET_INVALID),
+        warmup_time(0),
+        cooldown_time(0),
+        physical_attack(0),
+        magical_attack(0),
+        physical_defense(0),
+        magical_defense(0),
+        usable_by(0),
+        shard_slots(0)
+    {}
+
+    //! \brief The object id, or 0 when the definition is invalid.
+    uint32 id;
+
+    vt_utils::ustring name;
+    vt_utils::ustring description;
+    bool is_key_item;
+    uint32 price;
+    uint32 trade_price;
+
+    //! \brief The trade conditions <item_id, number>
+    std::vector<std::pair<uint32, uint32> > trade_conditions;
+
+    //! \brief The icon image, shared by all the instances of the object.
+    vt_video::StillImage icon_image;
+
+    std::vector<std::pair<GLOBAL_ELEMENTAL, GLOBAL_INTENSITY> > elemental_effects;
+    std::vector<std::pair<GLOBAL_STATUS, GLOBAL_INTENSITY> > status_effects;
+
+    //! \name Item members
+    //@{
+    GLOBAL_TARGET target_type;
+    uint32 warmup_time;
+    uint32 cooldown_time;
+    ScriptObject battle_use_function;
+    ScriptObject field_use_function;
+    //@}
+
+    //! \name Weapon and armor members
+    //@{
+    uint32 physical_attack;
+    uint32 magical_attack;
+    uint32 physical_defense;
+    uint32 magical_defense;
+    uint32 usable_by;
+
+    //! \brief The number of shard slots of the equipment.
+    uint32 shard_slots;
+
+    std::string ammo_image_file;
+
+    //! \brief map < character_id, map < animation alias, animation filename > >
+    std::map<uint32, std::map<std::string, std::string> > weapon_animations;
+    //@}
+};
+
+/** ****************************************************************************
+*** \brief The standard battle effect of a skill
+***
+*** Most skills only check the target evasion, then change a status, deal damage
+*** and play a sound. Such skills give their effect in a battle_effect table
+*** rather than a BattleExecute function, and are executed without any script.
+*** ***************************************************************************/
+struct SkillBattleEffect {
+    SkillBattleEffect() :
+        valid(false),
+        damage_type(GLOBAL_DAMAGE_INVALID),
+        damage_adder(0),
+        damage_multiplier(1.0f),
+        evade_adder(0.0f),
+        status(GLOBAL_STATUS_INVALID),
+        status_intensity(GLOBAL_INTENSITY_NEUTRAL),
+        status_chance(100.0f)
+    {}
+
+    //! \brief Whether the skill has a battle effect.
+    bool valid;
+
+    //! \brief How the damage is computed, or GLOBAL_DAMAGE_INVALID when the skill deals no damage.
+    GLOBAL_DAMAGE damage_type;
+
+    //! \brief The attack added to the user attack, used when the multiplier is 1.
+    int32 damage_adder;
+
+    //! \brief The multiplier applied to the damage.
+    float damage_multiplier;
+
+    //! \brief The evasion added to the target evasion, in percent.
+    float evade_adder;
+
+    //! \brief The status changed on the target when hit, if any.
+    GLOBAL_STATUS status;
+    GLOBAL_INTENSITY status_intensity;
+
+    //! \brief The chance to change the status when the target is hit, in percent. Only rolled when below 100.
+    float status_chance;
+
+    //! \brief The sounds played when the target is hit or missed, if any.
+    std::string hit_sound;
+    std::string miss_sound;
+};
+
+//! \brief The data shared by all the instances of a skill.
+struct SkillDefinition {
+    SkillDefinition() :
+        id(0),
+        type(GLOBAL_SKILL_INVALID),
+        sp_required(0),
+        warmup_time(0),
+        cooldown_time(0),
+        target_type(GLOBAL_TARGET_INVALID)
+    {}
+
+    //! \brief The skill id, or 0 when the definition is invalid.
+    uint32 id;
+
+    vt_utils::ustring name;
+    vt_utils::ustring description;
+    std::string icon_filename;
+    GLOBAL_SKILL type;
+    uint32 sp_required;
+    uint32 warmup_time;
+    uint32 cooldown_time;
+    std::string warmup_action_name;
+    std::string action_name;
+    GLOBAL_TARGET target_type;
+    ScriptObject battle_execute_function;
+    ScriptObject field_execute_function;
+
+    //! \brief The effect executed in battles when there is no battle execute function.
+    SkillBattleEffect battle_effect;
+
+    //! \brief The animation scripts filenames, by character id.
+    std::map<uint32, std::string> animation_scripts;
+};
+
+/** ****************************************************************************
+*** \brief Holds the definitions of all the objects and skills.
+***
+*** The definitions are stored one after the other and indexed by id. A
+*** definition never moves nor is freed once read, and is updated in place
+*** when the scripts are read again, so that the object and skill instances
+*** can keep pointing to it.
+*** ***************************************************************************/
+class GlobalDefinitions
+{
+public:
+    /** \brief Reads all the object definitions of a script file
+    *** \param script The definition script, whose definitions table is open.
+    *** \param object_type The type of the objects defined, telling which data to read.
+    **/
+    void LoadObjectDefinitions(vt_script::ReadScriptDescriptor &script, GLOBAL_OBJECT object_type);
+
+    /** \brief Reads all the skill definitions of a script file
+    *** \param script The definition script, whose skills table is open.
+    **/
+    void LoadSkillDefinitions(vt_script::ReadScriptDescriptor &script);
+
+    //! \brief Returns the definition of an object, or an invalid definition when there is none.
+    const ObjectDefinition *GetObjectDefinition(uint32 id) const {
+        if(id < _object_indices.size() && _object_indices[id] >= 0)
+            return &_objects[_object_indices[id]];
+        return &_invalid_object;
+    }
+
+    //! \brief Returns the definition of a skill, or an invalid definition when there is none.
+    const SkillDefinition *GetSkillDefinition(uint32 id) const {
+        if(id < _skill_indices.size() && _skill_indices[id] >= 0)
+            return &_skills[_skill_indices[id]];
+        return &_invalid_skill;
+    }
+
+private:
+    //! \brief The object definitions, in reading order.
+    std::deque<ObjectDefinition> _objects;
+
+    //! \brief The index of each object definition in _objects, by id, or -1 when there is none.
+    std::vector<int32> _object_indices;
+
+    //! \brief The skill definitions, in reading order.
+    std::deque<SkillDefinition> _skills;
+
+    //! \brief The index of each skill definition in _skills, by id, or -1 when there is none.
+    std::vector<int32> _skill_indices;
+
+    //! \brief The definitions given for unknown ids.
+    ObjectDefinition _invalid_object;
+    SkillDefinition _invalid_skill;
+
+    /** \brief Returns the definition to fill for an id, creating it when needed
+    *** The definition is reset when it already exists.
+    **/
+    ObjectDefinition &_GetObjectSlot(uint32 id);
+    SkillDefinition &_GetSkillSlot(uint32 id);
+
+    //! \brief Reads the definition of an object from its open table.
+    void _ReadObjectDefinition(vt_script::ReadScriptDescriptor &script, GLOBAL_OBJECT object_type,
+                               ObjectDefinition &definition);
+
+    //! \brief Helpers to _ReadObjectDefinition() reading the optional tables of a definition.
+    void _ReadTradeConditions(vt_script::ReadScriptDescriptor &script, ObjectDefinition &definition);
+    void _ReadElementalEffects(vt_script::ReadScriptDescriptor &script, ObjectDefinition &definition);
+    void _ReadStatusEffects(vt_script::ReadScriptDescriptor &script, ObjectDefinition &definition);
+    void _ReadWeaponBattleAnimations(vt_script::ReadScriptDescriptor &script, ObjectDefinition &definition);
+
+    //! \brief Reads the definition of a skill from its open table.
+    void _ReadSkillDefinition(vt_script::ReadScriptDescriptor &script, SkillDefinition &definition);
+
+    //! \brief Helper to _ReadSkillDefinition() reading the optional battle effect of a skill.
+    void _ReadSkillBattleEffect(vt_script::ReadScriptDescriptor &script, SkillDefinition &definition);
+}; // class GlobalDefinitions
+
+} // namespace private_global
+
+} // namespace vt_global
+
+#endif // __GLOBAL_DEFINITIONS_HEADER__
@@ -0,0 +1,559 @@
+////////////////////////////////////////////////////////////////////////////////
+//            Copyright (C) 2013 by Bertram (Valyria Tear)
+//                         All Rights Reserved
+//
+// This code is licensed under the GNU GPL version 2. It is free software
+// and you may modify it and/or redistribute it under the terms of this license.
+// See http://www.gnu.org/copyleft/gpl.html for details.
+////////////////////////////////////////////////////////////////////////////////
+
+/** ****************************************************************************
+*** \file    global_save.cpp
+*** \author  Yohann Ferreira, yohann ferreira orange fr
+*** \brief   Source file for the saved game files
+*** ***************************************************************************/
+
+#include "global_save.h"
+
+#include "engine/script/script_read.h"
+
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+
+#ifdef _WIN32
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+using namespace vt_utils;
+using namespace vt_script;
+
+namespace vt_global
+{
+
+namespace private_global
+{
+
+//! \brief The first bytes of a binary saved game file.
+static const uint32 SAVE_GAME_MAGIC = 0x47535456; // "VTSG"
+
+//! \brief Changes whenever the saved game format changes.
+static const uint32 SAVE_GAME_VERSION = 1;
+
+//! \brief The size of the file header preceding the preview header: magic, version and preview header size.
+static const uint32 SAVE_GAME_FILE_HEADER_SIZE = 12;
+
+//! \brief Computes the FNV-1a hash of the saved game data, to detect corrupted files.
+static uint32 _HashSaveData(const std::string &data)
+{
+    uint32 hash = 2166136261u;
+    for(size_t i = 0; i < data.size(); ++i) {
+        hash ^= static_cast<uint8>(data[i]);
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+//! \brief Decodes a little endian value.
+static uint32 _DecodeUInt32(const char *data)
+{
+    const uint8 *bytes = reinterpret_cast<const uint8 *>(data);
+    return bytes[0] | (bytes[1] << 8) | (bytes[2] << 16) | (static_cast<uint32>(bytes[3]) << 24);
+}
+
+//! \brief Returns the number of bytes left to read in a file, up to 0xFFFFFFFF.
+static uint32 _GetRemainingFileSize(std::ifstream &file)
+{
+    std::streampos position = file.tellg();
+    file.seekg(0, std::ios::end);
+    std::streampos end = file.tellg();
+    file.seekg(position);
+    if(position < 0 || end < position)
+        return 0;
+
+    std::streamoff remaining = end - position;
+    if(remaining > static_cast<std::streamoff>(0xFFFFFFFFu))
+        return 0xFFFFFFFFu;
+    return static_cast<uint32>(remaining);
+}
+
+void SaveGameWriter::WriteUInt32(uint32 value)
+{
+    _data.push_back(static_cast<char>(value & 0xFF));
+    _data.push_back(static_cast<char>((value >> 8) & 0xFF));
+    _data.push_back(static_cast<char>((value >> 16) & 0xFF));
+    _data.push_back(static_cast<char>((value >> 24) & 0xFF));
+}
+
+void SaveGameWriter::WriteFloat(float value)
+{
+    uint32 bits = 0;
+    memcpy(&bits, &value, sizeof(bits));
+    WriteUInt32(bits);
+}
+
+void SaveGameWriter::WriteString(const std::string &value)
+{
+    WriteUInt32(value.size());
+    _data.append(value);
+}
+
+bool SaveGameReader::_CanRead(size_t size)
+{
+    if(_valid && _data.size() - _position >= size)
+        return true;
+    _valid = false;
+    return false;
+}
+
+uint8 SaveGameReader::ReadUInt8()
+{
+    if(!_CanRead(1))
+        return 0;
+    return static_cast<uint8>(_data[_position++]);
+}
+
+uint32 SaveGameReader::ReadUInt32()
+{
+    if(!_CanRead(4))
+        return 0;
+    uint32 value = _DecodeUInt32(&_data[_position]);
+    _position += 4;
+    return value;
+}
+
+float SaveGameReader::ReadFloat()
+{
+    uint32 bits = ReadUInt32();
+    float value = 0.0f;
+    memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+std::string SaveGameReader::ReadString()
+{
+    uint32 size = ReadUInt32();
+    if(!_CanRead(size))
+        return std::string();
+    std::string value = _data.substr(_position, size);
+    _position += size;
+    return value;
+}
+
+bool WriteSaveGameFile(const std::string &filename, const std::string &header, const std::string &body)
+{
+    SaveGameWriter file_header;
+    file_header.WriteUInt32(SAVE_GAME_MAGIC);
+    file_header.WriteUInt32(SAVE_GAME_VERSION);
+    file_header.WriteUInt32(header.size());
+
+    SaveGameWriter body_header;
+    body_header.WriteUInt32(body.size());
+    body_header.WriteUInt32(_HashSaveData(body));
+
+    std::string temp_filename = filename + ".tmp";
+    FILE *file = fopen(temp_filename.c_str(), "wb");
+    if(!file) {
+        PRINT_ERROR << "Couldn't create the saved game file: " << temp_filename << std::endl;
+        return false;
+    }
+
+    bool written = fwrite(file_header.GetData().data(), 1, file_header.GetData().size(), file) == file_header.GetData().size()
+                   && fwrite(header.data(), 1, header.size(), file) == header.size()
+                   && fwrite(body_header.GetData().data(), 1, body_header.GetData().size(), file) == body_header.GetData().size()
+                   && fwrite(body.data(), 1, body.size(), file) == body.size()
+                   && fflush(file) == 0;
+
+    // Makes sure the data is on the disk before the file replaces the previous one.
+#ifdef _WIN32
+    written = written && _commit(_fileno(file)) == 0;
+#else
+    written = written && fsync(fileno(file)) == 0;
+#endif
+
+    if(fclose(file) != 0)
+        written = false;
+
+    if(!written) {
+        PRINT_ERROR << "Couldn't write the saved game file: " << temp_filename << std::endl;
+        DeleteFile(temp_filename);
+        return false;
+    }
+
+    if(!MoveFile(temp_filename, filename)) {
+        PRINT_ERROR << "Couldn't replace the saved game file: " << filename << std::endl;
+        DeleteFile(temp_filename);
+        return false;
+    }
+    return true;
+}
+
+bool ReadSaveGameFile(const std::string &filename, std::string &header, std::string *body)
+{
+    std::ifstream file(filename.c_str(), std::ios::in | std::ios::binary);
+    if(!file)
+        return false;
+
+    char file_header[SAVE_GAME_FILE_HEADER_SIZE];
+    file.read(file_header, SAVE_GAME_FILE_HEADER_SIZE);
+    if(!file.good() || _DecodeUInt32(file_header) != SAVE_GAME_MAGIC)
+        return false;
+
+    if(_DecodeUInt32(file_header + 4) != SAVE_GAME_VERSION) {
+        PRINT_WARNING << "Unknown saved game version in: " << filename << std::endl;
+        return false;
+    }
+
+    // The sizes are checked against the file length, so that a corrupted file can't request a huge buffer.
+    uint32 header_size = _DecodeUInt32(file_header + 8);
+    if(header_size > _GetRemainingFileSize(file)) {
+        PRINT_ERROR << "The saved game file is truncated or corrupted: " << filename << std::endl;
+        return false;
+    }
+    header.assign(header_size, '\0');
+    if(header_size > 0)
+        file.read(&header[0], header_size);
+    if(!file.good())
+        return false;
+
+    if(!body)
+        return true;
+
+    char body_header[8];
+    file.read(body_header, 8);
+    if(!file.good())
+        return false;
+
+    uint32 body_size = _DecodeUInt32(body_header);
+    if(body_size > _GetRemainingFileSize(file)) {
+        PRINT_ERROR << "The saved game file is truncated or corrupted: " << filename << std::endl;
+        return false;
+    }
+    body->assign(body_size, '\0');
+    if(body_size > 0)
+        file.read(&(*body)[0], body_size);
+
+    if(!file.good() || _HashSaveData(*body) != _DecodeUInt32(body_header + 4)) {
+        PRINT_ERROR << "The saved game file is corrupted: " << filename << std::endl;
+        return false;
+    }
+    return true;
+}
+
+SaveGameFileWriter::SaveGameFileWriter() :
+    _write_thread(NULL),
+    _write_lock(NULL),
+    _writing(false),
+    _written_file_count(0)
+{}
+
+SaveGameFileWriter::~SaveGameFileWriter()
+{
+    Finish();
+
+    if(_write_lock)
+        vt_system::SystemManager->DestroySemaphore(_write_lock);
+}
+
+void SaveGameFileWriter::Write(const std::string &filename, const std::string &header, const std::string &body)
+{
+    if(!_write_lock)
+        _write_lock = vt_system::SystemManager->CreateSemaphore(1);
+
+    vt_system::SystemManager->LockThread(_write_lock);
+    // An older version of the file still pending is replaced, rather than written first.
+    PendingFile *file = NULL;
+    for(uint32 i = 0; i < _pending_files.size() && !file; ++i) {
+        if(_pending_files[i].filename == filename)
+            file = &_pending_files[i];
+    }
+    if(!file) {
+        _pending_files.push_back(PendingFile());
+        file = &_pending_files.back();
+        file->filename = filename;
+    }
+    file->header = header;
+    file->body = body;
+
+    bool writing = _writing;
+    _writing = true;
+    vt_system::SystemManager->UnlockThread(_write_lock);
+
+    // The running write thread handles the file before returning.
+    if(writing)
+        return;
+
+    // The previous write thread is done, and only needs to be joined.
+    if(_write_thread) {
+        vt_system::SystemManager->WaitForThread(_write_thread);
+        _write_thread = NULL;
+    }
+
+    _write_thread = vt_system::SystemManager->SpawnThread(&SaveGameFileWriter::_WriteFiles, this);
+    if(!_write_thread) {
+        PRINT_WARNING << "Couldn't start the saved game write thread, writing the file right away" << std::endl;
+        _WriteFiles();
+    }
+}
+
+void SaveGameFileWriter::Finish()
+{
+    if(!_write_thread)
+        return;
+
+    // The write thread only returns once the queue is empty.
+    vt_system::SystemManager->WaitForThread(_write_thread);
+    _write_thread = NULL;
+}
+
+bool SaveGameFileWriter::IsWriting()
+{
+    if(!_write_lock)
+        return false;
+
+    vt_system::SystemManager->LockThread(_write_lock);
+    bool writing = _writing;
+    vt_system::SystemManager->UnlockThread(_write_lock);
+    return writing;
+}
+
+uint32 SaveGameFileWriter::GetWrittenFileCount()
+{
+    if(!_write_lock)
+        return 0;
+
+    vt_system::SystemManager->LockThread(_write_lock);
+    uint32 count = _written_file_count;
+    vt_system::SystemManager->UnlockThread(_write_lock);
+    return count;
+}
+
+void SaveGameFileWriter::_WriteFiles()
+{
+    while(true) {
+        PendingFile file;
+
+        vt_system::SystemManager->LockThread(_write_lock);
+        if(_pending_files.empty()) {
+            _writing = false;
+            vt_system::SystemManager->UnlockThread(_write_lock);
+            return;
+        }
+        std::swap(file.filename, _pending_files.front().filename);
+        std::swap(file.header, _pending_files.front().header);
+        std::swap(file.body, _pending_files.front().body);
+        _pending_files.pop_front();
+        vt_system::SystemManager->UnlockThread(_write_lock);
+
+        WriteSaveGameFile(file.filename, file.header, file.body);
+
+        vt_system::SystemManager->LockThread(_write_lock);
+        ++_written_file_count;
+        vt_system::SystemManager->UnlockThread(_write_lock);
+    }
+}
+
+//! \brief Reads the preview data of a Lua saved game, written by the older versions.
+static bool _ReadLuaSaveGameHeader(const std::string &filename, SaveGameHeader &header)
+{
+    ReadScriptDescriptor file;
+
+    // Clear out the save data namespace to avoid loading false information
+    // when dealing with a save game that has an invalid namespace
+    vt_script::ScriptManager->DropGlobalTable("save_game1");
+
+    if(!file.OpenFile(filename))
+        return false;
+
+    if(!file.DoesTableExist("save_game1")) {
+        file.CloseFile();
+        return false;
+    }
+
+    // open the namespace that the save game is encapsulated in.
+    file.OpenTable("save_game1");
+
+    // DEPRECATED: Old way, will be removed in one release.
+    if (file.DoesStringExist("map_filename")) {
+        header.map_script_filename = file.ReadString("map_filename");
+        header.map_data_filename = file.ReadString("map_filename");
+    }
+    else {
+        header.map_script_filename = file.ReadString("map_script_filename");
+        header.map_data_filename = file.ReadString("map_data_filename");
+    }
+
+    // DEPRECATED: Remove in one release
+    // Hack to permit the split of last map data and scripts.
+    if (!header.map_script_filename.empty() && header.map_data_filename == header.map_script_filename) {
+        std::string map_common_name = header.map_data_filename.substr(0, header.map_data_filename.length() - 4);
+        header.map_data_filename = map_common_name + "_map.lua";
+        header.map_script_filename = map_common_name + "_script.lua";
+    }
+
+    header.location_x = file.ReadUInt("location_x");
+    header.location_y = file.ReadUInt("location_y");
+    header.play_hours = file.ReadUInt("play_hours");
+    header.play_minutes = file.ReadUInt("play_minutes");
+    header.play_seconds = file.ReadUInt("play_seconds");
+    header.drunes = file.ReadUInt("drunes");
+
+    if(!file.DoesTableExist("characters")) {
+        file.CloseTable(); // save_game1
+        file.CloseFile();
+        return false;
+    }
+
+    file.OpenTable("characters");
+    std::vector<uint32> char_ids;
+    file.ReadUIntVector("order", char_ids);
+
+    header.characters.clear();
+    for(uint32 i = 0; i < SAVE_GAME_HEADER_CHARACTERS && i < char_ids.size(); ++i) {
+        SaveGameCharacter character;
+        character.id = char_ids[i];
+
+        if(file.DoesTableExist(char_ids[i])) {
+            file.OpenTable(char_ids[i]);
+            character.experience_level = file.ReadUInt("experience_level");
+            character.max_hit_points = file.ReadUInt("max_hit_points");
+            character.hit_points = file.ReadUInt("hit_points");
+            character.max_skill_points = file.ReadUInt("max_skill_points");
+            character.skill_points = file.ReadUInt("skill_points");
+            file.CloseTable(); // character id
+        }
+        header.characters.push_back(character);
+    }
+    file.CloseTable(); // characters
+
+    // Report any errors detected from the previous read operations
+    if(file.IsErrorDetected()) {
+        PRINT_WARNING << "One or more errors occurred while reading the save game file - they are listed below:"
+            << std::endl << file.GetErrorMessages() << std::endl;
+        file.ClearErrors();
+    }
+
+    file.CloseTable(); // save_game1
+    file.CloseFile();
+    return true;
+}
+
+} // namespace private_global
+
+using namespace private_global;
+
+void SaveGameHeader::Write(SaveGameWriter &writer) const
+{
+    writer.WriteString(map_data_filename);
+    writer.WriteString(map_script_filename);
+    writer.WriteUInt32(location_x);
+    writer.WriteUInt32(location_y);
+    writer.WriteUInt32(play_hours);
+    writer.WriteUInt32(play_minutes);
+    writer.WriteUInt32(play_seconds);
+    writer.WriteUInt32(drunes);
+
+    writer.WriteUInt32(characters.size());
+    for(uint32 i = 0; i < characters.size(); ++i) {
+        writer.WriteUInt32(characters[i].id);
+        writer.WriteUInt32(characters[i].experience_level);
+        writer.WriteUInt32(characters[i].hit_points);
+        writer.WriteUInt32(characters[i].max_hit_points);
+        writer.WriteUInt32(characters[i].skill_points);
+        writer.WriteUInt32(characters[i].max_skill_points);
+    }
+}
+
+bool SaveGameHeader::Read(SaveGameReader &reader)
+{
+    map_data_filename = reader.ReadString();
+    map_script_filename = reader.ReadString();
+    location_x = reader.ReadUInt32();
+    location_y = reader.ReadUInt32();
+    play_hours = reader.ReadUInt32();
+    play_minutes = reader.ReadUInt32();
+    play_seconds = reader.ReadUInt32();
+    drunes = reader.ReadUInt32();
+
+    uint32 num_characters = reader.ReadUInt32();
+    characters.clear();
+    for(uint32 i = 0; i < num_characters && reader.IsValid(); ++i) {
+        SaveGameCharacter character;
+        character.id = reader.ReadUInt32();
+        character.experience_level = reader.ReadUInt32();
+        character.hit_points = reader.ReadUInt32();
+        character.max_hit_points = reader.ReadUInt32();
+        character.skill_points = reader.ReadUInt32();
+        character.max_skill_points = reader.ReadUInt32();
+        characters.push_back(character);
+    }
+
+    return reader.IsValid() && !map_data_filename.empty() && !map_script_filename.empty();
+}
+
+std::string GetSaveGameFilename(uint32 slot_id)
+{
+    if(slot_id == AUTOSAVE_SLOT_ID)
+        return GetUserDataPath() + "autosave.sav";
+
+    std::ostringstream f;
+    f << GetUserDataPath() + "saved_game_" << slot_id << ".sav";
+    return f.str();
+}
+
+std::string GetSaveGameThumbnailFilename(uint32 slot_id)
+{
+    if(slot_id == AUTOSAVE_SLOT_ID)
+        return GetUserDataPath() + "autosave_thumbnail.jpg";
+
+    std::ostringstream f;
+    f << GetUserDataPath() + "saved_game_" << slot_id << "_thumbnail.jpg";
+    return f.str();
+}
+
+std::string FindSaveGameFilename(uint32 slot_id)
+{
+    std::string filename = GetSaveGameFilename(slot_id);
+    if(DoesFileExist(filename))
+        return filename;
+
+    // The saved games of the older versions
+    std::ostringstream f;
+    f << GetUserDataPath() + "saved_game_" << slot_id << ".lua";
+    filename = f.str();
+    if(DoesFileExist(filename))
+        return filename;
+
+    return std::string();
+}
+
+bool IsBinarySaveGame(const std::string &filename)
+{
+    std::ifstream file(filename.c_str(), std::ios::in | std::ios::binary);
+    if(!file)
+        return false;
+
+    char magic[4];
+    file.read(magic, 4);
+    return file.good() && _DecodeUInt32(magic) == SAVE_GAME_MAGIC;
+}
+
+bool ReadSaveGameHeader(const std::string &filename, SaveGameHeader &header)
+{
+    if(!DoesFileExist(filename))
+        return false;
+
+    if(!IsBinarySaveGame(filename))
+        return _ReadLuaSaveGameHeader(filename, header);
+
+    std::string header_data;
+    if(!ReadSaveGameFile(filename, header_data, NULL))
+        return false;
+
+    SaveGameReader reader(header_data);
+    return header.Read(reader);
+}
+
+} // namespace vt_global
@@ -0,0 +1,300 @@
+////////////////////////////////////////////////////////////////////////////////
+//            Copyright (C) 2013 by Bertram (Valyria Tear)
+//                         All Rights Reserved
+//
+// This code is licensed under the GNU GPL version 2. It is free software
+// and you may modify it and/or redistribute it under the terms of this license.
+// See http://www.gnu.org/copyleft/gpl.html for details.
+////////////////////////////////////////////////////////////////////////////////
+
+/** ****************************************************************************
+*** \file    global_save.h
+*** \author  Yohann Ferreira, yohann ferreira orange fr
+*** \brief   Header file for the saved game files
+***
+*** Games are saved in a versioned binary format, starting with a small preview
+*** header which can be read without going through the whole file. The files
+*** are written to a temporary file first, and renamed once complete.
+***
+*** The files can be written in a background thread, from a snapshot of the
+*** game data taken beforehand, so that the game doesn't wait for the disk.
+***
+*** The Lua saved games written by the older versions can still be loaded.
+*** ***************************************************************************/
+
+#ifndef __GLOBAL_SAVE_HEADER__
+#define __GLOBAL_SAVE_HEADER__
+
+#include "utils.h"
+
+#include "engine/system.h"
+
+#include <deque>
+
+namespace vt_global
+{
+
+namespace private_global
+{
+
+/** ****************************************************************************
+*** \brief Serializes values into a binary buffer.
+***
+*** The values are written in little endian order, whatever the platform is.
+*** ***************************************************************************/
+class SaveGameWriter
+{
+public:
+    void WriteUInt8(uint8 value) {
+        _data.push_back(static_cast<char>(value));
+    }
+
+    void WriteUInt32(uint32 value);
+
+    void WriteInt32(int32 value) {
+        WriteUInt32(static_cast<uint32>(value));
+    }
+
+    void WriteFloat(float value);
+
+    void WriteBool(bool value) {
+        WriteUInt8(value ? 1 : 0);
+    }
+
+    //! \brief Writes the string size followed by its characters.
+    void WriteString(const std::string &value);
+
+    const std::string &GetData() const {
+        return _data;
+    }
+
+private:
+    //! \brief The values written so far.
+    std::string _data;
+}; // class SaveGameWriter
+
+/** ****************************************************************************
+*** \brief Reads back the values written by a SaveGameWriter.
+***
+*** Reading past the end of the data gives zeroes and empty strings, and marks
+*** the reader as invalid, so that the values can be checked only once at the end.
+*** ***************************************************************************/
+class SaveGameReader
+{
+public:
+    //! \param data The buffer to read, which must outlive the reader.
+    SaveGameReader(const std::string &data) :
+        _data(data),
+        _position(0),
+        _valid(true)
+    {}
+
+    uint8 ReadUInt8();
+
+    uint32 ReadUInt32();
+
+    int32 ReadInt32() {
+        return static_cast<int32>(ReadUInt32());
+    }
+
+    float ReadFloat();
+
+    bool ReadBool() {
+        return ReadUInt8() != 0;
+    }
+
+    std::string ReadString();
+
+    //! \brief Tells whether all the values read so far were in the data.
+    bool IsValid() const {
+        return _valid;
+    }
+
+    //! \brief Tells whether the whole data was read.
+    bool IsAtEnd() const {
+        return _position == _data.size();
+    }
+
+private:
+    //! \brief The data read.
+    const std::string &_data;
+
+    //! \brief The position of the next value to read.
+    size_t _position;
+
+    //! \brief Whether no value was read past the end of the data.
+    bool _valid;
+
+    //! \brief Checks that the given number of bytes can be read, and invalidates the reader otherwise.
+    bool _CanRead(size_t size);
+}; // class SaveGameReader
+
+/** \brief Writes a saved game file atomically
+*** \param filename The file to write.
+*** \param header The preview header data.
+*** \param body The saved game data.
+*** \return Whether the file could be written. The previous file is left untouched otherwise.
+***
+*** The data is written and flushed to the disk in a temporary file, which then replaces
+*** the saved game file, so that a crash never leaves a saved game half written.
+**/
+bool WriteSaveGameFile(const std::string &filename, const std::string &header, const std::string &body);
+
+/** \brief Reads a binary saved game file
+*** \param filename The file to read.
+*** \param header Set to the preview header data.
+*** \param body Set to the saved game data, unless NULL, in which case only the header is read.
+*** \return false when the file is missing, isn't a binary saved game, is of an unknown version or is corrupted.
+**/
+bool ReadSaveGameFile(const std::string &filename, std::string &header, std::string *body);
+
+/** ****************************************************************************
+*** \brief Writes the saved game files in a background thread.
+***
+*** The saved game data is serialized by the caller beforehand, so the write
+*** thread only handles the file writing and flushing, and never reads the game
+*** data. When a file is queued while an older version of it is still pending,
+*** only the newest data is written.
+***
+*** \note The functions of this class must be called from the main thread.
+*** ***************************************************************************/
+class SaveGameFileWriter
+{
+public:
+    SaveGameFileWriter();
+
+    //! \brief Waits for the pending files to be written.
+    ~SaveGameFileWriter();
+
+    /** \brief Queues a saved game file to be written in the background.
+    *** \param filename The file to write.
+    *** \param header The preview header data.
+    *** \param body The saved game data.
+    *** The file is written right away when the write thread can't be started.
+    **/
+    void Write(const std::string &filename, const std::string &header, const std::string &body);
+
+    //! \brief Waits until all the queued files are written.
+    void Finish();
+
+    //! \brief Tells whether files are still being written.
+    bool IsWriting();
+
+    //! \brief Returns the number of files written so far, to detect the files changed in the background.
+    uint32 GetWrittenFileCount();
+
+private:
+    //! \brief A saved game file waiting to be written.
+    struct PendingFile {
+        std::string filename;
+        std::string header;
+        std::string body;
+    };
+
+    //! \brief The files waiting to be written, shared with the write thread.
+    std::deque<PendingFile> _pending_files;
+
+    //! \brief The write thread, or NULL when none was started since the last Finish() call.
+    Thread *_write_thread;
+
+    //! \brief Protects the members shared with the write thread.
+    Semaphore *_write_lock;
+
+    //! \brief Whether the write thread is running, cleared by it once the queue is empty.
+    bool _writing;
+
+    //! \brief The number of files written by the write thread since the start.
+    uint32 _written_file_count;
+
+    //! \brief Writes the queued files until none is left. Runs in the write thread.
+    void _WriteFiles();
+}; // class SaveGameFileWriter
+
+} // namespace private_global
+
+//! \brief The data of a party member shown in the saved games preview.
+struct SaveGameCharacter {
+    SaveGameCharacter() :
+        id(0),
+        experience_level(0),
+        hit_points(0),
+        max_hit_points(0),
+        skill_points(0),
+        max_skill_points(0)
+    {}
+
+    uint32 id;
+    uint32 experience_level;
+    uint32 hit_points;
+    uint32 max_hit_points;
+    uint32 skill_points;
+    uint32 max_skill_points;
+};
+
+/** ****************************************************************************
+*** \brief The preview header of a saved game.
+***
+*** It holds everything the save mode shows about a saved game, so that the
+*** rest of the file doesn't have to be read to preview it.
+*** ***************************************************************************/
+struct SaveGameHeader {
+    SaveGameHeader() :
+        location_x(0),
+        location_y(0),
+        play_hours(0),
+        play_minutes(0),
+        play_seconds(0),
+        drunes(0)
+    {}
+
+    std::string map_data_filename;
+    std::string map_script_filename;
+
+    //! \brief The save point location, in map tiles.
+    uint32 location_x, location_y;
+
+    uint32 play_hours, play_minutes, play_seconds;
+
+    uint32 drunes;
+
+    //! \brief The first party members, in the party order.
+    std::vector<SaveGameCharacter> characters;
+
+    void Write(private_global::SaveGameWriter &writer) const;
+
+    //! \return false when the header data is invalid.
+    bool Read(private_global::SaveGameReader &reader);
+};
+
+//! \brief The maximum number of party members stored in the saved game headers.
+const uint32 SAVE_GAME_HEADER_CHARACTERS = 4;
+
+//! \brief The save slot of the automatic saved game, written on map transitions.
+const uint32 AUTOSAVE_SLOT_ID = 6;
+
+//! \brief Returns the binary saved game filename of a save slot.
+std::string GetSaveGameFilename(uint32 slot_id);
+
+//! \brief Returns the filename of the screen thumbnail optionally stored along with a save slot.
+std::string GetSaveGameThumbnailFilename(uint32 slot_id);
+
+/** \brief Returns the saved game file of a save slot to load
+*** \return The binary saved game file of the slot, or its older Lua saved game file if only
+*** this one exists, or an empty string when the slot is empty.
+**/
+std::string FindSaveGameFilename(uint32 slot_id);
+
+//! \brief Tells whether the given file is a binary saved game, rather than a Lua one.
+bool IsBinarySaveGame(const std::string &filename);
+
+/** \brief Reads the preview header of a saved game file
+*** \param filename The saved game file, either binary or Lua.
+*** \param header Filled with the preview data.
+*** \return false when the file is missing or invalid.
+*** \note Reading a Lua saved game runs the whole file, while only the beginning of a binary one is read.
+**/
+bool ReadSaveGameHeader(const std::string &filename, SaveGameHeader &header);
+
+} // namespace vt_global
+
+#endif // __GLOBAL_SAVE_HEADER__
@@ -22,7 +22,7 @@
 #ifndef __GLOBAL_SKILLS_HEADER__
 #define __GLOBAL_SKILLS_HEADER__
 
-#include "global_utils.h"
+#include "global_definitions.h"
 
 #include "engine/script/script.h"
 #include "modes/battle/battle_actors.h"
@@ -50,7 +50,8 @@ namespace vt_global
 *** Because skills are scripted and can achieve almost any possible effect, this class
 *** only retains the common properties that all skills share. For example, the skill's
 *** name, type of target, and the amount of time it takes an actor to "warmup" to use
-*** the skill or "cooldown" after the skill execution is finished.
+*** the skill or "cooldown" after the skill execution is finished. These properties
+*** are read once into the skill definition, which all the instances point to.
 *** ***************************************************************************/
 class GlobalSkill
 {
@@ -61,10 +62,6 @@ public:
     ~GlobalSkill()
     {}
 
-    GlobalSkill(const GlobalSkill &copy);
-
-    GlobalSkill &operator=(const GlobalSkill &copy);
-
     //! \brief Returns true if the skill is properly initialized and ready to be used
     bool IsValid() const {
         return (_id != 0);
@@ -72,12 +69,12 @@ public:
 
     //! \brief Returns true if the skill can be executed in battles
     bool IsExecutableInBattle() const {
-        return _battle_execute_function.is_valid();
+        return _definition->battle_execute_function.is_valid() || _definition->battle_effect.valid;
     }
 
     //! \brief Returns true if the skill can be executed in menus
     bool IsExecutableInField() const {
-        return _field_execute_function.is_valid();
+        return _definition->field_execute_function.is_valid();
     }
 
     /** \name Class member access functions
@@ -85,15 +82,15 @@ public:
     **/
     //@{
     const vt_utils::ustring &GetName() const {
-        return _name;
+        return _definition->name;
     }
 
     const vt_utils::ustring &GetDescription() const {
-        return _description;
+        return _definition->description;
     }
 
     const std::string &GetIconFilename() const {
-        return _icon_filename;
+        return _definition->icon_filename;
     }
 
     uint32 GetID() const {
@@ -101,48 +98,56 @@ public:
     }
 
     GLOBAL_SKILL GetType() const {
-        return _type;
+        return _definition->type;
     }
 
     uint32 GetSPRequired() const {
-        return _sp_required;
+        return _definition->sp_required;
     }
 
     uint32 GetWarmupTime() const {
-        return _warmup_time;
+        return _definition->warmup_time;
     }
 
     uint32 GetCooldownTime() const {
-        return _cooldown_time;
+        return _definition->cooldown_time;
     }
 
     const std::string &GetWarmupActionName() const {
-        return _warmup_action_name;
+        return _definition->warmup_action_name;
     }
 
     const std::string &GetActionName() const {
-        return _action_name;
+        return _definition->action_name;
     }
 
     GLOBAL_TARGET GetTargetType() const {
-        return _target_type;
+        return _definition->target_type;
     }
 
     /** \brief Returns a pointer to the ScriptObject of the battle execution function
     *** \note This function will return NULL if the skill is not executable in battle
     **/
     const ScriptObject &GetBattleExecuteFunction() const {
-        return _battle_execute_function;
+        return _definition->battle_execute_function;
+    }
+
+    //! \brief Returns the standard battle effect of the skill, only valid when it has no battle execute function
+    const private_global::SkillBattleEffect &GetBattleEffect() const {
+        return _definition->battle_effect;
     }
 
-    //! Execute the corresponding skill Battle function
+    /** \brief Executes the skill in battle
+    *** The battle execute function is called when there is one, and the standard battle effect
+    *** is applied natively otherwise.
+    **/
     bool ExecuteBattleFunction(vt_battle::private_battle::BattleActor *user, vt_battle::private_battle::BattleTarget target);
 
     /** \brief Returns a pointer to the ScriptObject of the menu execution function
     *** \note This function will return NULL if the skill is not executable in menus
     **/
     const ScriptObject &GetFieldExecuteFunction() const {
-        return _field_execute_function;
+        return _definition->field_execute_function;
     }
 
     /** \brief Tells the animation script filename linked to the skill for the given character,
@@ -155,64 +160,10 @@ private:
     //! \brief The unique identifier number of the skill.
     uint32 _id;
 
-    //! \brief The name of the skill as it will be displayed on the screen.
-    vt_utils::ustring _name;
-
-    /** \brief A short description of what the skill does when executed
-    *** \note Not all defined skills have a description. For example, skills used only by enemies are
-    *** typically missing a description
-    **/
-    vt_utils::ustring _description;
-
-    //! The potential skill icon filename
-    std::string _icon_filename;
-
-    //! \brief The type identifier for the skill
-    GLOBAL_SKILL _type;
-
-    /** \brief The amount of skill points (SP) that the skill requires to be used
-    *** Zero is a valid value for this member and means that no skill points are required to use the
-    *** skill. Skills with this property are known as "innate skills".
-    **/
-    uint32 _sp_required;
-
-    /** \brief The amount of time (in milliseconds) that must expire before a skill can be used after it is selected
-    *** When a character or enemy has selected to use the skill in a battle, this value instructs how
-    *** much time must pass before the skill may be executed. It is acceptable for this member to be zero.
+    /** \brief The data shared by all the instances of the skill
+    *** It is never NULL, and is owned by the global manager.
     **/
-    uint32 _warmup_time;
-
-    /** \brief The amount of time (in milliseconds) that must expire after a skill hase been used
-    *** After a character or enemy uses a skill, this value instructs how much time must pass before
-    *** the actor who executed the skill can recover and begin recharging their battle stamina bar.
-    *** It is acceptable for this member to be zero.
-    **/
-    uint32 _cooldown_time;
-
-    /** \brief The animation name played at warmup time, if any.
-    *** If none is given, the idle animation will be played.
-    **/
-    std::string _warmup_action_name;
-
-    /** \brief The animation name played before dealing the battle_execute_function.
-    *** When a character is ready to attack, it will first play an attack animation for instance
-    *** before delaing damage.
-    **/
-    std::string _action_name;
-
-    /** \brief The type of target for the skill
-    *** Target types include attack points, actors, and parties. This enum type is defined in global_actors.h
-    **/
-    GLOBAL_TARGET _target_type;
-
-    //! \brief A reference to the skill's execution function for battles
-    ScriptObject _battle_execute_function;
-
-    //! \brief A reference to the skill's execution function for menus
-    ScriptObject _field_execute_function;
-
-    //! \brief map containing the animation scripts names linked to each characters id for the given skill.
-    std::map <uint32, std::string> _animation_scripts;
+    const private_global::SkillDefinition *_definition;
 }; // class GlobalSkill
 
 } // namespace vt_global
@@ -236,6 +236,16 @@ enum GLOBAL_SKILL {
     GLOBAL_SKILL_TOTAL    =  3
 };
 
+/** \name Damage Types
+*** \brief Enum values used to identify how the damage of a skill battle effect is computed.
+**/
+enum GLOBAL_DAMAGE {
+    GLOBAL_DAMAGE_INVALID  = -1,
+    GLOBAL_DAMAGE_PHYSICAL =  0,
+    GLOBAL_DAMAGE_MAGICAL  =  1,
+    GLOBAL_DAMAGE_TOTAL    =  2
+};
+
 //! \brief The Battle enemies harm levels
 enum GLOBAL_ENEMY_HURT {
     GLOBAL_ENEMY_HURT_NONE     = 0,
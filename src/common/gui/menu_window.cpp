@@ -33,7 +33,16 @@ MenuWindow::MenuWindow() :
     _window_state(VIDEO_MENU_STATE_HIDDEN),
     _display_timer(0),
     _display_mode(VIDEO_MENU_INSTANT),
-    _is_scissored(false)
+    _is_scissored(false),
+    _scissor_rect_valid(false),
+    _scissor_x_position(0.0f),
+    _scissor_y_position(0.0f),
+    _scissor_width(0.0f),
+    _scissor_height(0.0f),
+    _scissor_xalign(0),
+    _scissor_yalign(0),
+    _scissor_screen_width(0),
+    _scissor_screen_height(0)
 {
     _id = GUIManager->_GetNextMenuWindowID();
     _initialized = IsInitialized(_initialization_errors);
@@ -106,33 +115,8 @@ void MenuWindow::Update(uint32 frame_time)
             _window_state = VIDEO_MENU_STATE_HIDDEN;
     }
 
-    // TODO: This does not need to be done every update call (it always retuns the same thing so long
-    // as the window does not move. This is a performance problem and should be fixed so that this is
-    // only done with the window size or alignment changes.
     if(_window_state == VIDEO_MENU_STATE_HIDDEN || _window_state == VIDEO_MENU_STATE_SHOWN) {
-//		if (_is_scissored == true) {
-        float x_buffer = (_width - _inner_width) / 2;
-        float y_buffer = (_height - _inner_height) / 2;
-
-        float left, right, bottom, top;
-        left = 0.0f;
-        right = _width;
-        bottom = 0.0f;
-        top = _height;
-
-        VideoManager->PushState();
-        VideoManager->SetDrawFlags(_xalign, _yalign, 0);
-        CalculateAlignedRect(left, right, bottom, top);
-        VideoManager->PopState();
-
-        _scissor_rect = VideoManager->CalculateScreenRect(left, right, bottom, top);
-
-        _scissor_rect.left   += static_cast<int32>(x_buffer);
-        _scissor_rect.width  -= static_cast<int32>(x_buffer * 2);
-        _scissor_rect.top    += static_cast<int32>(y_buffer);
-        _scissor_rect.height -= static_cast<int32>(y_buffer * 2);
-// 		}
-
+        _UpdateFullScissorRect();
         _is_scissored = false;
         return;
     }
@@ -172,6 +156,8 @@ void MenuWindow::Update(uint32 frame_time)
             top    = center * (1.0f - draw_percent) + top * draw_percent;
 
             _scissor_rect = VideoManager->CalculateScreenRect(left, right, bottom, top);
+            // The full-size rectangle must be computed again once the animation is over
+            _scissor_rect_valid = false;
         }
     }
 } // void MenuWindow::Update(uint32 frame_time)
@@ -342,6 +328,52 @@ void MenuWindow::SetDisplayMode(VIDEO_MENU_DISPLAY_MODE mode)
 
 
 
+void MenuWindow::_UpdateFullScissorRect()
+{
+    int32 screen_width = VideoManager->GetScreenWidth();
+    int32 screen_height = VideoManager->GetScreenHeight();
+
+    // The rectangle only depends on the window geometry and on the screen size
+    if(_scissor_rect_valid && IsFloatEqual(_scissor_x_position, _x_position) && IsFloatEqual(_scissor_y_position, _y_position)
+            && IsFloatEqual(_scissor_width, _width) && IsFloatEqual(_scissor_height, _height)
+            && _scissor_xalign == _xalign && _scissor_yalign == _yalign
+            && _scissor_screen_width == screen_width && _scissor_screen_height == screen_height)
+        return;
+
+    float x_buffer = (_width - _inner_width) / 2;
+    float y_buffer = (_height - _inner_height) / 2;
+
+    float left, right, bottom, top;
+    left = 0.0f;
+    right = _width;
+    bottom = 0.0f;
+    top = _height;
+
+    VideoManager->PushState();
+    VideoManager->SetDrawFlags(_xalign, _yalign, 0);
+    CalculateAlignedRect(left, right, bottom, top);
+    VideoManager->PopState();
+
+    _scissor_rect = VideoManager->CalculateScreenRect(left, right, bottom, top);
+
+    _scissor_rect.left   += static_cast<int32>(x_buffer);
+    _scissor_rect.width  -= static_cast<int32>(x_buffer * 2);
+    _scissor_rect.top    += static_cast<int32>(y_buffer);
+    _scissor_rect.height -= static_cast<int32>(y_buffer * 2);
+
+    _scissor_rect_valid = true;
+    _scissor_x_position = _x_position;
+    _scissor_y_position = _y_position;
+    _scissor_width = _width;
+    _scissor_height = _height;
+    _scissor_xalign = _xalign;
+    _scissor_yalign = _yalign;
+    _scissor_screen_width = screen_width;
+    _scissor_screen_height = screen_height;
+} // void MenuWindow::_UpdateFullScissorRect()
+
+
+
 bool MenuWindow::_RecreateImage()
 {
     if(_skin == NULL) {
@@ -350,6 +382,8 @@ bool MenuWindow::_RecreateImage()
     }
 
     _menu_image.Clear();
+    // The border sizes may differ, which changes the inner window rectangle
+    _scissor_rect_valid = false;
 
     // Get information about the border sizes
     float left_border_size   = _skin->borders[1][0].GetWidth();
@@ -320,6 +320,22 @@ private:
     //! \brief The rectangle used for scissoring, set during each call to Update().
     vt_video::ScreenRect _scissor_rect;
 
+    //! \brief Tells whether _scissor_rect holds the full-size window rectangle computed for the geometry below.
+    bool _scissor_rect_valid;
+
+    //! \brief The window geometry and screen size the full-size scissor rectangle was computed for.
+    //@{
+    float _scissor_x_position, _scissor_y_position;
+    float _scissor_width, _scissor_height;
+    int32 _scissor_xalign, _scissor_yalign;
+    int32 _scissor_screen_width, _scissor_screen_height;
+    //@}
+
+    /** \brief Computes the scissor rectangle of the fully shown window.
+    *** This is only done when the window position, size, alignment or the screen size changed.
+    **/
+    void _UpdateFullScissorRect();
+
     /** \brief Used to create the menu window's image when the visible properties of the window change.
     *** \return True if the menu image was successfully created, false otherwise.
     ***
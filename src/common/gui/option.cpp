@@ -34,7 +34,8 @@ namespace vt_gui
 
 Option::Option() :
     disabled(false),
-    image(NULL)
+    image(NULL),
+    text_images_disabled(false)
 {}
 
 
@@ -49,7 +50,10 @@ Option::~Option()
 Option::Option(const Option &copy) :
     disabled(copy.disabled),
     elements(copy.elements),
-    text(copy.text)
+    text(copy.text),
+    text_images(copy.text_images),
+    text_widths(copy.text_widths),
+    text_images_disabled(copy.text_images_disabled)
 {
     if(copy.image == NULL) {
         image = NULL;
@@ -70,6 +74,9 @@ Option &Option::operator=(const Option &copy)
     disabled = copy.disabled;
     elements = copy.elements;
     text = copy.text;
+    text_images = copy.text_images;
+    text_widths = copy.text_widths;
+    text_images_disabled = copy.text_images_disabled;
     if(copy.image == NULL) {
         image = NULL;
     } else {
@@ -86,6 +93,9 @@ void Option::Clear()
     disabled = false;
     elements.clear();
     text.clear();
+    text_images.clear();
+    text_widths.clear();
+    text_images_disabled = false;
     if(image != NULL) {
         delete image;
         image = NULL;
@@ -778,6 +788,12 @@ void OptionBox::SetTextStyle(const TextStyle &style)
 
     _text_style = style;
     _initialized = IsInitialized(_initialization_errors);
+
+    // The option texts must be rendered again with the new style
+    for(uint32 i = 0; i < _options.size(); ++i) {
+        _options[i].text_images.clear();
+        _options[i].text_widths.clear();
+    }
 }
 
 
@@ -1136,13 +1152,15 @@ void OptionBox::_DetermineScrollArrows()
 
 
 
-void OptionBox::_DrawOption(const Option &op, const OptionCellBounds &bounds, float &left_edge)
+void OptionBox::_DrawOption(Option &op, const OptionCellBounds &bounds, float &left_edge)
 {
     float x, y;
     int32 xalign = _option_xalign;
     int32 yalign = _option_yalign;
     CoordSys &cs = VideoManager->_current_context.coordinate_system;
 
+    _CreateOptionTextImages(op);
+
     _SetupAlignment(xalign, yalign, bounds, x, y);
 
     // Iterate through all option elements in the current option
@@ -1188,8 +1206,7 @@ void OptionBox::_DrawOption(const Option &op, const OptionCellBounds &bounds, fl
             int32 text_index = op.elements[element].value;
 
             if(text_index >= 0 && text_index < static_cast<int32>(op.text.size())) {
-                const ustring &text = op.text[text_index];
-                float width = static_cast<float>(VideoManager->Text()->CalculateTextWidth(_text_style.font, text));
+                float width = op.text_widths[text_index];
                 float edge = x - bounds.x_left; // edge value for VIDEO_X_LEFT
 
                 if(xalign == VIDEO_X_CENTER)
@@ -1199,14 +1216,7 @@ void OptionBox::_DrawOption(const Option &op, const OptionCellBounds &bounds, fl
 
                 if(edge < left_edge)
                     left_edge = edge;
-                if(op.disabled) {
-                    Color saved = _text_style.color;
-                    _text_style.color = Color::gray;
-                    TextManager->Draw(text, _text_style);
-                    _text_style.color = saved;
-                } else {
-                    TextManager->Draw(text, _text_style);
-                }
+                op.text_images[text_index].Draw();
             }
 
             break;
@@ -1219,7 +1229,30 @@ void OptionBox::_DrawOption(const Option &op, const OptionCellBounds &bounds, fl
         }
         } // switch (op.elements[element].type)
     } // for (int32 element = 0; element < static_cast<int32>(op.elements.size()); element++)
-} // void OptionBox::_DrawOption(const Option& op, const OptionCellBounds &bounds, float scroll_offset, float& left_edge)
+} // void OptionBox::_DrawOption(Option& op, const OptionCellBounds &bounds, float& left_edge)
+
+
+
+void OptionBox::_CreateOptionTextImages(Option &op)
+{
+    if(op.text_images.size() == op.text.size() && op.text_images_disabled == op.disabled)
+        return;
+
+    // Disabled options are rendered using a gray text color
+    TextStyle style = _text_style;
+    if(op.disabled)
+        style.color = Color::gray;
+
+    op.text_images.clear();
+    op.text_widths.clear();
+    op.text_images.reserve(op.text.size());
+    op.text_widths.reserve(op.text.size());
+    for(uint32 i = 0; i < op.text.size(); ++i) {
+        op.text_images.push_back(TextImage(op.text[i], style));
+        op.text_widths.push_back(static_cast<float>(TextManager->CalculateTextWidth(_text_style.font, op.text[i])));
+    }
+    op.text_images_disabled = op.disabled;
+}
 
 
 
@@ -221,6 +221,18 @@ public:
 
     //! \brief Contains all images used for this option
     vt_video::StillImage *image;
+
+    /** \brief The rendered image and width of each piece of text, in the same order as the text container.
+    *** Those are created by the option box on the first draw and are emptied whenever the option is
+    *** reconstructed, so that the text is drawn as a single quad rather than glyph by glyph each frame.
+    **/
+    //@{
+    std::vector<vt_video::TextImage> text_images;
+    std::vector<float> text_widths;
+    //@}
+
+    //! \brief Whether the text images were rendered with the disabled (gray) text color.
+    bool text_images_disabled;
 }; // class Option
 
 } // namespace private_gui
@@ -659,7 +671,13 @@ private:
     *** \param bounds The boundary coordinates for the information cell
     *** \param left_edge Returns a coordinate that represents the left edge of the cell content (as opposed to strictly the cell boundary)
     **/
-    void _DrawOption(const private_gui::Option &op, const private_gui::OptionCellBounds &bounds, float &left_edge);
+    void _DrawOption(private_gui::Option &op, const private_gui::OptionCellBounds &bounds, float &left_edge);
+
+    /** \brief Renders the option text pieces into images and caches their widths
+    *** \param op The option to render the text of
+    *** Nothing is done when the cached images are still valid for the option text, disabled state and text style.
+    **/
+    void _CreateOptionTextImages(private_gui::Option &op);
 
     /** \brief Draws the cursor
     *** \param op The option contents to draw within the cell
@@ -76,6 +76,8 @@ void TextBox::ClearText()
     _text.clear();
     _num_chars = 0;
     _text_save.clear();
+    _line_widths.clear();
+    _line_images.clear();
 }
 
 
@@ -267,6 +269,8 @@ void TextBox::_ReformatText()
     const size_t temp_length = _text_save.length();
     _text.clear();
     _num_chars = 0;
+    _line_widths.clear();
+    _line_images.clear();
 
 
     // If font not set, return (leave _text vector empty)
@@ -292,6 +296,11 @@ void TextBox::_ReformatText()
         }
     }
 
+    // Cache the line widths, needed each frame to align the text
+    _line_widths.resize(_text.size());
+    for(uint32 i = 0; i < _text.size(); ++i)
+        _line_widths[i] = static_cast<float>(TextManager->CalculateTextWidth(_text_style.font, _text[i]));
+
     // Update the scissor cache
     // Stores the positions of the four sides of the rectangle
     float left   = 0.0f;
@@ -349,6 +358,19 @@ void TextBox::_ReformatText()
 
 
 
+void TextBox::_CreateLineImages()
+{
+    if(_line_images.size() == _text.size())
+        return;
+
+    _line_images.clear();
+    _line_images.reserve(_text.size());
+    for(uint32 i = 0; i < _text.size(); ++i)
+        _line_images.push_back(TextImage(_text[i], _text_style));
+}
+
+
+
 bool TextBox::IsInitialized(std::string &errors)
 {
     errors.clear();
@@ -468,10 +490,13 @@ void TextBox::_DrawTextLines(float text_x, float text_y, ScreenRect scissor_rect
     else
         percent_complete = static_cast<float>(_current_time) / static_cast<float>(_end_time);
 
+    // Fully displayed lines are drawn from their cached images
+    _CreateLineImages();
+
     // Iterate through the loop for every line of text and draw it
     for(int32 line = 0; line < static_cast<int32>(_text.size()); ++line) {
         // (1): Calculate the x draw offset for this line and move to that position
-        float line_width = static_cast<float>(TextManager->CalculateTextWidth(_text_style.font, _text[line]));
+        float line_width = _line_widths[line];
         int32 x_align = VideoManager->_ConvertXAlign(_text_xalign);
         float x_offset = text_x + ((x_align + 1) * line_width) * 0.5f * VideoManager->_current_context.coordinate_system.GetHorizontalDirection();
 
@@ -481,7 +506,7 @@ void TextBox::_DrawTextLines(float text_x, float text_y, ScreenRect scissor_rect
 
         // (2): Draw the text depending on the display mode and whether or not the gradual display is finished
         if(_finished || _mode == VIDEO_TEXT_INSTANT) {
-            TextManager->Draw(_text[line], _text_style);
+            _line_images[line].Draw();
         }
         else if(_mode == VIDEO_TEXT_CHAR) {
             // Determine which character is currently being rendered
@@ -489,7 +514,7 @@ void TextBox::_DrawTextLines(float text_x, float text_y, ScreenRect scissor_rect
 
             // If the current character to draw is after this line, render the entire line
             if(num_chars_drawn + line_size < cur_char) {
-                TextManager->Draw(_text[line], _text_style);
+                _line_images[line].Draw();
             }
             // The current character to draw is on this line: figure out which characters on this line should be drawn
             else {
@@ -509,7 +534,7 @@ void TextBox::_DrawTextLines(float text_x, float text_y, ScreenRect scissor_rect
 
             // If the current character to draw is after this line, draw the whole line
             if(num_chars_drawn + line_size <= cur_char) {
-                TextManager->Draw(_text[line], _text_style);
+                _line_images[line].Draw();
             }
             // The current character is on this line: draw any previous characters on this line as well as the current character
             else {
@@ -544,15 +569,11 @@ void TextBox::_DrawTextLines(float text_x, float text_y, ScreenRect scissor_rect
 
             // If this line comes before the line being rendered, simply draw the line and be done with it
             if(line < lines) {
-                TextManager->Draw(_text[line], _text_style);
+                _line_images[line].Draw();
             }
             // Otherwise if this is the line being rendered, determine the amount of alpha for the line being faded in and draw it
             else if(line == lines) {
-                Color old_color = _text_style.color;
-                _text_style.color[3] *= cur_percent;
-
-                TextManager->Draw(_text[line], _text_style);
-                _text_style.color = old_color;
+                _line_images[line].Draw(Color(1.0f, 1.0f, 1.0f, cur_percent));
             }
         } // else if (_mode == VIDEO_TEXT_FADELINE)
 
@@ -565,7 +586,7 @@ void TextBox::_DrawTextLines(float text_x, float text_y, ScreenRect scissor_rect
 
             // If the current character comes after this line, simply render the entire line
             if(num_chars_drawn + line_size <= cur_char) {
-                TextManager->Draw(_text[line], _text_style);
+                _line_images[line].Draw();
             }
             // If the line contains the current character, draw all previous characters as well as the current one
             else if(num_completed_chars >= 0) {
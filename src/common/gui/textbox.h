@@ -233,8 +233,6 @@ private:
     //! \brief The number of milliseconds remaining until the gradual text display will be complete.
     uint32 _end_time;
 
-    //! \brief The rendered image of the text stored in the text box
-    vt_video::TextImage _text_image;
 
     //! \brief The text style for this textbox
     vt_video::TextStyle _text_style;
@@ -260,6 +258,14 @@ private:
     // Holds the actual x and y position where the text should be drawn
     float _text_xpos;
     float _text_ypos;
+    // Holds the width of each line of text, in pixels
+    std::vector<float> _line_widths;
+
+    /** \brief The rendered image of each line of text, drawn as a single textured quad.
+    *** Those are created on the first draw call following a call to _ReformatText(),
+    *** so that per-glyph rendering is only needed for lines being gradually displayed.
+    **/
+    std::vector<vt_video::TextImage> _line_images;
 
     /** \brief Returns true if the given unicode character can be interrupted for a word wrap.
     *** \param character The character you wish to check.
@@ -287,6 +293,9 @@ private:
     **/
     void _ReformatText();
 
+    //! \brief Renders each line of text into its own image, when not already done.
+    void _CreateLineImages();
+
     /** \brief Draws an outline of the element boundaries
     *** \note This function also draws an outline for each line of text in addition to the textbox
     *** as a whole.
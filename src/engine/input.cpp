@@ -23,6 +23,9 @@
 
 #include "mode_manager.h"
 #include "system.h"
+#include "profiler.h"
+
+#include <cstring>
 
 using namespace vt_utils;
 using namespace vt_video;
@@ -80,6 +83,11 @@ InputEngine::InputEngine()
     _joystick.y_axis      = 1;
     _joystick.threshold   = 8192;
     _joystick.joy_index   = 0; // the first joystick
+
+    _frame_number         = 0;
+    _replaying            = false;
+    _replay_index         = 0;
+    _replay_end_frame     = 0;
 }
 
 
@@ -89,6 +97,12 @@ InputEngine::~InputEngine()
     IF_PRINT_WARNING(INPUT_DEBUG) << "INPUT: InputEngine destructor invoked"
                                   << std::endl;
 
+    // Tells the replay when to stop
+    if(_record_file.is_open()) {
+        _record_file << _frame_number << " end" << std::endl;
+        _record_file.close();
+    }
+
     DeinitializeJoysticks();
 }
 
@@ -206,12 +220,8 @@ bool InputEngine::AnyKeyRelease()
 }
 
 
-// Handles all of the event processing for the game.
-void InputEngine::EventHandler()
+void InputEngine::ResetPressAndReleaseFlags()
 {
-    SDL_Event event; // Holds the game event
-
-    // Reset all of the press and release flags so that they don't get detected twice.
     _any_key_press   = false;
     _any_key_release = false;
 
@@ -233,6 +243,13 @@ void InputEngine::EventHandler()
     _pause_press = false;
     _quit_press = false;
     _help_press = false;
+}
+
+
+// Handles all of the event processing for the game.
+void InputEngine::EventHandler()
+{
+    SDL_Event event; // Holds the game event
 
     // Loops until there are no remaining events to process
     while(SDL_PollEvent(&event)) {
@@ -274,14 +291,153 @@ void InputEngine::EventHandler()
 // 			}
             break;
         } else if(event.type == SDL_KEYUP || event.type == SDL_KEYDOWN) {
+            // The real input is ignored while replaying
+            if(_replaying)
+                continue;
+            _RecordEvent(event);
             _KeyEventHandler(event.key);
         } else {
+            if(_replaying)
+                continue;
+            _RecordEvent(event);
             _JoystickEventHandler(event);
         }
     } // while (SDL_PollEvent(&event)
+
+    if(_replaying)
+        _ReplayEvents();
+
+    ++_frame_number;
 } // void InputEngine::EventHandler()
 
 
+bool InputEngine::StartRecording(const std::string &filename)
+{
+    _record_file.open(filename.c_str());
+    if(!_record_file.is_open()) {
+        PRINT_ERROR << "Couldn't open the input record file: " << filename << std::endl;
+        return false;
+    }
+
+    _record_file << "# Valyria Tear input record: <frame> key <down> <sym> <mod> | "
+                 << "<frame> joyaxis <axis> <value> | <frame> joybutton <down> <button> | <frame> end" << std::endl;
+    return true;
+}
+
+
+bool InputEngine::StartReplay(const std::string &filename)
+{
+    std::ifstream replay_file(filename.c_str());
+    if(!replay_file.is_open()) {
+        PRINT_ERROR << "Couldn't open the input replay file: " << filename << std::endl;
+        return false;
+    }
+
+    _replay_events.clear();
+    _replay_index = 0;
+    _replay_end_frame = 0;
+
+    std::string line;
+    while(std::getline(replay_file, line)) {
+        if(line.empty() || line[0] == '#')
+            continue;
+
+        std::istringstream line_stream(line);
+        ReplayEvent replay_event;
+        std::string type;
+        int32 a = 0;
+        int32 b = 0;
+        int32 c = 0;
+        line_stream >> replay_event.frame >> type;
+        memset(&replay_event.event, 0, sizeof(SDL_Event));
+
+        if(type == "end") {
+            _replay_end_frame = replay_event.frame;
+            break;
+        } else if(type == "key" && (line_stream >> a >> b >> c)) {
+            replay_event.event.type = a ? SDL_KEYDOWN : SDL_KEYUP;
+            replay_event.event.key.type = replay_event.event.type;
+            replay_event.event.key.state = a ? SDL_PRESSED : SDL_RELEASED;
+            replay_event.event.key.keysym.sym = static_cast<SDLKey>(b);
+            replay_event.event.key.keysym.mod = static_cast<SDLMod>(c);
+        } else if(type == "joyaxis" && (line_stream >> a >> b)) {
+            replay_event.event.type = SDL_JOYAXISMOTION;
+            replay_event.event.jaxis.type = SDL_JOYAXISMOTION;
+            replay_event.event.jaxis.axis = static_cast<uint8>(a);
+            replay_event.event.jaxis.value = static_cast<int16>(b);
+        } else if(type == "joybutton" && (line_stream >> a >> b)) {
+            replay_event.event.type = a ? SDL_JOYBUTTONDOWN : SDL_JOYBUTTONUP;
+            replay_event.event.jbutton.type = replay_event.event.type;
+            replay_event.event.jbutton.state = a ? SDL_PRESSED : SDL_RELEASED;
+            replay_event.event.jbutton.button = static_cast<uint8>(b);
+        } else {
+            PRINT_WARNING << "Invalid line in the input replay file: " << filename << ": " << line << std::endl;
+            continue;
+        }
+
+        _replay_events.push_back(replay_event);
+    }
+
+    // Without an end marker, stop right after the last event.
+    if(_replay_end_frame == 0 && !_replay_events.empty())
+        _replay_end_frame = _replay_events.back().frame + 1;
+
+    _replaying = true;
+    return true;
+}
+
+
+void InputEngine::_HandleInputEvent(SDL_Event &event)
+{
+    _event = event;
+    if(event.type == SDL_KEYUP || event.type == SDL_KEYDOWN)
+        _KeyEventHandler(event.key);
+    else
+        _JoystickEventHandler(event);
+}
+
+
+void InputEngine::_RecordEvent(const SDL_Event &event)
+{
+    if(!_record_file.is_open())
+        return;
+
+    switch(event.type) {
+    case SDL_KEYDOWN:
+    case SDL_KEYUP:
+        _record_file << _frame_number << " key " << (event.type == SDL_KEYDOWN ? 1 : 0) << " "
+                     << static_cast<int32>(event.key.keysym.sym) << " "
+                     << static_cast<int32>(event.key.keysym.mod) << std::endl;
+        break;
+    case SDL_JOYAXISMOTION:
+        _record_file << _frame_number << " joyaxis " << static_cast<int32>(event.jaxis.axis) << " "
+                     << static_cast<int32>(event.jaxis.value) << std::endl;
+        break;
+    case SDL_JOYBUTTONDOWN:
+    case SDL_JOYBUTTONUP:
+        _record_file << _frame_number << " joybutton " << (event.type == SDL_JOYBUTTONDOWN ? 1 : 0) << " "
+                     << static_cast<int32>(event.jbutton.button) << std::endl;
+        break;
+    default:
+        break;
+    }
+}
+
+
+void InputEngine::_ReplayEvents()
+{
+    while(_replay_index < _replay_events.size() && _replay_events[_replay_index].frame <= _frame_number) {
+        _HandleInputEvent(_replay_events[_replay_index].event);
+        ++_replay_index;
+    }
+
+    if(_frame_number >= _replay_end_frame) {
+        _replaying = false;
+        SystemManager->ExitGame();
+    }
+}
+
+
 
 // Handles all keyboard events for the game
 void InputEngine::_KeyEventHandler(SDL_KeyboardEvent &key_event)
@@ -327,6 +483,23 @@ void InputEngine::_KeyEventHandler(SDL_KeyboardEvent &key_event)
                 // Display and cycle through the texture sheets
                 VideoManager->Textures()->DEBUG_NextTexSheet();
                 return;
+            } else if(key_event.keysym.sym == SDLK_p) {
+                // Toggle the frame-time profiler graph
+                ProfilerManager->ToggleOverlay();
+                return;
+            } else if(key_event.keysym.sym == SDLK_e) {
+                // Export the frame-time profiler records
+                static uint32 i = 1;
+                std::string path = "";
+                while(true) {
+                    path = vt_utils::GetUserDataPath() + "profile_" + NumberToString<uint32>(i);
+                    if(!DoesFileExist(path + ".csv"))
+                        break;
+                    i++;
+                }
+                ProfilerManager->ExportCSV(path + ".csv");
+                ProfilerManager->ExportChromeTrace(path + ".json");
+                return;
             }
 #endif
 
@@ -22,6 +22,8 @@
 
 #include "utils.h"
 
+#include <fstream>
+
 //! All calls to the input engine are wrapped in this namespace.
 namespace vt_input
 {
@@ -34,6 +36,11 @@ extern InputEngine *InputManager;
 //! Determines whether the code in the vt_input namespace should print debug statements or not.
 extern bool INPUT_DEBUG;
 
+/** \brief The time, in milliseconds, each frame advances the game by while recording or replaying input.
+*** A fixed frame time makes the game behave identically whatever the machine speed.
+**/
+const uint32 INPUT_REPLAY_FRAME_TIME = 16;
+
 //! An internal namespace to be used only within the input code.
 namespace private_input
 {
@@ -103,6 +110,16 @@ public:
     uint16 threshold;
 }; // class JoystickState
 
+/** ***************************************************************************
+*** \brief A recorded keyboard or joystick event, and the frame it happened on.
+*** **************************************************************************/
+struct ReplayEvent {
+    //! \brief The number of the frame, starting at 0 with the first frame of the game.
+    uint32 frame;
+
+    SDL_Event event;
+}; // struct ReplayEvent
+
 } // namespace private_input
 
 /** ***************************************************************************
@@ -238,6 +255,33 @@ private:
      **/
     SDL_Event _event;
 
+    //! \brief The number of times the events have been handled, used to time the recorded events.
+    uint32 _frame_number;
+
+    //! \brief The file the events are recorded to, when recording.
+    std::ofstream _record_file;
+
+    //! \brief Tells whether recorded events are being replayed.
+    bool _replaying;
+
+    //! \brief The events to replay, in frame order.
+    std::vector<private_input::ReplayEvent> _replay_events;
+
+    //! \brief The index of the next event to replay.
+    uint32 _replay_index;
+
+    //! \brief The frame at which the replay ends and the game exits.
+    uint32 _replay_end_frame;
+
+    //! \brief Passes a keyboard or joystick event to the corresponding handler.
+    void _HandleInputEvent(SDL_Event &event);
+
+    //! \brief Writes a keyboard or joystick event to the record file.
+    void _RecordEvent(const SDL_Event &event);
+
+    //! \brief Handles the recorded events of the current frame, and exits the game at the end of the replay.
+    void _ReplayEvents();
+
     /** \brief Processes all keyboard input events
     *** \param key_event The event to process
     **/
@@ -310,9 +354,37 @@ public:
     *** and JoystickEventHandler() functions.
     ***
     *** \note EventHandler() should only be called in the main game loop. Do \b not call it anywhere else.
+    *** \note The press and release flags are kept until ResetPressAndReleaseFlags() is called,
+    *** so that they aren't lost when no game update step happens during a frame.
     **/
     void EventHandler();
 
+    /** \brief Records all the keyboard and joystick events to the given file, frame after frame.
+    *** \return False if the file couldn't be opened.
+    *** \note The game should then advance by INPUT_REPLAY_FRAME_TIME on each frame so that the record can be replayed identically.
+    **/
+    bool StartRecording(const std::string &filename);
+
+    /** \brief Replays the keyboard and joystick events recorded in the given file.
+    *** While replaying, the real keyboard and joystick events are ignored,
+    *** and the game exits once the last recorded frame is reached.
+    *** \return False if the file couldn't be read.
+    **/
+    bool StartReplay(const std::string &filename);
+
+    bool IsRecording() const {
+        return _record_file.is_open();
+    }
+
+    bool IsReplaying() const {
+        return _replaying;
+    }
+
+    /** \brief Resets all the press and release flags so that they don't get detected twice.
+    *** The main game loop calls it after each game update step.
+    **/
+    void ResetPressAndReleaseFlags();
+
     /** \name   Input state member access functions
     *** \return True if the input event key/button is being held down
     **/
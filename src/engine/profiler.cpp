@@ -0,0 +1,420 @@
+////////////////////////////////////////////////////////////////////////////////
+//            Copyright (C) 2012-2013 by Bertram (Valyria Tear)
+//                         All Rights Reserved
+//
+// This code is licensed under the GNU GPL version 2. It is free software
+// and you may modify it and/or redistribute it under the terms of this license.
+// See http://www.gnu.org/copyleft/gpl.html for details.
+////////////////////////////////////////////////////////////////////////////////
+
+/** ****************************************************************************
+*** \file    profiler.cpp
+*** \author  Yohann Ferreira, yohann ferreira orange fr
+*** \brief   Source file for the frame-time profiler
+*** ***************************************************************************/
+
+#include "engine/profiler.h"
+
+#include "engine/video/video.h"
+
+#include <fstream>
+#include <cstring>
+
+#ifndef _WIN32
+#include <sys/time.h>
+#endif
+
+using namespace vt_utils;
+using namespace vt_video;
+using namespace vt_system::private_system;
+
+template<> vt_system::Profiler *Singleton<vt_system::Profiler>::_singleton_reference = NULL;
+
+namespace vt_system
+{
+
+Profiler *ProfilerManager = NULL;
+
+//! \brief The colors used to draw the top-level zones in the overlay graph.
+static const uint32 PROFILER_COLOR_COUNT = 6;
+static const Color PROFILER_COLORS[PROFILER_COLOR_COUNT] = {
+    Color(0.9f, 0.3f, 0.3f, 0.8f),
+    Color(0.3f, 0.9f, 0.3f, 0.8f),
+    Color(0.3f, 0.5f, 1.0f, 0.8f),
+    Color(1.0f, 0.9f, 0.2f, 0.8f),
+    Color(0.8f, 0.4f, 1.0f, 0.8f),
+    Color(0.2f, 0.9f, 0.9f, 0.8f)
+};
+
+//! \brief The overlay graph position and size, in standard screen coordinates.
+static const float PROFILER_GRAPH_X = 16.0f;
+static const float PROFILER_GRAPH_Y = 16.0f;
+static const float PROFILER_GRAPH_HEIGHT = 160.0f;
+static const float PROFILER_BAR_WIDTH = 2.0f;
+
+//! \brief The frame time, in microseconds, corresponding to the full graph height (two 60 Hz frames).
+static const float PROFILER_GRAPH_MAX_TIME = 33333.0f;
+
+Profiler::Profiler():
+    _enabled(false),
+    _overlay_visible(false),
+    _in_frame(false),
+    _frames(NULL),
+    _current_frame(0),
+    _recorded_frames(0),
+    _frame_number(0),
+    _frame_start(0),
+    _depth(0),
+    _frame_time_histogram(NULL),
+    _histogram_total_time(0.0f),
+    _max_frame_time(0)
+{
+    _frames = new ProfilerFrameRecord[PROFILER_FRAME_SAMPLES];
+    _frame_time_histogram = new uint32[PROFILER_HISTOGRAM_BUCKETS];
+    memset(_frame_time_histogram, 0, PROFILER_HISTOGRAM_BUCKETS * sizeof(uint32));
+}
+
+Profiler::~Profiler()
+{
+    delete[] _frames;
+    delete[] _frame_time_histogram;
+}
+
+bool Profiler::SingletonInitialize()
+{
+    return true;
+}
+
+uint32 Profiler::_GetMicroseconds()
+{
+#ifdef _WIN32
+    static LARGE_INTEGER frequency;
+    static bool frequency_known = false;
+    if(!frequency_known) {
+        QueryPerformanceFrequency(&frequency);
+        frequency_known = true;
+    }
+
+    LARGE_INTEGER counter;
+    QueryPerformanceCounter(&counter);
+    // Split the computation to avoid overflowing the counter value
+    return static_cast<uint32>((counter.QuadPart / frequency.QuadPart) * 1000000
+                               + ((counter.QuadPart % frequency.QuadPart) * 1000000) / frequency.QuadPart);
+#else
+    struct timeval time_value;
+    gettimeofday(&time_value, NULL);
+    return static_cast<uint32>(time_value.tv_sec) * 1000000u + static_cast<uint32>(time_value.tv_usec);
+#endif
+}
+
+void Profiler::SetEnabled(bool enabled)
+{
+    if(_enabled == enabled)
+        return;
+
+    _enabled = enabled;
+    _in_frame = false;
+    _depth = 0;
+
+    if(_enabled) {
+        _current_frame = 0;
+        _recorded_frames = 0;
+        _frame_number = 0;
+        memset(_frame_time_histogram, 0, PROFILER_HISTOGRAM_BUCKETS * sizeof(uint32));
+        _histogram_total_time = 0.0f;
+        _max_frame_time = 0;
+    }
+}
+
+void Profiler::ToggleOverlay()
+{
+    _overlay_visible = !_overlay_visible;
+    if(_overlay_visible)
+        SetEnabled(true);
+}
+
+void Profiler::BeginFrame()
+{
+    if(!_enabled)
+        return;
+
+    ProfilerFrameRecord &frame = _frames[_current_frame];
+    frame.ticks = SDL_GetTicks();
+    frame.duration = 0;
+    frame.zone_count = 0;
+
+    _frame_start = _GetMicroseconds();
+    _depth = 0;
+    _in_frame = true;
+}
+
+void Profiler::EndFrame()
+{
+    if(!_enabled || !_in_frame)
+        return;
+
+    uint32 duration = _GetMicroseconds() - _frame_start;
+    _frames[_current_frame].duration = duration;
+    _in_frame = false;
+
+    uint32 bucket = duration / PROFILER_HISTOGRAM_RESOLUTION;
+    if(bucket >= PROFILER_HISTOGRAM_BUCKETS)
+        bucket = PROFILER_HISTOGRAM_BUCKETS - 1;
+    ++_frame_time_histogram[bucket];
+    _histogram_total_time += static_cast<float>(duration) / 1000.0f;
+    if(duration > _max_frame_time)
+        _max_frame_time = duration;
+
+    _current_frame = (_current_frame + 1) % PROFILER_FRAME_SAMPLES;
+    if(_recorded_frames < PROFILER_FRAME_SAMPLES)
+        ++_recorded_frames;
+    ++_frame_number;
+}
+
+int32 Profiler::_BeginZone(const char *name)
+{
+    if(!_in_frame || _depth >= PROFILER_MAX_DEPTH)
+        return -1;
+
+    ProfilerFrameRecord &frame = _frames[_current_frame];
+    if(frame.zone_count >= PROFILER_MAX_ZONES)
+        return -1;
+
+    ProfilerZoneRecord &zone = frame.zones[frame.zone_count];
+    zone.name = name;
+    zone.depth = _depth;
+    zone.start = _GetMicroseconds() - _frame_start;
+    zone.duration = 0;
+
+    ++_depth;
+    return static_cast<int32>(frame.zone_count++);
+}
+
+void Profiler::_EndZone(int32 zone_index)
+{
+    // The frame may have ended before the zone did.
+    if(!_in_frame)
+        return;
+
+    ProfilerZoneRecord &zone = _frames[_current_frame].zones[zone_index];
+    zone.duration = (_GetMicroseconds() - _frame_start) - zone.start;
+
+    if(_depth > 0)
+        --_depth;
+}
+
+uint32 Profiler::GetAverageFrameTime() const
+{
+    if(_recorded_frames == 0)
+        return 0;
+
+    uint32 sum = 0;
+    for(uint32 i = 0; i < _recorded_frames; ++i)
+        sum += _GetFrame(i).duration;
+
+    return sum / _recorded_frames;
+}
+
+uint32 Profiler::GetFrameTimePercentile(float percent) const
+{
+    if(_frame_number == 0)
+        return 0;
+
+    // The rank of the frame to find, counting from the fastest one.
+    uint32 rank = static_cast<uint32>(percent / 100.0f * static_cast<float>(_frame_number));
+    if(rank >= _frame_number)
+        rank = _frame_number - 1;
+
+    uint32 count = 0;
+    for(uint32 i = 0; i < PROFILER_HISTOGRAM_BUCKETS; ++i) {
+        count += _frame_time_histogram[i];
+        if(count > rank)
+            return (i + 1) * PROFILER_HISTOGRAM_RESOLUTION;
+    }
+
+    return _max_frame_time;
+}
+
+void Profiler::PrintFrameTimeReport(std::ostream &stream) const
+{
+    if(_frame_number == 0) {
+        stream << "No frame was profiled." << std::endl;
+        return;
+    }
+
+    stream << "Frame times over " << _frame_number << " frames (ms):" << std::endl
+           << "  average: " << _histogram_total_time / static_cast<float>(_frame_number) << std::endl
+           << "  50%: " << GetFrameTimePercentile(50.0f) / 1000.0f
+           << "  90%: " << GetFrameTimePercentile(90.0f) / 1000.0f
+           << "  95%: " << GetFrameTimePercentile(95.0f) / 1000.0f
+           << "  99%: " << GetFrameTimePercentile(99.0f) / 1000.0f << std::endl
+           << "  max: " << _max_frame_time / 1000.0f << std::endl;
+}
+
+uint32 Profiler::GetAverageZoneTime(const std::string &zone_name) const
+{
+    if(_recorded_frames == 0)
+        return 0;
+
+    uint32 sum = 0;
+    for(uint32 i = 0; i < _recorded_frames; ++i) {
+        const ProfilerFrameRecord &frame = _GetFrame(i);
+        for(uint32 j = 0; j < frame.zone_count; ++j) {
+            if(frame.zones[j].depth == 0 && zone_name == frame.zones[j].name)
+                sum += frame.zones[j].duration;
+        }
+    }
+
+    return sum / _recorded_frames;
+}
+
+void Profiler::DrawOverlay()
+{
+    if(!_overlay_visible || _recorded_frames == 0)
+        return;
+
+    VideoManager->PushState();
+    VideoManager->SetCoordSys(0.0f, VIDEO_STANDARD_RES_WIDTH, 0.0f, VIDEO_STANDARD_RES_HEIGHT);
+    VideoManager->SetDrawFlags(VIDEO_X_LEFT, VIDEO_Y_BOTTOM, VIDEO_X_NOFLIP, VIDEO_Y_NOFLIP, VIDEO_BLEND, 0);
+
+    const float graph_width = PROFILER_FRAME_SAMPLES * PROFILER_BAR_WIDTH;
+    const float scale = PROFILER_GRAPH_HEIGHT / PROFILER_GRAPH_MAX_TIME;
+
+    // Background
+    VideoManager->Move(PROFILER_GRAPH_X, PROFILER_GRAPH_Y);
+    VideoManager->DrawRectangle(graph_width, PROFILER_GRAPH_HEIGHT, Color(0.0f, 0.0f, 0.0f, 0.6f));
+
+    // One bar per frame, the oldest on the left. Top-level zones are stacked
+    // in their own color, and the remaining (untracked) time is drawn in gray.
+    for(uint32 age = 0; age < _recorded_frames; ++age) {
+        const ProfilerFrameRecord &frame = _GetFrame(age);
+        float x = PROFILER_GRAPH_X + graph_width - (age + 1) * PROFILER_BAR_WIDTH;
+        float y = PROFILER_GRAPH_Y;
+        uint32 color_index = 0;
+        uint32 tracked_time = 0;
+
+        for(uint32 j = 0; j < frame.zone_count; ++j) {
+            const ProfilerZoneRecord &zone = frame.zones[j];
+            if(zone.depth != 0)
+                continue;
+
+            float height = zone.duration * scale;
+            if(y + height > PROFILER_GRAPH_Y + PROFILER_GRAPH_HEIGHT)
+                height = PROFILER_GRAPH_Y + PROFILER_GRAPH_HEIGHT - y;
+            if(height > 0.0f) {
+                VideoManager->Move(x, y);
+                VideoManager->DrawRectangle(PROFILER_BAR_WIDTH, height, PROFILER_COLORS[color_index % PROFILER_COLOR_COUNT]);
+                y += height;
+            }
+            tracked_time += zone.duration;
+            ++color_index;
+        }
+
+        if(frame.duration > tracked_time) {
+            float height = (frame.duration - tracked_time) * scale;
+            if(y + height > PROFILER_GRAPH_Y + PROFILER_GRAPH_HEIGHT)
+                height = PROFILER_GRAPH_Y + PROFILER_GRAPH_HEIGHT - y;
+            if(height > 0.0f) {
+                VideoManager->Move(x, y);
+                VideoManager->DrawRectangle(PROFILER_BAR_WIDTH, height, Color(0.5f, 0.5f, 0.5f, 0.8f));
+            }
+        }
+    }
+
+    // The 60 Hz frame budget line
+    float budget_y = PROFILER_GRAPH_Y + PROFILER_GRAPH_HEIGHT / 2.0f;
+    VideoManager->DrawLine(PROFILER_GRAPH_X, budget_y, PROFILER_GRAPH_X + graph_width, budget_y, 1.0f, Color::white);
+
+    // The legend, with the averaged top-level zone times
+    const ProfilerFrameRecord &last_frame = _GetFrame(0);
+    float text_y = PROFILER_GRAPH_Y + PROFILER_GRAPH_HEIGHT + 24.0f;
+    char text[128];
+
+    sprintf(text, "Frame: %.2f ms", GetAverageFrameTime() / 1000.0f);
+    VideoManager->Move(PROFILER_GRAPH_X, text_y);
+    VideoManager->Text()->Draw(text, TextStyle("text20", Color::white));
+
+    uint32 color_index = 0;
+    for(uint32 j = 0; j < last_frame.zone_count; ++j) {
+        const ProfilerZoneRecord &zone = last_frame.zones[j];
+        if(zone.depth != 0)
+            continue;
+
+        text_y += 20.0f;
+        snprintf(text, sizeof(text), "%s: %.2f ms", zone.name, GetAverageZoneTime(zone.name) / 1000.0f);
+        VideoManager->Move(PROFILER_GRAPH_X, text_y);
+        VideoManager->Text()->Draw(text, TextStyle("text20", PROFILER_COLORS[color_index % PROFILER_COLOR_COUNT]));
+        ++color_index;
+    }
+
+    VideoManager->PopState();
+}
+
+bool Profiler::ExportCSV(const std::string &filename) const
+{
+    std::ofstream file(filename.c_str());
+    if(!file.is_open()) {
+        PRINT_WARNING << "Couldn't open profiler CSV file for writing: " << filename << std::endl;
+        return false;
+    }
+
+    file << "frame,ticks_ms,zone,depth,start_us,duration_us" << std::endl;
+
+    // Write from the oldest to the newest frame
+    uint32 first_frame_number = _frame_number - _recorded_frames;
+    for(uint32 i = 0; i < _recorded_frames; ++i) {
+        const ProfilerFrameRecord &frame = _GetFrame(_recorded_frames - 1 - i);
+        uint32 frame_number = first_frame_number + i;
+
+        file << frame_number << "," << frame.ticks << ",Frame,-1,0," << frame.duration << std::endl;
+        for(uint32 j = 0; j < frame.zone_count; ++j) {
+            const ProfilerZoneRecord &zone = frame.zones[j];
+            file << frame_number << "," << frame.ticks << "," << zone.name << "," << zone.depth << ","
+                 << zone.start << "," << zone.duration << std::endl;
+        }
+    }
+
+    file.close();
+    return true;
+}
+
+bool Profiler::ExportChromeTrace(const std::string &filename) const
+{
+    std::ofstream file(filename.c_str());
+    if(!file.is_open()) {
+        PRINT_WARNING << "Couldn't open profiler trace file for writing: " << filename << std::endl;
+        return false;
+    }
+
+    // Use fixed notation so that timestamps aren't written in scientific notation.
+    file.setf(std::ios::fixed);
+    file.precision(0);
+
+    file << "{\"traceEvents\":[" << std::endl;
+
+    bool first_event = true;
+    for(uint32 i = 0; i < _recorded_frames; ++i) {
+        const ProfilerFrameRecord &frame = _GetFrame(_recorded_frames - 1 - i);
+        double frame_start = static_cast<double>(frame.ticks) * 1000.0;
+
+        if(!first_event)
+            file << "," << std::endl;
+        first_event = false;
+
+        file << "{\"name\":\"Frame\",\"ph\":\"X\",\"pid\":1,\"tid\":1,\"ts\":" << frame_start
+             << ",\"dur\":" << frame.duration << "}";
+
+        for(uint32 j = 0; j < frame.zone_count; ++j) {
+            const ProfilerZoneRecord &zone = frame.zones[j];
+            file << "," << std::endl
+                 << "{\"name\":\"" << zone.name << "\",\"ph\":\"X\",\"pid\":1,\"tid\":1,\"ts\":"
+                 << frame_start + zone.start << ",\"dur\":" << zone.duration << "}";
+        }
+    }
+
+    file << std::endl << "]}" << std::endl;
+    file.close();
+    return true;
+}
+
+} // namespace vt_system
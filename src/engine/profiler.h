@@ -0,0 +1,268 @@
+////////////////////////////////////////////////////////////////////////////////
+//            Copyright (C) 2012-2013 by Bertram (Valyria Tear)
+//                         All Rights Reserved
+//
+// This code is licensed under the GNU GPL version 2. It is free software
+// and you may modify it and/or redistribute it under the terms of this license.
+// See http://www.gnu.org/copyleft/gpl.html for details.
+////////////////////////////////////////////////////////////////////////////////
+
+/** ****************************************************************************
+*** \file    profiler.h
+*** \author  Yohann Ferreira, yohann ferreira orange fr
+*** \brief   Header file for the frame-time profiler
+***
+*** The profiler measures how much time is spent in named, nestable zones of
+*** code during each frame. The last PROFILER_FRAME_SAMPLES frames are kept in
+*** a ring buffer, can be displayed as a graph overlay and exported to either
+*** a CSV file or a Chrome trace file (chrome://tracing).
+***
+*** Zones are declared with the PROFILE_SCOPE() macro:
+*** \code
+*** void MapMode::Update()
+*** {
+***     PROFILE_SCOPE("MapMode::Update");
+***     ...
+*** }
+*** \endcode
+***
+*** \note When the profiler is disabled, a zone costs a single boolean check.
+*** ***************************************************************************/
+
+#ifndef __PROFILER_HEADER__
+#define __PROFILER_HEADER__
+
+#include "utils.h"
+
+namespace vt_system
+{
+
+class Profiler;
+
+//! \brief The singleton pointer responsible for the frame-time measurements.
+extern Profiler *ProfilerManager;
+
+//! \brief The number of frames kept in the profiler ring buffer.
+const uint32 PROFILER_FRAME_SAMPLES = 240;
+
+//! \brief The maximum number of zones recorded per frame. Further zones are ignored.
+const uint32 PROFILER_MAX_ZONES = 128;
+
+//! \brief The maximum zone nesting depth.
+const uint32 PROFILER_MAX_DEPTH = 16;
+
+//! \brief The frame-time histogram resolution, in microseconds.
+const uint32 PROFILER_HISTOGRAM_RESOLUTION = 100;
+
+//! \brief The number of frame-time histogram buckets. Frames slower than one second share the last one.
+const uint32 PROFILER_HISTOGRAM_BUCKETS = 10000;
+
+namespace private_system
+{
+
+/** ****************************************************************************
+*** \brief A single measured zone in a frame.
+*** ***************************************************************************/
+struct ProfilerZoneRecord {
+    //! \brief The zone name. It must be a string literal as only its pointer is kept.
+    const char *name;
+
+    //! \brief The zone nesting depth, 0 being a top-level zone.
+    uint32 depth;
+
+    //! \brief The zone start time in microseconds, relative to the start of the frame.
+    uint32 start;
+
+    //! \brief The zone duration in microseconds.
+    uint32 duration;
+};
+
+/** ****************************************************************************
+*** \brief All the zones measured during one frame.
+*** ***************************************************************************/
+struct ProfilerFrameRecord {
+    ProfilerFrameRecord():
+        ticks(0),
+        duration(0),
+        zone_count(0)
+    {}
+
+    //! \brief The SDL ticks (in milliseconds) at the beginning of the frame.
+    uint32 ticks;
+
+    //! \brief The whole frame duration in microseconds.
+    uint32 duration;
+
+    //! \brief The number of valid entries in the zones array.
+    uint32 zone_count;
+
+    ProfilerZoneRecord zones[PROFILER_MAX_ZONES];
+};
+
+} // namespace private_system
+
+/** ****************************************************************************
+*** \brief Records the time spent in named zones of code, frame after frame.
+***
+*** The main loop calls BeginFrame() and EndFrame() around each iteration,
+*** and code zones are measured in between using ScopedProfile objects
+*** (through the PROFILE_SCOPE() macro).
+***
+*** \note This class is a singleton.
+*** ***************************************************************************/
+class Profiler : public vt_utils::Singleton<Profiler>
+{
+    friend class vt_utils::Singleton<Profiler>;
+    friend class ScopedProfile;
+
+public:
+    ~Profiler();
+
+    bool SingletonInitialize();
+
+    //! \brief Starts/ends a new frame record. Only the main loop should call those.
+    //@{
+    void BeginFrame();
+    void EndFrame();
+    //@}
+
+    //! \brief Enables or disables the measurements. The ring buffer is cleared when enabling it.
+    void SetEnabled(bool enabled);
+
+    bool IsEnabled() const {
+        return _enabled;
+    }
+
+    //! \brief Toggles the graph overlay. Showing it also enables the measurements.
+    void ToggleOverlay();
+
+    /** \brief Draws the frame-time graph and the averaged top-level zones.
+    *** \note This must be called after all the other draw calls of the frame,
+    *** so that the overlay is drawn on top of everything.
+    **/
+    void DrawOverlay();
+
+    /** \brief Writes the recorded zones to a CSV file.
+    *** Each line is: frame,ticks_ms,zone,depth,start_us,duration_us
+    *** \return false if the file couldn't be written.
+    **/
+    bool ExportCSV(const std::string &filename) const;
+
+    /** \brief Writes the recorded zones to a Chrome trace file.
+    *** The file can be opened with chrome://tracing or any compatible viewer.
+    *** \return false if the file couldn't be written.
+    **/
+    bool ExportChromeTrace(const std::string &filename) const;
+
+    /** \brief Returns the average time spent in the given top-level zone
+    *** over the recorded frames, in microseconds.
+    **/
+    uint32 GetAverageZoneTime(const std::string &zone_name) const;
+
+    //! \brief Returns the average frame time over the recorded frames, in microseconds.
+    uint32 GetAverageFrameTime() const;
+
+    /** \brief Returns the frame time under which the given percentage of all the frames
+    *** measured since the profiler was enabled fall, in microseconds.
+    *** \param percent The percentile to compute: [0.0 - 100.0]
+    *** \note The result is precise to PROFILER_HISTOGRAM_RESOLUTION microseconds.
+    **/
+    uint32 GetFrameTimePercentile(float percent) const;
+
+    /** \brief Prints the frame count, average, percentiles and maximum frame times
+    *** of all the frames measured since the profiler was enabled.
+    **/
+    void PrintFrameTimeReport(std::ostream &stream) const;
+
+private:
+    Profiler();
+
+    //! \brief Returns the current time, in microseconds. The value wraps, so only differences are meaningful.
+    static uint32 _GetMicroseconds();
+
+    //! \brief Called by ScopedProfile objects. Returns the zone index or -1 if it couldn't be recorded.
+    int32 _BeginZone(const char *name);
+    void _EndZone(int32 zone_index);
+
+    //! \brief Returns the frame record at the given age, 0 being the last completed frame.
+    const private_system::ProfilerFrameRecord &_GetFrame(uint32 age) const {
+        return _frames[(_current_frame + PROFILER_FRAME_SAMPLES - 1 - age) % PROFILER_FRAME_SAMPLES];
+    }
+
+    //! \brief Tells whether zones are currently measured.
+    bool _enabled;
+
+    //! \brief Tells whether the graph overlay is drawn.
+    bool _overlay_visible;
+
+    //! \brief Tells whether a frame is currently being recorded.
+    bool _in_frame;
+
+    //! \brief The ring buffer of frame records.
+    private_system::ProfilerFrameRecord *_frames;
+
+    //! \brief The index of the frame currently being recorded in the ring buffer.
+    uint32 _current_frame;
+
+    //! \brief The number of completed frames in the ring buffer.
+    uint32 _recorded_frames;
+
+    //! \brief The total number of frames recorded since the profiler was enabled.
+    uint32 _frame_number;
+
+    //! \brief The microsecond time at which the current frame started.
+    uint32 _frame_start;
+
+    //! \brief The current zone nesting depth.
+    uint32 _depth;
+
+    /** \brief The number of frames per frame duration, since the profiler was enabled.
+    *** Unlike the ring buffer, the histogram covers whole sessions in a fixed amount of memory.
+    **/
+    uint32 *_frame_time_histogram;
+
+    //! \brief The sum of all the frame durations in the histogram, in milliseconds.
+    float _histogram_total_time;
+
+    //! \brief The longest frame duration since the profiler was enabled, in microseconds.
+    uint32 _max_frame_time;
+};
+
+/** ****************************************************************************
+*** \brief Measures the time spent between its construction and its destruction.
+***
+*** Use the PROFILE_SCOPE() macro rather than this class directly.
+*** ***************************************************************************/
+class ScopedProfile
+{
+public:
+    //! \param name The zone name. It must be a string literal as only its pointer is kept.
+    explicit ScopedProfile(const char *name):
+        _zone_index(-1)
+    {
+        if(ProfilerManager && ProfilerManager->_enabled)
+            _zone_index = ProfilerManager->_BeginZone(name);
+    }
+
+    ~ScopedProfile() {
+        if(_zone_index >= 0)
+            ProfilerManager->_EndZone(_zone_index);
+    }
+
+private:
+    //! \brief The index of the zone in the current frame record, or -1 if not recorded.
+    int32 _zone_index;
+
+    // Not copyable
+    ScopedProfile(const ScopedProfile &);
+    ScopedProfile &operator=(const ScopedProfile &);
+};
+
+} // namespace vt_system
+
+//! \brief Measures the time spent in the enclosing scope under the given zone name.
+#define PROFILE_SCOPE_CONCAT_INTERNAL(a, b) a##b
+#define PROFILE_SCOPE_CONCAT(a, b) PROFILE_SCOPE_CONCAT_INTERNAL(a, b)
+#define PROFILE_SCOPE(name) vt_system::ScopedProfile PROFILE_SCOPE_CONCAT(_profile_zone_, __LINE__)(name)
+
+#endif // __PROFILER_HEADER__
@@ -28,6 +28,13 @@ using namespace luabind;
 using namespace vt_utils;
 using namespace vt_script::private_script;
 
+//! \brief Appends the chunks given by lua_dump() to a string.
+static int _WriteBytecode(lua_State * /*state*/, const void *data, size_t size, void *bytecode)
+{
+    static_cast<std::string *>(bytecode)->append(static_cast<const char *>(data), size);
+    return 0;
+}
+
 template<> vt_script::ScriptEngine *Singleton<vt_script::ScriptEngine>::_singleton_reference = NULL;
 
 namespace vt_script
@@ -99,6 +106,46 @@ void ScriptEngine::HandleCastError(const luabind::cast_failed &err)
 
 
 
+bool ScriptEngine::CacheScript(const std::string &filename)
+{
+    if(_cached_scripts.find(filename) != _cached_scripts.end())
+        return true;
+
+    if(!DoesFileExist(filename)) {
+        PRINT_WARNING << "Couldn't find the script file to cache: " << filename << std::endl;
+        return false;
+    }
+
+    // The global stack keeps the open files threads, so only the chunk or error message is popped.
+    if(luaL_loadfile(_global_state, filename.c_str()) != 0) {
+        PRINT_WARNING << "Couldn't compile the script file: " << filename << ", error message:" << std::endl
+                      << lua_tostring(_global_state, STACK_TOP) << std::endl;
+        lua_pop(_global_state, 1);
+        return false;
+    }
+
+    lua_dump(_global_state, _WriteBytecode, &_cached_scripts[filename]);
+    lua_pop(_global_state, 1);
+    return true;
+}
+
+
+
+const std::string *ScriptEngine::_GetScriptBytecode(const std::string &filename) const
+{
+    std::map<std::string, std::string>::const_iterator it = _precompiled_scripts.find(filename);
+    if(it != _precompiled_scripts.end())
+        return &it->second;
+
+    it = _cached_scripts.find(filename);
+    if(it != _cached_scripts.end())
+        return &it->second;
+
+    return NULL;
+}
+
+
+
 void ScriptEngine::_AddOpenFile(ScriptDescriptor *sd)
 {
     // NOTE: This function assumes that the file is not already open
@@ -288,6 +288,32 @@ public:
         return tablespace;
     }
 
+    /** \brief Keeps the compiled bytecode of a script file, so that opening the file doesn't parse it again.
+    *** \param filename The script file the bytecode was compiled from.
+    *** \param bytecode The bytecode, as dumped by lua_dump().
+    **/
+    void AddPrecompiledScript(const std::string &filename, const std::string &bytecode) {
+        _precompiled_scripts[filename] = bytecode;
+    }
+
+    //! \brief Frees all the precompiled script bytecode.
+    void ClearPrecompiledScripts() {
+        _precompiled_scripts.clear();
+    }
+
+    /** \brief Compiles a script file once and keeps its bytecode until ClearCachedScripts() is called.
+    *** Unlike the precompiled scripts, which are replaced at each map preloading, the cached
+    *** scripts are meant for the files opened over and over, e.g. by each battle.
+    *** Opening the file still runs it, so that the data it declares is created anew.
+    *** \return false when the file couldn't be compiled.
+    **/
+    bool CacheScript(const std::string &filename);
+
+    //! \brief Frees all the cached script bytecode.
+    void ClearCachedScripts() {
+        _cached_scripts.clear();
+    }
+
 private:
     ScriptEngine();
 
@@ -303,6 +329,15 @@ private:
     //! \brief The lua state shared globally by all files
     lua_State *_global_state;
 
+    //! \brief The compiled bytecode of script files, used instead of the files when opening them.
+    std::map<std::string, std::string> _precompiled_scripts;
+
+    //! \brief The compiled bytecode of the script files cached with CacheScript().
+    std::map<std::string, std::string> _cached_scripts;
+
+    //! \brief Returns the bytecode compiled from a script file, or NULL when there is none.
+    const std::string *_GetScriptBytecode(const std::string &filename) const;
+
     //! \brief Adds an open file to the list of open files
     void _AddOpenFile(ScriptDescriptor *sd);
 
@@ -64,8 +64,15 @@ bool ReadScriptDescriptor::OpenFile(const std::string &filename)
     lua_checkstack(ScriptManager->GetGlobalState(), 1);
     _lstack = lua_newthread(ScriptManager->GetGlobalState());
 
-    // Attempt to load and execute the Lua file
-    if(luaL_loadfile(_lstack, filename.c_str()) != 0 || lua_pcall(_lstack, 0, 0, 0)) {
+    // Attempt to load and execute the Lua file, using its bytecode when it was compiled in advance
+    int32 load_result = 0;
+    const std::string *bytecode = ScriptManager->_GetScriptBytecode(filename);
+    if(bytecode)
+        load_result = luaL_loadbuffer(_lstack, bytecode->data(), bytecode->size(), ("@" + filename).c_str());
+    else
+        load_result = luaL_loadfile(_lstack, filename.c_str());
+
+    if(load_result != 0 || lua_pcall(_lstack, 0, 0, 0)) {
         PRINT_ERROR << "could not open script file: " << filename << ", error message:" << std::endl
                     << lua_tostring(_lstack, private_script::STACK_TOP) << std::endl;
         _access_mode = SCRIPT_CLOSED;
@@ -309,6 +309,17 @@ SystemEngine::SystemEngine()
 {
     IF_PRINT_DEBUG(SYSTEM_DEBUG) << "constructor invoked" << std::endl;
 
+    _last_update = 0;
+    _update_time = 1;
+    _frame_time = 0;
+    _simulated_frame_time = 0;
+    _fixed_update_step = 0;
+    _accumulated_time = 0;
+    _update_steps = 0;
+    _frame_rate_limit = SYSTEM_DEFAULT_FRAME_RATE_LIMIT;
+    _benchmark_mode = false;
+    _interpolation_alpha = 1.0f;
+
     _not_done = true;
     SetLanguage("en@quot"); //Default language is English
 }
@@ -386,6 +397,7 @@ void SystemEngine::InitializeTimers()
 {
     _last_update = SDL_GetTicks();
     _update_time = 1; // Set to non-zero, otherwise bad things may happen...
+    _accumulated_time = 0;
     _hours_played = 0;
     _minutes_played = 0;
     _seconds_played = 0;
@@ -433,12 +445,68 @@ void SystemEngine::RemoveAutoTimer(SystemTimer *timer)
 
 void SystemEngine::UpdateTimers()
 {
-    // ----- (1): Update the update game timer
     uint32 tmp = _last_update;
     _last_update = SDL_GetTicks();
-    _update_time = _last_update - tmp;
+    _frame_time = _last_update - tmp;
+    _update_steps = 0;
+
+    uint32 game_time = (_simulated_frame_time > 0) ? _simulated_frame_time : _frame_time;
+
+    if(_fixed_update_step == 0) {
+        // Uncapped frames may take less than a millisecond, but the update time must stay non-zero.
+        _update_time = (game_time > 0) ? game_time : 1;
+        return;
+    }
+
+    // Don't try to catch up with the time lost during a long stall.
+    _accumulated_time += (game_time > SYSTEM_MAX_FRAME_TIME) ? SYSTEM_MAX_FRAME_TIME : game_time;
+}
+
+bool SystemEngine::StartUpdateStep()
+{
+    if(_fixed_update_step == 0) {
+        // Variable step: a single update using the whole frame time.
+        if(_update_steps > 0)
+            return false;
+    } else {
+        if(_accumulated_time < _fixed_update_step) {
+            // Tells how far the frame to draw is between the last update step and the next one.
+            _interpolation_alpha = static_cast<float>(_accumulated_time) / static_cast<float>(_fixed_update_step);
+            return false;
+        }
+        _accumulated_time -= _fixed_update_step;
+        _update_time = _fixed_update_step;
+    }
 
-    // ----- (2): Update the game play timer
+    ++_update_steps;
+    // While updating, the current positions are the ones to use.
+    _interpolation_alpha = 1.0f;
+    _UpdateGameTimers();
+    return true;
+}
+
+void SystemEngine::WaitForNextFrame()
+{
+    if(_benchmark_mode || _frame_rate_limit == 0)
+        return;
+
+    // _last_update is the start time of the last frame.
+    uint32 frame_duration = 1000 / _frame_rate_limit;
+    uint32 elapsed = SDL_GetTicks() - _last_update;
+    if(elapsed < frame_duration)
+        SDL_Delay(frame_duration - elapsed);
+}
+
+void SystemEngine::SetFixedUpdateStep(uint32 step)
+{
+    _fixed_update_step = step;
+    _accumulated_time = 0;
+    _interpolation_alpha = 1.0f;
+}
+
+void SystemEngine::_UpdateGameTimers()
+{
+    // ----- (1): Update the game play timer
     _milliseconds_played += _update_time;
     if(_milliseconds_played >= 1000) {
         _seconds_played += _milliseconds_played / 1000;
@@ -453,7 +521,7 @@ void SystemEngine::UpdateTimers()
         }
     }
 
-    // ----- (3): Update all SystemTimer objects
+    // ----- (2): Update all SystemTimer objects
     for(std::set<SystemTimer *>::iterator i = _auto_system_timers.begin(); i != _auto_system_timers.end(); i++)
         (*i)->_AutoUpdate();
 }
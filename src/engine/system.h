@@ -82,6 +82,14 @@ const int32 SYSTEM_TIMER_NO_LOOPS = 0;
 **/
 const int32 SYSTEM_TIMER_INFINITE_LOOP = -1;
 
+/** \brief The maximum amount of time, in milliseconds, a single frame can feed to the fixed update steps
+*** This prevents the game from trying to catch up endlessly after a long stall (loading, debugger, ...).
+**/
+const uint32 SYSTEM_MAX_FRAME_TIME = 250;
+
+//! \brief The default frame rate limit, used when the vertical sync isn't available.
+const uint32 SYSTEM_DEFAULT_FRAME_RATE_LIMIT = 60;
+
 //! \brief All of the possible states which a SystemTimer classs object may be in
 enum SYSTEM_TIMER_STATE {
     SYSTEM_TIMER_INVALID  = -1,
@@ -380,6 +388,7 @@ public:
     void InitializeUpdateTimer() {
         _last_update = SDL_GetTicks();
         _update_time = 1;
+        _accumulated_time = 0;
     }
 
     /** \brief Adds a timer to the set system timers for auto updating
@@ -398,13 +407,76 @@ public:
     **/
     void RemoveAutoTimer(SystemTimer *timer);
 
-    /** \brief Updates the game timer variables.
+    /** \brief Measures the time elapsed since the last frame and feeds the update accumulator.
     *** This function should only be called <b>once</b> for each cycle through the main game loop. Since
     *** it is called inside the loop in main.cpp, you should have no reason to call this function anywhere
-    *** else.
+    *** else. The game timers themselves are updated by StartUpdateStep().
     **/
     void UpdateTimers();
 
+    /** \brief Starts the next game logic update step of the current frame, if any.
+    *** \return True if the game should be updated, false once all the steps of the frame are done.
+    ***
+    *** The main loop calls this function until it returns false and updates the game state each time.
+    *** With a variable update step (the default), there is exactly one step per frame, lasting
+    *** the whole frame duration. With a fixed update step, the elapsed time is consumed in steps
+    *** of exactly GetFixedUpdateStep() milliseconds, and the remainder is kept for the next frame.
+    *** The play time and the auto-updated timers are advanced on each step.
+    **/
+    bool StartUpdateStep();
+
+    /** \brief Waits until it is time to start the next frame, according to the frame rate limit.
+    *** This replaces a blind sleep in the main loop: the time already spent on the last frame
+    *** is deduced. It returns immediately in benchmark mode or when there is no frame rate limit.
+    *** \note The main loop should not call it when the vertical sync already paces the frames.
+    **/
+    void WaitForNextFrame();
+
+    /** \brief Sets the duration of a game logic update step, in milliseconds.
+    *** 0 means the game is updated once per frame using the real elapsed time (variable step).
+    **/
+    void SetFixedUpdateStep(uint32 step);
+
+    uint32 GetFixedUpdateStep() const {
+        return _fixed_update_step;
+    }
+
+    //! \brief Sets the maximum number of frames per second. 0 means no limit.
+    void SetFrameRateLimit(uint32 limit) {
+        _frame_rate_limit = limit;
+    }
+
+    uint32 GetFrameRateLimit() const {
+        return _frame_rate_limit;
+    }
+
+    /** \brief Enables or disables the benchmark mode.
+    *** In benchmark mode, the frames aren't paced at all so that the game runs as fast as possible.
+    **/
+    void SetBenchmarkMode(bool benchmark) {
+        _benchmark_mode = benchmark;
+    }
+
+    bool IsBenchmarkMode() const {
+        return _benchmark_mode;
+    }
+
+    /** \brief Makes the game advance by the given amount of milliseconds on each frame, whatever the real time.
+    *** This makes the game updates independent from the machine speed, which is needed
+    *** to replay recorded input identically. 0 means the real elapsed time is used.
+    **/
+    void SetSimulatedFrameTime(uint32 frame_time) {
+        _simulated_frame_time = frame_time;
+    }
+
+    /** \brief Returns how far the rendered frame is between the last two update steps: [0.0 - 1.0].
+    *** Draw code can use it to interpolate the positions between the previous update step and the current one.
+    *** It is always 1.0 when using a variable update step, and while the game is being updated.
+    **/
+    float GetInterpolationAlpha() const {
+        return _interpolation_alpha;
+    }
+
     /** \brief Checks all system timers for whether they should be paused or resumed
     *** This function is typically called whenever the ModeEngine class has changed the active game mode.
     *** When this is done, all system timers that are owned by the active game mode are resumed, all timers with
@@ -426,6 +498,11 @@ public:
         return _update_time;
     }
 
+    //! \brief Returns the real number of milliseconds that have transpired since the last frame.
+    uint32 GetFrameTime() const {
+        return _frame_time;
+    }
+
     /** \brief Sets the play time of a game instance
     *** \param h The amount of hours to set.
     *** \param m The amount of minutes to set.
@@ -502,6 +579,33 @@ private:
     //! \brief The number of milliseconds that have transpired on the last timer update.
     uint32 _update_time;
 
+    //! \brief The real number of milliseconds that have transpired since the last frame.
+    uint32 _frame_time;
+
+    //! \brief The fixed number of milliseconds each frame advances the game by, or 0 to use the real time.
+    uint32 _simulated_frame_time;
+
+    //! \brief The duration of a game logic update step in milliseconds, or 0 for a variable step.
+    uint32 _fixed_update_step;
+
+    //! \brief The time not yet consumed by fixed update steps, in milliseconds.
+    uint32 _accumulated_time;
+
+    //! \brief The number of update steps already done during the current frame.
+    uint32 _update_steps;
+
+    //! \brief The maximum number of frames per second, or 0 for no limit.
+    uint32 _frame_rate_limit;
+
+    //! \brief When true, the frames aren't paced at all.
+    bool _benchmark_mode;
+
+    //! \brief The draw interpolation factor between the last two update steps.
+    float _interpolation_alpha;
+
+    //! \brief Advances the play time and the auto-updated timers by the current update time.
+    void _UpdateGameTimers();
+
     /** \name Play time members
     *** \brief Timers that retain the total amount of time that the user has been playing
     *** When the player starts a new game or loads an existing game, these timers are reset.
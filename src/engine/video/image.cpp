@@ -562,12 +562,12 @@ void ImageDescriptor::_DrawTexture(const Color *draw_color) const
     if(VideoManager->_current_context.blend) {
         VideoManager->EnableBlending();
         if(VideoManager->_current_context.blend == 1)
-            glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA); // Normal blending
+            VideoManager->SetBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA); // Normal blending
         else
-            glBlendFunc(GL_SRC_ALPHA, GL_ONE); // Additive blending
+            VideoManager->SetBlendFunc(GL_SRC_ALPHA, GL_ONE); // Additive blending
     } else if(_blend) {
         VideoManager->EnableBlending();
-        glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA); // Normal blending
+        VideoManager->SetBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA); // Normal blending
     } else {
         VideoManager->DisableBlending();
     }
@@ -617,8 +617,8 @@ void ImageDescriptor::_DrawTexture(const Color *draw_color) const
         glTexCoordPointer(2, GL_FLOAT, 0, tex_coords);
 
         if(_unichrome_vertices) {
-            glColor4fv((GLfloat *)draw_color[0].GetColors());
             VideoManager->DisableColorArray();
+            VideoManager->SetColor(draw_color[0]);
         } else {
             VideoManager->EnableColorArray();
             glColorPointer(4, GL_FLOAT, 0, (GLfloat *)draw_color);
@@ -629,8 +629,8 @@ void ImageDescriptor::_DrawTexture(const Color *draw_color) const
 
         // Use a single call to glColor for unichrome images, or a setup a gl color array for multiple colors
         if(_unichrome_vertices) {
-            glColor4fv((GLfloat *)draw_color[0].GetColors());
             VideoManager->DisableColorArray();
+            VideoManager->SetColor(draw_color[0]);
         } else {
             VideoManager->EnableColorArray();
             glColorPointer(4, GL_FLOAT, 0, (GLfloat *)draw_color);
@@ -1053,7 +1053,7 @@ void StillImage::Draw(const Color &draw_color) const
 
 
 
-bool StillImage::Save(const std::string &filename) const
+bool StillImage::Save(const std::string &filename, uint32 downscale_factor) const
 {
     if(_image_texture == NULL) {
         IF_PRINT_WARNING(VIDEO_DEBUG) << "attempted to save an image that had no texture reference" << std::endl;
@@ -1082,6 +1082,10 @@ bool StillImage::Save(const std::string &filename) const
 
     ImageMemory buffer;
     buffer.CopyFromImage(_image_texture);
+    // The screen captures are stored upside down, and flipped by their texture coordinates.
+    if(_image_texture->v1 > _image_texture->v2)
+        buffer.FlipVertically();
+    buffer.Downscale(downscale_factor);
     return buffer.SaveImage(filename, is_png_image);
 } // bool StillImage::Save(const string& filename)
 
@@ -1478,6 +1482,9 @@ void AnimatedImage::Update(uint32 elapsed_time)
     // Get the amount of milliseconds that have pass since the last display
     uint32 ms_change = (elapsed_time == 0) ? vt_system::SystemManager->GetUpdateTime() : elapsed_time;
     _frame_counter += ms_change;
+    // Skip whole loops at once when catching up with a long elapsed time.
+    if(_number_loops < 0 && _animation_time > 0 && _frame_counter >= _animation_time)
+        _frame_counter %= _animation_time;
     // If the frame time has expired, update the frame index and counter.
     while(_frame_counter >= _frames[_frame_index].frame_time) {
         ms_change = _frame_counter - _frames[_frame_index].frame_time;
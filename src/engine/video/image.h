@@ -395,12 +395,13 @@ public:
 
     /** \brief Saves the image to a file
     *** \param filename The filename of the image to save (should have a .png or .jpg extension)
+    *** \param downscale_factor The image is shrunk by this factor when greater than 1, e.g. to save thumbnails.
     *** \return True if the image was successfully saved to a file
     ***
     *** \note The image being saved should contain only one image element. Support for saving of
     *** composite (multi-element) images is not yet supported
     **/
-    bool Save(const std::string &filename) const;
+    bool Save(const std::string &filename, uint32 downscale_factor = 1) const;
 
     //! \brief Enables grayscaling for the image then reloads it
     void EnableGrayScale();
@@ -70,6 +70,10 @@ bool ImageMemory::LoadImage(const std::string &filename)
         pixels = NULL;
     }
 
+    // Use the image data decoded in advance, if any
+    if(TextureManager->_TakePreloadedImage(filename, *this))
+        return true;
+
     SDL_Surface *temp_surf = NULL;
     SDL_Surface *alpha_surf = NULL;
 
@@ -147,6 +151,70 @@ bool ImageMemory::LoadImage(const std::string &filename)
 
 
 
+bool ImageMemory::DecodeImage(const std::string &filename)
+{
+    if(pixels != NULL) {
+        IF_PRINT_WARNING(VIDEO_DEBUG) << "pixels member was not NULL upon function invocation" << std::endl;
+        free(pixels);
+        pixels = NULL;
+    }
+
+    SDL_Surface *temp_surf = IMG_Load(filename.c_str());
+    if(temp_surf == NULL) {
+        PRINT_ERROR << "Couldn't load image file: " << filename << std::endl;
+        return false;
+    }
+
+    // The display format is only known by the main thread, so convert the image
+    // to a surface whose bytes are already ordered as RGBA.
+#if SDL_BYTEORDER == SDL_BIG_ENDIAN
+    SDL_Surface *format_surf = SDL_CreateRGBSurface(SDL_SWSURFACE, 1, 1, 32,
+                                                    0xFF000000, 0x00FF0000, 0x0000FF00, 0x000000FF);
+#else
+    SDL_Surface *format_surf = SDL_CreateRGBSurface(SDL_SWSURFACE, 1, 1, 32,
+                                                    0x000000FF, 0x0000FF00, 0x00FF0000, 0xFF000000);
+#endif
+    SDL_Surface *rgba_surf = NULL;
+    if(format_surf != NULL) {
+        rgba_surf = SDL_ConvertSurface(temp_surf, format_surf->format, SDL_SWSURFACE);
+        SDL_FreeSurface(format_surf);
+    }
+    SDL_FreeSurface(temp_surf);
+
+    if(rgba_surf == NULL) {
+        PRINT_ERROR << "Couldn't convert image file: " << filename << std::endl;
+        return false;
+    }
+
+    width = rgba_surf->w;
+    height = rgba_surf->h;
+    pixels = malloc(width * height * 4);
+    rgb_format = false;
+    if(pixels == NULL) {
+        SDL_FreeSurface(rgba_surf);
+        return false;
+    }
+
+    for(uint32 y = 0; y < height; ++y) {
+        uint8 *dst_pixel = static_cast<uint8 *>(pixels) + y * width * 4;
+        memcpy(dst_pixel, static_cast<uint8 *>(rgba_surf->pixels) + y * rgba_surf->pitch, width * 4);
+
+        // GL_LINEAR white artifact removal, as done in LoadImage()
+        for(uint32 x = 0; x < width; ++x, dst_pixel += 4) {
+            if(dst_pixel[3] == 0) {
+                dst_pixel[0] = 0;
+                dst_pixel[1] = 0;
+                dst_pixel[2] = 0;
+            }
+        }
+    }
+
+    SDL_FreeSurface(rgba_surf);
+    return true;
+}
+
+
+
 bool ImageMemory::SaveImage(const std::string &filename, bool png_image)
 {
     if(pixels == NULL) {
@@ -228,6 +296,67 @@ void ImageMemory::RGBAToRGB()
 
 
 
+void ImageMemory::FlipVertically()
+{
+    if(pixels == NULL) {
+        IF_PRINT_WARNING(VIDEO_DEBUG) << "no image data (pixels == NULL)" << std::endl;
+        return;
+    }
+
+    uint32 bytes_per_row = width * (rgb_format ? 3 : 4);
+    std::vector<uint8> row(bytes_per_row);
+    uint8 *data = static_cast<uint8 *>(pixels);
+    for(uint32 i = 0; i < height / 2; ++i) {
+        uint8 *top = data + i * bytes_per_row;
+        uint8 *bottom = data + (height - i - 1) * bytes_per_row;
+        memcpy(&row[0], top, bytes_per_row);
+        memcpy(top, bottom, bytes_per_row);
+        memcpy(bottom, &row[0], bytes_per_row);
+    }
+}
+
+
+
+void ImageMemory::Downscale(uint32 factor)
+{
+    if(pixels == NULL) {
+        IF_PRINT_WARNING(VIDEO_DEBUG) << "no image data (pixels == NULL)" << std::endl;
+        return;
+    }
+
+    if(factor <= 1 || width < factor || height < factor)
+        return;
+
+    uint32 channels = rgb_format ? 3 : 4;
+    uint32 new_width = width / factor;
+    uint32 new_height = height / factor;
+    uint8 *source = static_cast<uint8 *>(pixels);
+    // The result is written over the source, which is always read ahead of it.
+    uint8 *destination = source;
+
+    for(uint32 y = 0; y < new_height; ++y) {
+        for(uint32 x = 0; x < new_width; ++x) {
+            for(uint32 c = 0; c < channels; ++c) {
+                uint32 sum = 0;
+                for(uint32 j = 0; j < factor; ++j) {
+                    const uint8 *block_row = source + ((y * factor + j) * width + x * factor) * channels + c;
+                    for(uint32 i = 0; i < factor; ++i)
+                        sum += block_row[i * channels];
+                }
+                destination[(y * new_width + x) * channels + c] = static_cast<uint8>(sum / (factor * factor));
+            }
+        }
+    }
+
+    width = new_width;
+    height = new_height;
+    void *new_pixels = realloc(pixels, width * height * channels);
+    if(new_pixels != NULL)
+        pixels = new_pixels;
+}
+
+
+
 void ImageMemory::CopyFromTexture(TexSheet *texture)
 {
     if(pixels != NULL)
@@ -88,6 +88,13 @@ public:
     **/
     bool LoadImage(const std::string &filename);
 
+    /** \brief Decodes an image file into 32 bit RGBA data, without using the display format
+    *** \param filename The filename of the image to decode
+    *** \return True if the image was decoded successfully, false if it was not
+    *** \note Unlike LoadImage(), this function can be called from another thread than the main one.
+    **/
+    bool DecodeImage(const std::string &filename);
+
     /** \brief Saves raw image data to a file
     *** \param file_name The full filename of the image to load
     *** \param png_image Set to true if this is a PNG image, or false if it is a JPG image
@@ -111,6 +118,14 @@ public:
     **/
     void RGBAToRGB();
 
+    //! \brief Vertically flips the image data
+    void FlipVertically();
+
+    /** \brief Shrinks the image data by an integer factor, averaging the pixels of each block
+    *** \param factor The number of source pixels per result pixel, in each direction
+    **/
+    void Downscale(uint32 factor);
+
     /** \brief Set the class members by making a copy of a texture sheet
     *** \param texture A pointer to the TexSheet to be copied
     ***
@@ -77,9 +77,9 @@ bool ParticleSystem::Draw()
         VideoManager->EnableBlending();
 
         if(_system_def->blend_mode == VIDEO_BLEND)
-            glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+            VideoManager->SetBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
         else
-            glBlendFunc(GL_SRC_ALPHA, GL_ONE); // additive
+            VideoManager->SetBlendFunc(GL_SRC_ALPHA, GL_ONE); // additive
     }
 
 
@@ -113,12 +113,11 @@ bool ParticleSystem::Draw()
 
     VideoManager->EnableTexture2D();
 
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-
     StillImage *id = _animation.GetFrame(_animation.GetCurrentFrameIndex());
     private_video::ImageTexture *img = id->_image_texture;
     TextureManager->_BindTexture(img->texture_sheet->tex_id);
+    // Only changes the texture filtering when the sheet isn't smoothed already
+    img->texture_sheet->Smooth(true);
 
 
     float frame_progress = _animation.GetPercentProgress();
@@ -878,14 +878,13 @@ void TextSupervisor::_DrawTextHelper(const uint16 *const text, FontProperties *f
         return;
     }
 
-    glBlendFunc(GL_ONE, GL_ONE);
     VideoManager->EnableBlending();
 
     CoordSys &cs = VideoManager->_current_context.coordinate_system;
 
     _CacheGlyphs(text, fp);
 
-    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+    VideoManager->SetBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
     VideoManager->EnableTexture2D();
 
     glPushMatrix();
@@ -903,6 +902,8 @@ void TextSupervisor::_DrawTextHelper(const uint16 *const text, FontProperties *f
 
     VideoManager->EnableVertexArray();
     VideoManager->EnableTextureCoordArray();
+    VideoManager->DisableColorArray();
+    VideoManager->SetColor(text_color);
 
     GLint vertices[8];
     GLfloat tex_coords[8];
@@ -930,10 +931,6 @@ void TextSupervisor::_DrawTextHelper(const uint16 *const text, FontProperties *f
         ty = glyph_info->max_y;
 
         TextureManager->_BindTexture(glyph_info->texture);
-        if(VideoManager->CheckGLError()) {
-            IF_PRINT_WARNING(VIDEO_DEBUG) << "OpenGL error detected: " << VideoManager->CreateGLErrorString() << std::endl;
-            return;
-        }
 
         vertices[0] = min_x;
         vertices[1] = min_y;
@@ -952,12 +949,17 @@ void TextSupervisor::_DrawTextHelper(const uint16 *const text, FontProperties *f
         tex_coords[6] = 0.0f;
         tex_coords[7] = 0.0f;
 
-        glColor4fv((GLfloat *)&text_color);
         glDrawArrays(GL_QUADS, 0, 4);
 
         xpos += glyph_info->advance;
     } // for (const uint16* glyph = text; *glyph != 0; glyph++)
 
+    // Check for errors once per string rather than once per glyph,
+    // as glGetError() stalls the rendering pipeline.
+    if(VideoManager->CheckGLError()) {
+        IF_PRINT_WARNING(VIDEO_DEBUG) << "OpenGL error detected: " << VideoManager->CreateGLErrorString() << std::endl;
+    }
+
     glPopMatrix();
 } // void TextSupervisor::_DrawTextHelper(const uint16* const text, FontProperties* fp, Color color)
 
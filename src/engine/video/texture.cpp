@@ -156,7 +156,8 @@ bool TexSheet::CopyScreenRect(int32 x, int32 y, const ScreenRect &screen_rect)
 
 void TexSheet::Smooth(bool flag)
 {
-    // If setting has changed, set the appropriate filtering
+    // If setting has changed, set the appropriate filtering.
+    // This is called on every draw, so the texture filtering state is cached in the smoothed member.
     if(smoothed != flag) {
         smoothed = flag;
         GLenum filtering_type = smoothed ? GL_LINEAR : GL_NEAREST;
@@ -41,6 +41,8 @@ TextureController::TextureController() :
 
 TextureController::~TextureController()
 {
+    ClearPreloadedImages();
+
     IF_PRINT_DEBUG(VIDEO_DEBUG) << "Deleting all remaining ImageTextures, a total of: " << _images.size() << std::endl;
 
     // Invoking the ImageTexture destructor will erase the entry in the _images map that corresponds to that object
@@ -304,11 +306,42 @@ GLuint TextureController::_CreateBlankGLTexture(int32 width, int32 height)
 
 
 
+void TextureController::AddPreloadedImage(const std::string &filename, ImageMemory &image)
+{
+    // The image elements are registered under the filename followed by their tags.
+    std::map<std::string, ImageTexture *>::const_iterator it = _images.lower_bound(filename);
+    bool already_loaded = (it != _images.end() && it->first.compare(0, filename.size(), filename) == 0);
+
+    if(already_loaded || _preloaded_images.find(filename) != _preloaded_images.end()) {
+        free(image.pixels);
+        image.pixels = NULL;
+        return;
+    }
+
+    _preloaded_images[filename] = image;
+    image.pixels = NULL;
+}
+
+
+
+void TextureController::ClearPreloadedImages()
+{
+    for(std::map<std::string, ImageMemory>::iterator it = _preloaded_images.begin(); it != _preloaded_images.end(); ++it) {
+        free(it->second.pixels);
+        it->second.pixels = NULL;
+    }
+    _preloaded_images.clear();
+}
+
+
+
 void TextureController::_BindTexture(GLuint tex_id)
 {
     // Return if this texture ID is already bound
-    if(tex_id == _last_tex_id)
+    if(tex_id == _last_tex_id) {
+        ++VideoManager->_gl_avoided_state_changes;
         return;
+    }
 
     _last_tex_id = tex_id;
     glBindTexture(GL_TEXTURE_2D, tex_id);
@@ -649,6 +682,20 @@ void TextureController::_UnregisterImageTexture(ImageTexture *img)
 
 
 
+bool TextureController::_TakePreloadedImage(const std::string &filename, ImageMemory &image)
+{
+    std::map<std::string, ImageMemory>::iterator it = _preloaded_images.find(filename);
+    if(it == _preloaded_images.end())
+        return false;
+
+    image = it->second;
+    it->second.pixels = NULL;
+    _preloaded_images.erase(it);
+    return true;
+}
+
+
+
 void TextureController::_RegisterTextTexture(TextTexture *tex)
 {
     if(tex == NULL) {
@@ -100,6 +100,16 @@ public:
     **/
     void DEBUG_ShowTexSheet();
 
+    /** \brief Keeps decoded image data, so that the next load of the image file doesn't read it again
+    *** \param filename The image file the data was decoded from
+    *** \param image The decoded image data, whose pixels are now owned by the texture controller.
+    *** \note The data is freed at once when the image is already in texture memory.
+    **/
+    void AddPreloadedImage(const std::string &filename, private_video::ImageMemory &image);
+
+    //! \brief Frees the decoded image data that hasn't been used
+    void ClearPreloadedImages();
+
     //! \brief An index to _tex_sheets of the current texture sheet being shown in debug mode. -1 indicates no sheet
     int32 debug_current_sheet;
 
@@ -121,6 +131,9 @@ private:
     //! \brief Keeps track of the number of texture switches per frame
     uint32 _debug_num_tex_switches;
 
+    //! \brief The image data decoded in advance, indexed by image filename
+    std::map<std::string, private_video::ImageMemory> _preloaded_images;
+
     // ---------- Private methods
 
     //! \name Texture Operations
@@ -222,6 +235,13 @@ private:
         if(_IsImageTextureRegistered(nametag) == true) return _images[nametag];
         else return NULL;
     }
+
+    /** \brief Hands over the image data decoded in advance for the given file
+    *** \param filename The image filename
+    *** \param image Set to the decoded data, which is removed from the preloaded images
+    *** \return True if decoded data was available for this file
+    **/
+    bool _TakePreloadedImage(const std::string &filename, private_video::ImageMemory &image);
     //@}
 
     //! \name Text Texture Operations
@@ -26,6 +26,10 @@
 #include "engine/mode_manager.h"
 #endif
 
+#ifdef HEADLESS_SUPPORT
+#include <GL/osmesa.h>
+#endif
+
 using namespace vt_utils;
 using namespace vt_video::private_video;
 
@@ -83,6 +87,11 @@ VideoEngine::VideoEngine():
     _gl_vertex_array_is_activated(false),
     _gl_color_array_is_activated(false),
     _gl_texture_coord_array_is_activated(false),
+    _gl_blend_source_factor(GL_ONE),
+    _gl_blend_destination_factor(GL_ZERO),
+    _gl_color_is_known(false),
+    _gl_avoided_state_changes(0),
+    _gl_avoided_state_changes_last_frame(0),
     _target(VIDEO_TARGET_SDL_WINDOW),
     _screen_width(0),
     _screen_height(0),
@@ -97,7 +106,14 @@ VideoEngine::VideoEngine():
     _temp_width(0),
     _temp_height(0),
     _smooth_pixel_art(true),
-    _initialized(false)
+    _temp_vsync(true),
+    _vsync_active(false),
+    _light_map_width(0),
+    _light_map_height(0),
+    _light_map_ready(false),
+    _initialized(false),
+    _offscreen_context(NULL),
+    _offscreen_buffer(NULL)
 {
     _current_context.blend = 0;
     _current_context.x_align = -1;
@@ -121,7 +137,7 @@ void VideoEngine::DrawFPS()
     if(!_fps_display)
         return;
 
-    uint32 frame_time = vt_system::SystemManager->GetUpdateTime();
+    uint32 frame_time = vt_system::SystemManager->GetFrameTime();
     SetDrawFlags(VIDEO_X_LEFT, VIDEO_Y_BOTTOM, VIDEO_X_NOFLIP, VIDEO_Y_NOFLIP, VIDEO_BLEND, 0);
 
     // Calculate the FPS for the current frame
@@ -172,6 +188,14 @@ void VideoEngine::DrawFPS()
     Move(930.0f, 720.0f); // Upper right hand corner of the screen
     Text()->Draw(fps_text, TextStyle("text20", Color::white));
 
+    // Also show how many redundant GL state changes were skipped during the last frame
+    if(_debug_info) {
+        char state_text[48];
+        sprintf(state_text, "GL calls avoided: %u", _gl_avoided_state_changes_last_frame);
+        Move(780.0f, 700.0f);
+        Text()->Draw(state_text, TextStyle("text20", Color::white));
+    }
+
 } // void GUISystem::_DrawFPS(uint32 frame_time)
 
 
@@ -181,8 +205,15 @@ VideoEngine::~VideoEngine()
 
     _default_menu_cursor.Clear();
     _rectangle_image.Clear();
+    _light_map.Clear();
 
     TextureManager->SingletonDestroy();
+
+#ifdef HEADLESS_SUPPORT
+    if(_offscreen_context)
+        OSMesaDestroyContext(static_cast<OSMesaContext>(_offscreen_context));
+#endif
+    delete[] _offscreen_buffer;
 }
 
 
@@ -193,13 +224,17 @@ bool VideoEngine::SingletonInitialize()
     if(_initialized)
         return true;
 
+    // Without a window, SDL is still needed for the events and the timers.
+    if(IsHeadless()) {
+        static char dummy_driver[] = "SDL_VIDEODRIVER=dummy";
+        SDL_putenv(dummy_driver);
+    }
+
     if(SDL_InitSubSystem(SDL_INIT_VIDEO) < 0) {
         PRINT_ERROR << "SDL video initialization failed" << std::endl;
         return false;
     }
 
-
-
     return true;
 } // bool VideoEngine::SingletonInitialize()
 
@@ -241,6 +276,12 @@ bool VideoEngine::FinalizeInitialization()
 
 void VideoEngine::SetInitialResolution(int32 width, int32 height)
 {
+    // There is no screen to fit in when rendering offscreen.
+    if(IsHeadless()) {
+        SetResolution(width, height);
+        return;
+    }
+
     // Get the current system color depth and resolution
     const SDL_VideoInfo *video_info(0);
     video_info = SDL_GetVideoInfo();
@@ -357,6 +398,8 @@ void VideoEngine::Clear(const Color &c)
     glClear(GL_COLOR_BUFFER_BIT);
 
     TextureManager->_debug_num_tex_switches = 0;
+    _gl_avoided_state_changes_last_frame = _gl_avoided_state_changes;
+    _gl_avoided_state_changes = 0;
 }
 
 
@@ -421,6 +464,9 @@ bool VideoEngine::ApplySettings()
             flags |= SDL_FULLSCREEN;
         }
 
+        // The benchmark mode never waits for the screen refresh.
+        bool vsync = _temp_vsync && !(vt_system::SystemManager && vt_system::SystemManager->IsBenchmarkMode());
+
         SDL_GL_SetAttribute(SDL_GL_RED_SIZE, 8);
         SDL_GL_SetAttribute(SDL_GL_GREEN_SIZE, 8);
         SDL_GL_SetAttribute(SDL_GL_BLUE_SIZE, 8);
@@ -429,7 +475,7 @@ bool VideoEngine::ApplySettings()
         SDL_GL_SetAttribute(SDL_GL_DOUBLEBUFFER, 1);
         SDL_GL_SetAttribute(SDL_GL_MULTISAMPLEBUFFERS, 2);
         SDL_GL_SetAttribute(SDL_GL_MULTISAMPLESAMPLES, 4);
-        SDL_GL_SetAttribute(SDL_GL_SWAP_CONTROL, 1);
+        SDL_GL_SetAttribute(SDL_GL_SWAP_CONTROL, vsync ? 1 : 0);
 
         if(SDL_SetVideoMode(_temp_width, _temp_height, 0, flags) == false) {
             // RGB values of 1 for each and 8 for depth seemed to be sufficient.
@@ -442,7 +488,7 @@ bool VideoEngine::ApplySettings()
             SDL_GL_SetAttribute(SDL_GL_ALPHA_SIZE, 0);
             SDL_GL_SetAttribute(SDL_GL_MULTISAMPLEBUFFERS, 0);
             SDL_GL_SetAttribute(SDL_GL_MULTISAMPLESAMPLES, 0);
-            SDL_GL_SetAttribute(SDL_GL_SWAP_CONTROL, 1);
+            SDL_GL_SetAttribute(SDL_GL_SWAP_CONTROL, vsync ? 1 : 0);
 
             if(SDL_SetVideoMode(_temp_width, _temp_height, 0, flags) == false) {
                 IF_PRINT_WARNING(VIDEO_DEBUG) << "SDL_SetVideoMode() failed with error: " << SDL_GetError() << std::endl;
@@ -458,18 +504,14 @@ bool VideoEngine::ApplySettings()
             }
         }
 
+        // Check whether the driver honors the swap control request,
+        // as the main loop needs to pace the frames itself otherwise.
+        int swap_control = 0;
+        _vsync_active = vsync && SDL_GL_GetAttribute(SDL_GL_SWAP_CONTROL, &swap_control) == 0
+                        && swap_control == 1;
+
         // Clear GL state, after SDL_SetVideoMode() for OSX compatibility
-        DisableBlending();
-        DisableTexture2D();
-        DisableAlphaTest();
-        DisableStencilTest();
-        DisableScissoring();
-        DisableVertexArray();
-        DisableColorArray();
-        DisableTextureCoordArray();
-
-        // Turn off writing to the depth buffer
-        glDepthMask(GL_FALSE);
+        _InitializeGLState();
 
         _screen_width = _temp_width;
         _screen_height = _temp_height;
@@ -490,9 +532,82 @@ bool VideoEngine::ApplySettings()
         return true;
     }
 
+    // Used by the benchmarks, without any window
+    else if(IsHeadless()) {
+        if(!_ApplyOffscreenSettings()) {
+            _temp_width = _screen_width;
+            _temp_height = _screen_height;
+            return false;
+        }
+
+        _screen_width = _temp_width;
+        _screen_height = _temp_height;
+        _fullscreen = false;
+        _temp_fullscreen = false;
+        return true;
+    }
+
     return false;
 } // bool VideoEngine::ApplySettings()
 
+bool VideoEngine::_ApplyOffscreenSettings()
+{
+#ifdef HEADLESS_SUPPORT
+    // The context survives resolution changes, so the textures don't need to be reloaded.
+    if(!_offscreen_context) {
+        _offscreen_context = OSMesaCreateContextExt(OSMESA_RGBA, 16, 8, 0, NULL);
+        if(!_offscreen_context) {
+            PRINT_ERROR << "could not create the offscreen rendering context" << std::endl;
+            return false;
+        }
+    }
+
+    int32 buffer_width = (_target == VIDEO_TARGET_NULL) ? 1 : _temp_width;
+    int32 buffer_height = (_target == VIDEO_TARGET_NULL) ? 1 : _temp_height;
+
+    delete[] _offscreen_buffer;
+    _offscreen_buffer = new uint8[buffer_width * buffer_height * 4];
+
+    if(!OSMesaMakeCurrent(static_cast<OSMesaContext>(_offscreen_context), _offscreen_buffer,
+                          GL_UNSIGNED_BYTE, buffer_width, buffer_height)) {
+        PRINT_ERROR << "could not make the offscreen rendering context current" << std::endl;
+        return false;
+    }
+
+    // Nothing to synchronize with.
+    _vsync_active = false;
+    _InitializeGLState();
+    return true;
+#else
+    PRINT_ERROR << "offscreen rendering isn't available: the game was built without the HEADLESS_SUPPORT option" << std::endl;
+    return false;
+#endif
+}
+
+void VideoEngine::_InitializeGLState()
+{
+    _ResetGLStateCache();
+    DisableBlending();
+    DisableTexture2D();
+    DisableAlphaTest();
+    DisableStencilTest();
+    DisableScissoring();
+    DisableVertexArray();
+    DisableColorArray();
+    DisableTextureCoordArray();
+
+    // Turn off writing to the depth buffer
+    glDepthMask(GL_FALSE);
+}
+
+void VideoEngine::SwapBuffers()
+{
+    if(_target == VIDEO_TARGET_SDL_WINDOW)
+        SDL_GL_SwapBuffers();
+    else if(IsHeadless())
+        glFinish();
+}
+
 //-----------------------------------------------------------------------------
 // VideoEngine class - Coordinate system and viewport methods
 //-----------------------------------------------------------------------------
@@ -537,6 +652,8 @@ void VideoEngine::EnableAlphaTest()
     if(!_gl_alpha_test_is_active) {
         glEnable(GL_ALPHA_TEST);
         _gl_alpha_test_is_active = true;
+    } else {
+        ++_gl_avoided_state_changes;
     }
 }
 
@@ -545,6 +662,8 @@ void VideoEngine::DisableAlphaTest()
     if(_gl_alpha_test_is_active) {
         glDisable(GL_ALPHA_TEST);
         _gl_alpha_test_is_active = false;
+    } else {
+        ++_gl_avoided_state_changes;
     }
 }
 
@@ -553,6 +672,8 @@ void VideoEngine::EnableBlending()
     if(!_gl_blend_is_active) {
         glEnable(GL_BLEND);
         _gl_blend_is_active = true;
+    } else {
+        ++_gl_avoided_state_changes;
     }
 }
 
@@ -561,6 +682,8 @@ void VideoEngine::DisableBlending()
     if(_gl_blend_is_active) {
         glDisable(GL_BLEND);
         _gl_blend_is_active = false;
+    } else {
+        ++_gl_avoided_state_changes;
     }
 }
 
@@ -569,6 +692,8 @@ void VideoEngine::EnableStencilTest()
     if(!_gl_stencil_test_is_active) {
         glEnable(GL_STENCIL_TEST);
         _gl_stencil_test_is_active = true;
+    } else {
+        ++_gl_avoided_state_changes;
     }
 }
 
@@ -577,6 +702,8 @@ void VideoEngine::DisableStencilTest()
     if(_gl_stencil_test_is_active) {
         glDisable(GL_STENCIL_TEST);
         _gl_stencil_test_is_active = false;
+    } else {
+        ++_gl_avoided_state_changes;
     }
 }
 
@@ -585,6 +712,8 @@ void VideoEngine::EnableTexture2D()
     if(!_gl_texture_2d_is_active) {
         glEnable(GL_TEXTURE_2D);
         _gl_texture_2d_is_active = true;
+    } else {
+        ++_gl_avoided_state_changes;
     }
 }
 
@@ -593,6 +722,8 @@ void VideoEngine::DisableTexture2D()
     if(_gl_texture_2d_is_active) {
         glDisable(GL_TEXTURE_2D);
         _gl_texture_2d_is_active = false;
+    } else {
+        ++_gl_avoided_state_changes;
     }
 }
 
@@ -601,6 +732,8 @@ void VideoEngine::EnableColorArray()
     if(!_gl_color_array_is_activated) {
         glEnableClientState(GL_COLOR_ARRAY);
         _gl_color_array_is_activated = true;
+    } else {
+        ++_gl_avoided_state_changes;
     }
 }
 
@@ -609,6 +742,10 @@ void VideoEngine::DisableColorArray()
     if(_gl_color_array_is_activated) {
         glDisableClientState(GL_COLOR_ARRAY);
         _gl_color_array_is_activated = false;
+        // The current color is undefined after drawing with a color array.
+        _gl_color_is_known = false;
+    } else {
+        ++_gl_avoided_state_changes;
     }
 }
 
@@ -617,6 +754,8 @@ void VideoEngine::EnableVertexArray()
     if(!_gl_vertex_array_is_activated) {
         glEnableClientState(GL_VERTEX_ARRAY);
         _gl_vertex_array_is_activated = true;
+    } else {
+        ++_gl_avoided_state_changes;
     }
 }
 
@@ -625,6 +764,8 @@ void VideoEngine::DisableVertexArray()
     if(_gl_vertex_array_is_activated) {
         glDisableClientState(GL_VERTEX_ARRAY);
         _gl_vertex_array_is_activated = false;
+    } else {
+        ++_gl_avoided_state_changes;
     }
 }
 
@@ -633,6 +774,8 @@ void VideoEngine::EnableTextureCoordArray()
     if(!_gl_texture_coord_array_is_activated) {
         glEnableClientState(GL_TEXTURE_COORD_ARRAY);
         _gl_texture_coord_array_is_activated = true;
+    } else {
+        ++_gl_avoided_state_changes;
     }
 }
 
@@ -641,7 +784,45 @@ void VideoEngine::DisableTextureCoordArray()
     if(_gl_texture_coord_array_is_activated) {
         glDisableClientState(GL_TEXTURE_COORD_ARRAY);
         _gl_texture_coord_array_is_activated = false;
+    } else {
+        ++_gl_avoided_state_changes;
+    }
+}
+
+void VideoEngine::SetBlendFunc(GLenum source_factor, GLenum destination_factor)
+{
+    if(source_factor == _gl_blend_source_factor && destination_factor == _gl_blend_destination_factor) {
+        ++_gl_avoided_state_changes;
+        return;
+    }
+
+    glBlendFunc(source_factor, destination_factor);
+    _gl_blend_source_factor = source_factor;
+    _gl_blend_destination_factor = destination_factor;
+}
+
+void VideoEngine::SetColor(const Color &color)
+{
+    if(_gl_color_is_known && _gl_current_color == color) {
+        ++_gl_avoided_state_changes;
+        return;
     }
+
+    glColor4fv((GLfloat *)color.GetColors());
+    _gl_current_color = color;
+    _gl_color_is_known = true;
+}
+
+void VideoEngine::_ResetGLStateCache()
+{
+    // A new GL context starts with the default blending function and an unknown color.
+    _gl_blend_source_factor = GL_ONE;
+    _gl_blend_destination_factor = GL_ZERO;
+    _gl_color_is_known = false;
+
+    // Force the next glBindTexture() call
+    if(TextureManager)
+        TextureManager->_last_tex_id = INVALID_TEXTURE_ID;
 }
 
 void VideoEngine::SetScissorRect(float left, float right, float bottom, float top)
@@ -1088,7 +1269,7 @@ void VideoEngine::DrawLine(float x1, float y1, float x2, float y2, float width,
     };
     EnableBlending();
     DisableTexture2D();
-    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA); // Normal blending
+    SetBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA); // Normal blending
     glPushAttrib(GL_LINE_WIDTH);
 
     float pixel_width, pixel_height;
@@ -1097,10 +1278,12 @@ void VideoEngine::DrawLine(float x1, float y1, float x2, float y2, float width,
     EnableVertexArray();
     DisableColorArray();
     DisableTextureCoordArray();
-    glColor4fv((GLfloat *)color.GetColors());
+    SetColor(color);
     glVertexPointer(2, GL_FLOAT, 0, vert_coords);
     glDrawArrays(GL_LINES, 0, 2);
     glPopAttrib(); // GL_LINE_WIDTH
+    // The attribute mask above includes GL_CURRENT_BIT, so the current color was restored as well.
+    _gl_color_is_known = false;
 }
 
 void VideoEngine::DrawGrid(float x, float y, float x_step, float y_step, const Color &c)
@@ -1128,8 +1311,9 @@ void VideoEngine::DrawGrid(float x, float y, float x_step, float y_step, const C
         vertices.push_back(y);
         num_vertices += 2;
     }
-    glColor4fv(&c[0]);
     DisableTexture2D();
+    DisableColorArray();
+    SetColor(c);
     EnableVertexArray();
     glVertexPointer(2, GL_FLOAT, 0, &(vertices[0]));
     glDrawArrays(GL_LINES, 0, num_vertices);
@@ -1164,4 +1348,92 @@ void VideoEngine::DrawHalo(const ImageDescriptor &id, const Color &color)
     //PopMatrix();
 }
 
+bool VideoEngine::BeginLightMap()
+{
+    _light_map_ready = false;
+
+    int32 width = _screen_width / LIGHT_MAP_SCALE_FACTOR;
+    int32 height = _screen_height / LIGHT_MAP_SCALE_FACTOR;
+    if(width <= 0 || height <= 0)
+        return false;
+
+    // The light map follows the screen resolution changes.
+    if(width != _light_map_width || height != _light_map_height) {
+        _light_map.Clear();
+        _light_map_width = 0;
+        _light_map_height = 0;
+        if(!_CreateLightMap(width, height))
+            return false;
+    }
+
+    // Render into the bottom left corner of the back buffer, which only holds the clear color yet.
+    PushState();
+    _current_context.viewport = ScreenRect(0, 0, _light_map_width, _light_map_height);
+    glViewport(0, 0, _light_map_width, _light_map_height);
+    return true;
+}
+
+void VideoEngine::EndLightMap()
+{
+    ScreenRect screen_rect(0, _light_map_height, _light_map_width, _light_map_height);
+    _light_map_ready = _light_map._image_texture->texture_sheet->CopyScreenRect(0, 0, screen_rect);
+
+    // Clears the accumulated halos away, using the current frame clear color.
+    glClear(GL_COLOR_BUFFER_BIT);
+    PopState();
+}
+
+void VideoEngine::DrawLightMap()
+{
+    if(!_light_map_ready)
+        return;
+
+    PushState();
+    SetStandardCoordSys();
+    SetDrawFlags(VIDEO_X_LEFT, VIDEO_Y_BOTTOM, VIDEO_X_NOFLIP, VIDEO_Y_NOFLIP, 0);
+    Move(0.0f, VIDEO_STANDARD_RES_HEIGHT);
+    // The halos were already blended over black, so the light map is simply added to the screen.
+    _current_context.blend = VIDEO_BLEND_ADD;
+    _light_map.Draw();
+    PopState();
+
+    _light_map_ready = false;
+}
+
+bool VideoEngine::_CreateLightMap(int32 width, int32 height)
+{
+    // Static variable used to make sure the light map has a unique name in the texture image map
+    static uint32 light_map_id = 0;
+
+    ImageTexture *new_image = new ImageTexture("light_map" + NumberToString(light_map_id++), "<T>", width, height);
+    new_image->AddReference();
+
+    TexSheet *temp_sheet = TextureManager->_CreateTexSheet(RoundUpPow2(width), RoundUpPow2(height), VIDEO_TEXSHEET_ANY, false);
+    VariableTexSheet *sheet = dynamic_cast<VariableTexSheet *>(temp_sheet);
+    if(sheet == NULL) {
+        IF_PRINT_WARNING(VIDEO_DEBUG) << "could not create the light map texture sheet" << std::endl;
+        delete new_image;
+        return false;
+    }
+    if(sheet->InsertTexture(new_image) == false) {
+        IF_PRINT_WARNING(VIDEO_DEBUG) << "could not insert the light map into its texture sheet" << std::endl;
+        TextureManager->_RemoveSheet(sheet);
+        delete new_image;
+        return false;
+    }
+
+    // The image is stretched over the whole screen, with the copied pixels upside down.
+    _light_map.SetDimensions(VIDEO_STANDARD_RES_WIDTH, VIDEO_STANDARD_RES_HEIGHT);
+    _light_map._image_texture = new_image;
+    _light_map._texture = new_image;
+
+    float temp = new_image->v1;
+    new_image->v1 = new_image->v2;
+    new_image->v2 = temp;
+
+    _light_map_width = width;
+    _light_map_height = height;
+    return true;
+}
+
 }  // namespace vt_video
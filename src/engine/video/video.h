@@ -100,6 +100,9 @@ namespace private_video
 //! \brief The number of FPS samples to retain across frames
 const uint32 FPS_SAMPLES = 250;
 
+//! \brief The light map width and height are the screen ones divided by this factor.
+const int32 LIGHT_MAP_SCALE_FACTOR = 4;
+
 //! \brief Maximum milliseconds that the current frame time and our averaged frame time must vary before we begin trying to catch up
 const uint32 MAX_FTIME_DIFF = 5;
 
@@ -158,7 +161,15 @@ enum VIDEO_TARGET {
     //! Represents a QT widget
     VIDEO_TARGET_QT_WIDGET  = 1,
 
-    VIDEO_TARGET_TOTAL = 2
+    //! Represents an offscreen buffer, without any window (needs the HEADLESS_SUPPORT build option)
+    VIDEO_TARGET_OFFSCREEN  = 2,
+
+    /** Represents an offscreen buffer of a single pixel (needs the HEADLESS_SUPPORT build option)
+    *** All the draw calls are still issued and processed, but nearly nothing gets rasterized.
+    **/
+    VIDEO_TARGET_NULL       = 3,
+
+    VIDEO_TARGET_TOTAL = 4
 };
 
 //! \brief The standard screen resolution
@@ -227,6 +238,17 @@ public:
     **/
     void SetTarget(VIDEO_TARGET target);
 
+    //! \brief Returns true if the video engine renders without any window.
+    bool IsHeadless() const {
+        return (_target == VIDEO_TARGET_OFFSCREEN || _target == VIDEO_TARGET_NULL);
+    }
+
+    /** \brief Presents the frame once all the draw operations are done.
+    *** The buffers are swapped for a SDL window, while the offscreen targets wait
+    *** for the rendering to complete so that the frame time remains meaningful.
+    **/
+    void SwapBuffers();
+
     /** \brief Sets one to multiple flags which control drawing orientation (flip, align, blending, etc). Simply pass
     *** \param first_flag The first (and possibly only) draw flag to set
     *** \param ... Additional draw flags. The list must terminate with a 0.
@@ -258,11 +280,16 @@ public:
     *** \note This function only produces a meaningful result if the VIDEO_DEBUG variable is set to true. This is done
     *** because the call to glGetError() requires a round trip to the GPU and a flush of the rendering pipeline; a fairly
     *** expensive operation. If VIDEO_DEBUG is false, the function will always return false immediately.
+    *** \note In non-debug builds, the check is compiled out entirely and the function always returns false.
     **/
     bool CheckGLError() {
+#ifdef DEBUG
         if(VIDEO_DEBUG == false) return false;
         _gl_error_code = glGetError();
         return (_gl_error_code != GL_NO_ERROR);
+#else
+        return false;
+#endif
     }
 
     //! \brief Returns the value of the most recently fetched OpenGL error code
@@ -331,6 +358,25 @@ public:
         return _smooth_pixel_art;
     }
 
+    /** \brief Requests the buffer swaps to be synchronized with the screen refresh rate
+     *  \note  you must call ApplySettings() to actually apply the change
+     */
+    void SetVSync(bool vsync) {
+        _temp_vsync = vsync;
+    }
+
+    //! \brief Returns true if the vertical sync was requested in the settings.
+    bool IsVSyncRequested() const {
+        return _temp_vsync;
+    }
+
+    /** \brief Returns true if the buffer swaps are actually synchronized with the screen refresh rate
+    *** When it isn't the case, the main loop paces the frames itself.
+    **/
+    bool IsVSyncActive() const {
+        return _vsync_active;
+    }
+
     //! \brief Returns a reference to the current coordinate system
     const CoordSys &GetCoordSys() const {
         return _current_context.coordinate_system;
@@ -421,6 +467,25 @@ public:
     void EnableTextureCoordArray();
     void DisableTextureCoordArray();
 
+    /** \brief Sets the OpenGL blending function, but only if it differs from the current one.
+    *** \param source_factor The source blending factor (e.g.: GL_SRC_ALPHA)
+    *** \param destination_factor The destination blending factor (e.g.: GL_ONE_MINUS_SRC_ALPHA)
+    **/
+    void SetBlendFunc(GLenum source_factor, GLenum destination_factor);
+
+    /** \brief Sets the current OpenGL vertex color, but only if it differs from the current one.
+    *** \note The cached color is invalidated whenever the color array is disabled,
+    *** since drawing with a color array leaves the current color undefined.
+    **/
+    void SetColor(const Color &color);
+
+    /** \brief Returns the number of redundant OpenGL state changes that were avoided
+    *** during the last frame thanks to the state caches above.
+    **/
+    uint32 GetAvoidedStateChanges() const {
+        return _gl_avoided_state_changes_last_frame;
+    }
+
     /** \brief Enables the scissoring effect in the video engine
     *** Scisorring is where you can specify a rectangle of the screen which is affected
     *** by rendering operations (and hence, specify what area is not affected). Make sure
@@ -618,6 +683,26 @@ public:
      */
     void DrawHalo(const ImageDescriptor &id, const Color &color = Color::white);
 
+    /** \brief Starts accumulating the halos drawn into the light map.
+    *** \return false when the light map can't be used, in which case the halos should be drawn as usual.
+    ***
+    *** The halos drawn until EndLightMap() is called are rendered at a reduced resolution,
+    *** in a corner of the back buffer, so this must be called before anything else is drawn
+    *** in the frame. The light map is then added to the screen at once by DrawLightMap().
+    **/
+    bool BeginLightMap();
+
+    //! \brief Stores the halos drawn since BeginLightMap() into the light map, and clears the screen back.
+    void EndLightMap();
+
+    //! \brief Adds the light map accumulated this frame to the screen, if any.
+    void DrawLightMap();
+
+    //! \brief Tells whether a light map was accumulated this frame and wasn't drawn yet.
+    bool IsLightMapReady() const {
+        return _light_map_ready;
+    }
+
     //-- Fading ---------------------------------------------------------------
 
     //! \brief call after all map images are drawn to apply a fade effect.
@@ -820,6 +905,17 @@ private:
     bool _gl_color_array_is_activated;
     //! \brief Holds whether the GL_VERTEX_ARRAY state is activated. Used to optimize the drawing logic
     bool _gl_texture_coord_array_is_activated;
+    //! \brief Holds the current blending function factors. Used to optimize the drawing logic
+    GLenum _gl_blend_source_factor;
+    GLenum _gl_blend_destination_factor;
+    //! \brief Holds the current OpenGL vertex color. Only valid when _gl_color_is_known is true.
+    Color _gl_current_color;
+    bool _gl_color_is_known;
+
+    //! \brief The number of redundant OpenGL state changes avoided during the current frame
+    uint32 _gl_avoided_state_changes;
+    //! \brief The number of redundant OpenGL state changes avoided during the last frame
+    uint32 _gl_avoided_state_changes_last_frame;
 
     //! \brief The type of window target that the video manager will operate on (SDL window or QT widget)
     VIDEO_TARGET _target;
@@ -869,18 +965,39 @@ private:
     //! \brief Tells whether pixel art sprites should be smoothed.
     bool _smooth_pixel_art;
 
+    //! holds the desired vertical sync status. Not actually applied until ApplySettings() is called
+    bool _temp_vsync;
+
+    //! \brief Tells whether the driver actually honors the vertical sync.
+    bool _vsync_active;
+
     //! image which is to be used as the cursor
     StillImage _default_menu_cursor;
 
     //! Image used for rendering rectangles
     StillImage _rectangle_image;
 
+    //! \brief The texture the halos are accumulated into, once per frame.
+    StillImage _light_map;
+
+    //! \brief The light map size, in pixels.
+    int32 _light_map_width, _light_map_height;
+
+    //! \brief Whether the light map was accumulated this frame and wasn't drawn yet.
+    bool _light_map_ready;
+
     //! stack containing context, i.e. draw flags plus coord sys. Context is pushed and popped by any VideoEngine functions that clobber these settings
     std::stack<private_video::Context> _context_stack;
 
     //! check to see if the VideoManager has already been setup.
     bool _initialized;
 
+    //! \brief The offscreen rendering context (an OSMesaContext), or NULL.
+    void *_offscreen_context;
+
+    //! \brief The pixel buffer the offscreen context renders into.
+    uint8 *_offscreen_buffer;
+
     //-- Private methods ------------------------------------------------------
 
     /** \brief converts VIDEO_DRAW_LEFT or VIDEO_DRAW_RIGHT flags to a numerical offset
@@ -906,6 +1023,22 @@ private:
     * \return the converted value
     */
     int32 _ScreenCoordY(float y);
+
+    //! \brief Resets the state caches that can't be trusted anymore after a GL context change.
+    void _ResetGLStateCache();
+
+    //! \brief Sets the GL state the engine expects, once a new GL context is current.
+    void _InitializeGLState();
+
+    /** \brief Creates the light map texture, with the given size in pixels.
+    *** \return false if the texture couldn't be created.
+    **/
+    bool _CreateLightMap(int32 width, int32 height);
+
+    /** \brief Creates or resizes the offscreen rendering context.
+    *** \return False if the context couldn't be made current, or if the offscreen support isn't compiled in.
+    **/
+    bool _ApplyOffscreenSettings();
 }; // class VideoEngine : public vt_utils::Singleton<VideoEngine>
 
 }  // namespace vt_video
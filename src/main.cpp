@@ -32,11 +32,13 @@
 #include "engine/mode_manager.h"
 #include "engine/video/video.h"
 #include "engine/system.h"
+#include "engine/profiler.h"
 
 #include "common/global/global.h"
 #include "common/gui/gui.h"
 
 #include "modes/boot/boot.h"
+#include "modes/battle/battle_resources.h"
 #include "main_options.h"
 
 #ifdef __MACH__
@@ -90,8 +92,16 @@ void QuitApp()
     // NOTE: Even if the singleton objects do not exist when this function is called, invoking the
     // static Destroy() singleton function will do no harm (it checks that the object exists before deleting it).
 
+    // Keep the frame-time records of profiled sessions
+    if(ProfilerManager && ProfilerManager->IsEnabled()) {
+        ProfilerManager->ExportCSV(GetUserDataPath() + "profile.csv");
+        ProfilerManager->ExportChromeTrace(GetUserDataPath() + "profile.json");
+        ProfilerManager->PrintFrameTimeReport(std::cout);
+    }
+
     // Delete the mode manager first so that all game modes free their resources
     ModeEngine::SingletonDestroy();
+    vt_battle::BattleResourceCache::SingletonDestroy();
 
     // Delete the global manager second to remove all object references corresponding to other engine subsystems
     GameGlobal::SingletonDestroy();
@@ -101,6 +111,7 @@ void QuitApp()
     AudioEngine::SingletonDestroy();
     InputEngine::SingletonDestroy();
     SystemEngine::SingletonDestroy();
+    Profiler::SingletonDestroy();
     VideoEngine::SingletonDestroy();
     // Do it last since all luabind objects must be freed before closing the lua state.
     ScriptEngine::SingletonDestroy();
@@ -188,6 +199,13 @@ bool LoadSettings()
         VideoManager->SetPixelArtSmoothed(settings.ReadBool("smooth_graphics"));
     else
         VideoManager->SetPixelArtSmoothed(true);
+    // Frame pacing, with defaults for older settings files
+    if(settings.DoesBoolExist("vsync"))
+        VideoManager->SetVSync(settings.ReadBool("vsync"));
+    if(settings.DoesIntExist("frame_rate_limit"))
+        SystemManager->SetFrameRateLimit(static_cast<uint32>(settings.ReadInt("frame_rate_limit")));
+    if(settings.DoesIntExist("fixed_update_step"))
+        SystemManager->SetFixedUpdateStep(static_cast<uint32>(settings.ReadInt("fixed_update_step")));
     settings.CloseTable(); // video_settings
 
     // Load Audio settings
@@ -390,13 +408,19 @@ void InitializeEngine() throw(Exception)
 
     // Create and initialize singleton class managers
     AudioManager = AudioEngine::SingletonCreate();
-    InputManager = InputEngine::SingletonCreate();
+    if(!InputManager)
+        InputManager = InputEngine::SingletonCreate();
     ScriptManager = ScriptEngine::SingletonCreate();
-    VideoManager = VideoEngine::SingletonCreate();
-    SystemManager = SystemEngine::SingletonCreate();
+    if(!VideoManager)
+        VideoManager = VideoEngine::SingletonCreate();
+    if(!SystemManager)
+        SystemManager = SystemEngine::SingletonCreate();
+    if(!ProfilerManager)
+        ProfilerManager = Profiler::SingletonCreate();
     ModeManager = ModeEngine::SingletonCreate();
     GUIManager = GUISystem::SingletonCreate();
     GlobalManager = GameGlobal::SingletonCreate();
+    vt_battle::BattleResources = vt_battle::BattleResourceCache::SingletonCreate();
 
     if(VideoManager->SingletonInitialize() == false) {
         throw Exception("ERROR: unable to initialize VideoManager", __FILE__, __LINE__, __FUNCTION__);
@@ -432,6 +456,12 @@ void InitializeEngine() throw(Exception)
     if(!LoadSettings())
         throw Exception("ERROR: Unable to load settings file", __FILE__, __LINE__, __FUNCTION__);
 
+    // Recorded input must be replayed with the exact same game updates.
+    if(InputManager->IsRecording() || InputManager->IsReplaying()) {
+        SystemManager->SetFixedUpdateStep(0);
+        SystemManager->SetSimulatedFrameTime(INPUT_REPLAY_FRAME_TIME);
+    }
+
     // Apply engine configuration settings with delayed initialization calls to the managers
     InputManager->InitializeJoysticks();
 
@@ -534,39 +564,78 @@ int main(int argc, char *argv[])
         return EXIT_FAILURE;
     }
 
-    ModeManager->Push(new BootMode(), false, true);
+    vt_mode_manager::GameMode *startup_mode = vt_main::CreateStartupMode();
+    if(startup_mode)
+        ModeManager->Push(startup_mode, false, true);
+    else
+        ModeManager->Push(new BootMode(), false, true);
 
     try {
         // This is the main loop for the game. The loop iterates once for every frame drawn to the screen.
         while(SystemManager->NotDone()) {
-            // Update only every 10 milliseconds.
-            SDL_Delay(10);
-
-            // 1) Render the scene
-            VideoManager->Clear();
-            ModeManager->Draw();
-            VideoManager->Draw();
-            ModeManager->DrawEffects();
-            ModeManager->DrawPostEffects();
-            VideoManager->DrawFadeEffect();
-            // Swap the buffers once the draw operations are done.
-            SDL_GL_SwapBuffers();
+            ProfilerManager->BeginFrame();
 
-            // Update timers for correct time-based movement operation
-            SystemManager->UpdateTimers();
+            // Wait for the next frame, unless the vertical sync already paces the buffer swaps.
+            {
+                PROFILE_SCOPE("Sleep");
+                if(!VideoManager->IsVSyncActive())
+                    SystemManager->WaitForNextFrame();
+            }
 
-            // Process all new events
-            InputManager->EventHandler();
+            // Measure the time elapsed since the last frame
+            {
+                PROFILE_SCOPE("SystemManager::UpdateTimers");
+                SystemManager->UpdateTimers();
+            }
 
-            // Update video
-            VideoManager->Update();
+            // Process all new events
+            {
+                PROFILE_SCOPE("InputManager::EventHandler");
+                InputManager->EventHandler();
+            }
 
             // Update any streaming audio sources
-            AudioManager->Update();
+            {
+                PROFILE_SCOPE("AudioManager::Update");
+                AudioManager->Update();
+            }
+
+            // Update the game status, using as many update steps as needed
+            // to catch up with the elapsed time.
+            while(SystemManager->NotDone() && SystemManager->StartUpdateStep()) {
+                {
+                    PROFILE_SCOPE("VideoManager::Update");
+                    VideoManager->Update();
+                }
+
+                {
+                    PROFILE_SCOPE("ModeManager::Update");
+                    ModeManager->Update();
+                }
+
+                // Input events are handled by the first update step only.
+                InputManager->ResetPressAndReleaseFlags();
+            }
 
-            // Update the game status
-            ModeManager->Update();
+            // Render the scene
+            {
+                PROFILE_SCOPE("ModeManager::Draw");
+                VideoManager->Clear();
+                ModeManager->Draw();
+                VideoManager->Draw();
+                ModeManager->DrawEffects();
+                ModeManager->DrawPostEffects();
+                VideoManager->DrawFadeEffect();
+            }
+            ProfilerManager->DrawOverlay();
+
+            // Swap the buffers once the draw operations are done.
+            {
+                PROFILE_SCOPE("SwapBuffers");
+                VideoManager->SwapBuffers();
+            }
 
+            ProfilerManager->EndFrame();
         } // while (SystemManager->NotDone())
     } catch(const Exception &e) {
 #ifdef WIN32
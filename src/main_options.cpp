@@ -25,9 +25,12 @@
 #include "engine/input.h"
 #include "engine/system.h"
 #include "engine/mode_manager.h"
+#include "engine/profiler.h"
 
 #include "common/global/global.h"
 
+#include "modes/battle/battle_simulation.h"
+
 namespace vt_battle {
 extern bool BATTLE_DEBUG;
 }
@@ -52,6 +55,18 @@ using namespace vt_utils;
 namespace vt_main
 {
 
+//! \brief The battle simulations asked by the command-line options, if any
+static std::string _simulation_script;
+static std::string _simulation_function;
+static uint32 _simulation_count = 0;
+
+//! \brief The skill benchmark asked by the command-line options, if any
+static std::string _skill_benchmark_script;
+static uint32 _skill_benchmark_count = 0;
+
+//! \brief The random seed of the first battle simulated
+static uint32 _simulation_seed = 1;
+
 bool ParseProgramOptions(int32 &return_code, int32 argc, char **argv)
 {
     // Convert the argument list to a vector of strings for convenience
@@ -59,7 +74,28 @@ bool ParseProgramOptions(int32 &return_code, int32 argc, char **argv)
     return_code = 0;
 
     for(uint32 i = 1; i < options.size(); i++) {
-        if(options[i] == "-c" || options[i] == "--check") {
+        if(options[i] == "-b" || options[i] == "--benchmark") {
+            // Run as fast as possible, without any frame pacing
+            if(!vt_system::SystemManager)
+                vt_system::SystemManager = vt_system::SystemEngine::SingletonCreate();
+            vt_system::SystemManager->SetBenchmarkMode(true);
+        } else if(options[i] == "--benchmark-skills") {
+            if((i + 2) >= options.size() || !IsStringNumeric(options[i + 2])) {
+                std::cerr << "Option " << options[i] << " requires a script and a number of executions." << std::endl;
+                PrintUsage();
+                return_code = 1;
+                return false;
+            }
+            _skill_benchmark_script = options[i + 1];
+            _skill_benchmark_count = static_cast<uint32>(atoi(options[i + 2].c_str()));
+
+            // Nothing needs to be seen nor heard
+            if(!vt_video::VideoManager)
+                vt_video::VideoManager = vt_video::VideoEngine::SingletonCreate();
+            vt_video::VideoManager->SetTarget(vt_video::VIDEO_TARGET_NULL);
+            vt_audio::AUDIO_ENABLE = false;
+            i += 2;
+        } else if(options[i] == "-c" || options[i] == "--check") {
             if(CheckFiles() == true) {
                 return_code = 0;
             } else {
@@ -84,6 +120,12 @@ bool ParseProgramOptions(int32 &return_code, int32 argc, char **argv)
             PrintUsage();
             return_code = 0;
             return false;
+        } else if(options[i] == "--headless" || options[i] == "--null-render") {
+            // Render without any window
+            if(!vt_video::VideoManager)
+                vt_video::VideoManager = vt_video::VideoEngine::SingletonCreate();
+            vt_video::VideoManager->SetTarget(options[i] == "--headless" ?
+                                              vt_video::VIDEO_TARGET_OFFSCREEN : vt_video::VIDEO_TARGET_NULL);
         } else if(options[i] == "-i" || options[i] == "--info") {
             if(PrintSystemInformation() == true) {
                 return_code = 0;
@@ -91,6 +133,57 @@ bool ParseProgramOptions(int32 &return_code, int32 argc, char **argv)
                 return_code = 1;
             }
             return false;
+        } else if(options[i] == "-p" || options[i] == "--profile") {
+            // Start measuring frame times right away
+            vt_system::ProfilerManager = vt_system::Profiler::SingletonCreate();
+            vt_system::ProfilerManager->SetEnabled(true);
+        } else if(options[i] == "--record" || options[i] == "--replay") {
+            if((i + 1) >= options.size()) {
+                std::cerr << "Option " << options[i] << " requires an argument." << std::endl;
+                PrintUsage();
+                return_code = 1;
+                return false;
+            }
+            if(!vt_input::InputManager)
+                vt_input::InputManager = vt_input::InputEngine::SingletonCreate();
+            bool started = (options[i] == "--record") ?
+                           vt_input::InputManager->StartRecording(options[i + 1]) :
+                           vt_input::InputManager->StartReplay(options[i + 1]);
+            if(!started) {
+                return_code = 1;
+                return false;
+            }
+            i++;
+        } else if(options[i] == "--seed") {
+            if((i + 1) >= options.size() || !IsStringNumeric(options[i + 1])) {
+                std::cerr << "Option " << options[i] << " requires a number." << std::endl;
+                PrintUsage();
+                return_code = 1;
+                return false;
+            }
+            _simulation_seed = static_cast<uint32>(atoi(options[i + 1].c_str()));
+            srand(_simulation_seed);
+            i++;
+        } else if(options[i] == "--simulate-battles") {
+            if((i + 3) >= options.size() || !IsStringNumeric(options[i + 3])) {
+                std::cerr << "Option " << options[i] << " requires a script, a function and a number of battles." << std::endl;
+                PrintUsage();
+                return_code = 1;
+                return false;
+            }
+            _simulation_script = options[i + 1];
+            _simulation_function = options[i + 2];
+            _simulation_count = static_cast<uint32>(atoi(options[i + 3].c_str()));
+
+            // Nothing needs to be seen nor heard, and the battles run as fast as possible
+            if(!vt_video::VideoManager)
+                vt_video::VideoManager = vt_video::VideoEngine::SingletonCreate();
+            vt_video::VideoManager->SetTarget(vt_video::VIDEO_TARGET_NULL);
+            if(!vt_system::SystemManager)
+                vt_system::SystemManager = vt_system::SystemEngine::SingletonCreate();
+            vt_system::SystemManager->SetBenchmarkMode(true);
+            vt_audio::AUDIO_ENABLE = false;
+            i += 3;
         } else if(options[i] == "-r" || options[i] == "--reset") {
             if(ResetSettings() == true) {
                 return_code = 0;
@@ -112,6 +205,18 @@ bool ParseProgramOptions(int32 &return_code, int32 argc, char **argv)
 
 
 
+vt_mode_manager::GameMode *CreateStartupMode()
+{
+    if(_skill_benchmark_count > 0)
+        return new vt_battle::SkillBenchmarkMode(_skill_benchmark_script, _skill_benchmark_count, _simulation_seed);
+    if(_simulation_count > 0)
+        return new vt_battle::BattleSimulationMode(_simulation_script, _simulation_function,
+                                                   _simulation_count, _simulation_seed);
+    return NULL;
+}
+
+
+
 bool ParseSecondaryOptions(const std::string &vars, std::vector<std::string>& options)
 {
     uint32 sbegin = 0;
@@ -149,6 +254,10 @@ void PrintUsage()
 {
     std::cout
             << "usage: "APPSHORTNAME" [options]" << std::endl
+            << "  --benchmark/-b    :: disables the vertical sync and the frame rate limit" << std::endl
+            << "  --benchmark-skills <script> <count>" << std::endl
+            << "                    :: executes the skill set up by the script <count> times" << std::endl
+            << "                       natively and through Lua, prints both timings and exits" << std::endl
             << "  --check/-c        :: checks all files for integrity" << std::endl
             << "  --debug/-d <args> :: enables debug statements in specifed sections of the" << std::endl
             << "                       program, where <args> can be:" << std::endl
@@ -156,9 +265,19 @@ void PrintUsage()
             << "                       map, mode_manager, pause, quit, scene, system" << std::endl
             << "                       utils, video" << std::endl
             << "  --disable-audio   :: disables loading and playing audio" << std::endl
+            << "  --headless        :: renders offscreen, without any window" << std::endl
             << "  --help/-h         :: prints this help menu" << std::endl
             << "  --info/-i         :: prints information about the user's system" << std::endl
-            << "  --reset/-r        :: resets game configuration to use default settings" << std::endl;
+            << "  --null-render     :: like --headless, but nearly nothing gets rasterized" << std::endl
+            << "  --profile/-p      :: starts recording frame times at startup and prints" << std::endl
+            << "                       the frame time percentiles at exit" << std::endl
+            << "  --record <file>   :: records the keyboard and joystick input to a file" << std::endl
+            << "  --replay <file>   :: replays a recorded input file and exits at its end" << std::endl
+            << "  --reset/-r        :: resets game configuration to use default settings" << std::endl
+            << "  --seed <n>        :: seeds the random numbers, and the first simulated battle" << std::endl
+            << "  --simulate-battles <script> <function> <count>" << std::endl
+            << "                    :: runs <count> battles set up by the script function" << std::endl
+            << "                       without any player, prints their results and exits" << std::endl;
 }
 
 
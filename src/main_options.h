@@ -18,6 +18,10 @@
 
 #include "utils.h"
 
+namespace vt_mode_manager {
+class GameMode;
+}
+
 /** \brief Namespace containing functions central to main program execution.
 *** \note Normally no other code should need to use this namespace.
 **/
@@ -38,6 +42,12 @@ bool ParseProgramOptions(int32& return_code, int32 argc, char **argv);
 **/
 bool ParseSecondaryOptions(const std::string& vars, std::vector<std::string>& options);
 
+/** \brief Creates the first game mode asked by the command-line options
+*** \return The new game mode, or NULL when the game should start with the boot mode.
+*** \note This must be called once the game engine is initialized.
+**/
+vt_mode_manager::GameMode *CreateStartupMode();
+
 //! \brief Prints out the program usage for running the program.
 void PrintUsage();
 
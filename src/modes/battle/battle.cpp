@@ -21,6 +21,7 @@
 #include "engine/audio/audio.h"
 #include "engine/input.h"
 #include "engine/mode_manager.h"
+#include "engine/profiler.h"
 #include "engine/script/script.h"
 #include "engine/video/video.h"
 
@@ -32,9 +33,11 @@
 #include "modes/battle/battle_command.h"
 #include "modes/battle/battle_dialogue.h"
 #include "modes/battle/battle_finish.h"
+#include "modes/battle/battle_resources.h"
 #include "modes/battle/battle_sequence.h"
 #include "modes/battle/battle_utils.h"
 #include "modes/battle/battle_effects.h"
+#include "modes/battle/battle_simulation.h"
 
 using namespace vt_utils;
 using namespace vt_audio;
@@ -109,6 +112,14 @@ BattleMedia::BattleMedia()
     character_SP_text.SetStyle(TextStyle("text18", Color::white));
     character_SP_text.SetText(Translate("SP"));
 
+    // Render the indicator texts before the battle starts, so that the actions never wait for it.
+    miss_indicator_text.SetStyle(TextStyle("text24", Color::white));
+    miss_indicator_text.SetText(Translate("Miss"));
+
+    const char *indicator_fonts[] = { "text24", "text24.2", "text26", "text28", "text36", "text48" };
+    for(uint32 i = 0; i < sizeof(indicator_fonts) / sizeof(indicator_fonts[0]); ++i)
+        GetIndicatorDigits(indicator_fonts[i]);
+
     if(victory_music.LoadAudio(DEFAULT_VICTORY_MUSIC) == false)
         IF_PRINT_WARNING(BATTLE_DEBUG) << "failed to load victory music file: " << DEFAULT_VICTORY_MUSIC << std::endl;
 
@@ -121,6 +132,15 @@ BattleMedia::BattleMedia()
 }
 
 
+BattleMedia::~BattleMedia()
+{
+    for(std::map<std::string, IndicatorDigits *>::iterator it = _indicator_digits.begin();
+            it != _indicator_digits.end(); ++it)
+        delete it->second;
+    _indicator_digits.clear();
+}
+
+
 void BattleMedia::Update()
 {
     attack_point_indicator.Update();
@@ -180,6 +200,18 @@ StillImage *BattleMedia::GetTargetTypeIcon(vt_global::GLOBAL_TARGET target_type)
     }
 }
 
+
+const IndicatorDigits *BattleMedia::GetIndicatorDigits(const std::string &font)
+{
+    std::map<std::string, IndicatorDigits *>::const_iterator it = _indicator_digits.find(font);
+    if(it != _indicator_digits.end())
+        return it->second;
+
+    IndicatorDigits *digits = new IndicatorDigits(font);
+    _indicator_digits[font] = digits;
+    return digits;
+}
+
 } // namespace private_battle
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -198,7 +230,10 @@ BattleMode::BattleMode() :
     _actor_state_paused(false),
     _battle_type(BATTLE_TYPE_WAIT),
     _highest_agility(0),
-    _battle_type_time_factor(BATTLE_WAIT_FACTOR)
+    _battle_type_time_factor(BATTLE_WAIT_FACTOR),
+    _simulated(false),
+    _action_count(0),
+    _battle_time(0)
 {
     IF_PRINT_DEBUG(BATTLE_DEBUG) << "constructor invoked" << std::endl;
 
@@ -235,6 +270,7 @@ BattleMode::~BattleMode()
     _enemy_party.clear();
 
     _ready_queue.clear();
+    _battle_objects.clear();
 
     if(_current_instance == this) {
         _current_instance = NULL;
@@ -270,8 +306,10 @@ void BattleMode::RestartBattle()
 
     // Removes all enemies and readd only the ones that were present
     // at the beginning of the battle.
-    for(uint32 i = 0; i < _enemy_actors.size(); ++i)
+    for(uint32 i = 0; i < _enemy_actors.size(); ++i) {
+        _RemoveBattleObject(_enemy_actors[i]);
         delete _enemy_actors[i];
+    }
 
     _enemy_actors.clear();
     _enemy_party.clear();
@@ -300,11 +338,21 @@ void BattleMode::RestartBattle()
     ChangeState(BATTLE_STATE_INITIAL);
 }
 
-//! \brief Compares the Y-coordinates of the battle objects,
-//! It is used to sort them before draw calls.
-static bool CompareObjectsYCoord(BattleObject *one, BattleObject *other)
+//! \brief Sorts the battle objects by their Y-coordinates before the draw calls.
+//! The objects were sorted at the previous frame and only a few of them move,
+//! so an insertion sort only compares each object with its neighbour most of the time.
+static void SortObjectsYCoord(std::vector<BattleObject *> &objects)
 {
-    return (one->GetYLocation() < other->GetYLocation());
+    for(uint32 i = 1; i < objects.size(); ++i) {
+        BattleObject *object = objects[i];
+        float y = object->GetYLocation();
+        uint32 j = i;
+        while(j > 0 && objects[j - 1]->GetYLocation() > y) {
+            objects[j] = objects[j - 1];
+            --j;
+        }
+        objects[j] = object;
+    }
 }
 
 void BattleMode::Update()
@@ -323,6 +371,15 @@ void BattleMode::Update()
         return;
     }
 
+    // Stop the simulated battles that would never end, e.g. waiting for the player.
+    if(_simulated) {
+        _battle_time += SystemManager->GetUpdateTime();
+        if(_battle_time > BATTLE_SIMULATION_TIME_LIMIT) {
+            _FinishSimulation();
+            return;
+        }
+    }
+
     if(_dialogue_supervisor->IsDialogueActive() == true) {
         _dialogue_supervisor->Update();
 
@@ -335,33 +392,26 @@ void BattleMode::Update()
     }
 
     // Update all actors animations and y-sorting
-    _battle_objects.clear();
-    for(uint32 i = 0; i < _character_actors.size(); ++i) {
+    PROFILE_SCOPE("BattleMode actors update");
+    for(uint32 i = 0; i < _character_actors.size(); ++i)
         _character_actors[i]->Update();
-        _battle_objects.push_back(_character_actors[i]);
-        // Add also potential ammo objects
-        if(_character_actors[i]->GetAmmo().IsAmmoShown())
-            _battle_objects.push_back(&(_character_actors[i]->GetAmmo()));
-    }
-    for(uint32 i = 0; i < _enemy_actors.size(); ++i) {
+    for(uint32 i = 0; i < _enemy_actors.size(); ++i)
         _enemy_actors[i]->Update();
-        _battle_objects.push_back(_enemy_actors[i]);
-    }
 
-    // Add particle effects
+    // Update the particle effects
     for(std::vector<BattleParticleEffect *>::iterator it = _battle_particle_effects.begin();
             it != _battle_particle_effects.end();) {
         if((*it)->IsAlive()) {
             (*it)->Update();
-            _battle_objects.push_back(*it);
             ++it;
         } else {
+            _RemoveBattleObject(*it);
             delete (*it);
             it = _battle_particle_effects.erase(it);
         }
     }
 
-    std::sort(_battle_objects.begin(), _battle_objects.end(), CompareObjectsYCoord);
+    SortObjectsYCoord(_battle_objects);
 
     // Now checking standard battle conditions
 
@@ -471,11 +521,12 @@ void BattleMode::Update()
         switch(acting_actor->GetState()) {
         case ACTOR_STATE_READY:
             acting_actor->ChangeState(ACTOR_STATE_ACTING);
+            ++_action_count;
             break;
         case ACTOR_STATE_ACTING:
             break;
         default:
-            _ready_queue.pop_front();
+            _ready_queue.erase(_ready_queue.begin());
             break;
         }
     }
@@ -493,7 +544,10 @@ void BattleMode::Draw()
     }
 
     _DrawBackgroundGraphics();
-    _DrawSprites();
+    {
+        PROFILE_SCOPE("BattleMode::_DrawSprites");
+        _DrawSprites();
+    }
     _DrawForegroundGraphics();
 }
 
@@ -508,6 +562,7 @@ void BattleMode::DrawPostEffects()
         return;
     }
 
+    PROFILE_SCOPE("BattleMode::_DrawGUI");
     _DrawGUI();
 }
 
@@ -517,6 +572,9 @@ void BattleMode::DrawPostEffects()
 
 void BattleMode::AddEnemy(uint32 new_enemy_id, float position_x, float position_y)
 {
+    // Done once per enemy id, unless it was already prepared before the battle.
+    BattleResources->PrepareEnemy(new_enemy_id);
+
     GlobalEnemy *new_enemy = new vt_global::GlobalEnemy(new_enemy_id);
 
     // Don't add the enemy if its id was invalidated
@@ -537,6 +595,7 @@ void BattleMode::AddEnemy(uint32 new_enemy_id, float position_x, float position_
 
     _enemy_actors.push_back(new_battle_enemy);
     _enemy_party.push_back(new_battle_enemy);
+    _battle_objects.push_back(new_battle_enemy);
 
     if (GetState() == BATTLE_STATE_INVALID) {
         // When the enemy is added before the battle has begun, we can store it
@@ -558,6 +617,13 @@ void BattleMode::ChangeState(BATTLE_STATE new_state)
     }
 
     _state = new_state;
+
+    // Simulated battles end without the finish screens.
+    if(_simulated && (_state == BATTLE_STATE_VICTORY || _state == BATTLE_STATE_DEFEAT)) {
+        _FinishSimulation();
+        return;
+    }
+
     switch(_state) {
     case BATTLE_STATE_INITIAL:
         // Reset logic flags
@@ -646,6 +712,17 @@ void BattleMode::NotifyCommandCancel()
 
 
 
+void BattleMode::_FinishSimulation()
+{
+    if(BattleSimulationMode::CurrentInstance())
+        BattleSimulationMode::CurrentInstance()->NotifyBattleFinished(_state, _action_count, _battle_time);
+
+    _simulated = false;
+    ModeManager->Pop();
+}
+
+
+
 void BattleMode::NotifyCharacterCommandComplete(BattleCharacter *character)
 {
     if(character == NULL) {
@@ -669,11 +746,9 @@ void BattleMode::NotifyCharacterCommandComplete(BattleCharacter *character)
 
 void BattleMode::NotifyActorReady(BattleActor *actor)
 {
-    for(std::list<BattleActor *>::iterator i = _ready_queue.begin(); i != _ready_queue.end(); i++) {
-        if(actor == (*i)) {
-            IF_PRINT_WARNING(BATTLE_DEBUG) << "actor was already present in the ready queue" << std::endl;
-            return;
-        }
+    if(std::find(_ready_queue.begin(), _ready_queue.end(), actor) != _ready_queue.end()) {
+        IF_PRINT_WARNING(BATTLE_DEBUG) << "actor was already present in the ready queue" << std::endl;
+        return;
     }
 
     _ready_queue.push_back(actor);
@@ -689,7 +764,9 @@ void BattleMode::NotifyActorDeath(BattleActor *actor)
     }
 
     // Remove the actor from the ready queue if it is there
-    _ready_queue.remove(actor);
+    std::vector<BattleActor *>::iterator it = std::find(_ready_queue.begin(), _ready_queue.end(), actor);
+    if(it != _ready_queue.end())
+        _ready_queue.erase(it);
 
     // Notify the command supervisor about the death event if it is active
     if(_state == BATTLE_STATE_COMMAND) {
@@ -737,6 +814,9 @@ void BattleMode::_Initialize()
         BattleCharacter *new_actor = new BattleCharacter(dynamic_cast<GlobalCharacter *>(active_party->GetActorAtIndex(i)));
         _character_actors.push_back(new_actor);
         _character_party.push_back(new_actor);
+        // The ammo is always listed, and only drawn when shown.
+        _battle_objects.push_back(new_actor);
+        _battle_objects.push_back(&new_actor->GetAmmo());
         _ResetPassiveStatusEffects(*new_actor);
         // Check whether the character is alive
         if(new_actor->GetHitPoints() == 0)
@@ -919,6 +999,14 @@ void BattleMode::TriggerBattleParticleEffect(const std::string &effect_filename,
     effect->Start();
 
     _battle_particle_effects.push_back(effect);
+    _battle_objects.push_back(effect);
+}
+
+void BattleMode::_RemoveBattleObject(BattleObject *object)
+{
+    std::vector<BattleObject *>::iterator it = std::find(_battle_objects.begin(), _battle_objects.end(), object);
+    if(it != _battle_objects.end())
+        _battle_objects.erase(it);
 }
 
 void BattleMode::_DetermineActorLocations()
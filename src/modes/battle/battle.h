@@ -25,13 +25,14 @@
 #define __BATTLE_HEADER__
 
 #include "battle_utils.h"
+#include "battle_indicators.h"
 
 #include "engine/audio/audio_descriptor.h"
 #include "engine/mode_manager.h"
 
 #include "common/global/global_actors.h"
 
-#include <list>
+#include <algorithm>
 
 namespace vt_battle
 {
@@ -127,7 +128,7 @@ class BattleMedia
 public:
     BattleMedia();
 
-    ~BattleMedia() {}
+    ~BattleMedia();
 
     ///! \brief Updates the different animations and media
     void Update();
@@ -158,6 +159,12 @@ public:
         return _stunned_icon;
     }
 
+    /** \brief Retrieves the pre-rendered digits of a font, used to draw the numeric indicators
+    *** \param font The name of the font
+    *** \return A pointer to the digits, rendered the first time only
+    **/
+    const private_battle::IndicatorDigits *GetIndicatorDigits(const std::string &font);
+
     // ---------- Public members
 
     //! \brief The static background image to be used for the battle
@@ -188,6 +195,9 @@ public:
     vt_video::TextImage character_HP_text;
     vt_video::TextImage character_SP_text;
 
+    //! \brief The text displayed by the miss indicators
+    vt_video::TextImage miss_indicator_text;
+
     /** \brief The universal stamina bar that is used to represent the state of battle actors
     *** All battle actors have a portrait that moves along this meter to signify their
     *** turn in the rotation.  The meter and corresponding portraits must be drawn after the
@@ -225,6 +235,9 @@ private:
 
     //! \brief An icon displayed above the character's head when it is stunned.
     vt_video::StillImage _stunned_icon;
+
+    //! \brief The pre-rendered digits of the numeric indicators, by font name
+    std::map<std::string, private_battle::IndicatorDigits *> _indicator_digits;
 }; // class BattleMedia
 
 } // namespace private_battle
@@ -382,6 +395,18 @@ public:
         return _battle_type_time_factor;
     }
 
+    /** \brief Makes the battle run without any player, as part of the battle simulations
+    *** The characters then decide their actions by themselves, and the battle ends
+    *** without the finish screens, reporting its result to the battle simulation mode.
+    **/
+    void SetSimulated(bool simulated) {
+        _simulated = simulated;
+    }
+
+    bool IsSimulated() const {
+        return _simulated;
+    }
+
     //! \name Class member accessor methods
     //@{
     std::deque<private_battle::BattleCharacter *>& GetCharacterActors() {
@@ -494,11 +519,12 @@ private:
     *** executing their action. All other actors in the queue are waiting for the acting actor to finish and
     *** be removed from the queue before they can take their turn.
     **/
-    std::list<private_battle::BattleActor *> _ready_queue;
+    std::vector<private_battle::BattleActor *> _ready_queue;
     //@}
 
     /** \brief Vector used to draw all battle objects based on their y coordinate.
-    *** Sorted in the update() method.
+    *** The objects are added and removed along with the actors and particle effects,
+    *** and the vector is kept sorted in the update() method.
     **/
     std::vector<private_battle::BattleObject *> _battle_objects;
 
@@ -529,11 +555,23 @@ private:
     //! \brief the battle type time factor, speeding the battle actors depending on the battle type.
     float _battle_type_time_factor;
 
+    //! \brief Tells whether the battle is run without any player by the battle simulation mode.
+    bool _simulated;
+
+    //! \brief The number of actions executed since the battle start.
+    uint32 _action_count;
+
+    //! \brief The game time elapsed since the battle start, in milliseconds. Only counted in simulated battles.
+    uint32 _battle_time;
+
     ////////////////////////////// PRIVATE METHODS ///////////////////////////////
 
     //! \brief Initializes all data necessary for the battle to begin
     void _Initialize();
 
+    //! \brief Reports the result of a simulated battle and leaves it.
+    void _FinishSimulation();
+
     //! \brief resets the character's original global attributes
     //! \note this also sets the BattleActor's attributes for the first time
     void _ResetAttributesFromGlobalActor(private_battle::BattleActor &character);
@@ -558,6 +596,9 @@ private:
     **/
     void _DetermineActorLocations();
 
+    //! \brief Removes an object about to be deleted from the draw list
+    void _RemoveBattleObject(private_battle::BattleObject *object);
+
     //! \brief Returns the number of enemies that are still alive in the battle
     uint32 _NumberEnemiesAlive() const;
 
@@ -25,6 +25,7 @@
 #include "modes/battle/battle.h"
 #include "modes/battle/battle_actions.h"
 #include "modes/battle/battle_actors.h"
+#include "modes/battle/battle_resources.h"
 #include "modes/battle/battle_utils.h"
 
 using namespace vt_utils;
@@ -81,6 +82,9 @@ SkillAction::SkillAction(BattleActor *actor, BattleTarget target, GlobalSkill *s
     if(animation_script_file.empty())
         return;
 
+    // The script is only read and compiled once, but still run again for each action below.
+    BattleResources->PrepareSkill(skill->GetID());
+
     // Clears out old script data
     std::string tablespace = ScriptEngine::GetTableSpace(animation_script_file);
     ScriptManager->DropGlobalTable(tablespace);
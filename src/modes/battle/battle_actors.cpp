@@ -24,6 +24,7 @@
 #include "modes/battle/battle_command.h"
 #include "modes/battle/battle_effects.h"
 #include "modes/battle/battle_indicators.h"
+#include "modes/battle/battle_resources.h"
 #include "modes/battle/battle_utils.h"
 
 #include "engine/input.h"
@@ -459,6 +460,116 @@ void BattleActor::SetAgility(uint32 agility)
     BattleMode::CurrentInstance()->SetActorIdleStateTime(this);
 }
 
+// TODO: No party target will work, this will have to be addressed eventually.
+// The use of a skill on dead allies is not supported either.
+bool BattleActor::_SetRandomSkillAction(const std::vector<GlobalSkill *> &skills)
+{
+    // Obtain the living foes
+    std::deque<BattleActor *> alive_foes = IsEnemy() ? BattleMode::CurrentInstance()->GetCharacterParty()
+                                           : BattleMode::CurrentInstance()->GetEnemyParty();
+    std::deque<BattleActor *>::iterator actor_iterator = alive_foes.begin();
+    while(actor_iterator != alive_foes.end()) {
+        if(!(*actor_iterator)->IsAlive())
+            actor_iterator = alive_foes.erase(actor_iterator);
+        else
+            ++actor_iterator;
+    }
+    if(alive_foes.empty())
+        return false;
+
+    // and the living allies
+    std::deque<BattleActor *> alive_allies = IsEnemy() ? BattleMode::CurrentInstance()->GetEnemyParty()
+                                             : BattleMode::CurrentInstance()->GetCharacterParty();
+    actor_iterator = alive_allies.begin();
+    while(actor_iterator != alive_allies.end()) {
+        if(!(*actor_iterator)->IsAlive())
+            actor_iterator = alive_allies.erase(actor_iterator);
+        else
+            ++actor_iterator;
+    }
+
+    if(alive_allies.empty()) {
+        // it means that the actor actually thinking now is already dead.
+        PRINT_WARNING << "An actor was deciding an action while being dead." << std::endl;
+        return false;
+    }
+
+    // Targeting members
+    BattleTarget target;
+    BattleActor *actor_target = NULL;
+
+    // Select a random skill to use
+    uint32 skill_index = 0;
+    if(skills.size() > 1)
+        skill_index = RandomBoundedInteger(0, skills.size() - 1);
+    GlobalSkill *skill = skills[skill_index];
+
+    // Select the target
+    GLOBAL_TARGET target_type = skill->GetTargetType();
+    switch(target_type) {
+    case GLOBAL_TARGET_FOE_POINT:
+    case GLOBAL_TARGET_FOE:
+        // Select a random living foe
+        if(alive_foes.size() == 1)
+            actor_target = alive_foes[0];
+        else
+            actor_target = alive_foes[RandomBoundedInteger(0, alive_foes.size() - 1)];
+        break;
+    case GLOBAL_TARGET_SELF_POINT:
+    case GLOBAL_TARGET_SELF:
+        actor_target = this;
+        break;
+    case GLOBAL_TARGET_ALLY_POINT:
+    case GLOBAL_TARGET_ALLY:
+    case GLOBAL_TARGET_ALLY_EVEN_DEAD:
+        // Select a random living ally, selecting a dead ally is unsupported at the moment.
+        if(alive_allies.size() == 1)
+            actor_target = alive_allies[0];
+        else
+            actor_target = alive_allies[RandomBoundedInteger(0, alive_allies.size() - 1)];
+        break;
+    case GLOBAL_TARGET_ALL_FOES: // TODO: Add support for this
+    case GLOBAL_TARGET_ALL_ALLIES: // TODO: Add support for this
+    default:
+        PRINT_WARNING << "Unsupported skill target type found." << std::endl;
+        return false;
+    }
+
+    // Potentially select the target point and finsh targeting
+    switch(target_type) {
+    case GLOBAL_TARGET_SELF_POINT:
+    case GLOBAL_TARGET_FOE_POINT:
+    case GLOBAL_TARGET_ALLY_POINT: {
+        // Select a random attack point on the target
+        uint32 num_points = actor_target->GetAttackPoints().size();
+        uint32 point_target = 0;
+        if(num_points == 1)
+            point_target = 0;
+        else
+            point_target = RandomBoundedInteger(0, num_points - 1);
+
+        target.SetPointTarget(target_type, point_target, actor_target);
+        break;
+    }
+
+    case GLOBAL_TARGET_FOE:
+    case GLOBAL_TARGET_SELF:
+    case GLOBAL_TARGET_ALLY:
+    case GLOBAL_TARGET_ALLY_EVEN_DEAD:
+        target.SetActorTarget(target_type, actor_target);
+        break;
+
+    case GLOBAL_TARGET_ALL_FOES: // TODO: Add support for this
+    case GLOBAL_TARGET_ALL_ALLIES: // TODO: Add support for this
+    default:
+        PRINT_WARNING << "Unsupported skill target type found." << std::endl;
+        return false;
+    }
+
+    SetAction(new SkillAction(this, target, skill));
+    return true;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 // BattleCharacter class
 ////////////////////////////////////////////////////////////////////////////////
@@ -468,6 +579,13 @@ BattleCharacter::BattleCharacter(GlobalCharacter *character) :
     _global_character(character),
     _last_rendered_hp(0),
     _last_rendered_sp(0),
+    _last_rendered_max_hp(0),
+    _last_rendered_max_sp(0),
+    _status_display_outdated(true),
+    _hp_bar_size(0.0f),
+    _sp_bar_size(0.0f),
+    _portrait_frame(0),
+    _portrait_blend_alpha(0.0f),
     _sprite_animation_alias("idle")
 {
     _last_rendered_hp = GetHitPoints();
@@ -479,6 +597,7 @@ BattleCharacter::BattleCharacter(GlobalCharacter *character) :
     _hit_points_text.SetText(NumberToString(_last_rendered_hp));
     _skill_points_text.SetStyle(TextStyle("text24", VIDEO_TEXT_SHADOW_BLACK));
     _skill_points_text.SetText(NumberToString(_last_rendered_sp));
+    _UpdateStatusDisplay();
 
     _action_selection_text.SetStyle(TextStyle("text20"));
     _action_selection_text.SetText("");
@@ -488,11 +607,7 @@ BattleCharacter::BattleCharacter(GlobalCharacter *character) :
     // Init the battle animation pointers
     _current_sprite_animation = _global_character->RetrieveBattleAnimation(_sprite_animation_alias);
     // Add custom weapon animation
-    std::string weapon_animation;
-    if (_global_character->GetWeaponEquipped())
-            weapon_animation = _global_character->GetWeaponEquipped()->GetWeaponAnimationFile(_global_character->GetID(), _sprite_animation_alias);
-    if (weapon_animation.empty() || !_current_weapon_animation.LoadFromAnimationScript(weapon_animation))
-        _current_weapon_animation.Clear();
+    _LoadWeaponAnimation();
 
     // Prepare the flying height of potential ammo weapons
     _ammo.SetFlyingHeight(GetSpriteHeight() / 2.0f);
@@ -509,6 +624,12 @@ void BattleCharacter::ChangeState(ACTOR_STATE new_state)
 
     switch(_state) {
     case ACTOR_STATE_COMMAND:
+        // Simulated battles have no player to give the commands
+        if(BattleMode::CurrentInstance()->IsSimulated()) {
+            _DecideAction();
+            break;
+        }
+
         // The battle action should pause whenever a character enters the command state in the WAIT battle type
         if(BattleMode::CurrentInstance()->GetBattleType() == BATTLE_TYPE_WAIT) {
             BattleMode::CurrentInstance()->SetActorStatePaused(true);
@@ -567,6 +688,8 @@ void BattleCharacter::Update()
 {
     BattleActor::Update();
 
+    _UpdateStatusDisplay();
+
     _animation_timer.Update();
 
     // Update the active sprite animation
@@ -671,12 +794,7 @@ void BattleCharacter::ChangeSpriteAnimation(const std::string &alias)
     _current_sprite_animation = _global_character->RetrieveBattleAnimation(_sprite_animation_alias);
 
     // Change the weapon animation as well
-    // Add custom weapon animation
-    std::string weapon_animation;
-    if (_global_character->GetWeaponEquipped())
-            weapon_animation = _global_character->GetWeaponEquipped()->GetWeaponAnimationFile(_global_character->GetID(), _sprite_animation_alias);
-    if (weapon_animation.empty() || !_current_weapon_animation.LoadFromAnimationScript(weapon_animation))
-        _current_weapon_animation.Clear();
+    _LoadWeaponAnimation();
 
     _current_sprite_animation->ResetAnimation();
     _current_weapon_animation.ResetAnimation();
@@ -687,6 +805,20 @@ void BattleCharacter::ChangeSpriteAnimation(const std::string &alias)
     _animation_timer.Run();
 }
 
+void BattleCharacter::_LoadWeaponAnimation()
+{
+    // The weapon animations are loaded once, and copied from the battle resources afterwards.
+    std::string weapon_animation;
+    if (_global_character->GetWeaponEquipped())
+            weapon_animation = _global_character->GetWeaponEquipped()->GetWeaponAnimationFile(_global_character->GetID(), _sprite_animation_alias);
+
+    const AnimatedImage *animation = weapon_animation.empty() ? NULL : BattleResources->GetAnimation(weapon_animation);
+    if (animation)
+        _current_weapon_animation = *animation;
+    else
+        _current_weapon_animation.Clear();
+}
+
 void BattleCharacter::ChangeActionText()
 {
     // If the character has no action selected to be used, clear both action and target text
@@ -712,29 +844,9 @@ void BattleCharacter::DrawPortrait()
     VideoManager->Move(48.0f, 759.0f);
 
     std::vector<StillImage>& portrait_frames = *(_global_character->GetBattlePortraits());
-    float hp_percent =  static_cast<float>(GetHitPoints()) / static_cast<float>(GetMaxHitPoints());
-
-    if(GetHitPoints() == GetMaxHitPoints()) {
-        portrait_frames[0].Draw();
-    } else if(GetHitPoints() == 0) {
-        portrait_frames[4].Draw();
-    } else if(hp_percent > 0.75f) {
-        portrait_frames[0].Draw();
-        float alpha = 1.0f - ((hp_percent - 0.75f) * 4.0f);
-        portrait_frames[1].Draw(Color(1.0f, 1.0f, 1.0f, alpha));
-    } else if(hp_percent > 0.50f) {
-        portrait_frames[1].Draw();
-        float alpha = 1.0f - ((hp_percent - 0.50f) * 4.0f);
-        portrait_frames[2].Draw(Color(1.0f, 1.0f, 1.0f, alpha));
-    } else if(hp_percent > 0.25f) {
-        portrait_frames[2].Draw();
-        float alpha = 1.0f - ((hp_percent - 0.25f) * 4.0f);
-        portrait_frames[3].Draw(Color(1.0f, 1.0f, 1.0f, alpha));
-    } else { // (hp_precent > 0.0f)
-        portrait_frames[3].Draw();
-        float alpha = 1.0f - (hp_percent * 4.0f);
-        portrait_frames[4].Draw(Color(1.0f, 1.0f, 1.0f, alpha));
-    }
+    portrait_frames[_portrait_frame].Draw();
+    if(_portrait_blend_alpha > 0.0f)
+        portrait_frames[_portrait_frame + 1].Draw(Color(1.0f, 1.0f, 1.0f, _portrait_blend_alpha));
 }
 
 void BattleCharacter::DrawStatus(uint32 order, BattleCharacter* character_command)
@@ -784,26 +896,23 @@ void BattleCharacter::DrawStatus(uint32 order, BattleCharacter* character_comman
     }
 
     // draw the status, HP and SP bars (bars are 90 pixels wide and 6 pixels high)
-    float bar_size;
     VideoManager->SetDrawFlags(VIDEO_X_LEFT, VIDEO_NO_BLEND, 0);
 
     // Draw HP bar in green
-    bar_size = static_cast<float>(90 * GetHitPoints()) / static_cast<float>(GetMaxHitPoints());
     VideoManager->Move(312.0f, 678.0f + y_offset);
 
-    if(GetHitPoints() > 0) {
-        if (bar_size < 90.0f / 4.0f)
-            VideoManager->DrawRectangle(bar_size, 6, Color::orange);
+    if(_last_rendered_hp > 0) {
+        if (_hp_bar_size < 90.0f / 4.0f)
+            VideoManager->DrawRectangle(_hp_bar_size, 6, Color::orange);
         else
-            VideoManager->DrawRectangle(bar_size, 6, green_hp);
+            VideoManager->DrawRectangle(_hp_bar_size, 6, green_hp);
     }
 
     // Draw SP bar in blue
-    bar_size = static_cast<float>(90 * GetSkillPoints()) / static_cast<float>(GetMaxSkillPoints());
     VideoManager->Move(424.0f, 678.0f + y_offset);
 
-    if(GetSkillPoints() > 0)
-        VideoManager->DrawRectangle(bar_size, 6, blue_sp);
+    if(_last_rendered_sp > 0)
+        VideoManager->DrawRectangle(_sp_bar_size, 6, blue_sp);
 
     // Draw the cover image over the top of the bar
     VideoManager->SetDrawFlags(VIDEO_BLEND, 0);
@@ -821,21 +930,6 @@ void BattleCharacter::DrawStatus(uint32 order, BattleCharacter* character_comman
     VideoManager->MoveRelative(114.0f, 0.0f);
     _skill_points_text.Draw();
 
-    // TODO: The SetText calls below should not be done here. They should be made whenever the character's HP/SP
-    // is modified. This re-renders the text every frame regardless of whether or not the HP/SP changed so its
-    // not efficient
-
-    // Update hit and skill points after drawing to reduce gpu stall
-    if(_last_rendered_hp != GetHitPoints()) {
-        _last_rendered_hp = GetHitPoints();
-        _hit_points_text.SetText(NumberToString(_last_rendered_hp));
-    }
-
-    if(_last_rendered_sp != GetSkillPoints()) {
-        _last_rendered_sp = GetSkillPoints();
-        _skill_points_text.SetText(NumberToString(_last_rendered_sp));
-    }
-
     // Note: if the command menu is visible, it will be drawn over all of the components that follow below. We still perform these draw calls
     // regardless because sometimes even if the battle is in the command state, the command menu may not be drawn if a dialogue is active or if
     // a scripted scene is taking place. Its easier (and not costly) to just always draw this information rather than check for all possible
@@ -866,6 +960,77 @@ void BattleCharacter::DrawStatus(uint32 order, BattleCharacter* character_comman
     _target_selection_text.Draw();
 } // void BattleCharacter::DrawStatus()
 
+void BattleCharacter::_UpdateStatusDisplay()
+{
+    uint32 hp = GetHitPoints();
+    uint32 sp = GetSkillPoints();
+    uint32 max_hp = GetMaxHitPoints();
+    uint32 max_sp = GetMaxSkillPoints();
+
+    if(!_status_display_outdated && hp == _last_rendered_hp && sp == _last_rendered_sp
+            && max_hp == _last_rendered_max_hp && max_sp == _last_rendered_max_sp)
+        return;
+
+    // The texts are only rendered again when their value changed
+    if(hp != _last_rendered_hp)
+        _hit_points_text.SetText(NumberToString(hp));
+    if(sp != _last_rendered_sp)
+        _skill_points_text.SetText(NumberToString(sp));
+
+    _status_display_outdated = false;
+    _last_rendered_hp = hp;
+    _last_rendered_sp = sp;
+    _last_rendered_max_hp = max_hp;
+    _last_rendered_max_sp = max_sp;
+
+    _hp_bar_size = max_hp > 0 ? static_cast<float>(90 * hp) / static_cast<float>(max_hp) : 0.0f;
+    _sp_bar_size = max_sp > 0 ? static_cast<float>(90 * sp) / static_cast<float>(max_sp) : 0.0f;
+
+    // The portrait frames show the damages by quarters of HP, blended with the next frame
+    if(hp >= max_hp) {
+        _portrait_frame = 0;
+        _portrait_blend_alpha = 0.0f;
+    } else if(hp == 0) {
+        _portrait_frame = 4;
+        _portrait_blend_alpha = 0.0f;
+    } else {
+        float hp_percent = static_cast<float>(hp) / static_cast<float>(max_hp);
+        if(hp_percent > 0.75f)
+            _portrait_frame = 0;
+        else if(hp_percent > 0.50f)
+            _portrait_frame = 1;
+        else if(hp_percent > 0.25f)
+            _portrait_frame = 2;
+        else
+            _portrait_frame = 3;
+        float frame_percent = 0.75f - 0.25f * _portrait_frame;
+        _portrait_blend_alpha = 1.0f - ((hp_percent - frame_percent) * 4.0f);
+    }
+}
+
+void BattleCharacter::_DecideAction()
+{
+    // Use the weapon and magic skills, as the player would
+    std::vector<GlobalSkill *> *skill_lists[2] = {
+        GetWeaponEquipped() ? _global_character->GetWeaponSkills() : _global_character->GetBareHandsSkills(),
+        _global_character->GetMagicSkills()
+    };
+
+    std::vector<GlobalSkill *> usable_skills;
+    for(uint32 i = 0; i < 2; ++i) {
+        for(uint32 j = 0; j < skill_lists[i]->size(); ++j) {
+            GlobalSkill *skill = skill_lists[i]->at(j);
+            if(skill->IsExecutableInBattle() && skill->GetSPRequired() <= GetSkillPoints())
+                usable_skills.push_back(skill);
+        }
+    }
+
+    if(!usable_skills.empty() && _SetRandomSkillAction(usable_skills))
+        ChangeState(ACTOR_STATE_WARM_UP);
+    else
+        ChangeState(ACTOR_STATE_IDLE);
+}
+
 // /////////////////////////////////////////////////////////////////////////////
 // BattleEnemy class
 // /////////////////////////////////////////////////////////////////////////////
@@ -1098,8 +1263,6 @@ void BattleEnemy::DrawStaminaIcon(const vt_video::Color &color) const
     }
 }
 
-// TODO: No party target will work, this will have to be addressed eventually.
-// The use of a skill on dead enemies is not supported either.
 void BattleEnemy::_DecideAction()
 {
     if(_global_enemy->GetSkills().empty()) {
@@ -1108,115 +1271,10 @@ void BattleEnemy::_DecideAction()
         return;
     }
 
-    // Obtain the living characters
-    std::deque<BattleActor *> alive_characters = BattleMode::CurrentInstance()->GetCharacterParty();
-    std::deque<BattleActor *>::iterator actor_iterator = alive_characters.begin();
-    while(actor_iterator != alive_characters.end()) {
-        if(!(*actor_iterator)->IsAlive())
-            actor_iterator = alive_characters.erase(actor_iterator);
-        else
-            ++actor_iterator;
-    }
-    if(alive_characters.empty()) {
-        ChangeState(ACTOR_STATE_IDLE);
-        return;
-    }
-
-    // and the living enemies
-    std::deque<BattleActor *> alive_enemies = BattleMode::CurrentInstance()->GetEnemyParty();
-    actor_iterator = alive_enemies.begin();
-    while(actor_iterator != alive_enemies.end()) {
-        if(!(*actor_iterator)->IsAlive())
-            actor_iterator = alive_enemies.erase(actor_iterator);
-        else
-            ++actor_iterator;
-    }
-
-    if(alive_enemies.empty()) {
-        // it means that the enemy actually thinking now is already dead.
-        PRINT_WARNING << "An enemy was deciding an action while being dead." << std::endl;
-        ChangeState(ACTOR_STATE_IDLE);
-        return;
-    }
-
-    // Targeting members
-    BattleTarget target;
-    BattleActor *actor_target = NULL;
-
-    // Select a random skill to use
-    uint32 skill_index = 0;
-    if(_enemy_skills.size() > 1)
-        skill_index = RandomBoundedInteger(0, _enemy_skills.size() - 1);
-    GlobalSkill *skill = _enemy_skills[skill_index];
-
-    // Select the target
-    GLOBAL_TARGET target_type = skill->GetTargetType();
-    switch(target_type) {
-    case GLOBAL_TARGET_FOE_POINT:
-    case GLOBAL_TARGET_FOE:
-        // Select a random living character
-        if(alive_characters.size() == 1)
-            actor_target = alive_characters[0];
-        else
-            actor_target = alive_characters[RandomBoundedInteger(0, alive_characters.size() - 1)];
-        break;
-    case GLOBAL_TARGET_SELF_POINT:
-    case GLOBAL_TARGET_SELF:
-        actor_target = this;
-        break;
-    case GLOBAL_TARGET_ALLY_POINT:
-    case GLOBAL_TARGET_ALLY:
-    case GLOBAL_TARGET_ALLY_EVEN_DEAD:
-        // Select a random living enemy, selecting a dead enemy ally is unsupported at the moment.
-        if(alive_enemies.size() == 1)
-            actor_target = alive_enemies[0];
-        else
-            actor_target = alive_enemies[RandomBoundedInteger(0, alive_enemies.size() - 1)];
-        break;
-    case GLOBAL_TARGET_ALL_FOES: // TODO: Add support for this
-    case GLOBAL_TARGET_ALL_ALLIES: // TODO: Add support for this
-    default:
-        PRINT_WARNING << "Unsupported enemy skill type found." << std::endl;
-        ChangeState(ACTOR_STATE_IDLE);
-        return;
-        break;
-    }
-
-    // Potentially select the target point and finsh targeting
-    switch(target_type) {
-    case GLOBAL_TARGET_SELF_POINT:
-    case GLOBAL_TARGET_FOE_POINT:
-    case GLOBAL_TARGET_ALLY_POINT: {
-        // Select a random attack point on the target
-        uint32 num_points = actor_target->GetAttackPoints().size();
-        uint32 point_target = 0;
-        if(num_points == 1)
-            point_target = 0;
-        else
-            point_target = RandomBoundedInteger(0, num_points - 1);
-
-        target.SetPointTarget(target_type, point_target, actor_target);
-        break;
-    }
-
-    case GLOBAL_TARGET_FOE:
-    case GLOBAL_TARGET_SELF:
-    case GLOBAL_TARGET_ALLY:
-    case GLOBAL_TARGET_ALLY_EVEN_DEAD:
-        target.SetActorTarget(target_type, actor_target);
-        break;
-
-    case GLOBAL_TARGET_ALL_FOES: // TODO: Add support for this
-    case GLOBAL_TARGET_ALL_ALLIES: // TODO: Add support for this
-    default:
-        PRINT_WARNING << "Unsupported enemy skill type found." << std::endl;
+    if(_SetRandomSkillAction(_enemy_skills))
+        ChangeState(ACTOR_STATE_WARM_UP);
+    else
         ChangeState(ACTOR_STATE_IDLE);
-        return;
-        break;
-    }
-
-    SetAction(new SkillAction(this, target, skill));
-    ChangeState(ACTOR_STATE_WARM_UP);
 }
 
 } // namespace private_battle
@@ -538,6 +538,12 @@ protected:
 
     //! \brief Updates the Stamina Icon position.
     void _UpdateStaminaIconPosition();
+
+    /** \brief Sets an action using a random skill on a random living target
+    *** \param skills The skills to choose from. Should not be empty.
+    *** \return false when no action could be set, e.g. when the skill target type isn't supported.
+    **/
+    bool _SetRandomSkillAction(const std::vector<vt_global::GlobalSkill *> &skills);
 }; // class BattleActor
 
 
@@ -618,8 +624,19 @@ protected:
     //! \brief A pointer to the global character object which the battle character represents
     vt_global::GlobalCharacter *_global_character;
 
-    //! \brief Retrains the last HP and SP values that were rendered to text
+    //! \brief Retrains the last HP and SP values, and their maximum, that the status display was computed for
     uint32 _last_rendered_hp, _last_rendered_sp;
+    uint32 _last_rendered_max_hp, _last_rendered_max_sp;
+
+    //! \brief Tells whether the status display must be computed even though the values above didn't change
+    bool _status_display_outdated;
+
+    //! \brief The width of the HP and SP bars, in pixels
+    float _hp_bar_size, _sp_bar_size;
+
+    //! \brief The portrait frame drawn, and the opacity of the next frame drawn over it
+    uint32 _portrait_frame;
+    float _portrait_blend_alpha;
 
     //! \brief Contains the identifier text of the current sprite animation
     std::string _sprite_animation_alias;
@@ -650,6 +667,17 @@ protected:
 
     //! \brief Rendered text of the character's currently selected target
     vt_video::TextImage _target_selection_text;
+
+    /** \brief Decides the character action without any player, in simulated battles
+    *** A random skill is used among the ones the character has enough skill points for.
+    **/
+    void _DecideAction();
+
+    //! \brief Computes the status texts, bars and portrait blending again, only when the HP or SP changed
+    void _UpdateStatusDisplay();
+
+    //! \brief Sets the weapon animation matching the current sprite animation, if any
+    void _LoadWeaponAnimation();
 }; // class BattleCharacter
 
 
@@ -342,8 +342,11 @@ void CharacterCommandSettings::SetLastEnemyTarget(BattleTarget &target)
 // ItemCommand class
 ////////////////////////////////////////////////////////////////////////////////
 
-ItemCommand::ItemCommand(MenuWindow &window)
+ItemCommand::ItemCommand(MenuWindow &window) :
+    _inventory_changed(true)
 {
+    GlobalManager->AddInventoryListener(this);
+
     _item_header.SetOwner(&window);
     _item_header.SetPosition(HEADER_POSITION_X, HEADER_POSITION_Y);
     _item_header.SetDimensions(HEADER_SIZE_X, HEADER_SIZE_Y, 1, 1, 1, 1);
@@ -375,8 +378,20 @@ ItemCommand::ItemCommand(MenuWindow &window)
     ResetItemList();
 }
 
+ItemCommand::~ItemCommand()
+{
+    GlobalManager->RemoveInventoryListener(this);
+}
+
 void ItemCommand::ResetItemList()
 {
+    // The item copies still match the inventory, so only the items used are given back.
+    if(!_inventory_changed) {
+        for(uint32 i = 0; i < _items.size(); ++i)
+            _items[i].ResetBattleCount();
+        return;
+    }
+
     _items.clear();
     std::vector<GlobalItem *>* all_items = GlobalManager->GetInventoryItems();
     for(uint32 i = 0; i < all_items->size(); i++) {
@@ -389,6 +404,7 @@ void ItemCommand::ResetItemList()
         }
     }
     _item_mappings.resize(_items.size(), -1);
+    _inventory_changed = false;
 }
 
 
@@ -23,6 +23,7 @@
 #ifndef __BATTLE_COMMAND_HEADER__
 #define __BATTLE_COMMAND_HEADER__
 
+#include "common/global/global.h"
 #include "common/gui/menu_window.h"
 #include "common/gui/option.h"
 
@@ -183,18 +184,20 @@ private:
 *** certain GUI displays to assist the CommandSupervisor in displaying the list of
 *** items available to use.
 ***
+*** The class listens to the inventory changes, so that the item copies are only
+*** created again at battle restart when the inventory changed in the meantime.
+***
 *** \note In the future we may wish to support the case where a new item that is not
 *** currently in the player's inventory is added in the middle of the battle. Support
 *** for such a feature would have to be added to and tested in this class first.
 *** ***************************************************************************/
-class ItemCommand
+class ItemCommand : public vt_global::GlobalInventoryListener
 {
 public:
     //! \param window A reference to the MenuWindow that the GUI objects should be owned by
     ItemCommand(vt_gui::MenuWindow &window);
 
-    ~ItemCommand()
-    {}
+    ~ItemCommand();
 
     /** \brief Constructs the _item_list option box from scratch using the _items container
     *** This will also reset the selection on the item list to the first element. Typically this only needs to be
@@ -251,9 +254,20 @@ public:
     **/
     void CommitChangesToInventory();
 
-    //! \brief Reset the item list content, used at battle restart
+    /** \brief Reset the item list content, used at battle restart
+    *** The item copies are kept and only their battle count is reset, unless the inventory changed.
+    **/
     void ResetItemList();
 
+    //! \brief Notes that the item copies no longer match the inventory.
+    void InventoryChanged(uint32 /*obj_id*/) {
+        _inventory_changed = true;
+    }
+
+    void InventoryCleared() {
+        _inventory_changed = true;
+    }
+
     //! \brief Retuns the number of items that will be displayed in the list
     uint32 GetNumberListOptions() const {
         return _item_list.GetNumberOptions();
@@ -285,6 +299,9 @@ private:
     **/
     std::vector<int32> _item_mappings;
 
+    //! \brief Tells whether the inventory changed since the item copies were created.
+    bool _inventory_changed;
+
     //! \brief A single line of header text for the item list option box
     vt_gui::OptionBox _item_header;
 
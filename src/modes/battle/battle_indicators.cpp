@@ -116,6 +116,14 @@ void IndicatorElement::Start()
 }
 
 
+void IndicatorElement::_Reset(INDICATOR_TYPE indicator_type)
+{
+    _timer.Reset();
+    _alpha_color.SetAlpha(0.0f);
+    _indicator_type = indicator_type;
+}
+
+
 void IndicatorElement::Draw()
 {
     VideoManager->SetDrawFlags(VIDEO_X_RIGHT, VIDEO_Y_BOTTOM, VIDEO_BLEND, 0);
@@ -215,26 +223,91 @@ bool IndicatorElement::_ComputeDrawAlpha()
     }
 }
 
+////////////////////////////////////////////////////////////////////////////////
+// IndicatorDigits class
+////////////////////////////////////////////////////////////////////////////////
+
+IndicatorDigits::IndicatorDigits(const std::string &font)
+{
+    for(uint32 i = 0; i < 10; ++i) {
+        _digits[i].SetStyle(TextStyle(font, Color::white, VIDEO_TEXT_SHADOW_BLACK));
+        _digits[i].SetText(NumberToString(i));
+    }
+}
+
+
+
+void IndicatorDigits::Draw(uint32 number, const Color &color) const
+{
+    // Each digit is drawn on the left of the previous one, from the last digit.
+    do {
+        const TextImage &digit = _digits[number % 10];
+        digit.Draw(color);
+        VideoManager->MoveRelative(-digit.GetWidth(), 0.0f);
+        number /= 10;
+    } while(number > 0);
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 // IndicatorText class
 ////////////////////////////////////////////////////////////////////////////////
 
-IndicatorText::IndicatorText(BattleActor *actor, const std::string &text, const TextStyle &style,
-                             INDICATOR_TYPE indicator_type) :
-    IndicatorElement(actor, indicator_type),
-    _text_image(text, style)
+IndicatorText::IndicatorText(BattleActor *actor) :
+    IndicatorElement(actor, DAMAGE_INDICATOR),
+    _text(NULL),
+    _digits(NULL),
+    _number(0)
 {}
 
 
 
+void IndicatorText::SetNumber(uint32 number, const IndicatorDigits *digits, const Color &color,
+                              INDICATOR_TYPE indicator_type)
+{
+    _Reset(indicator_type);
+    _text = NULL;
+    _digits = digits;
+    _number = number;
+    _number_color = color;
+}
+
+
+
+void IndicatorText::SetText(const TextImage *text, INDICATOR_TYPE indicator_type)
+{
+    _Reset(indicator_type);
+    _text = text;
+    _digits = NULL;
+}
+
+
+
+float IndicatorText::ElementHeight() const
+{
+    if(_digits)
+        return _digits->GetHeight();
+    else if(_text)
+        return _text->GetHeight();
+    return 0.0f;
+}
+
+
+
 void IndicatorText::Draw()
 {
     IndicatorElement::Draw();
 
-    if(_ComputeDrawAlpha())
-        _text_image.Draw(_alpha_color);
-    else
-        _text_image.Draw();
+    if(_digits) {
+        Color color = _number_color;
+        if(_ComputeDrawAlpha())
+            color.SetAlpha(color.GetAlpha() * _alpha_color.GetAlpha());
+        _digits->Draw(_number, color);
+    } else if(_text) {
+        if(_ComputeDrawAlpha())
+            _text->Draw(_alpha_color);
+        else
+            _text->Draw();
+    }
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -354,6 +427,10 @@ IndicatorSupervisor::~IndicatorSupervisor()
     for(uint32 i = 0; i < _active_queue.size(); i++)
         delete _active_queue[i];
     _active_queue.clear();
+
+    for(uint32 i = 0; i < _text_pool.size(); i++)
+        delete _text_pool[i];
+    _text_pool.clear();
 }
 
 static bool IndicatorCompare(IndicatorElement *one, IndicatorElement *another)
@@ -370,7 +447,7 @@ void IndicatorSupervisor::Update()
     // Remove all expired elements from the active queue
     while(_active_queue.empty() == false) {
         if(_active_queue.front()->IsExpired() == true) {
-            delete _active_queue.front();
+            _ReleaseElement(_active_queue.front());
             _active_queue.pop_front();
         } else {
             // If the front element is not expired, no other elements should be expired either
@@ -396,6 +473,25 @@ void IndicatorSupervisor::Update()
         std::sort(_active_queue.begin(), _active_queue.end(), IndicatorCompare);
 }
 
+IndicatorText *IndicatorSupervisor::_GetTextIndicator()
+{
+    if(_text_pool.empty())
+        return new IndicatorText(_actor);
+
+    IndicatorText *indicator = _text_pool.back();
+    _text_pool.pop_back();
+    return indicator;
+}
+
+void IndicatorSupervisor::_ReleaseElement(IndicatorElement *element)
+{
+    IndicatorText *indicator = dynamic_cast<IndicatorText *>(element);
+    if(indicator)
+        _text_pool.push_back(indicator);
+    else
+        delete element;
+}
+
 bool IndicatorSupervisor::_FixPotentialIndicatorOverlapping(IndicatorElement *element)
 {
     if(!element)
@@ -441,41 +537,39 @@ void IndicatorSupervisor::AddDamageIndicator(uint32 amount)
         return;
     }
 
-    std::string text = NumberToString(amount);
-
-    TextStyle style;
+    Color color;
+    std::string font;
 
     float damage_percent = static_cast<float>(amount) / static_cast<float>(_actor->GetMaxHitPoints());
     if(damage_percent < 0.10f) {
-        style.color = low_red;
-        style.shadow_style = VIDEO_TEXT_SHADOW_BLACK;
+        color = low_red;
     } else if(damage_percent < 0.20f) {
-        style.color = mid_red;
-        style.shadow_style = VIDEO_TEXT_SHADOW_BLACK;
+        color = mid_red;
     } else if(damage_percent < 0.30f) {
-        style.color = high_red;
-        style.shadow_style = VIDEO_TEXT_SHADOW_BLACK;
+        color = high_red;
     } else { // (damage_percent >= 0.30f)
-        style.color = full_red;
-        style.shadow_style = VIDEO_TEXT_SHADOW_BLACK;
+        color = full_red;
     }
 
     // Set the text size depending on the amount of pure damage.
     if(amount < 50) {
-        style.font = "text24"; // text24
+        font = "text24"; // text24
     } else if(amount < 100) {
-        style.font = "text24.2";
+        font = "text24.2";
     } else if(amount < 250) {
-        style.font = "text26";
+        font = "text26";
     } else if(amount < 500) {
-        style.font = "text28";
+        font = "text28";
     } else if(amount < 1000) {
-        style.font = "text36";
+        font = "text36";
     } else {
-        style.font = "text48";
+        font = "text48";
     }
 
-    _wait_queue.push_back(new IndicatorText(_actor, text, style, DAMAGE_INDICATOR));
+    IndicatorText *indicator = _GetTextIndicator();
+    indicator->SetNumber(amount, BattleMode::CurrentInstance()->GetMedia().GetIndicatorDigits(font),
+                         color, DAMAGE_INDICATOR);
+    _wait_queue.push_back(indicator);
 }
 
 
@@ -495,39 +589,33 @@ void IndicatorSupervisor::AddHealingIndicator(uint32 amount, bool hit_points)
         return;
     }
 
-    std::string text = NumberToString(amount);
-    TextStyle style;
+    Color color;
 
     // Use different colors/shades of green/blue for different degrees of healing
     float healing_percent = static_cast<float>(amount / _actor->GetMaxHitPoints());
     if(healing_percent < 0.10f) {
-        style.font = "text24";
-        style.color = hit_points ? low_green : low_blue;
-        style.shadow_style = VIDEO_TEXT_SHADOW_BLACK;
+        color = hit_points ? low_green : low_blue;
     } else if(healing_percent < 0.20f) {
-        style.font = "text24";
-        style.color = hit_points ? mid_green : mid_blue;
-        style.shadow_style = VIDEO_TEXT_SHADOW_BLACK;
+        color = hit_points ? mid_green : mid_blue;
     } else if(healing_percent < 0.30f) {
-        style.font = "text24";
-        style.color = hit_points ? high_green : high_blue;
-        style.shadow_style = VIDEO_TEXT_SHADOW_BLACK;
+        color = hit_points ? high_green : high_blue;
     } else { // (healing_percent >= 0.30f)
-        style.font = "text24";
-        style.color = hit_points ? Color::green : Color::blue;
-        style.shadow_style = VIDEO_TEXT_SHADOW_BLACK;
+        color = hit_points ? Color::green : Color::blue;
     }
 
-    _wait_queue.push_back(new IndicatorText(_actor, text, style, HEALING_INDICATOR));
+    IndicatorText *indicator = _GetTextIndicator();
+    indicator->SetNumber(amount, BattleMode::CurrentInstance()->GetMedia().GetIndicatorDigits("text24"),
+                         color, HEALING_INDICATOR);
+    _wait_queue.push_back(indicator);
 }
 
 
 
 void IndicatorSupervisor::AddMissIndicator()
 {
-    std::string text = Translate("Miss");
-    TextStyle style("text24", Color::white);
-    _wait_queue.push_back(new IndicatorText(_actor, text, style, MISS_INDICATOR));
+    IndicatorText *indicator = _GetTextIndicator();
+    indicator->SetText(&BattleMode::CurrentInstance()->GetMedia().miss_indicator_text, MISS_INDICATOR);
+    _wait_queue.push_back(indicator);
 }
 
 
@@ -157,6 +157,11 @@ protected:
     //! \brief Updates the draw indicator effect position
     void _UpdateDrawPosition();
 
+    /** \brief Sets the element back to its state before being started, so that it can be reused
+    *** \param indicator_type The new indicator use in game.
+    **/
+    void _Reset(INDICATOR_TYPE indicator_type);
+
     /** \brief Calculates the standard alpha (transparency) value for drawing the element
     *** \return True if the alpha value is 1.0f and thus the indicator should be drawn with no alpha applied
     ***
@@ -169,42 +174,97 @@ protected:
 }; // class IndicatorElement
 
 
+/** ****************************************************************************
+*** \brief Draws numbers from the pre-rendered images of their digits
+***
+*** The ten digits of a font are rendered once, in white, so that any number can
+*** then be drawn in any color by modulating them, without rendering text nor
+*** uploading a texture again.
+*** ***************************************************************************/
+class IndicatorDigits
+{
+public:
+    //! \param font The name of the font to render the digits with
+    IndicatorDigits(const std::string &font);
+
+    ~IndicatorDigits()
+    {}
+
+    //! \brief Returns the height of the digits
+    float GetHeight() const {
+        return _digits[0].GetHeight();
+    }
+
+    /** \brief Draws a number, from its last digit to its first one
+    *** \param number The number to draw
+    *** \param color The color the white digits are modulated with, alpha included
+    *** \note The number is drawn on the left of the current cursor position, so the
+    *** VIDEO_X_RIGHT draw flag is expected to be set.
+    **/
+    void Draw(uint32 number, const vt_video::Color &color) const;
+
+private:
+    //! \brief The rendered images of the digits 0 to 9
+    vt_video::TextImage _digits[10];
+}; // class IndicatorDigits
+
+
 /** ****************************************************************************
 *** \brief Displays an item of text next to an actor
 ***
 *** Text indicators are normally used to display numeric text representing the
 *** amount of damage dealt to the actor or the amount of healing performed. Another
 *** common use is to display the word "Miss" when the actor is a target for a skill
-*** that did not connect successfully. The style of the rendered text can also be
-*** varied and is typically used for drawing text in different colors such as red
-*** for damage and green for healing. The text size may be made larger to indicate
-*** more powerful or otherwise significant changes as well.
+*** that did not connect successfully. The color of the text can be varied and is
+*** typically red for damage and green for healing. The text size may be made larger
+*** to indicate more powerful or otherwise significant changes as well.
+***
+*** The text is never rendered by the indicator itself: numbers are composed from
+*** shared pre-rendered digits and other texts are shared pre-rendered images, so
+*** that text indicators can be created and reused without any rendering cost.
 *** ***************************************************************************/
 class IndicatorText : public IndicatorElement
 {
 public:
-    /** \param actor A valid pointer to the actor object
-    *** \param text The text to use to render the text image
-    *** \param style The style to use to render the text image
-    *** \param indicator_type tells the indicator use in game.
-    **/
-    IndicatorText(BattleActor *actor, const std::string &text, const vt_video::TextStyle &style,
-                  INDICATOR_TYPE indicator_type);
+    //! \param actor A valid pointer to the actor object
+    IndicatorText(BattleActor *actor);
 
     ~IndicatorText()
     {}
 
-    //! \brief Returns the height of the rendered text image
-    float ElementHeight() const {
-        return _text_image.GetHeight();
-    }
+    /** \brief Sets the indicator to display a number
+    *** \param number The number to display
+    *** \param digits The digits to draw the number with, which must outlive the indicator.
+    *** \param color The color to draw the number with
+    *** \param indicator_type tells the indicator use in game.
+    **/
+    void SetNumber(uint32 number, const IndicatorDigits *digits, const vt_video::Color &color,
+                   INDICATOR_TYPE indicator_type);
 
-    //! \brief Draws the text image
+    /** \brief Sets the indicator to display a text image
+    *** \param text The rendered text to display, which must outlive the indicator.
+    *** \param indicator_type tells the indicator use in game.
+    **/
+    void SetText(const vt_video::TextImage *text, INDICATOR_TYPE indicator_type);
+
+    //! \brief Returns the height of the displayed text
+    float ElementHeight() const;
+
+    //! \brief Draws the text image or the number
     void Draw();
 
 protected:
-    //! \brief The rendered image of the text to display
-    vt_video::TextImage _text_image;
+    //! \brief The rendered text to display, or NULL when displaying a number
+    const vt_video::TextImage *_text;
+
+    //! \brief The digits to draw the number with, or NULL when displaying a text image
+    const IndicatorDigits *_digits;
+
+    //! \brief The number to display
+    uint32 _number;
+
+    //! \brief The color to draw the number with
+    vt_video::Color _number_color;
 }; // class IndicatorText  : public IndicatorElement
 
 
@@ -407,6 +467,15 @@ private:
     //! \brief A FIFO queue container of all elements that have begun and are going through their display sequence
     std::deque<IndicatorElement *> _active_queue;
 
+    //! \brief The expired text indicators, kept to be reused rather than allocated again
+    std::vector<IndicatorText *> _text_pool;
+
+    //! \brief Returns a text indicator from the pool, or a new one when the pool is empty.
+    IndicatorText *_GetTextIndicator();
+
+    //! \brief Puts back an expired text indicator into the pool and deletes the other elements.
+    void _ReleaseElement(IndicatorElement *element);
+
     //! Check the waiting queue and fix potential overlaps depending on the element position and type.
     //! \param element the Indicator Element which is about to be added.
     //! \return whether there were overlappiong elements whose positions were fixed.
@@ -0,0 +1,120 @@
+////////////////////////////////////////////////////////////////////////////////
+//            Copyright (C) 2013 by Bertram (Valyria Tear)
+//                         All Rights Reserved
+//
+// This code is licensed under the GNU GPL version 2. It is free software
+// and you may modify it and/or redistribute it under the terms of this license.
+// See http://www.gnu.org/copyleft/gpl.html for details.
+////////////////////////////////////////////////////////////////////////////////
+
+/** ****************************************************************************
+*** \file    battle_resources.cpp
+*** \author  Yohann Ferreira, yohann ferreira orange fr
+*** \brief   Source file for the battle resources kept across the battles
+*** ***************************************************************************/
+
+#include "modes/battle/battle_resources.h"
+
+#include "engine/script/script.h"
+
+#include "common/global/global.h"
+
+using namespace vt_utils;
+using namespace vt_video;
+using namespace vt_script;
+using namespace vt_global;
+
+template<> vt_battle::BattleResourceCache *Singleton<vt_battle::BattleResourceCache>::_singleton_reference = NULL;
+
+namespace vt_battle
+{
+
+BattleResourceCache *BattleResources = NULL;
+
+//! \brief The script file defining all the enemies, opened for each enemy created.
+const std::string ENEMY_DEFINITIONS_FILENAME = "dat/actors/enemies.lua";
+
+BattleResourceCache::~BattleResourceCache()
+{
+    Clear();
+}
+
+void BattleResourceCache::PrepareEnemy(uint32 enemy_id)
+{
+    if(!_prepared_enemies.insert(enemy_id).second)
+        return;
+
+    PrepareScript(ENEMY_DEFINITIONS_FILENAME);
+
+    // The enemy loads its animations, which are then kept with their images.
+    GlobalEnemy enemy(enemy_id);
+    if(enemy.GetID() == 0)
+        return;
+
+    _enemy_animations[enemy_id] = *enemy.GetBattleAnimations();
+    PrepareScript(enemy.GetDeathScriptFilename());
+}
+
+void BattleResourceCache::PrepareSkill(uint32 skill_id)
+{
+    if(!_prepared_skills.insert(skill_id).second)
+        return;
+
+    const private_global::SkillDefinition *definition = GlobalManager->GetSkillDefinition(skill_id);
+    for(std::map<uint32, std::string>::const_iterator it = definition->animation_scripts.begin();
+            it != definition->animation_scripts.end(); ++it) {
+        PrepareScript(it->second);
+    }
+}
+
+void BattleResourceCache::PrepareCharacters()
+{
+    GlobalParty *party = GlobalManager->GetActiveParty();
+    for(uint32 i = 0; i < party->GetPartySize(); ++i) {
+        GlobalCharacter *character = dynamic_cast<GlobalCharacter *>(party->GetActorAtIndex(i));
+        if(!character)
+            continue;
+
+        std::vector<GlobalSkill *> *skill_lists[3] = {
+            character->GetWeaponSkills(), character->GetBareHandsSkills(), character->GetMagicSkills()
+        };
+        for(uint32 j = 0; j < 3; ++j) {
+            for(uint32 k = 0; k < skill_lists[j]->size(); ++k)
+                PrepareSkill(skill_lists[j]->at(k)->GetID());
+        }
+    }
+}
+
+void BattleResourceCache::PrepareScript(const std::string &filename)
+{
+    if(!filename.empty())
+        ScriptManager->CacheScript(filename);
+}
+
+const AnimatedImage *BattleResourceCache::GetAnimation(const std::string &filename)
+{
+    std::map<std::string, AnimatedImage>::iterator it = _animations.find(filename);
+    if(it != _animations.end())
+        return &it->second;
+
+    PrepareScript(filename);
+    AnimatedImage &animation = _animations[filename];
+    if(!animation.LoadFromAnimationScript(filename)) {
+        _animations.erase(filename);
+        return NULL;
+    }
+    return &animation;
+}
+
+void BattleResourceCache::Clear()
+{
+    _prepared_enemies.clear();
+    _prepared_skills.clear();
+    _enemy_animations.clear();
+    _animations.clear();
+
+    if(ScriptManager)
+        ScriptManager->ClearCachedScripts();
+}
+
+} // namespace vt_battle
@@ -0,0 +1,102 @@
+////////////////////////////////////////////////////////////////////////////////
+//            Copyright (C) 2013 by Bertram (Valyria Tear)
+//                         All Rights Reserved
+//
+// This code is licensed under the GNU GPL version 2. It is free software
+// and you may modify it and/or redistribute it under the terms of this license.
+// See http://www.gnu.org/copyleft/gpl.html for details.
+////////////////////////////////////////////////////////////////////////////////
+
+/** ****************************************************************************
+*** \file    battle_resources.h
+*** \author  Yohann Ferreira, yohann ferreira orange fr
+*** \brief   Header file for the battle resources kept across the battles
+***
+*** The enemy definitions, the enemies animations and the death and skill
+*** animation scripts are needed by each battle again. They are loaded once and
+*** kept from one battle to the next, and can be prepared before the battle
+*** starts, e.g. as soon as the enemies of a map zone can be met.
+*** ***************************************************************************/
+
+#ifndef __BATTLE_RESOURCES_HEADER__
+#define __BATTLE_RESOURCES_HEADER__
+
+#include "engine/video/image.h"
+
+#include <map>
+#include <set>
+
+namespace vt_battle
+{
+
+class BattleResourceCache;
+
+//! \brief The singleton pointer responsible for keeping the battle resources.
+extern BattleResourceCache *BattleResources;
+
+/** ****************************************************************************
+*** \brief Keeps the resources used by the battles from one battle to the next
+***
+*** The script files are compiled once and their bytecode is kept by the script
+*** engine, so that opening them again neither reads nor parses them. Opening
+*** them still runs them, so that each actor gets its own script data as before.
+*** The animations are kept loaded, so that their images aren't freed at the end
+*** of a battle and loaded again by the next one.
+***
+*** \note The resources are freed with Clear(), each time a map is loaded, and when the game exits.
+*** ***************************************************************************/
+class BattleResourceCache : public vt_utils::Singleton<BattleResourceCache>
+{
+    friend class vt_utils::Singleton<BattleResourceCache>;
+
+public:
+    ~BattleResourceCache();
+
+    bool SingletonInitialize() {
+        return true;
+    }
+
+    /** \brief Prepares the resources of an enemy, once per enemy id
+    *** The enemy definitions and death scripts are compiled, and the enemy
+    *** battle animations are kept loaded.
+    **/
+    void PrepareEnemy(uint32 enemy_id);
+
+    /** \brief Prepares the animation scripts of a skill for all the characters, once per skill id
+    *** \param skill_id The id of the skill, whose definition gives the animation scripts.
+    **/
+    void PrepareSkill(uint32 skill_id);
+
+    //! \brief Prepares the skills of the characters in the active party.
+    void PrepareCharacters();
+
+    //! \brief Compiles a script file used by the battles, once. Empty filenames are ignored.
+    void PrepareScript(const std::string &filename);
+
+    /** \brief Returns the animation loaded from an animation script, loading it the first time
+    *** \param filename The animation script file.
+    *** \return The loaded animation, to be copied, or NULL when it couldn't be loaded.
+    **/
+    const vt_video::AnimatedImage *GetAnimation(const std::string &filename);
+
+    //! \brief Frees all the battle resources kept.
+    void Clear();
+
+private:
+    BattleResourceCache()
+    {}
+
+    //! \brief The ids of the enemies and skills already prepared
+    std::set<uint32> _prepared_enemies;
+    std::set<uint32> _prepared_skills;
+
+    //! \brief The battle animations of the prepared enemies, keeping their images loaded
+    std::map<uint32, std::vector<vt_video::AnimatedImage> > _enemy_animations;
+
+    //! \brief The animations loaded by GetAnimation(), by animation script filename
+    std::map<std::string, vt_video::AnimatedImage> _animations;
+}; // class BattleResourceCache
+
+} // namespace vt_battle
+
+#endif // __BATTLE_RESOURCES_HEADER__
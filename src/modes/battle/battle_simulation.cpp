@@ -0,0 +1,245 @@
+////////////////////////////////////////////////////////////////////////////////
+//            Copyright (C) 2013 by Bertram (Valyria Tear)
+//                         All Rights Reserved
+//
+// This code is licensed under the GNU GPL version 2. It is free software
+// and you may modify it and/or redistribute it under the terms of this license.
+// See http://www.gnu.org/copyleft/gpl.html for details.
+////////////////////////////////////////////////////////////////////////////////
+
+/** ****************************************************************************
+*** \file    battle_simulation.cpp
+*** \author  Yohann Ferreira, yohann ferreira orange fr
+*** \brief   Source file for the battle simulations.
+*** ***************************************************************************/
+
+#include "modes/battle/battle_simulation.h"
+
+#include "modes/battle/battle.h"
+#include "modes/battle/battle_actors.h"
+
+#include "engine/script/script_read.h"
+#include "engine/system.h"
+
+#include "common/global/global.h"
+#include "common/global/global_skills.h"
+
+using namespace vt_utils;
+using namespace vt_script;
+using namespace vt_system;
+using namespace vt_global;
+using namespace vt_battle::private_battle;
+
+namespace vt_battle
+{
+
+BattleSimulationMode *BattleSimulationMode::_current_instance = NULL;
+
+BattleSimulationMode::BattleSimulationMode(const std::string &script_filename, const std::string &function_name,
+                                           uint32 battle_count, uint32 first_seed) :
+    _script_filename(script_filename),
+    _function_name(function_name),
+    _battle_count(battle_count),
+    _battles_done(0),
+    _seed(first_seed),
+    _battle_running(false),
+    _battle_start_ticks(0),
+    _victories(0),
+    _defeats(0),
+    _total_actions(0),
+    _total_battle_time(0.0),
+    _total_real_time(0.0)
+{
+    _current_instance = this;
+
+    // Many fixed update steps are done for each drawn frame, whatever the real time.
+    SystemManager->SetFixedUpdateStep(BATTLE_SIMULATION_UPDATE_STEP);
+    SystemManager->SetSimulatedFrameTime(SYSTEM_MAX_FRAME_TIME);
+}
+
+
+
+BattleSimulationMode::~BattleSimulationMode()
+{
+    if(_current_instance == this)
+        _current_instance = NULL;
+}
+
+
+
+void BattleSimulationMode::Update()
+{
+    // The battle pushed is not active yet.
+    if(_battle_running)
+        return;
+
+    if(_battles_done >= _battle_count || !_StartBattle()) {
+        _PrintReport();
+        SystemManager->ExitGame();
+    }
+}
+
+
+
+void BattleSimulationMode::NotifyBattleFinished(BATTLE_STATE result, uint32 action_count, uint32 battle_time)
+{
+    if(!_battle_running) {
+        IF_PRINT_WARNING(BATTLE_DEBUG) << "no simulated battle was running" << std::endl;
+        return;
+    }
+    _battle_running = false;
+    ++_battles_done;
+
+    if(result == BATTLE_STATE_VICTORY)
+        ++_victories;
+    else if(result == BATTLE_STATE_DEFEAT)
+        ++_defeats;
+
+    _total_actions += action_count;
+    _total_battle_time += battle_time;
+    _total_real_time += SDL_GetTicks() - _battle_start_ticks;
+}
+
+
+
+bool BattleSimulationMode::_StartBattle()
+{
+    // Each battle starts from the same data and a known seed.
+    GlobalManager->ClearAllData();
+    srand(_seed++);
+
+    _battle_start_ticks = SDL_GetTicks();
+
+    ReadScriptDescriptor script;
+    if(!script.RunScriptFunction(_script_filename, _function_name, true))
+        return false;
+
+    BattleMode *battle = BattleMode::CurrentInstance();
+    if(battle == NULL) {
+        PRINT_ERROR << "The function " << _function_name << " didn't push a new battle mode" << std::endl;
+        return false;
+    }
+
+    battle->SetSimulated(true);
+    _battle_running = true;
+    return true;
+}
+
+
+
+void BattleSimulationMode::_PrintReport()
+{
+    std::cout << "Battle simulations: " << _script_filename << ", " << _function_name << "()" << std::endl
+              << "  Battles:            " << _battles_done << std::endl;
+    if(_battles_done == 0)
+        return;
+
+    float battles = static_cast<float>(_battles_done);
+    uint32 timeouts = _battles_done - _victories - _defeats;
+    std::cout << "  Victories:          " << _victories << " (" << 100.0f * _victories / battles << "%)" << std::endl
+              << "  Defeats:            " << _defeats << " (" << 100.0f * _defeats / battles << "%)" << std::endl
+              << "  Unfinished:         " << timeouts << " (" << 100.0f * timeouts / battles << "%)" << std::endl
+              << "  Actions per battle: " << _total_actions / battles << std::endl
+              << "  Simulated time:     " << _total_battle_time / battles / 1000.0 << " s per battle" << std::endl
+              << "  Real time:          " << _total_real_time / battles << " ms per battle" << std::endl;
+}
+
+
+
+SkillBenchmarkMode::SkillBenchmarkMode(const std::string &script_filename, uint32 execution_count, uint32 seed) :
+    _script_filename(script_filename),
+    _execution_count(execution_count),
+    _seed(seed)
+{}
+
+
+
+void SkillBenchmarkMode::Update()
+{
+    if(!_Run())
+        PRINT_ERROR << "The skill benchmark couldn't be run: " << _script_filename << std::endl;
+    SystemManager->ExitGame();
+}
+
+
+
+bool SkillBenchmarkMode::_Run()
+{
+    GlobalManager->ClearAllData();
+
+    ReadScriptDescriptor script;
+    if(!script.OpenFile(_script_filename))
+        return false;
+
+    uint32 skill_id = script.ReadUInt("benchmark_skill_id");
+    luabind::object battle_execute = script.ReadFunctionPointer("BenchmarkSkillBattleExecute");
+    bool setup_done = script.DoesFunctionExist("BenchmarkSkillsSetup") && script.RunScriptFunction("BenchmarkSkillsSetup");
+    script.CloseFile();
+    if(!setup_done || !battle_execute.is_valid())
+        return false;
+
+    GlobalSkill skill(skill_id);
+    if(!skill.IsValid() || !skill.GetBattleEffect().valid) {
+        PRINT_ERROR << "The skill " << skill_id << " has no battle effect table" << std::endl;
+        return false;
+    }
+
+    BattleMode *battle = BattleMode::CurrentInstance();
+    if(battle == NULL) {
+        PRINT_ERROR << "The BenchmarkSkillsSetup function didn't push a new battle mode" << std::endl;
+        return false;
+    }
+
+    // The battle isn't active yet: its actors are created right away instead.
+    battle->Reset();
+    if(battle->GetCharacterActors().empty() || battle->GetEnemyActors().empty()) {
+        PRINT_ERROR << "The benchmark battle needs at least one character and one enemy" << std::endl;
+        return false;
+    }
+
+    BattleActor *user = battle->GetCharacterActors().front();
+    BattleActor *target_actor = battle->GetEnemyActors().front();
+    BattleTarget target;
+    if(!target.SetActorTarget(GLOBAL_TARGET_FOE, target_actor))
+        return false;
+
+    srand(_seed);
+    uint32 start_ticks = SDL_GetTicks();
+    for(uint32 i = 0; i < _execution_count; ++i) {
+        target_actor->ResetActor();
+        ExecuteSkillBattleEffect(user, &target, skill.GetBattleEffect());
+    }
+    uint32 native_time = SDL_GetTicks() - start_ticks;
+    int32 native_next_random = rand();
+
+    srand(_seed);
+    start_ticks = SDL_GetTicks();
+    for(uint32 i = 0; i < _execution_count; ++i) {
+        target_actor->ResetActor();
+        try {
+            ScriptCallFunction<void>(battle_execute, user, target);
+        } catch(const luabind::error &err) {
+            ScriptManager->HandleLuaError(err);
+            return false;
+        } catch(const luabind::cast_failed &e) {
+            ScriptManager->HandleCastError(e);
+            return false;
+        }
+    }
+    uint32 script_time = SDL_GetTicks() - start_ticks;
+    int32 script_next_random = rand();
+
+    // Both runs must have taken the same random numbers to execute the same branches.
+    if(native_next_random != script_next_random)
+        PRINT_WARNING << "The battle effect and the Lua script didn't take the same random numbers, "
+                      << "their timings don't compare the same executions" << std::endl;
+
+    float executions = static_cast<float>(_execution_count);
+    std::cout << "Skill benchmark: " << _script_filename << ", skill " << skill_id << std::endl
+              << "  Executions:    " << _execution_count << std::endl
+              << "  Battle effect: " << native_time << " ms (" << 1000.0f * native_time / executions << " us per execution)" << std::endl
+              << "  Lua script:    " << script_time << " ms (" << 1000.0f * script_time / executions << " us per execution)" << std::endl;
+    return true;
+}
+
+} // namespace vt_battle
@@ -0,0 +1,171 @@
+////////////////////////////////////////////////////////////////////////////////
+//            Copyright (C) 2013 by Bertram (Valyria Tear)
+//                         All Rights Reserved
+//
+// This code is licensed under the GNU GPL version 2. It is free software
+// and you may modify it and/or redistribute it under the terms of this license.
+// See http://www.gnu.org/copyleft/gpl.html for details.
+////////////////////////////////////////////////////////////////////////////////
+
+/** ****************************************************************************
+*** \file    battle_simulation.h
+*** \author  Yohann Ferreira, yohann ferreira orange fr
+*** \brief   Header file for the battle simulations.
+***
+*** Battle simulations run the same battle many times without any player, in
+*** accelerated simulated time, and report how the battles went. They are used
+*** to balance the battles and to measure the performance of the battle code.
+*** ***************************************************************************/
+
+#ifndef __BATTLE_SIMULATION_HEADER__
+#define __BATTLE_SIMULATION_HEADER__
+
+#include "modes/battle/battle_utils.h"
+
+#include "engine/mode_manager.h"
+
+namespace vt_battle
+{
+
+namespace private_battle
+{
+
+//! \brief The duration of the battle update steps while simulating, in milliseconds.
+const uint32 BATTLE_SIMULATION_UPDATE_STEP = 10;
+
+//! \brief The simulated time after which a battle is considered to never end, in milliseconds.
+const uint32 BATTLE_SIMULATION_TIME_LIMIT = 30 * 60 * 1000;
+
+} // namespace private_battle
+
+/** ****************************************************************************
+*** \brief Runs the same battle many times and reports the results
+***
+*** The battle is set up by a script function, in the same way as the debug
+*** battles: it adds the characters and their items, then pushes the battle
+*** mode. The characters then pick a random skill and target as the enemies do,
+*** and the battle ends as soon as it is won or lost, without the finish screens.
+*** Each battle starts with a new random seed, so that the runs are repeatable.
+***
+*** The battles are updated by fixed steps, many steps per drawn frame, so that
+*** they run as fast as the machine permits. Running the game with the null
+*** video target then leaves almost only the battle code to measure.
+*** ***************************************************************************/
+class BattleSimulationMode : public vt_mode_manager::GameMode
+{
+public:
+    /** \param script_filename The script setting up the battle
+    *** \param function_name The script function setting up the battle
+    *** \param battle_count The number of battles to run
+    *** \param first_seed The random seed of the first battle, incremented for each battle
+    **/
+    BattleSimulationMode(const std::string &script_filename, const std::string &function_name,
+                         uint32 battle_count, uint32 first_seed);
+
+    ~BattleSimulationMode();
+
+    //! \brief Returns a pointer to the currently active instance of the battle simulation mode
+    static BattleSimulationMode *CurrentInstance() {
+        return _current_instance;
+    }
+
+    void Reset()
+    {}
+
+    //! \brief Starts the next battle, or prints the report and exits once all the battles ran.
+    void Update();
+
+    void Draw()
+    {}
+
+    /** \brief Called by the simulated battle when it ends
+    *** \param result BATTLE_STATE_VICTORY or BATTLE_STATE_DEFEAT, or any other state when the battle didn't end in time.
+    *** \param action_count The number of actions executed during the battle.
+    *** \param battle_time The simulated duration of the battle, in milliseconds.
+    **/
+    void NotifyBattleFinished(private_battle::BATTLE_STATE result, uint32 action_count, uint32 battle_time);
+
+private:
+    //! \brief The battle simulation mode currently running
+    static BattleSimulationMode *_current_instance;
+
+    //! \brief The script and function setting up the battle
+    std::string _script_filename;
+    std::string _function_name;
+
+    //! \brief The number of battles to run, and the number of battles done
+    uint32 _battle_count;
+    uint32 _battles_done;
+
+    //! \brief The random seed of the next battle
+    uint32 _seed;
+
+    //! \brief Whether a battle was started and didn't end yet
+    bool _battle_running;
+
+    //! \brief The real time when the running battle was started, in milliseconds
+    uint32 _battle_start_ticks;
+
+    //! \brief The results of the battles done
+    uint32 _victories;
+    uint32 _defeats;
+    uint32 _total_actions;
+    double _total_battle_time;
+    double _total_real_time;
+
+    //! \brief Sets up the next battle. Returns false if the setup script failed.
+    bool _StartBattle();
+
+    //! \brief Prints the results of the battles done on the standard output
+    void _PrintReport();
+}; // class BattleSimulationMode
+
+/** ****************************************************************************
+*** \brief Measures the cost of executing a skill natively and through a script
+***
+*** The script sets up a battle in its BenchmarkSkillsSetup() function, in the
+*** same way as the battle simulations do. The benchmark_skill_id skill, which
+*** must have a battle effect table, is then executed many times by the first
+*** character on the first enemy, first through ExecuteSkillBattleEffect(),
+*** then through the BenchmarkSkillBattleExecute(user, target) script function
+*** doing the same thing. Both durations are printed, and the game exits.
+***
+*** The target is reset before each execution, so that it never dies, and the
+*** same random seed is used for both runs, so that they take the same branches.
+*** A warning is printed when the runs didn't leave the random numbers in the same state.
+*** ***************************************************************************/
+class SkillBenchmarkMode : public vt_mode_manager::GameMode
+{
+public:
+    /** \param script_filename The script setting up the battle and defining the skill to execute
+    *** \param execution_count The number of times the skill is executed in each way
+    *** \param seed The random seed used for both runs
+    **/
+    SkillBenchmarkMode(const std::string &script_filename, uint32 execution_count, uint32 seed);
+
+    void Reset()
+    {}
+
+    //! \brief Runs the benchmark, prints the report and exits.
+    void Update();
+
+    void Draw()
+    {}
+
+private:
+    //! \brief The script setting up the battle and defining the skill to execute
+    std::string _script_filename;
+
+    //! \brief The number of times the skill is executed in each way
+    uint32 _execution_count;
+
+    //! \brief The random seed used for both runs
+    uint32 _seed;
+
+    //! \brief Runs both benchmarks and prints their durations. Returns false if they couldn't be set up.
+    bool _Run();
+}; // class SkillBenchmarkMode
+
+} // namespace vt_battle
+
+#endif // __BATTLE_SIMULATION_HEADER__
@@ -25,11 +25,14 @@
 
 #include "common/global/global.h"
 
+#include "engine/audio/audio.h"
 #include "engine/system.h"
 
 using namespace vt_utils;
 using namespace vt_system;
+using namespace vt_audio;
 using namespace vt_global;
+using namespace vt_global::private_global;
 
 namespace vt_battle
 {
@@ -417,6 +420,77 @@ uint32 CalculateMagicalDamageMultiplier(BattleActor *attacker, BattleTarget *tar
     return static_cast<uint32>(total_dmg);
 } // uint32 CalculateMagicalDamageMultiplier(BattleActor* attacker, BattleTarget* target, float mul_phys, float std_dev)
 
+
+
+//! \brief Applies a skill battle effect on an attack point or actor target.
+static void _ExecuteSkillBattleEffectOnTarget(BattleActor *user, BattleTarget *target, const SkillBattleEffect &effect)
+{
+    BattleActor *target_actor = target->GetActor();
+
+    if(CalculateStandardEvasionAdder(target, effect.evade_adder)) {
+        target_actor->RegisterMiss(true);
+        if(!effect.miss_sound.empty())
+            AudioManager->PlaySound(effect.miss_sound);
+        return;
+    }
+
+    // Like the skill scripts, no random number is taken for the certain status changes.
+    if(effect.status != GLOBAL_STATUS_INVALID
+            && (effect.status_chance >= 100.0f || RandomFloat(0.0f, 100.0f) <= effect.status_chance)) {
+        // The same duration as the standard skill scripts.
+        uint32 effect_duration = user->GetVigor() * 2000;
+        if(effect_duration < 15000)
+            effect_duration = 15000;
+        target_actor->RegisterStatusChange(effect.status, effect.status_intensity, effect_duration);
+    }
+
+    if(effect.damage_type != GLOBAL_DAMAGE_INVALID) {
+        uint32 damage = 0;
+        if(effect.damage_type == GLOBAL_DAMAGE_MAGICAL) {
+            damage = (effect.damage_multiplier != 1.0f) ?
+                     CalculateMagicalDamageMultiplier(user, target, effect.damage_multiplier) :
+                     CalculateMagicalDamageAdder(user, target, effect.damage_adder);
+        } else {
+            damage = (effect.damage_multiplier != 1.0f) ?
+                     CalculatePhysicalDamageMultiplier(user, target, effect.damage_multiplier) :
+                     CalculatePhysicalDamageAdder(user, target, effect.damage_adder);
+        }
+        target_actor->RegisterDamage(damage, target);
+    }
+
+    if(!effect.hit_sound.empty())
+        AudioManager->PlaySound(effect.hit_sound);
+}
+
+void ExecuteSkillBattleEffect(BattleActor *user, BattleTarget *target, const SkillBattleEffect &effect)
+{
+    if(user == NULL || target == NULL) {
+        IF_PRINT_WARNING(BATTLE_DEBUG) << "function received NULL argument" << std::endl;
+        return;
+    }
+    if(!effect.valid) {
+        IF_PRINT_WARNING(BATTLE_DEBUG) << "function received an invalid skill battle effect" << std::endl;
+        return;
+    }
+
+    if(!IsTargetParty(target->GetType())) {
+        _ExecuteSkillBattleEffectOnTarget(user, target, effect);
+        return;
+    }
+
+    // The evasion and damage functions only work on single actors.
+    GLOBAL_TARGET actor_type = IsTargetAlly(target->GetType()) ? GLOBAL_TARGET_ALLY : GLOBAL_TARGET_FOE;
+    BattleActor *actor = NULL;
+    for(uint32 i = 0; (actor = target->GetPartyActor(i)) != NULL; ++i) {
+        if(!actor->IsAlive())
+            continue;
+
+        BattleTarget actor_target;
+        if(actor_target.SetActorTarget(actor_type, actor))
+            _ExecuteSkillBattleEffectOnTarget(user, &actor_target, effect);
+    }
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 // BattleTarget class
 ////////////////////////////////////////////////////////////////////////////////
@@ -314,6 +314,17 @@ uint32 CalculateMagicalDamageMultiplier(BattleActor *attacker, BattleTarget *tar
 uint32 CalculateMagicalDamageMultiplier(BattleActor *attacker, BattleTarget *target, float mul_atk, float std_dev);
 //@}
 
+/** \brief Applies the standard battle effect of a skill on a target
+*** \param user A pointer to the actor using the skill
+*** \param target A pointer to the target of the skill
+*** \param effect The skill battle effect to apply
+***
+*** This does natively what the standard skill scripts do: when the target doesn't evade, the status
+*** change is applied first, so that a potential target death handles the effect removal properly, then
+*** the damage is dealt. Party targets have the effect applied on each of their living actors.
+**/
+void ExecuteSkillBattleEffect(BattleActor *user, BattleTarget *target, const vt_global::private_global::SkillBattleEffect &effect);
+
 /** ****************************************************************************
 *** \brief Container class for representing the target of a battle action
 ***
@@ -529,6 +540,11 @@ public:
     **/
     void DecrementBattleCount();
 
+    //! \brief Sets the available count back to the actual count of the item, e.g. at battle restart.
+    void ResetBattleCount() {
+        _battle_count = _item.GetCount();
+    }
+
     /** \brief A wrapper function that retrieves the actual count of the item
     *** \note Calling this function is equivalent to calling GetItem().GetCount()
     *** Note that the battle and inventory counts are separated because the changes are only committed
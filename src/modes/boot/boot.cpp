@@ -416,16 +416,13 @@ bool BootMode::_SavesAvailable(int32 maxId)
 {
     assert(maxId > 0);
     int32 savesAvailable = 0;
-    std::string data_path = GetUserDataPath();
     for(int id = 0; id < maxId; ++id) {
-        std::ostringstream f;
-        f << data_path + "saved_game_" << id << ".lua";
-        const std::string filename = f.str();
-
-        if(DoesFileExist(filename)) {
+        if(!FindSaveGameFilename(id).empty()) {
             ++savesAvailable;
         }
     }
+    if(!FindSaveGameFilename(AUTOSAVE_SLOT_ID).empty())
+        ++savesAvailable;
     return (savesAvailable > 0);
 }
 
@@ -1117,6 +1114,12 @@ bool BootMode::_SaveSettingsFile(const std::string &filename)
     settings_lua.WriteBool("full_screen", VideoManager->IsFullscreen());
     settings_lua.WriteComment("Used smoothed tile sprites when playing");
     settings_lua.WriteBool("smooth_graphics", VideoManager->ShouldSmoothPixelArt());
+    settings_lua.WriteComment("Synchronize the frames with the screen refresh rate");
+    settings_lua.WriteBool("vsync", VideoManager->IsVSyncRequested());
+    settings_lua.WriteComment("Maximum frames per second when the vertical sync isn't available (0: no limit)");
+    settings_lua.WriteInt("frame_rate_limit", SystemManager->GetFrameRateLimit());
+    settings_lua.WriteComment("Game update step in milliseconds (0: once per frame)");
+    settings_lua.WriteInt("fixed_update_step", SystemManager->GetFixedUpdateStep());
     settings_lua.EndTable(); // video_settings
 
     // audio
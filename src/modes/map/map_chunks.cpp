@@ -0,0 +1,354 @@
+////////////////////////////////////////////////////////////////////////////////
+//            Copyright (C) 2013 by Bertram (Valyria Tear)
+//                         All Rights Reserved
+//
+// This code is licensed under the GNU GPL version 2. It is free software
+// and you may modify it and/or redistribute it under the terms of this license.
+// See http://www.gnu.org/copyleft/gpl.html for details.
+////////////////////////////////////////////////////////////////////////////////
+
+/** ****************************************************************************
+*** \file    map_chunks.cpp
+*** \author  Yohann Ferreira, yohann ferreira orange fr
+*** \brief   Source file for the packed map data files
+*** ***************************************************************************/
+
+#include "modes/map/map_chunks.h"
+
+using namespace vt_utils;
+
+namespace vt_map
+{
+
+namespace private_map
+{
+
+//! \brief The first bytes of a packed map data file.
+static const uint32 MAP_CHUNK_FILE_MAGIC = 0x504D5456; // "VTMP"
+
+//! \brief Changes whenever the packed file format changes, to ignore the older files.
+static const uint32 MAP_CHUNK_FILE_VERSION = 1;
+
+template <typename T>
+static inline void _WriteValue(std::ofstream &file, const T &value)
+{
+    file.write(reinterpret_cast<const char *>(&value), sizeof(T));
+}
+
+template <typename T>
+static inline bool _ReadValue(std::ifstream &file, T &value)
+{
+    file.read(reinterpret_cast<char *>(&value), sizeof(T));
+    return file.good();
+}
+
+//! \brief The upper bounds of the counts read from a packed file, which are never trusted.
+//@{
+static const uint32 MAP_CHUNK_FILE_MAX_TILESETS = 256;
+static const uint32 MAP_CHUNK_FILE_MAX_FILENAME_LENGTH = 4096;
+//! The layer tiles are int16 indeces in the referenced tiles.
+static const uint32 MAP_CHUNK_FILE_MAX_REFERENCED_TILES = 32768;
+static const uint32 MAP_CHUNK_FILE_MAX_LAYERS = 256;
+//@}
+
+/** \brief Reads a number of elements from a packed file
+*** \param file_size The whole file size.
+*** \param element_size The minimum size of each element in the file.
+*** \param max_count The maximum number of elements.
+*** \return false when the count couldn't be read, exceeds max_count, or
+*** doesn't fit in the rest of the file.
+**/
+static bool _ReadCount(std::ifstream &file, std::streamoff file_size, uint32 element_size,
+                       uint32 max_count, uint32 &count)
+{
+    if(!_ReadValue(file, count) || count > max_count)
+        return false;
+
+    std::streamoff remaining_size = file_size - static_cast<std::streamoff>(file.tellg());
+    return static_cast<std::streamoff>(count) * element_size <= remaining_size;
+}
+
+MapChunkFile::MapChunkFile() :
+    _num_tile_x_axis(0),
+    _num_tile_y_axis(0),
+    _num_grid_x_axis(0),
+    _num_grid_y_axis(0),
+    _num_chunk_x_axis(0),
+    _num_chunk_y_axis(0)
+{}
+
+MapChunkFile::~MapChunkFile()
+{
+    Close();
+}
+
+std::string MapChunkFile::GetPackedFilename(const std::string &map_data_filename, uint32 &data_hash)
+{
+    data_hash = HashFile(HASH_SEED, map_data_filename);
+
+    std::string packed_directory = GetUserDataPath() + "maps/";
+    if(!DoesFileExist(packed_directory))
+        MakeDirectory(packed_directory);
+
+    // The map data file name is hashed too, so that two copies of a map don't share their packed file.
+    uint32 name_hash = HashData(HASH_SEED, reinterpret_cast<const uint8 *>(map_data_filename.c_str()),
+                                map_data_filename.size());
+    std::ostringstream filename;
+    filename << packed_directory << "map_" << std::hex << name_hash << ".pak";
+    return filename.str();
+}
+
+bool MapChunkFile::Write(const std::string &filename, uint32 data_hash,
+                         const std::vector<std::string> &tileset_filenames,
+                         const std::vector<uint32> &referenced_tiles,
+                         uint16 num_tile_x_axis, uint16 num_tile_y_axis,
+                         const std::vector<Layer> &layers,
+                         const std::vector<std::vector<uint32> > &collision_grid)
+{
+    if(collision_grid.empty() || num_tile_x_axis == 0 || num_tile_y_axis == 0)
+        return false;
+
+    // Write to a temporary file first, so that a packed file is never left half written.
+    std::string temp_filename = filename + ".tmp";
+    std::ofstream file(temp_filename.c_str(), std::ios::out | std::ios::binary | std::ios::trunc);
+    if(!file) {
+        PRINT_WARNING << "Couldn't create the packed map data file: " << temp_filename << std::endl;
+        return false;
+    }
+
+    _WriteValue(file, MAP_CHUNK_FILE_MAGIC);
+    _WriteValue(file, MAP_CHUNK_FILE_VERSION);
+    _WriteValue(file, data_hash);
+    _WriteValue(file, TILE_CHUNK_SIZE);
+    _WriteValue(file, num_tile_x_axis);
+    _WriteValue(file, num_tile_y_axis);
+
+    uint16 num_grid_y_axis = collision_grid.size();
+    uint16 num_grid_x_axis = collision_grid[0].size();
+    _WriteValue(file, num_grid_x_axis);
+    _WriteValue(file, num_grid_y_axis);
+
+    _WriteValue(file, static_cast<uint32>(tileset_filenames.size()));
+    for(uint32 i = 0; i < tileset_filenames.size(); ++i) {
+        _WriteValue(file, static_cast<uint32>(tileset_filenames[i].size()));
+        file.write(tileset_filenames[i].c_str(), tileset_filenames[i].size());
+    }
+
+    _WriteValue(file, static_cast<uint32>(referenced_tiles.size()));
+    for(uint32 i = 0; i < referenced_tiles.size(); ++i)
+        _WriteValue(file, referenced_tiles[i]);
+
+    _WriteValue(file, static_cast<uint32>(layers.size()));
+    for(uint32 i = 0; i < layers.size(); ++i)
+        _WriteValue(file, static_cast<uint8>(layers[i].layer_type));
+
+    // The collision grid, row by row
+    std::vector<uint32> grid_row(num_grid_x_axis, 0);
+    for(uint16 y = 0; y < num_grid_y_axis; ++y) {
+        for(uint16 x = 0; x < num_grid_x_axis; ++x)
+            grid_row[x] = x < collision_grid[y].size() ? collision_grid[y][x] : 1;
+        file.write(reinterpret_cast<const char *>(&grid_row[0]), num_grid_x_axis * sizeof(uint32));
+    }
+
+    // The tile chunks, row by row
+    uint16 num_chunk_x_axis = (num_tile_x_axis + TILE_CHUNK_SIZE - 1) / TILE_CHUNK_SIZE;
+    uint16 num_chunk_y_axis = (num_tile_y_axis + TILE_CHUNK_SIZE - 1) / TILE_CHUNK_SIZE;
+    std::vector<int16> chunk(TILE_CHUNK_SIZE * TILE_CHUNK_SIZE, -1);
+
+    for(uint16 chunk_y = 0; chunk_y < num_chunk_y_axis; ++chunk_y) {
+        for(uint16 chunk_x = 0; chunk_x < num_chunk_x_axis; ++chunk_x) {
+            for(uint32 layer_id = 0; layer_id < layers.size(); ++layer_id) {
+                const std::vector<std::vector<int16> > &tiles = layers[layer_id].tiles;
+
+                for(uint16 y = 0; y < TILE_CHUNK_SIZE; ++y) {
+                    uint32 tile_y = chunk_y * TILE_CHUNK_SIZE + y;
+                    for(uint16 x = 0; x < TILE_CHUNK_SIZE; ++x) {
+                        uint32 tile_x = chunk_x * TILE_CHUNK_SIZE + x;
+                        // Invalid layers have no tiles at all.
+                        if(tile_y < tiles.size() && tile_x < tiles[tile_y].size())
+                            chunk[y * TILE_CHUNK_SIZE + x] = tiles[tile_y][tile_x];
+                        else
+                            chunk[y * TILE_CHUNK_SIZE + x] = -1;
+                    }
+                }
+
+                file.write(reinterpret_cast<const char *>(&chunk[0]), chunk.size() * sizeof(int16));
+            }
+        }
+    }
+
+    file.close();
+    if(file.fail()) {
+        PRINT_WARNING << "Couldn't write the packed map data file: " << temp_filename << std::endl;
+        DeleteFile(temp_filename);
+        return false;
+    }
+
+    return MoveFile(temp_filename, filename);
+}
+
+bool MapChunkFile::Open(const std::string &filename, uint32 data_hash)
+{
+    Close();
+
+    if(!DoesFileExist(filename))
+        return false;
+
+    _file.open(filename.c_str(), std::ios::in | std::ios::binary);
+    if(!_file)
+        return false;
+
+    // The counts read are checked against the file size before allocating anything.
+    _file.seekg(0, std::ios::end);
+    std::streamoff file_size = _file.tellg();
+    _file.seekg(0, std::ios::beg);
+
+    uint32 magic = 0;
+    uint32 version = 0;
+    uint32 file_data_hash = 0;
+    uint16 chunk_size = 0;
+    if(!_ReadValue(_file, magic) || magic != MAP_CHUNK_FILE_MAGIC
+            || !_ReadValue(_file, version) || version != MAP_CHUNK_FILE_VERSION
+            || !_ReadValue(_file, file_data_hash) || file_data_hash != data_hash
+            || !_ReadValue(_file, chunk_size) || chunk_size != TILE_CHUNK_SIZE) {
+        Close();
+        return false;
+    }
+
+    if(!_ReadValue(_file, _num_tile_x_axis) || !_ReadValue(_file, _num_tile_y_axis)
+            || !_ReadValue(_file, _num_grid_x_axis) || !_ReadValue(_file, _num_grid_y_axis)) {
+        Close();
+        return false;
+    }
+
+    uint32 count = 0;
+    if(!_ReadCount(_file, file_size, sizeof(uint32), MAP_CHUNK_FILE_MAX_TILESETS, count)) {
+        Close();
+        return false;
+    }
+    for(uint32 i = 0; i < count; ++i) {
+        uint32 length = 0;
+        if(!_ReadCount(_file, file_size, 1, MAP_CHUNK_FILE_MAX_FILENAME_LENGTH, length)) {
+            Close();
+            return false;
+        }
+        std::string tileset_filename(length, '\0');
+        if(length > 0 && !_file.read(&tileset_filename[0], length)) {
+            Close();
+            return false;
+        }
+        _tileset_filenames.push_back(tileset_filename);
+    }
+
+    if(!_ReadCount(_file, file_size, sizeof(uint32), MAP_CHUNK_FILE_MAX_REFERENCED_TILES, count)) {
+        Close();
+        return false;
+    }
+    _referenced_tiles.resize(count);
+    for(uint32 i = 0; i < count; ++i) {
+        if(!_ReadValue(_file, _referenced_tiles[i])) {
+            Close();
+            return false;
+        }
+    }
+
+    if(!_ReadCount(_file, file_size, sizeof(uint8), MAP_CHUNK_FILE_MAX_LAYERS, count)) {
+        Close();
+        return false;
+    }
+    for(uint32 i = 0; i < count; ++i) {
+        uint8 layer_type = INVALID_LAYER;
+        if(!_ReadValue(_file, layer_type) || layer_type > INVALID_LAYER) {
+            Close();
+            return false;
+        }
+        _layer_types.push_back(static_cast<LAYER_TYPE>(layer_type));
+    }
+
+    if(!_file.good() || _num_tile_x_axis == 0 || _num_tile_y_axis == 0
+            || _num_grid_x_axis == 0 || _num_grid_y_axis == 0) {
+        Close();
+        return false;
+    }
+
+    _num_chunk_x_axis = (_num_tile_x_axis + TILE_CHUNK_SIZE - 1) / TILE_CHUNK_SIZE;
+    _num_chunk_y_axis = (_num_tile_y_axis + TILE_CHUNK_SIZE - 1) / TILE_CHUNK_SIZE;
+
+    _collision_grid_position = _file.tellg();
+    _chunks_position = _collision_grid_position
+                       + static_cast<std::streamoff>(_num_grid_x_axis) * _num_grid_y_axis * sizeof(uint32);
+
+    // The collision grid and every chunk must be there, so that they can be read later on.
+    std::streamoff chunks_size = static_cast<std::streamoff>(_num_chunk_x_axis) * _num_chunk_y_axis
+                                 * _layer_types.size() * TILE_CHUNK_SIZE * TILE_CHUNK_SIZE * sizeof(int16);
+    if(static_cast<std::streamoff>(_chunks_position) + chunks_size > file_size) {
+        Close();
+        return false;
+    }
+    return true;
+}
+
+void MapChunkFile::Close()
+{
+    if(_file.is_open())
+        _file.close();
+    _file.clear();
+
+    _num_tile_x_axis = 0;
+    _num_tile_y_axis = 0;
+    _num_grid_x_axis = 0;
+    _num_grid_y_axis = 0;
+    _num_chunk_x_axis = 0;
+    _num_chunk_y_axis = 0;
+    _tileset_filenames.clear();
+    _referenced_tiles.clear();
+    _layer_types.clear();
+}
+
+bool MapChunkFile::ReadCollisionGrid(std::vector<std::vector<uint32> > &collision_grid)
+{
+    if(!_file.is_open())
+        return false;
+
+    _file.seekg(_collision_grid_position);
+
+    collision_grid.assign(_num_grid_y_axis, std::vector<uint32>(_num_grid_x_axis, 0));
+    for(uint16 y = 0; y < _num_grid_y_axis; ++y)
+        _file.read(reinterpret_cast<char *>(&collision_grid[y][0]), _num_grid_x_axis * sizeof(uint32));
+
+    if(!_file.good()) {
+        PRINT_ERROR << "Couldn't read the collision grid from the packed map data file" << std::endl;
+        _file.clear();
+        return false;
+    }
+    return true;
+}
+
+bool MapChunkFile::ReadChunk(uint16 chunk_x, uint16 chunk_y, std::vector<int16> &tiles)
+{
+    if(!_file.is_open() || chunk_x >= _num_chunk_x_axis || chunk_y >= _num_chunk_y_axis)
+        return false;
+
+    const uint32 chunk_tiles = _layer_types.size() * TILE_CHUNK_SIZE * TILE_CHUNK_SIZE;
+    const uint32 chunk_index = chunk_y * _num_chunk_x_axis + chunk_x;
+
+    tiles.resize(chunk_tiles);
+    if(chunk_tiles == 0)
+        return true;
+
+    _file.seekg(_chunks_position + static_cast<std::streamoff>(chunk_index * chunk_tiles * sizeof(int16)));
+    _file.read(reinterpret_cast<char *>(&tiles[0]), chunk_tiles * sizeof(int16));
+
+    if(!_file.good()) {
+        PRINT_ERROR << "Couldn't read the tile chunk (" << chunk_x << ", " << chunk_y
+                    << ") from the packed map data file" << std::endl;
+        _file.clear();
+        tiles.assign(chunk_tiles, -1);
+        return false;
+    }
+    return true;
+}
+
+} // namespace private_map
+
+} // namespace vt_map
@@ -0,0 +1,156 @@
+////////////////////////////////////////////////////////////////////////////////
+//            Copyright (C) 2013 by Bertram (Valyria Tear)
+//                         All Rights Reserved
+//
+// This code is licensed under the GNU GPL version 2. It is free software
+// and you may modify it and/or redistribute it under the terms of this license.
+// See http://www.gnu.org/copyleft/gpl.html for details.
+////////////////////////////////////////////////////////////////////////////////
+
+/** ****************************************************************************
+*** \file    map_chunks.h
+*** \author  Yohann Ferreira, yohann ferreira orange fr
+*** \brief   Header file for the packed map data files
+***
+*** The tile layers and collision grid of a map data file are packed into a
+*** binary file the first time the map is loaded. The tiles are stored there in
+*** square chunks, so that they can be read around the camera only, while
+*** the next loads of the map don't need to run the map data script anymore.
+*** ***************************************************************************/
+
+#ifndef __MAP_CHUNKS_HEADER__
+#define __MAP_CHUNKS_HEADER__
+
+#include "modes/map/map_tiles.h"
+
+#include <fstream>
+
+namespace vt_map
+{
+
+namespace private_map
+{
+
+//! \brief The width and height of the tile chunks, in tiles.
+const uint16 TILE_CHUNK_SIZE = 16;
+
+/** ****************************************************************************
+*** \brief A packed map data file, giving access to the map tiles chunk by chunk.
+***
+*** The file starts with a header holding the map size, tilesets, layer types,
+*** referenced tiles and the whole collision grid, followed by the tile chunks.
+*** Each chunk holds TILE_CHUNK_SIZE x TILE_CHUNK_SIZE tile image indeces per layer,
+*** and -1 for the cells out of the map.
+***
+*** \note The packed file keeps the hash of the map data file it was made from,
+*** and is considered outdated as soon as the map data file changes.
+*** ***************************************************************************/
+class MapChunkFile
+{
+public:
+    MapChunkFile();
+
+    ~MapChunkFile();
+
+    /** \brief Gives the packed file name of a map data file.
+    *** \param map_data_filename The map data file.
+    *** \param data_hash Set to the map data file content hash.
+    **/
+    static std::string GetPackedFilename(const std::string &map_data_filename, uint32 &data_hash);
+
+    /** \brief Writes a packed map data file.
+    *** \param filename The packed file to write.
+    *** \param data_hash The hash of the map data file the data comes from.
+    *** \param tileset_filenames The tileset definition files used by the map.
+    *** \param referenced_tiles The tileset tile indeces used by the map, in increasing order.
+    *** The tiles in the layers are indeces in this vector.
+    *** \param num_tile_x_axis, num_tile_y_axis The map size, in tiles.
+    *** \param layers The map tile layers, fully loaded.
+    *** \param collision_grid The map collision grid, stored as collision_grid[y][x].
+    *** \return Whether the file could be written.
+    **/
+    static bool Write(const std::string &filename, uint32 data_hash,
+                      const std::vector<std::string> &tileset_filenames,
+                      const std::vector<uint32> &referenced_tiles,
+                      uint16 num_tile_x_axis, uint16 num_tile_y_axis,
+                      const std::vector<Layer> &layers,
+                      const std::vector<std::vector<uint32> > &collision_grid);
+
+    /** \brief Opens a packed map data file and reads its header.
+    *** \param filename The packed file to open.
+    *** \param data_hash The current hash of the map data file.
+    *** \return false when the file is missing, invalid or outdated.
+    **/
+    bool Open(const std::string &filename, uint32 data_hash);
+
+    //! \brief Closes the file.
+    void Close();
+
+    //! \brief Reads the whole collision grid, stored as collision_grid[y][x].
+    bool ReadCollisionGrid(std::vector<std::vector<uint32> > &collision_grid);
+
+    /** \brief Reads the tiles of a chunk.
+    *** \param chunk_x, chunk_y The chunk position, in chunks.
+    *** \param tiles Filled with the tiles of every layer, one layer after the other,
+    *** each one stored row by row.
+    *** \return Whether the chunk could be read.
+    **/
+    bool ReadChunk(uint16 chunk_x, uint16 chunk_y, std::vector<int16> &tiles);
+
+    //! \brief Class member accessor functions
+    //@{
+    uint16 GetNumTileXAxis() const {
+        return _num_tile_x_axis;
+    }
+
+    uint16 GetNumTileYAxis() const {
+        return _num_tile_y_axis;
+    }
+
+    uint16 GetNumChunkXAxis() const {
+        return _num_chunk_x_axis;
+    }
+
+    uint16 GetNumChunkYAxis() const {
+        return _num_chunk_y_axis;
+    }
+
+    const std::vector<std::string> &GetTilesetFilenames() const {
+        return _tileset_filenames;
+    }
+
+    const std::vector<uint32> &GetReferencedTiles() const {
+        return _referenced_tiles;
+    }
+
+    const std::vector<LAYER_TYPE> &GetLayerTypes() const {
+        return _layer_types;
+    }
+    //@}
+
+private:
+    //! \brief The opened packed file.
+    std::ifstream _file;
+
+    //! \brief The map size, in tiles and in collision grid units.
+    uint16 _num_tile_x_axis, _num_tile_y_axis;
+    uint16 _num_grid_x_axis, _num_grid_y_axis;
+
+    //! \brief The number of chunks on the x and y axes.
+    uint16 _num_chunk_x_axis, _num_chunk_y_axis;
+
+    //! \brief The map header data.
+    std::vector<std::string> _tileset_filenames;
+    std::vector<uint32> _referenced_tiles;
+    std::vector<LAYER_TYPE> _layer_types;
+
+    //! \brief The file positions of the collision grid and of the first chunk.
+    std::streampos _collision_grid_position;
+    std::streampos _chunks_position;
+}; // class MapChunkFile
+
+} // namespace private_map
+
+} // namespace vt_map
+
+#endif // __MAP_CHUNKS_HEADER__
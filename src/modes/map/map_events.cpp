@@ -24,6 +24,8 @@
 #include "modes/shop/shop.h"
 #include "modes/battle/battle.h"
 
+#include <algorithm>
+
 using namespace vt_audio;
 using namespace vt_mode_manager;
 using namespace vt_script;
@@ -177,6 +179,8 @@ bool MapTransitionEvent::_Update()
     if(!_done) {
         vt_global::GlobalManager->SetPreviousLocation(_transition_origin);
         MapMode *MM = new MapMode(_transition_map_data_filename, _transition_map_script_filename);
+        // The new map is set as the current one at this point, so that the autosave starts there.
+        vt_global::GlobalManager->AutoSave();
         ModeManager->Pop();
         ModeManager->Push(MM, false, true);
         _done = true;
@@ -878,6 +882,102 @@ void TreasureEvent::AddEvent(const std::string& event_id)
         _events.push_back(event_id);
 }
 
+// -----------------------------------------------------------------------------
+// ---------- EventTimerWheel Class Methods
+// -----------------------------------------------------------------------------
+
+EventTimerWheel::EventTimerWheel() :
+    _next_tick(1),
+    _num_timers(0)
+{
+    _slots[0].resize(1 << TIMER_WHEEL_FIRST_LEVEL_BITS);
+    for(uint32 level = 1; level < TIMER_WHEEL_LEVELS; ++level)
+        _slots[level].resize(1 << TIMER_WHEEL_LEVEL_BITS);
+}
+
+
+
+void EventTimerWheel::Insert(uint32 value, uint32 time)
+{
+    _AddTimer(Timer(value, time));
+    ++_num_timers;
+}
+
+
+
+void EventTimerWheel::Advance(uint32 time, std::vector<uint32> &expired)
+{
+    expired.clear();
+
+    const uint32 first_level_mask = _slots[0].size() - 1;
+    while(_num_timers > 0 && static_cast<int32>(time - _next_tick) >= 0) {
+        uint32 index = _next_tick & first_level_mask;
+
+        // When starting a new round of the first level, the timers of the upper levels
+        // falling into it are moved down.
+        if(index == 0) {
+            for(uint32 level = 1; level < TIMER_WHEEL_LEVELS; ++level) {
+                if(_Cascade(level) != 0)
+                    break;
+            }
+        }
+
+        ++_next_tick;
+
+        std::vector<Timer> &slot = _slots[0][index];
+        for(uint32 i = 0; i < slot.size(); ++i)
+            expired.push_back(slot[i].value);
+        _num_timers -= slot.size();
+        slot.clear();
+    }
+
+    // An empty wheel doesn't need to go through every millisecond.
+    if(static_cast<int32>(time - _next_tick) >= 0)
+        _next_tick = time + 1;
+}
+
+
+
+void EventTimerWheel::_AddTimer(const Timer &timer)
+{
+    // Past times are handled with the next millisecond.
+    if(static_cast<int32>(timer.time - _next_tick) < 0) {
+        _slots[0][_next_tick & (_slots[0].size() - 1)].push_back(timer);
+        return;
+    }
+
+    uint32 delta = timer.time - _next_tick;
+    uint32 time = timer.time;
+    uint32 level = 0;
+    uint32 level_bits = TIMER_WHEEL_FIRST_LEVEL_BITS;
+    while(level + 1 < TIMER_WHEEL_LEVELS && delta >= (1u << level_bits)) {
+        ++level;
+        level_bits += TIMER_WHEEL_LEVEL_BITS;
+    }
+
+    // Times out of the wheel span are put in its farthest slot, and put back there when reached.
+    if(delta >= (1u << level_bits))
+        time = _next_tick + (1u << level_bits) - 1;
+
+    uint32 shift = (level == 0) ? 0 : level_bits - TIMER_WHEEL_LEVEL_BITS;
+    _slots[level][(time >> shift) & (_slots[level].size() - 1)].push_back(timer);
+}
+
+
+
+uint32 EventTimerWheel::_Cascade(uint32 level)
+{
+    uint32 shift = TIMER_WHEEL_FIRST_LEVEL_BITS + (level - 1) * TIMER_WHEEL_LEVEL_BITS;
+    uint32 index = (_next_tick >> shift) & (_slots[level].size() - 1);
+
+    std::vector<Timer> timers;
+    timers.swap(_slots[level][index]);
+    for(uint32 i = 0; i < timers.size(); ++i)
+        _AddTimer(timers[i]);
+
+    return index;
+}
+
 // -----------------------------------------------------------------------------
 // ---------- EventSupervisor Class Methods
 // -----------------------------------------------------------------------------
@@ -886,13 +986,13 @@ EventSupervisor::~EventSupervisor()
 {
     _active_events.clear();
     _paused_events.clear();
-    _active_delayed_events.clear();
     _paused_delayed_events.clear();
 
-    for(std::map<std::string, MapEvent *>::iterator it = _all_events.begin(); it != _all_events.end(); ++it) {
-        delete it->second;
+    for(uint32 i = 0; i < _events.size(); ++i) {
+        delete _events[i].event;
     }
-    _all_events.clear();
+    _events.clear();
+    _event_handles.clear();
 }
 
 
@@ -910,7 +1010,9 @@ void EventSupervisor::RegisterEvent(MapEvent *new_event)
         return;
     }
 
-    _all_events.insert(std::make_pair(new_event->_event_id, new_event));
+    new_event->_event_handle = _events.size();
+    _events.push_back(EventState(new_event));
+    _event_handles.insert(std::make_pair(new_event->_event_id, new_event->_event_handle));
 }
 
 
@@ -941,7 +1043,7 @@ void EventSupervisor::StartEvent(const std::string &event_id, uint32 launch_time
     if(launch_time == 0)
         StartEvent(event);
     else
-        _active_delayed_events.push_back(std::make_pair(static_cast<int32>(launch_time), event));
+        _AddDelayedLaunch(event, launch_time);
 }
 
 
@@ -954,10 +1056,16 @@ void EventSupervisor::StartEvent(MapEvent *event, uint32 launch_time)
         return;
     }
 
-    if(launch_time == 0)
+    if(launch_time == 0) {
         StartEvent(event);
-    else
-        _active_delayed_events.push_back(std::make_pair(static_cast<int32>(launch_time), event));
+    }
+    else if(event->_event_handle == INVALID_EVENT_HANDLE) {
+        PRINT_WARNING << "The event: " << event->GetEventID()
+                      << " isn't registered. The StartEvent() call will be ignored. Fix your script!" << std::endl;
+    }
+    else {
+        _AddDelayedLaunch(event, launch_time);
+    }
 }
 
 
@@ -976,16 +1084,19 @@ void EventSupervisor::StartEvent(MapEvent *event)
         return;
     }
 
-    for(std::vector<MapEvent *>::iterator it = _active_events.begin(); it != _active_events.end(); ++it) {
-        if((*it) == event) {
-            PRINT_WARNING << "The event: " << event->GetEventID()
-                          << " is already active and can be active only once at a time. "
-                          "The StartEvent() call will be ignored. Fix your script!" << std::endl;
-            return;
-        }
+    if(event->_event_handle == INVALID_EVENT_HANDLE) {
+        PRINT_WARNING << "The event: " << event->GetEventID()
+                      << " isn't registered. The StartEvent() call will be ignored. Fix your script!" << std::endl;
+        return;
+    }
+
+    if(!_AddActiveEvent(event)) {
+        PRINT_WARNING << "The event: " << event->GetEventID()
+                      << " is already active and can be active only once at a time. "
+                      "The StartEvent() call will be ignored. Fix your script!" << std::endl;
+        return;
     }
 
-    _active_events.push_back(event);
     event->_Start();
     _ExamineEventLinks(event, true);
 }
@@ -1001,25 +1112,19 @@ void EventSupervisor::PauseEvents(const std::string &event_id)
         return;
     }
 
-    // Search for active ones
-    for(std::vector<MapEvent *>::iterator it = _active_events.begin(); it != _active_events.end();) {
-        if((*it)->_event_id == event_id) {
-            _paused_events.push_back(*it);
-            it = _active_events.erase(it);
-        } else {
-            ++it;
-        }
-    }
+    MapEvent *event = GetEvent(event_id);
+    if(!event)
+        return;
+
+    // Search for the active one
+    if(_RemoveActiveEvent(event))
+        _paused_events.push_back(event);
 
     // and for the delayed ones
-    for(std::vector<std::pair<int32, MapEvent *> >::iterator it = _active_delayed_events.begin();
-            it != _active_delayed_events.end();) {
-        if((*it).second->_event_id == event_id) {
-            _paused_delayed_events.push_back(*it);
-            it = _active_delayed_events.erase(it);
-        } else {
-            ++it;
-        }
+    std::vector<uint32> launches = _events[event->_event_handle].delayed_launches;
+    for(uint32 i = 0; i < launches.size(); ++i) {
+        int32 remaining_time = _CancelDelayedLaunch(launches[i]);
+        _paused_delayed_events.push_back(std::make_pair(remaining_time, event));
     }
 }
 
@@ -1039,25 +1144,22 @@ void EventSupervisor::PauseAllEvents(VirtualSprite *sprite)
     }
 
     // Starting by active ones.
-    for(std::vector<MapEvent *>::iterator it = _active_events.begin(); it != _active_events.end();) {
-        SpriteEvent *event = dynamic_cast<SpriteEvent *>(*it);
+    for(uint32 i = 0; i < _active_events.size(); ++i) {
+        SpriteEvent *event = dynamic_cast<SpriteEvent *>(_active_events[i]);
         if(event && event->GetSprite() == sprite) {
-            _paused_events.push_back(*it);
-            it = _active_events.erase(it);
-        } else {
-            ++it;
+            _RemoveActiveEvent(event);
+            _paused_events.push_back(event);
         }
     }
 
     // Looking at incoming ones.
-    for(std::vector<std::pair<int32, MapEvent *> >::iterator it = _active_delayed_events.begin();
-            it != _active_delayed_events.end();) {
-        SpriteEvent *event = dynamic_cast<SpriteEvent *>((*it).second);
+    std::vector<uint32> launches;
+    _GetDelayedLaunches(launches);
+    for(uint32 i = 0; i < launches.size(); ++i) {
+        SpriteEvent *event = dynamic_cast<SpriteEvent *>(_delayed_launches[launches[i]].event);
         if(event && event->GetSprite() == sprite) {
-            _paused_delayed_events.push_back(*it);
-            it = _active_delayed_events.erase(it);
-        } else {
-            ++it;
+            int32 remaining_time = _CancelDelayedLaunch(launches[i]);
+            _paused_delayed_events.push_back(std::make_pair(remaining_time, static_cast<MapEvent *>(event)));
         }
     }
 }
@@ -1076,7 +1178,7 @@ void EventSupervisor::ResumeEvents(const std::string &event_id)
     for(std::vector<MapEvent *>::iterator it = _paused_events.begin();
             it != _paused_events.end();) {
         if((*it)->_event_id == event_id) {
-            _active_events.push_back(*it);
+            _AddActiveEvent(*it);
             it = _paused_events.erase(it);
         } else {
             ++it;
@@ -1087,7 +1189,7 @@ void EventSupervisor::ResumeEvents(const std::string &event_id)
     for(std::vector<std::pair<int32, MapEvent *> >::iterator it = _paused_delayed_events.begin();
             it != _paused_delayed_events.end();) {
         if((*it).second->_event_id == event_id) {
-            _active_delayed_events.push_back(*it);
+            _AddDelayedLaunch((*it).second, std::max<int32>((*it).first, 0));
             it = _paused_delayed_events.erase(it);
         } else {
             ++it;
@@ -1114,7 +1216,7 @@ void EventSupervisor::ResumeAllEvents(VirtualSprite *sprite)
     for(std::vector<MapEvent *>::iterator it = _paused_events.begin(); it != _paused_events.end();) {
         SpriteEvent *event = dynamic_cast<SpriteEvent *>(*it);
         if(event && event->GetSprite() == sprite) {
-            _active_events.push_back(*it);
+            _AddActiveEvent(*it);
             it = _paused_events.erase(it);
         } else {
             ++it;
@@ -1126,7 +1228,7 @@ void EventSupervisor::ResumeAllEvents(VirtualSprite *sprite)
             it != _paused_delayed_events.end();) {
         SpriteEvent *event = dynamic_cast<SpriteEvent *>((*it).second);
         if(event && event->GetSprite() == sprite) {
-            _active_delayed_events.push_back(*it);
+            _AddDelayedLaunch((*it).second, std::max<int32>((*it).first, 0));
             it = _paused_delayed_events.erase(it);
         } else {
             ++it;
@@ -1147,37 +1249,30 @@ void EventSupervisor::TerminateEvents(const std::string &event_id, bool trigger_
         return;
     }
 
-    // Starting by active ones.
-    for(std::vector<MapEvent *>::iterator it = _active_events.begin(); it != _active_events.end();) {
-        if((*it)->_event_id == event_id) {
-            SpriteEvent *sprite_event = dynamic_cast<SpriteEvent *>(*it);
-            // Terminated sprite events need to release their owned sprite.
-            if(sprite_event)
-                sprite_event->Terminate();
+    MapEvent *event = GetEvent(event_id);
+    if(!event)
+        return;
 
-            MapEvent *terminated_event = *it;
-            it = _active_events.erase(it);
-            // We examine the event links only after the event has been removed from the active list
-            if(trigger_event_links)
-                _ExamineEventLinks(terminated_event, false);
-        } else {
-            ++it;
-        }
+    // Starting by the active one.
+    if(_RemoveActiveEvent(event)) {
+        SpriteEvent *sprite_event = dynamic_cast<SpriteEvent *>(event);
+        // Terminated sprite events need to release their owned sprite.
+        if(sprite_event)
+            sprite_event->Terminate();
+
+        // We examine the event links only after the event has been removed from the active list
+        if(trigger_event_links)
+            _ExamineEventLinks(event, false);
     }
 
     // Looking at incoming ones.
-    for(std::vector<std::pair<int32, MapEvent *> >::iterator it = _active_delayed_events.begin();
-            it != _active_delayed_events.end();) {
-        if((*it).second->_event_id == event_id) {
-            MapEvent *terminated_event = (*it).second;
-            it = _active_delayed_events.erase(it);
+    std::vector<uint32> launches = _events[event->_event_handle].delayed_launches;
+    for(uint32 i = 0; i < launches.size(); ++i) {
+        _CancelDelayedLaunch(launches[i]);
 
-            // We examine the event links only after the event has been removed from the active list
-            if(trigger_event_links)
-                _ExamineEventLinks(terminated_event, false);
-        } else {
-            ++it;
-        }
+        // We examine the event links only after the event has been removed from the launch list
+        if(trigger_event_links)
+            _ExamineEventLinks(event, false);
     }
 
     // And paused ones
@@ -1248,26 +1343,23 @@ void EventSupervisor::TerminateAllEvents(VirtualSprite *sprite)
     }
 
     // Starting by active ones.
-    for(std::vector<MapEvent *>::iterator it = _active_events.begin(); it != _active_events.end();) {
-        SpriteEvent *event = dynamic_cast<SpriteEvent *>(*it);
+    for(uint32 i = 0; i < _active_events.size(); ++i) {
+        SpriteEvent *event = dynamic_cast<SpriteEvent *>(_active_events[i]);
         if(event && event->GetSprite() == sprite) {
             // Active events need to release their owned sprite upon termination.
             event->Terminate();
 
-            it = _active_events.erase(it);
-        } else {
-            ++it;
+            _RemoveActiveEvent(event);
         }
     }
 
     // Looking at incoming ones.
-    for(std::vector<std::pair<int32, MapEvent *> >::iterator it = _active_delayed_events.begin();
-            it != _active_delayed_events.end();) {
-        SpriteEvent *event = dynamic_cast<SpriteEvent *>((*it).second);
+    std::vector<uint32> launches;
+    _GetDelayedLaunches(launches);
+    for(uint32 i = 0; i < launches.size(); ++i) {
+        SpriteEvent *event = dynamic_cast<SpriteEvent *>(_delayed_launches[launches[i]].event);
         if(event && event->GetSprite() == sprite)
-            it = _active_delayed_events.erase(it);
-        else
-            ++it;
+            _CancelDelayedLaunch(launches[i]);
     }
 
 
@@ -1298,18 +1390,31 @@ void EventSupervisor::TerminateAllEvents(VirtualSprite *sprite)
 
 void EventSupervisor::Update()
 {
-    // Update all launch event timers and start all events whose timers have finished
-    for(std::vector<std::pair<int32, MapEvent *> >::iterator it = _active_delayed_events.begin();
-            it != _active_delayed_events.end();) {
-        it->first -= SystemManager->GetUpdateTime();
+    // Advance the launch timers and start all events whose timers have finished,
+    // in the order they were delayed in.
+    std::vector<uint32> expired_launches;
+    _timer_wheel.Advance(_timer_wheel.GetTime() + SystemManager->GetUpdateTime(), expired_launches);
+
+    if(!expired_launches.empty()) {
+        std::vector<std::pair<uint32, uint32> > launches;
+        for(uint32 i = 0; i < expired_launches.size(); ++i) {
+            uint32 index = expired_launches[i];
+            launches.push_back(std::make_pair(_delayed_launches[index].sequence, index));
+        }
+        std::sort(launches.begin(), launches.end());
+
+        for(uint32 i = 0; i < launches.size(); ++i) {
+            uint32 index = launches[i].second;
+            MapEvent *start_event = _delayed_launches[index].event;
+
+            // The launch is out of the timer wheel now, so it can be freed, even if it was cancelled.
+            if(start_event)
+                _CancelDelayedLaunch(index);
+            _free_delayed_launches.push_back(index);
 
-        if(it->first <= 0) {  // Timer has expired
-            MapEvent *start_event = it->second;
-            it = _active_delayed_events.erase(it);
             // We begin the event only after it has been removed from the launch list
-            StartEvent(start_event);
-        } else {
-            ++it;
+            if(start_event)
+                StartEvent(start_event);
         }
     }
 
@@ -1319,18 +1424,28 @@ void EventSupervisor::Update()
     // Make the engine aware that the event supervisor is entering the event update loop
     _is_updating = true;
 
-    // Check for active events which have finished
-    for(std::vector<MapEvent *>::iterator it = _active_events.begin(); it != _active_events.end();) {
-        if((*it)->_Update() == true) {
+    // Check for active events which have finished, and compact the active events at the same time
+    uint32 num_active_events = 0;
+    for(uint32 i = 0; i < _active_events.size(); ++i) {
+        MapEvent *event = _active_events[i];
+        if(event == NULL)
+            continue;
+
+        if(event->_Update() == true) {
             // Add it ot the finished events list
-            finished_events.push_back(*it);
+            finished_events.push_back(event);
 
             // Remove the finished event from the active queue.
-            it = _active_events.erase(it);
-        } else {
-            ++it;
+            _events[event->_event_handle].active_slot = INVALID_EVENT_HANDLE;
+            continue;
         }
+
+        _active_events[num_active_events] = event;
+        _events[event->_event_handle].active_slot = num_active_events;
+        ++num_active_events;
     }
+    _active_events.resize(num_active_events);
+    _num_active_events = num_active_events;
 
     _is_updating = false;
 
@@ -1345,24 +1460,129 @@ void EventSupervisor::Update()
 
 bool EventSupervisor::IsEventActive(const std::string &event_id) const
 {
-    for(std::vector<MapEvent *>::const_iterator it = _active_events.begin(); it != _active_events.end(); ++it) {
-        if((*it)->_event_id == event_id) {
-            return true;
-        }
-    }
-    return false;
+    uint32 handle = _GetEventHandle(event_id);
+    return handle != INVALID_EVENT_HANDLE && _events[handle].active_slot != INVALID_EVENT_HANDLE;
 }
 
 
 
 MapEvent *EventSupervisor::GetEvent(const std::string &event_id) const
 {
-    std::map<std::string, MapEvent *>::const_iterator it = _all_events.find(event_id);
+    uint32 handle = _GetEventHandle(event_id);
 
-    if(it == _all_events.end())
+    if(handle == INVALID_EVENT_HANDLE)
         return NULL;
     else
-        return it->second;
+        return _events[handle].event;
+}
+
+
+
+void EventSupervisor::GetMapTransitionEvents(std::vector<MapTransitionEvent *> &events) const
+{
+    events.clear();
+    for(uint32 i = 0; i < _events.size(); ++i) {
+        if(_events[i].event->GetEventType() == MAP_TRANSITION_EVENT)
+            events.push_back(static_cast<MapTransitionEvent *>(_events[i].event));
+    }
+}
+
+
+
+uint32 EventSupervisor::_GetEventHandle(const std::string &event_id) const
+{
+    std::map<std::string, uint32>::const_iterator it = _event_handles.find(event_id);
+    return (it == _event_handles.end()) ? INVALID_EVENT_HANDLE : it->second;
+}
+
+
+
+bool EventSupervisor::_AddActiveEvent(MapEvent *event)
+{
+    EventState &state = _events[event->_event_handle];
+    if(state.active_slot != INVALID_EVENT_HANDLE)
+        return false;
+
+    state.active_slot = _active_events.size();
+    _active_events.push_back(event);
+    ++_num_active_events;
+    return true;
+}
+
+
+
+bool EventSupervisor::_RemoveActiveEvent(MapEvent *event)
+{
+    if(event->_event_handle == INVALID_EVENT_HANDLE)
+        return false;
+
+    EventState &state = _events[event->_event_handle];
+    if(state.active_slot == INVALID_EVENT_HANDLE)
+        return false;
+
+    // The slot is freed, and compacted by the next update.
+    _active_events[state.active_slot] = NULL;
+    state.active_slot = INVALID_EVENT_HANDLE;
+    --_num_active_events;
+
+    if(_num_active_events == 0)
+        _active_events.clear();
+    return true;
+}
+
+
+
+void EventSupervisor::_AddDelayedLaunch(MapEvent *event, uint32 launch_time)
+{
+    uint32 index = 0;
+    if(!_free_delayed_launches.empty()) {
+        index = _free_delayed_launches.back();
+        _free_delayed_launches.pop_back();
+    } else {
+        index = _delayed_launches.size();
+        _delayed_launches.push_back(DelayedLaunch());
+    }
+
+    DelayedLaunch &launch = _delayed_launches[index];
+    launch.event = event;
+    launch.launch_time = _timer_wheel.GetTime() + launch_time;
+    launch.sequence = _next_launch_sequence++;
+
+    _events[event->_event_handle].delayed_launches.push_back(index);
+    _timer_wheel.Insert(index, launch.launch_time);
+    ++_num_delayed_launches;
+}
+
+
+
+int32 EventSupervisor::_CancelDelayedLaunch(uint32 index)
+{
+    DelayedLaunch &launch = _delayed_launches[index];
+    int32 remaining_time = static_cast<int32>(launch.launch_time - _timer_wheel.GetTime());
+
+    std::vector<uint32> &launches = _events[launch.event->_event_handle].delayed_launches;
+    launches.erase(std::find(launches.begin(), launches.end(), index));
+
+    // The launch stays in the timer wheel until its time comes, and is freed then.
+    launch.event = NULL;
+    --_num_delayed_launches;
+    return remaining_time;
+}
+
+
+
+void EventSupervisor::_GetDelayedLaunches(std::vector<uint32> &launches) const
+{
+    std::vector<std::pair<uint32, uint32> > sorted_launches;
+    for(uint32 i = 0; i < _delayed_launches.size(); ++i) {
+        if(_delayed_launches[i].event)
+            sorted_launches.push_back(std::make_pair(_delayed_launches[i].sequence, i));
+    }
+    std::sort(sorted_launches.begin(), sorted_launches.end());
+
+    launches.clear();
+    for(uint32 i = 0; i < sorted_launches.size(); ++i)
+        launches.push_back(sorted_launches[i].second);
 }
 
 
@@ -1373,24 +1593,25 @@ void EventSupervisor::_ExamineEventLinks(MapEvent *parent_event, bool event_star
         EventLink &link = parent_event->_event_links[i];
 
         // Case 1: Start/finish launch member is not equal to the start/finish status of the parent event, so ignore this link
-        if(link.launch_at_start != event_start) {
+        if(link.launch_at_start != event_start)
+            continue;
+
+        if(link.child_event_handle == INVALID_EVENT_HANDLE)
+            link.child_event_handle = _GetEventHandle(link.child_event_id);
+
+        if(link.child_event_handle == INVALID_EVENT_HANDLE) {
+            IF_PRINT_WARNING(MAP_DEBUG) << "can not launch child event, no event with this ID existed: "
+                                        << link.child_event_id << std::endl;
             continue;
         }
+        MapEvent *child = _events[link.child_event_handle].event;
+
         // Case 2: The child event is to be launched immediately
-        else if(link.launch_timer == 0) {
-            StartEvent(link.child_event_id);
-        }
+        if(link.launch_timer == 0)
+            StartEvent(child);
         // Case 3: The child event has a timer associated with it and needs to be placed in the event launch container
-        else {
-            MapEvent *child = GetEvent(link.child_event_id);
-            if(child == NULL) {
-                IF_PRINT_WARNING(MAP_DEBUG) << "can not launch child event, no event with this ID existed: "
-                                            << link.child_event_id << std::endl;
-                continue;
-            } else {
-                _active_delayed_events.push_back(std::make_pair(static_cast<int32>(link.launch_timer), child));
-            }
-        }
+        else
+            _AddDelayedLaunch(child, link.launch_timer);
     }
 }
 
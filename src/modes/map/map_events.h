@@ -44,6 +44,9 @@ class VirtualSprite;
 
 struct BattleEnemyInfo;
 
+//! \brief The handle of an event id not registered to the event supervisor.
+const uint32 INVALID_EVENT_HANDLE = 0xFFFFFFFF;
+
 /** ****************************************************************************
 *** \brief A container class representing a link between two map events
 ***
@@ -67,7 +70,8 @@ class EventLink
 {
 public:
     EventLink(const std::string &child_id, bool start, uint32 time) :
-        child_event_id(child_id), launch_at_start(start), launch_timer(time) {}
+        child_event_id(child_id), child_event_handle(INVALID_EVENT_HANDLE),
+        launch_at_start(start), launch_timer(time) {}
 
     ~EventLink()
     {}
@@ -75,6 +79,9 @@ public:
     //! \brief The ID of the child event in this link
     std::string child_event_id;
 
+    //! \brief The handle of the child event, known once the link was first followed
+    uint32 child_event_handle;
+
     //! \brief The event will launch relative to the parent event's start if true, or its finish if false
     bool launch_at_start;
 
@@ -107,7 +114,7 @@ class MapEvent
 public:
     //! \param id The ID for the map event (an empty() value is invalid)
     MapEvent(const std::string &id, EVENT_TYPE type) :
-        _event_id(id), _event_type(type) {}
+        _event_id(id), _event_type(type), _event_handle(INVALID_EVENT_HANDLE) {}
 
     virtual ~MapEvent()
     {}
@@ -180,6 +187,9 @@ private:
     //! \brief Identifier for the class type of this event
     EVENT_TYPE _event_type;
 
+    //! \brief The index of the event in the event supervisor, set when registering it
+    uint32 _event_handle;
+
     //! \brief All child events of this class, represented by EventLink objects
     std::vector<EventLink> _event_links;
 }; // class MapEvent
@@ -369,6 +379,17 @@ public:
 
     ~MapTransitionEvent() {};
 
+    //! \brief Returns the data and script filenames of the map to transition to
+    //@{
+    const std::string &GetMapDataFilename() const {
+        return _transition_map_data_filename;
+    }
+
+    const std::string &GetMapScriptFilename() const {
+        return _transition_map_script_filename;
+    }
+    //@}
+
 protected:
     //! \brief Begins the transition process by fading out the screen and music
     void _Start();
@@ -966,6 +987,75 @@ protected:
     bool _Update();
 }; // class TreasureEvent : public MapEvent
 
+//! \brief The number of bits of the timer wheel first level, and of each following level.
+const uint32 TIMER_WHEEL_FIRST_LEVEL_BITS = 8;
+const uint32 TIMER_WHEEL_LEVEL_BITS = 6;
+
+//! \brief The number of levels of the timer wheel.
+const uint32 TIMER_WHEEL_LEVELS = 4;
+
+/** ****************************************************************************
+*** \brief A hierarchical timer wheel, telling which values reach their time.
+***
+*** The first level holds one slot per millisecond for the near future, and each
+*** following level holds slots spanning the whole previous level. Values are moved
+*** down to the previous level once their slot is reached, so that inserting a value
+*** and advancing the time only costs a few vector operations, whatever the number
+*** of values waiting.
+***
+*** \note Times farther than the last level span (about 18 hours) are waited
+*** in several steps.
+*** ***************************************************************************/
+class EventTimerWheel
+{
+public:
+    EventTimerWheel();
+
+    /** \brief Schedules a value
+    *** \param value The value, given back once its time is reached.
+    *** \param time The time to give it back at, in milliseconds.
+    *** Times already reached are given back once the time advances again.
+    **/
+    void Insert(uint32 value, uint32 time);
+
+    /** \brief Advances the wheel time
+    *** \param time The new time, in milliseconds.
+    *** \param expired Filled with the values whose time is reached, by time order.
+    **/
+    void Advance(uint32 time, std::vector<uint32> &expired);
+
+    //! \brief Returns the current wheel time, in milliseconds.
+    uint32 GetTime() const {
+        return _next_tick - 1;
+    }
+
+private:
+    //! \brief A scheduled value and its time.
+    struct Timer {
+        Timer(uint32 v, uint32 t) :
+            value(v), time(t) {}
+
+        uint32 value;
+        uint32 time;
+    };
+
+    //! \brief The slots of every level, each one holding the timers to handle when it is reached.
+    std::vector<std::vector<Timer> > _slots[TIMER_WHEEL_LEVELS];
+
+    //! \brief The next millisecond to handle.
+    uint32 _next_tick;
+
+    //! \brief The number of timers in the wheel.
+    uint32 _num_timers;
+
+    //! \brief Puts a timer in the slot corresponding to its time.
+    void _AddTimer(const Timer &timer);
+
+    //! \brief Moves the timers of the reached slot of a level down to the lower levels.
+    //! \return The index of the reached slot.
+    uint32 _Cascade(uint32 level);
+}; // class EventTimerWheel
+
 /** ****************************************************************************
 *** \brief Manages, processes, and launches map events
 ***
@@ -980,20 +1070,27 @@ protected:
 *** Immediately after starting the first event, the supervisor will examine its event
 *** links to determine which, if any, children events begin relative to the start of
 *** the base event. If they are to start a certain time after the start of the parent
-*** event, they are placed in a container and their countdown timers are initialized.
-*** These timers will count down on every update call to the event manager and after
-*** the timers expire, these events will be launched. When an active event ends, again
-*** its event links are examined to determine if any children events exist that start
-*** relative to the end of the parent event.
+*** event, they are placed in a timer wheel with their launch time. The wheel time
+*** advances on every update call to the event manager and after the launch times
+*** are reached, these events will be launched in the order they were delayed in.
+*** When an active event ends, again its event links are examined to determine if any
+*** children events exist that start relative to the end of the parent event.
 ***
-*** \todo What about the case when the same event is begun when the event is already
-*** active? Should we prevent the case where an event is activated twice, print a
-*** warning, or allow this situation and hope the programmer knows what they are doing?
+*** The events are given a handle when registered, indexing their state. The active
+*** events are kept in a vector where each event knows its slot, so that starting,
+*** terminating and checking an event doesn't need to look through the others.
+*** The freed slots are only compacted by Update(), which keeps the events updating
+*** in the order they were started.
+***
+*** \note Starting an event already active prints a warning and is ignored.
 *** ***************************************************************************/
 class EventSupervisor
 {
 public:
     EventSupervisor():
+        _num_active_events(0),
+        _num_delayed_launches(0),
+        _next_launch_sequence(0),
         _is_updating(false)
     {}
 
@@ -1078,12 +1175,12 @@ public:
 
     //! \brief Returns true if any events are active
     bool HasActiveEvent() const {
-        return !_active_events.empty();
+        return _num_active_events > 0;
     }
 
     //! \brief Returns true if any events are being prepared to be launched after their timers expire
     bool HasActiveDelayedEvent() const {
-        return !_active_delayed_events.empty();
+        return _num_delayed_launches > 0;
     }
 
     /** \brief Returns a pointer to a specified event stored by this class
@@ -1092,20 +1189,65 @@ public:
     **/
     MapEvent *GetEvent(const std::string &event_id) const;
 
+    /** \brief Gives the map transition events, telling which maps can be reached from the current one
+    *** \param events Filled with the registered map transition events
+    **/
+    void GetMapTransitionEvents(std::vector<MapTransitionEvent *> &events) const;
+
 private:
-    //! \brief A container for all map events, where the event's ID serves as the key to the std::map
-    std::map<std::string, MapEvent *> _all_events;
+    //! \brief A launch of an event waiting for its timer to expire.
+    struct DelayedLaunch {
+        //! \brief The event to start, or NULL when the launch was cancelled or is free.
+        MapEvent *event;
+
+        //! \brief The time to start the event at, in the timer wheel time.
+        uint32 launch_time;
+
+        //! \brief Tells the order the launches were delayed in.
+        uint32 sequence;
+    };
 
-    //! \brief A list of all events which have started but are not yet finished
+    //! \brief The state of a registered event, indexed by the event handle.
+    struct EventState {
+        EventState(MapEvent *e) :
+            event(e), active_slot(INVALID_EVENT_HANDLE) {}
+
+        MapEvent *event;
+
+        //! \brief The index of the event in _active_events, or INVALID_EVENT_HANDLE when not active.
+        uint32 active_slot;
+
+        //! \brief The indeces in _delayed_launches of the launches of this event waiting in the timer wheel.
+        std::vector<uint32> delayed_launches;
+    };
+
+    //! \brief All the registered events, indexed by their handle.
+    std::vector<EventState> _events;
+
+    //! \brief The handles of all map events, where the event's ID serves as the key to the std::map
+    std::map<std::string, uint32> _event_handles;
+
+    //! \brief The events which have started but are not yet finished, with NULL values where events stopped since the last update
     std::vector<MapEvent *> _active_events;
 
+    //! \brief The number of non-NULL values in _active_events.
+    uint32 _num_active_events;
+
     //! \brief A list of all events which have been paused
     std::vector<MapEvent *> _paused_events;
 
-    /** \brief A list of all events that are waiting on their launch timers to expire before being started
-    *** The interger part of this std::pair is the countdown timer for this event to be launched
-    **/
-    std::vector<std::pair<int32, MapEvent *> > _active_delayed_events;
+    //! \brief The delayed launches, referenced by index from the timer wheel. Free ones are listed in _free_delayed_launches.
+    std::vector<DelayedLaunch> _delayed_launches;
+    std::vector<uint32> _free_delayed_launches;
+
+    //! \brief The number of delayed launches waiting in the timer wheel, cancelled ones excluded.
+    uint32 _num_delayed_launches;
+
+    //! \brief The sequence number of the next delayed launch.
+    uint32 _next_launch_sequence;
+
+    //! \brief Tells when the delayed launches are due.
+    EventTimerWheel _timer_wheel;
 
     /** \brief A list of all events that are waiting on their launch timers to expire before being started
     *** The interger part of this std::pair is the countdown timer for this event to be launched
@@ -1118,6 +1260,32 @@ private:
     **/
     volatile bool _is_updating;
 
+    //! \brief Returns the handle of the given event id, or INVALID_EVENT_HANDLE if no such event is registered.
+    uint32 _GetEventHandle(const std::string &event_id) const;
+
+    //! \brief Adds a registered event at the end of the active events, unless it is already active.
+    //! \return Whether the event was added.
+    bool _AddActiveEvent(MapEvent *event);
+
+    //! \brief Removes an event from the active events, when it is active.
+    //! \return Whether the event was active.
+    bool _RemoveActiveEvent(MapEvent *event);
+
+    /** \brief Puts a launch of the given event in the timer wheel
+    *** \param event The event to launch, which must be registered.
+    *** \param launch_time The number of milliseconds to wait before launching the event.
+    **/
+    void _AddDelayedLaunch(MapEvent *event, uint32 launch_time);
+
+    /** \brief Cancels a delayed launch still in the timer wheel
+    *** \param index The index of the launch in _delayed_launches.
+    *** \return The number of milliseconds there was left before the launch.
+    **/
+    int32 _CancelDelayedLaunch(uint32 index);
+
+    //! \brief Gives the indeces of the delayed launches still waiting, in the order they were delayed.
+    void _GetDelayedLaunches(std::vector<uint32> &launches) const;
+
     /** \brief A function that is called whenever an event starts or finishes to examine that event's links
     *** \param parent_event The event that has just started or finished
     *** \param event_start The event has just started if this member is true, or if it just finished it will be false
@@ -22,7 +22,7 @@
 #include "common/gui/menu_window.h"
 
 #include <algorithm>
-#include <SDL_image.h>
+#include <cstring>
 
 namespace vt_map
 {
@@ -30,27 +30,14 @@ namespace vt_map
 namespace private_map
 {
 
-//! \brief allows for scoped-based control of SDL Surfaces
-struct SDLSurfaceController {
-    SDL_Surface *_surface;
-    inline SDLSurfaceController(const char *str) :
-        _surface(IMG_Load(str))
-    {
-        if(!_surface)
-            PRINT_ERROR << "Couldn't create white_noise image for collision map: " << SDL_GetError() << std::endl;
-    }
-
-    ~SDLSurfaceController()
-    {
-        if(_surface)
-            SDL_FreeSurface(_surface);
-    }
-};
-
 static vt_video::Color default_opacity = vt_video::Color(1.0f, 1.0f, 1.0f, 0.75f);
 static vt_video::Color overlap_opacity = vt_video::Color(1.0f, 1.0f, 1.0f, 0.65f);
 
-Minimap::Minimap(ObjectSupervisor *map_object_supervisor, const std::string &map_name) :
+//! \brief Changes whenever the collision map look changes, to ignore the older cache files
+static const uint32 MINIMAP_CACHE_VERSION = 1;
+
+Minimap::Minimap(ObjectSupervisor *map_object_supervisor, const std::string &map_name,
+                 const std::string &map_data_filename) :
     _current_position_x(-1),
     _current_position_y(-1),
     _box_x_length(20.0f),
@@ -59,7 +46,11 @@ Minimap::Minimap(ObjectSupervisor *map_object_supervisor, const std::string &map
     _y_offset(0),
     _x_half_len(1.75f * TILES_ON_X_AXIS * _box_x_length),
     _y_half_len(1.75f * TILES_ON_Y_AXIS * _box_y_length),
-    _map_alpha_scale(1.0f)
+    _map_alpha_scale(1.0f),
+    _generation_thread(NULL),
+    _generation_lock(NULL),
+    _generation_done(false),
+    _image_ready(false)
 {
     if(!map_object_supervisor)
     {
@@ -71,29 +62,29 @@ Minimap::Minimap(ObjectSupervisor *map_object_supervisor, const std::string &map
     vt_video::VideoManager->GetCurrentViewport(_viewport_original_x, _viewport_original_y,
                                                 _viewport_original_width, _viewport_original_height);
 
-    //create a temporary SDL surface on which to generate the collision map
-    SDL_Surface *temp_surface = _ProcedurallyDraw(map_object_supervisor);
-    if (!temp_surface) {
+    //take a snapshot of the static collisions, so that the generation doesn't depend on the map objects anymore
+    map_object_supervisor->GetGridAxis(_grid_width, _grid_height);
+    map_object_supervisor->GetStaticCollisionGrid(_collision_grid);
+
+    _image_name = map_name + "_cmap";
+    _cache_filename = _GetCacheFilename(map_data_filename);
+
+    //when the map didn't change since the collision map was cached, simply load it
+    if(vt_utils::DoesFileExist(_cache_filename) && _minimap_image.Load(_cache_filename)) {
+        _image_ready = true;
+    }
+    else if(!_noise_data.LoadImage("img/menus/minimap_collision.png")) {
+        PRINT_ERROR << "Couldn't load white_noise image for collision map" << std::endl;
         MapMode::CurrentInstance()->ShowMinimap(false);
     }
-
-    SDL_LockSurface(temp_surface);
-    //setup a temporary memory space to copy the SDL data into
-    vt_video::private_video::ImageMemory temp_data;
-    temp_data.rgb_format = false;
-    temp_data.width = temp_surface->w;
-    temp_data.height = temp_surface->h;
-    size_t len = temp_surface->h * temp_surface->w * ((unsigned short) (temp_surface->format->BitsPerPixel) / 8) ;
-    temp_data.pixels = malloc(len);
-    //copy the data
-    memcpy(temp_data.pixels, temp_surface->pixels, len);
-    SDL_UnlockSurface(temp_surface);
-    //at this point, the screen data is set up. We can get rid of unncesary data here
-    SDL_FreeSurface(temp_surface);
-    //do the image file creationg
-    std::string map_name_cmap = map_name + "_cmap";
-    _minimap_image = vt_video::VideoManager->CreateImage(&temp_data, map_name_cmap);
-    free(temp_data.pixels);
+    else {
+        //the surface creation and image loading can't be done outside of the main thread,
+        //so only the pixels are generated in the background
+        _generation_lock = vt_system::SystemManager->CreateSemaphore(1);
+        _generation_thread = vt_system::SystemManager->SpawnThread(&Minimap::_ProcedurallyDraw, this);
+        if(!_generation_thread)
+            _ProcedurallyDraw();
+    }
 
     //setup the map window, if it isn't already created
     _background.Load("img/menus/minimap_background.png");
@@ -116,91 +107,134 @@ Minimap::Minimap(ObjectSupervisor *map_object_supervisor, const std::string &map
     _viewport_height = 128.0f * ratio_y;
 }
 
-static inline bool _PrepareSurface(SDL_Surface *temp_surface)
+Minimap::~Minimap()
 {
-    static SDLSurfaceController white_noise("img/menus/minimap_collision.png");
-    SDL_Rect r;
-    r.x = r.y = 0;
-
-    //prepare the surface with the image. we tile the white noise image onto the surface
-    //with full alpha
-    for(int x = 0; x < temp_surface->w; x += white_noise._surface->w)
-    {
-        r.x = x;
-        for(int y = 0; y < temp_surface->h; y += white_noise._surface->h)
-        {
-            r.y = y;
-            if(SDL_BlitSurface(white_noise._surface, NULL, temp_surface, &r))
-            {
-                PRINT_ERROR << "Couldn't fill a rect on temp_surface: " << SDL_GetError() << std::endl;
-                return false;
-            }
-        }
+    //the generation thread uses the minimap members until it returns
+    if(_generation_thread)
+        vt_system::SystemManager->WaitForThread(_generation_thread);
+    if(_generation_lock)
+        vt_system::SystemManager->DestroySemaphore(_generation_lock);
+
+    if(_noise_data.pixels) {
+        free(_noise_data.pixels);
+        _noise_data.pixels = NULL;
+    }
+    if(_minimap_data.pixels) {
+        free(_minimap_data.pixels);
+        _minimap_data.pixels = NULL;
     }
-    return true;
+
+    _minimap_image.Clear();
+    _location_marker.Clear();
 }
 
-SDL_Surface *Minimap::_ProcedurallyDraw(ObjectSupervisor *map_object_supervisor)
+std::string Minimap::_GetCacheFilename(const std::string &map_data_filename) const
 {
+    uint32 hash = HASH_SEED;
+    hash = HashData(hash, reinterpret_cast<const uint8 *>(&MINIMAP_CACHE_VERSION), sizeof(MINIMAP_CACHE_VERSION));
 
-    float x, y, width, height;
-    vt_video::VideoManager->GetCurrentViewport(x, y, width, height);
+    //the map file content gives the collision grid, and the static collisions snapshot
+    //also catches the physical objects the map script may place differently from one visit to another
+    hash = HashFile(hash, map_data_filename);
 
-    map_object_supervisor->GetGridAxis(_grid_width, _grid_height);
+    hash = HashData(hash, reinterpret_cast<const uint8 *>(&_grid_width), sizeof(_grid_width));
+    hash = HashData(hash, reinterpret_cast<const uint8 *>(&_grid_height), sizeof(_grid_height));
+    if(!_collision_grid.empty())
+        hash = HashData(hash, &_collision_grid[0], _collision_grid.size());
 
-    //create a new SDL surface that is the rendering dimensions we want.
-    SDL_Surface *temp_surface = SDL_CreateRGBSurface(SDL_SWSURFACE,
-                                                     _grid_width * _box_x_length, _grid_height * _box_y_length, 32,
-#if SDL_BYTEORDER == SDL_BIG_ENDIAN
-                                                     0xff000000, 0x00ff0000, 0x0000ff00, 0x000000ff);
-#else
-                                                     0x000000ff, 0x0000ff00, 0x00ff0000, 0xff000000);
-#endif
-
-    if(!temp_surface) {
-        PRINT_ERROR << "Couldn't create temp_surface for collision map: " << SDL_GetError() << std::endl;
-        return NULL;
-    }
+    std::string cache_directory = vt_utils::GetUserDataPath() + "minimaps/";
+    if(!vt_utils::DoesFileExist(cache_directory))
+        vt_utils::MakeDirectory(cache_directory);
 
-    //set the basic rect information
-    SDL_Rect r;
-    r.w = _box_x_length;
-    r.h = _box_y_length;
-    r.x = r.y = 0;
-
-    //very simple. Just go through the entire grid, checking the visible-character's
-    //context against the map-grid's collision context. if this is NOT a colidable location
-    //fill that square in with a full alpha block
-    //note that the ordering needs to be transposed for drawing
-    if (!_PrepareSurface(temp_surface)) {
-        SDL_FreeSurface(temp_surface);
-        return NULL;
-    }
+    std::ostringstream filename;
+    filename << cache_directory << "minimap_" << std::hex << hash << ".png";
+    return filename.str();
+}
 
-    for(uint32 row = 0; row < _grid_width; ++row)
-    {
-        r.y = 0;
-        for(uint32 col = 0; col < _grid_height; ++col)
-        {
-            if(!map_object_supervisor->IsStaticCollision(row, col))
-            {
-
-                if(SDL_FillRect(temp_surface, &r, SDL_MapRGBA(temp_surface->format, 0x00, 0x00, 0x00, 0x00)))
-                {
-                    PRINT_ERROR << "Couldn't fill a rect on temp_surface: " << SDL_GetError() << std::endl;
-                    SDL_FreeSurface(temp_surface);
-                    return NULL;
-                }
+void Minimap::_ProcedurallyDraw()
+{
+    const uint32 width = _grid_width * _box_x_length;
+    const uint32 height = _grid_height * _box_y_length;
+    const uint32 noise_width = _noise_data.width;
+    const uint32 noise_height = _noise_data.height;
+
+    _minimap_data.rgb_format = false;
+    _minimap_data.width = width;
+    _minimap_data.height = height;
+    _minimap_data.pixels = malloc(width * height * 4);
+
+    uint8 *pixels = static_cast<uint8 *>(_minimap_data.pixels);
+    const uint8 *noise = static_cast<const uint8 *>(_noise_data.pixels);
+
+    //tile the white noise image onto the whole image, one pixel row at a time
+    for(uint32 y = 0; y < height; ++y) {
+        uint8 *row = pixels + y * width * 4;
+        const uint8 *noise_row = noise + (y % noise_height) * noise_width * 4;
+        for(uint32 x = 0; x < width; x += noise_width)
+            memcpy(row + x * 4, noise_row, std::min(noise_width, width - x) * 4);
+    }
 
+    //then clear the walkable cells to full alpha, going through each grid row
+    //by runs of consecutive walkable cells
+    for(uint32 grid_y = 0; grid_y < _grid_height; ++grid_y) {
+        const uint8 *collision_row = &_collision_grid[grid_y * _grid_width];
+        uint32 grid_x = 0;
+        while(grid_x < _grid_width) {
+            if(collision_row[grid_x]) {
+                ++grid_x;
+                continue;
             }
-            r.y += _box_y_length;
+
+            uint32 run_start = grid_x;
+            while(grid_x < _grid_width && !collision_row[grid_x])
+                ++grid_x;
+
+            size_t run_size = (grid_x - run_start) * _box_x_length * 4;
+            for(uint32 y = grid_y * _box_y_length; y < (grid_y + 1) * _box_y_length; ++y)
+                memset(pixels + (y * width + run_start * _box_x_length) * 4, 0, run_size);
         }
-        r.x += _box_x_length;
     }
 
-    //flush the SDL surface. This forces any pending writes onto the surface to complete
-    SDL_UpdateRect(temp_surface, 0, 0, 0, 0);
-    return temp_surface;
+    //save the result for the next visits. A failure here only means it will be generated again
+    if(!_minimap_data.SaveImage(_cache_filename, true))
+        PRINT_WARNING << "Couldn't save the collision map cache file: " << _cache_filename << std::endl;
+
+    vt_system::SystemManager->LockThread(_generation_lock);
+    _generation_done = true;
+    vt_system::SystemManager->UnlockThread(_generation_lock);
+}
+
+void Minimap::_FinishGeneration()
+{
+    //no generation is pending
+    if(!_generation_lock)
+        return;
+
+    vt_system::SystemManager->LockThread(_generation_lock);
+    bool done = _generation_done;
+    vt_system::SystemManager->UnlockThread(_generation_lock);
+    if(!done)
+        return;
+
+    if(_generation_thread) {
+        vt_system::SystemManager->WaitForThread(_generation_thread);
+        _generation_thread = NULL;
+    }
+    vt_system::SystemManager->DestroySemaphore(_generation_lock);
+    _generation_lock = NULL;
+
+    //the texture has to be created in the main thread
+    try {
+        _minimap_image = vt_video::VideoManager->CreateImage(&_minimap_data, _image_name);
+        _image_ready = true;
+    } catch(const vt_utils::Exception &e) {
+        PRINT_ERROR << e.ToString() << std::endl;
+    }
+
+    free(_minimap_data.pixels);
+    _minimap_data.pixels = NULL;
+    free(_noise_data.pixels);
+    _noise_data.pixels = NULL;
 }
 
 void Minimap::Draw()
@@ -230,7 +264,9 @@ void Minimap::Draw()
         VideoManager->Move(0, 0);
         //adjust the currnet opacity for the map scale
 
-        _minimap_image.Draw(resultant_opacity + Color(0.0f, 0.0f, 0.0f, -0.15f));
+        //the collision map only shows up once generated
+        if(_image_ready)
+            _minimap_image.Draw(resultant_opacity + Color(0.0f, 0.0f, 0.0f, -0.15f));
 
         VideoManager->Move(x_location, y_location);
         _location_marker.Draw(resultant_opacity);
@@ -245,6 +281,9 @@ void Minimap::Draw()
 
 void Minimap::Update(VirtualSprite *camera, float map_alpha_scale)
 {
+    //check whether the background generation just ended
+    _FinishGeneration();
+
     //in case the camera isn't specified, we don't do anything
     if(!camera)
         return;
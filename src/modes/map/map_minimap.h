@@ -21,6 +21,7 @@
 #define __MAP_MINIMAP_HEADER__
 
 #include "engine/video/image.h"
+#include "engine/system.h"
 
 #include <string>
 
@@ -41,22 +42,28 @@ class VirtualSprite;
 //! \brief Handles the Collision minimap generation, caching, drawing and updating the minimap
 class Minimap {
 public:
-    /** \brief constructor taking the target map mode. This also creates the actual collision map
+    /** \brief constructor taking the target map mode. This also starts the collision map creation
     *** Currently, there is only one global map supervisor instance, so technically I could call the static GetInstance function.
     *** However, I want the target map mode to be sent in explicitly. This will eliminate some of the confusion
     *** that can sometimes occur when having multiple targets and singletons -- IE temporal allocation is reduced since
     *** we explicitly force the pointer to be sent in
     *** \param map_object_supervisor the target map object supervisor
     *** \param map_name name of the actual map we are generating for
+    *** \param map_data_filename the map data file, used to find the collision map in the cache
+    *** \note The collision map image is read from the disk cache when the map didn't change since it was
+    *** saved there. Otherwise, it is generated in a background thread and becomes visible once done.
     **/
-    Minimap(ObjectSupervisor *map_object_supervisor, const std::string &map_name);
+    Minimap(ObjectSupervisor *map_object_supervisor, const std::string &map_name,
+            const std::string &map_data_filename);
 
-    Minimap() {}
+    Minimap() :
+        _generation_thread(NULL),
+        _generation_lock(NULL),
+        _generation_done(false),
+        _image_ready(false)
+    {}
 
-    ~Minimap() {
-        _minimap_image.Clear();
-        _location_marker.Clear();
-    }
+    ~Minimap();
 
     /** updates the map with effect changes and player location information
     *** \param camera a VirtualSprite indicating the camera location
@@ -73,8 +80,38 @@ private:
     //! \brief the generated collision map image for this collision map
     vt_video::StillImage _minimap_image;
 
-    //! \brief creates the procedural collision map
-    SDL_Surface *_ProcedurallyDraw(ObjectSupervisor *map_object_supervisor);
+    //! \brief the static collision of every grid cell, stored row by row, read by the generation thread
+    std::vector<uint8> _collision_grid;
+
+    //! \brief the white noise image tiled under the walls, and the generated collision map pixels
+    vt_video::private_video::ImageMemory _noise_data;
+    vt_video::private_video::ImageMemory _minimap_data;
+
+    //! \brief the name of the generated image, and the cache file it is saved to
+    std::string _image_name;
+    std::string _cache_filename;
+
+    //! \brief the thread generating the collision map, or NULL when not running
+    Thread *_generation_thread;
+
+    //! \brief protects _generation_done, which is set by the generation thread once the pixels are ready
+    Semaphore *_generation_lock;
+    bool _generation_done;
+
+    //! \brief tells whether the collision map image can be drawn. Only used by the main thread
+    bool _image_ready;
+
+    /** \brief Gives the cache file of the collision map
+    *** \param map_data_filename the map data file
+    *** \return the cache file name, depending on the map data file and the static collisions content
+    **/
+    std::string _GetCacheFilename(const std::string &map_data_filename) const;
+
+    //! \brief creates the procedural collision map pixels. Runs in the generation thread
+    void _ProcedurallyDraw();
+
+    //! \brief turns the generated pixels into the collision map image, once the generation thread is done
+    void _FinishGeneration();
 
     //! \brief objects for the "window" which will hold the map
     //! \note we plan to move this to a Controller object, or something similar
@@ -17,12 +17,15 @@
 
 #include "modes/map/map_mode.h"
 
+#include "modes/map/map_chunks.h"
 #include "modes/map/map_dialogue.h"
 #include "modes/map/map_events.h"
 #include "modes/map/map_objects.h"
+#include "modes/map/map_preloader.h"
 #include "modes/map/map_sprites.h"
 #include "modes/map/map_tiles.h"
 
+#include "modes/battle/battle_resources.h"
 #include "modes/menu/menu.h"
 #include "modes/pause.h"
 #include "modes/boot/boot.h"
@@ -30,6 +33,7 @@
 
 #include "engine/audio/audio.h"
 #include "engine/input.h"
+#include "engine/profiler.h"
 
 #include "common/global/global.h"
 
@@ -79,7 +83,8 @@ MapMode::MapMode(const std::string &data_filename, const std::string& script_fil
     _run_stamina(10000),
     _gui_alpha(0.0f),
     _minimap(NULL),
-    _show_minimap(false)
+    _show_minimap(false),
+    _preloader(NULL)
 {
     mode_type = MODE_MANAGER_MAP_MODE;
     _current_instance = this;
@@ -126,6 +131,11 @@ MapMode::MapMode(const std::string &data_filename, const std::string& script_fil
 
     _camera_timer.Initialize(0, 1);
 
+    // The battle resources prepared for the enemies of the previous map, or of the
+    // previous game, are freed before loading this map's ones.
+    if(vt_battle::BattleResources)
+        vt_battle::BattleResources->Clear();
+
     if(!_Load()) {
         BootMode *BM = new BootMode();
         ModeManager->PopAll();
@@ -145,6 +155,12 @@ MapMode::MapMode(const std::string &data_filename, const std::string& script_fil
 
     // Init the script component.
     GetScriptSupervisor().Initialize(this);
+
+    // Prepare the maps the transition events lead to, so that going there doesn't take long.
+    std::vector<MapTransitionEvent *> transition_events;
+    _event_supervisor->GetMapTransitionEvents(transition_events);
+    _preloader = new MapPreloader(this);
+    _preloader->Start(transition_events);
 }
 
 
@@ -157,6 +173,7 @@ MapMode::~MapMode()
     delete(_dialogue_supervisor);
     delete(_treasure_supervisor);
     if(_minimap) delete _minimap;
+    delete _preloader;
 }
 
 void MapMode::Deactivate()
@@ -242,14 +259,26 @@ void MapMode::Update()
 
     _dialogue_icon.Update();
 
+    if(_preloader)
+        _preloader->Update();
+
     // Call the map script's update function
-    if(_update_function.is_valid())
+    if(_update_function.is_valid()) {
+        PROFILE_SCOPE("MapMode script update");
         ScriptCallFunction<void>(_update_function);
+    }
 
     // Update all animated tile images
-    _tile_supervisor->Update();
-    _object_supervisor->Update();
-    _object_supervisor->SortObjects();
+    {
+        PROFILE_SCOPE("TileSupervisor::Update");
+        _tile_supervisor->Update();
+        _tile_supervisor->UpdateChunks(_map_frame);
+    }
+    {
+        PROFILE_SCOPE("ObjectSupervisor::Update");
+        _object_supervisor->Update();
+        _object_supervisor->SortObjects();
+    }
 
     switch(CurrentState()) {
     case STATE_SCENE:
@@ -291,7 +320,10 @@ void MapMode::Update()
     _camera_timer.Update();
 
     // ---------- (5) Update all active map events
-    _event_supervisor->Update();
+    {
+        PROFILE_SCOPE("EventSupervisor::Update");
+        _event_supervisor->Update();
+    }
 
     //update collision camera
     if(_show_minimap && _minimap && (CurrentState() != STATE_SCENE)
@@ -303,12 +335,33 @@ void MapMode::Update()
 
 void MapMode::Draw()
 {
+    VideoManager->SetCoordSys(0.0f, SCREEN_GRID_X_LENGTH, SCREEN_GRID_Y_LENGTH, 0.0f);
+    VideoManager->SetDrawFlags(VIDEO_X_CENTER, VIDEO_Y_BOTTOM, 0);
+
+    // The camera moves between the update steps when the positions are interpolated.
+    if(SystemManager->GetFixedUpdateStep() > 0)
+        _UpdateMapFrame();
+
+    _object_supervisor->UpdateVisibleObjects(_map_frame);
+
+    // The halos and lights are accumulated into the light map while the screen is still cleared,
+    // and added to the screen at once in DrawPostEffects().
+    if(_object_supervisor->HasVisibleLights() && VideoManager->BeginLightMap()) {
+        PROFILE_SCOPE("ObjectSupervisor::DrawLights");
+        _object_supervisor->DrawLights();
+        VideoManager->EndLightMap();
+    }
+
     VideoManager->SetStandardCoordSys();
     GetScriptSupervisor().DrawBackground();
 
     VideoManager->SetCoordSys(0.0f, SCREEN_GRID_X_LENGTH, SCREEN_GRID_Y_LENGTH, 0.0f);
     VideoManager->SetDrawFlags(VIDEO_X_CENTER, VIDEO_Y_BOTTOM, 0);
-    _DrawMapLayers();
+
+    {
+        PROFILE_SCOPE("MapMode::_DrawMapLayers");
+        _DrawMapLayers();
+    }
 
     VideoManager->SetStandardCoordSys();
     GetScriptSupervisor().DrawForeground();
@@ -329,7 +382,12 @@ void MapMode::DrawPostEffects()
     VideoManager->SetDrawFlags(VIDEO_X_CENTER, VIDEO_Y_BOTTOM, 0);
     // Halos are additive blending made, so they should be applied
     // as post-effects but before the GUI.
-    _object_supervisor->DrawLights();
+    if(VideoManager->IsLightMapReady()) {
+        VideoManager->DrawLightMap();
+    } else {
+        PROFILE_SCOPE("ObjectSupervisor::DrawLights");
+        _object_supervisor->DrawLights();
+    }
 
     VideoManager->SetStandardCoordSys();
     GetScriptSupervisor().DrawPostEffects();
@@ -394,6 +452,7 @@ void MapMode::AddFlatGroundObject(MapObject *obj)
     }
     _object_supervisor->_flat_ground_objects.push_back(obj);
     _object_supervisor->_all_objects.insert(std::make_pair(obj->object_id, obj));
+    _object_supervisor->_visibility_grids_dirty = true;
 }
 
 void MapMode::AddGroundObject(MapObject *obj)
@@ -404,6 +463,8 @@ void MapMode::AddGroundObject(MapObject *obj)
     }
     _object_supervisor->_ground_objects.push_back(obj);
     _object_supervisor->_all_objects.insert(std::make_pair(obj->object_id, obj));
+    _object_supervisor->_visibility_grids_dirty = true;
+    _object_supervisor->_static_obstacles_dirty = true;
 }
 
 
@@ -415,6 +476,7 @@ void MapMode::AddPassObject(MapObject *obj)
     }
     _object_supervisor->_pass_objects.push_back(obj);
     _object_supervisor->_all_objects.insert(std::make_pair(obj->object_id, obj));
+    _object_supervisor->_visibility_grids_dirty = true;
 }
 
 
@@ -426,6 +488,7 @@ void MapMode::AddSkyObject(MapObject *obj)
     }
     _object_supervisor->_sky_objects.push_back(obj);
     _object_supervisor->_all_objects.insert(std::make_pair(obj->object_id, obj));
+    _object_supervisor->_visibility_grids_dirty = true;
 }
 
 void MapMode::AddAmbientSoundObject(SoundObject *obj)
@@ -459,6 +522,7 @@ void MapMode::AddHalo(const std::string &filename, float x, float y, const Color
 {
     Halo *halo = new Halo(filename, x, y, color);
     _object_supervisor->_halos.push_back(halo);
+    _object_supervisor->_visibility_grids_dirty = true;
 }
 
 void MapMode::AddLight(const std::string &main_flare_filename,
@@ -478,6 +542,7 @@ void MapMode::AddLight(const std::string &main_flare_filename,
 void MapMode::AddLight(Light *light)
 {
     _object_supervisor->_lights.push_back(light);
+    _object_supervisor->_visibility_grids_dirty = true;
 }
 
 void MapMode::SetCamera(private_map::VirtualSprite *sprite, uint32 duration)
@@ -552,38 +617,64 @@ bool MapMode::_Load()
     // Clear out all old map data if existing.
     ScriptManager->DropGlobalTable("map_data");
 
-    // Open map script file and read in the basic map properties and tile definitions
-    if(!_map_script.OpenFile(_map_data_filename)) {
-        PRINT_ERROR << "Couldn't open map data file: "
-                    << _map_data_filename << std::endl;
-        return false;
+    // When the packed map data is up to date, the map data file doesn't need to be run at all,
+    // and the tiles are streamed from the packed file.
+    uint32 data_hash = 0;
+    std::string packed_filename = MapChunkFile::GetPackedFilename(_map_data_filename, data_hash);
+    MapChunkFile *chunk_file = new MapChunkFile();
+    if(chunk_file->Open(packed_filename, data_hash) && _object_supervisor->Load(*chunk_file)) {
+        // The tile supervisor owns the chunk file from now on, and frees it even when the load fails.
+        if(!_tile_supervisor->Load(chunk_file)) {
+            PRINT_ERROR << "Failed to load the tile data from: "
+                << packed_filename << std::endl;
+            return false;
+        }
     }
+    else {
+        delete chunk_file;
+
+        // Open map script file and read in the basic map properties and tile definitions
+        if(!_map_script.OpenFile(_map_data_filename)) {
+            PRINT_ERROR << "Couldn't open map data file: "
+                        << _map_data_filename << std::endl;
+            return false;
+        }
 
-    if(!_map_script.OpenTable("map_data")) {
-        PRINT_ERROR << "Couldn't open table 'map_data' in: "
-                    << _map_data_filename << std::endl;
-        _map_script.CloseFile();
-        return false;
-    }
+        if(!_map_script.OpenTable("map_data")) {
+            PRINT_ERROR << "Couldn't open table 'map_data' in: "
+                        << _map_data_filename << std::endl;
+            _map_script.CloseFile();
+            return false;
+        }
 
-    // Loads the collision grid
-    if(!_object_supervisor->Load(_map_script)) {
-        PRINT_ERROR << "Failed to load the collision grid from: "
-            << _map_data_filename << std::endl;
-        _map_script.CloseFile();
-        return false;
-    }
+        // Loads the collision grid
+        if(!_object_supervisor->Load(_map_script)) {
+            PRINT_ERROR << "Failed to load the collision grid from: "
+                << _map_data_filename << std::endl;
+            _map_script.CloseFile();
+            return false;
+        }
 
-    // Instruct the supervisor classes to perform their portion of the load operation
-    if(!_tile_supervisor->Load(_map_script)) {
-        PRINT_ERROR << "Failed to load the tile data from: "
-            << _map_data_filename << std::endl;
-        _map_script.CloseFile();
-        return false;
-    }
+        // Instruct the supervisor classes to perform their portion of the load operation
+        if(!_tile_supervisor->Load(_map_script)) {
+            PRINT_ERROR << "Failed to load the tile data from: "
+                << _map_data_filename << std::endl;
+            _map_script.CloseFile();
+            return false;
+        }
 
-    _map_script.CloseAllTables();
-    _map_script.CloseFile(); // Free the map data file once everyhting is loaded
+        _map_script.CloseAllTables();
+        _map_script.CloseFile(); // Free the map data file once everyhting is loaded
+
+        // Pack the map data for the next loads, and stream the tiles from it right away.
+        if(_tile_supervisor->WriteChunkFile(packed_filename, data_hash, _object_supervisor->GetCollisionGrid())) {
+            chunk_file = new MapChunkFile();
+            if(chunk_file->Open(packed_filename, data_hash))
+                _tile_supervisor->StreamFromChunkFile(chunk_file);
+            else
+                delete chunk_file;
+        }
+    }
 
     // Map script
 
@@ -676,7 +767,7 @@ bool MapMode::_CreateMinimap()
         _minimap = NULL;
     }
 
-    _minimap = new Minimap(_object_supervisor, this->GetMapScriptFilename());
+    _minimap = new Minimap(_object_supervisor, this->GetMapScriptFilename(), _map_data_filename);
     return true;
 }
 
@@ -792,24 +883,24 @@ void MapMode::_UpdateMapFrame()
 
     // Determine the center position coordinates for the camera
     float camera_x, camera_y; // Holds the final X, Y coordinates of the camera
-    float x_pixel_length, y_pixel_length; // The X and Y length values that coorespond to a single pixel in the current coodinate system
     float rounded_x_offset, rounded_y_offset; // The X and Y position offsets of the camera, rounded to perfectly align on a pixel boundary
 
     uint16 current_x, current_y; // Actual position of the view, either the camera sprite or a point on the camera movement path
     float current_offset_x, current_offset_y; // Actual offset for the view
 
-    // TODO: the call to GetPixelSize() will return the same result every time so long as the coordinate system did not change. If we never
-    // change the coordinate system in map mode, then this should be done only once and the calculated values should be saved for re-use.
-    // However, we've discussed the possiblity of adding a zoom feature to maps, in which case we need to continually re-calculate the pixel size
+    // The pixel size is kept in the map frame, so that the map objects don't have to query it again.
+    // It is computed every frame as it would change with a map zoom feature.
+    float &x_pixel_length = _map_frame.x_pixel_length;
+    float &y_pixel_length = _map_frame.y_pixel_length;
     VideoManager->GetPixelSize(x_pixel_length, y_pixel_length);
 
-    float path_x, path_y = 0.0f;
-    if(!_camera_timer.IsRunning()) {
-        path_x = _camera->GetXPosition();
-        path_y = _camera->GetYPosition();
-    } else {
-        path_x = _camera->GetXPosition() + (1 - _camera_timer.PercentComplete()) * _delta_x;
-        path_y = _camera->GetYPosition() + (1 - _camera_timer.PercentComplete()) * _delta_y;
+    // Follows the camera drawn position, which is interpolated when using a fixed update step.
+    MapPosition camera_position = _camera->GetInterpolatedPosition();
+    float path_x = camera_position.x;
+    float path_y = camera_position.y;
+    if(_camera_timer.IsRunning()) {
+        path_x += (1 - _camera_timer.PercentComplete()) * _delta_x;
+        path_y += (1 - _camera_timer.PercentComplete()) * _delta_y;
     }
 
     current_x = GetFloatInteger(path_x);
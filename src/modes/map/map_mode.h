@@ -57,6 +57,7 @@ class DialogueSupervisor;
 class EventSupervisor;
 class Light;
 class MapObject;
+class MapPreloader;
 class MapZone;
 class Minimap;
 class ObjectSupervisor;
@@ -468,6 +469,9 @@ private:
     //! \brief flag that enables minimap rendering or not
     bool _show_minimap;
 
+    //! \brief Prepares the maps reachable from this one in the background
+    private_map::MapPreloader *_preloader;
+
     // ----- Methods -----
 
     //! \brief Loads all map data contained in the Lua file that defines the map
@@ -17,6 +17,7 @@
 
 #include "modes/map/map_objects.h"
 
+#include "modes/map/map_chunks.h"
 #include "modes/map/map_mode.h"
 #include "modes/map/map_sprites.h"
 #include "modes/map/map_events.h"
@@ -54,11 +55,14 @@ MapObject::MapObject() :
     collision_mask(ALL_COLLISION),
     sky_object(false),
     draw_on_second_pass(false),
+    pinned(false),
     _object_type(OBJECT_TYPE),
     _emote_animation(0),
     _emote_offset_x(0.0f),
     _emote_offset_y(0.0f),
-    _emote_time(0)
+    _emote_time(0),
+    _sleeping(false),
+    _sleep_time(0)
 {}
 
 bool MapObject::ShouldDraw()
@@ -66,33 +70,43 @@ bool MapObject::ShouldDraw()
     if(!visible)
         return false;
 
-    MapMode *map = MapMode::CurrentInstance();
-
-    // Determine if the sprite is off-screen and if so, don't draw it.
-    if(!MapRectangle::CheckIntersection(GetImageRectangle(), map->GetMapFrame().screen_edges))
-        return false;
+    // The objects drawn are already known to be on screen, see ObjectSupervisor::UpdateVisibleObjects().
+    const MapFrame &frame = MapMode::CurrentInstance()->GetMapFrame();
 
     // Determine the center position coordinates for the camera
     float x_pos, y_pos; // Holds the final X, Y coordinates of the camera
-    float x_pixel_length, y_pixel_length; // The X and Y length values that coorespond to a single pixel in the current coodinate system
     float rounded_x_offset, rounded_y_offset; // The X and Y position offsets of the object, rounded to perfectly align on a pixel boundary
 
-
-    // TODO: the call to GetPixelSize() will return the same result every time so long as the coordinate system did not change. If we never
-    // change the coordinate system in map mode, then this should be done only once and the calculated values should be saved for re-use.
-    // However, we've discussed the possiblity of adding a zoom feature to maps, in which case we need to continually re-calculate the pixel size
-    VideoManager->GetPixelSize(x_pixel_length, y_pixel_length);
-    rounded_x_offset = FloorToFloatMultiple(GetFloatFraction(GetXPosition()), x_pixel_length);
-    rounded_y_offset = FloorToFloatMultiple(GetFloatFraction(GetYPosition()), y_pixel_length);
-    x_pos = static_cast<float>(GetFloatInteger(GetXPosition())) + rounded_x_offset;
-    y_pos = static_cast<float>(GetFloatInteger(GetYPosition())) + rounded_y_offset;
+    // The pixel size is computed once per frame by the map mode.
+    MapPosition draw_position = GetInterpolatedPosition();
+    rounded_x_offset = FloorToFloatMultiple(GetFloatFraction(draw_position.x), frame.x_pixel_length);
+    rounded_y_offset = FloorToFloatMultiple(GetFloatFraction(draw_position.y), frame.y_pixel_length);
+    x_pos = static_cast<float>(GetFloatInteger(draw_position.x)) + rounded_x_offset;
+    y_pos = static_cast<float>(GetFloatInteger(draw_position.y)) + rounded_y_offset;
 
     // ---------- Move the drawing cursor to the appropriate coordinates for this sprite
-    VideoManager->Move(x_pos - map->GetMapFrame().screen_edges.left,
-                       y_pos - map->GetMapFrame().screen_edges.top);
+    VideoManager->Move(x_pos - frame.screen_edges.left,
+                       y_pos - frame.screen_edges.top);
     return true;
 } // bool MapObject::ShouldDraw()
 
+MapPosition MapObject::GetInterpolatedPosition() const
+{
+    float alpha = SystemManager->GetInterpolationAlpha();
+    if(alpha >= 1.0f)
+        return position;
+
+    // Don't interpolate teleports: no sprite can move that much during a single update step.
+    if(fabs(position.x - _previous_position.x) > MAX_INTERPOLATED_DISTANCE
+            || fabs(position.y - _previous_position.y) > MAX_INTERPOLATED_DISTANCE)
+        return position;
+
+    MapPosition draw_position;
+    draw_position.x = _previous_position.x + (position.x - _previous_position.x) * alpha;
+    draw_position.y = _previous_position.y + (position.y - _previous_position.y) * alpha;
+    return draw_position;
+}
+
 MapRectangle MapObject::GetCollisionRectangle() const
 {
     MapRectangle rect;
@@ -161,6 +175,29 @@ void MapObject::_UpdateEmote()
     _emote_animation->Update();
 }
 
+void MapObject::WakeUp()
+{
+    if(!_sleeping)
+        return;
+
+    if(_sleep_time > 0)
+        _FastForward(_sleep_time);
+
+    _sleeping = false;
+    _sleep_time = 0;
+}
+
+void MapObject::_FastForward(uint32 elapsed_time)
+{
+    if(!_emote_animation)
+        return;
+
+    // The emote animation is shared, so only its timer is fast-forwarded.
+    _emote_time -= static_cast<int32>(elapsed_time);
+    if(_emote_time <= 0)
+        _emote_animation = 0;
+}
+
 void MapObject::_DrawEmote()
 {
     if(!_emote_animation)
@@ -176,6 +213,18 @@ void MapObject::_DrawEmote()
     _emote_animation->Draw();
 }
 
+void MapObject::_NotifyCollisionChange()
+{
+    // Only the physical objects and treasures are static obstacles of the region graph.
+    if(_object_type != PHYSICAL_TYPE && _object_type != TREASURE_TYPE)
+        return;
+
+    // The supervisor may not exist yet while the map is loading.
+    MapMode *map_mode = MapMode::CurrentInstance();
+    if(map_mode && map_mode->GetObjectSupervisor())
+        map_mode->GetObjectSupervisor()->InvalidateStaticObstacles();
+}
+
 // ----------------------------------------------------------------------------
 // ---------- PhysicalObject Class Functions
 // ----------------------------------------------------------------------------
@@ -197,6 +246,14 @@ void PhysicalObject::Update()
         animations[current_animation].Update();
 }
 
+void PhysicalObject::_FastForward(uint32 elapsed_time)
+{
+    MapObject::_FastForward(elapsed_time);
+
+    if(!animations.empty() && updatable)
+        animations[current_animation].Update(elapsed_time);
+}
+
 void PhysicalObject::Draw()
 {
     if(!animations.empty() && MapObject::ShouldDraw()) {
@@ -436,6 +493,13 @@ void Halo::Update()
 }
 
 
+void Halo::_FastForward(uint32 elapsed_time)
+{
+    if(updatable)
+        _animation.Update(elapsed_time);
+}
+
+
 void Halo::Draw()
 {
     if(MapObject::ShouldDraw() && _animation.GetCurrentFrame())
@@ -547,6 +611,14 @@ void Light::Update()
     }
 }
 
+void Light::_FastForward(uint32 elapsed_time)
+{
+    if(updatable) {
+        _main_animation.Update(elapsed_time);
+        _secondary_animation.Update(elapsed_time);
+    }
+}
+
 void Light::Draw()
 {
     if(MapObject::ShouldDraw()
@@ -897,7 +969,11 @@ ObjectSupervisor::ObjectSupervisor() :
     _num_grid_x_axis(0),
     _num_grid_y_axis(0),
     _last_id(1000),
-    _visible_party_member(0)
+    _visible_party_member(0),
+    _activity_region_margin(DEFAULT_ACTIVITY_REGION_MARGIN),
+    _visibility_grids_dirty(true),
+    _hierarchical_pathfinding(true),
+    _static_obstacles_dirty(true)
 {
     _virtual_focus = new VirtualSprite();
     _virtual_focus->SetPosition(0.0f, 0.0f);
@@ -1009,6 +1085,7 @@ bool ObjectSupervisor::Load(ReadScriptDescriptor &map_file)
     }
 
     // Construct the collision grid
+    _collision_grid.clear();
     map_file.OpenTable("map_grid");
     _num_grid_y_axis = map_file.GetTableSize();
     for(uint16 y = 0; y < _num_grid_y_axis; ++y) {
@@ -1017,6 +1094,23 @@ bool ObjectSupervisor::Load(ReadScriptDescriptor &map_file)
     }
     map_file.CloseTable();
     _num_grid_x_axis = _collision_grid[0].size();
+
+    // The static obstacles are added by the map script later on, and are taken in account when path finding.
+    _region_graph.Build(_collision_grid);
+    return true;
+}
+
+bool ObjectSupervisor::Load(MapChunkFile &chunk_file)
+{
+    if(!chunk_file.ReadCollisionGrid(_collision_grid) || _collision_grid.empty()) {
+        _collision_grid.clear();
+        return false;
+    }
+
+    _num_grid_y_axis = _collision_grid.size();
+    _num_grid_x_axis = _collision_grid[0].size();
+
+    _region_graph.Build(_collision_grid);
     return true;
 }
 
@@ -1024,82 +1118,197 @@ bool ObjectSupervisor::Load(ReadScriptDescriptor &map_file)
 
 void ObjectSupervisor::Update()
 {
+    _SavePreviousPositions();
+    _UpdateActivityRegion();
+
+    if(_visibility_grids_dirty) {
+        _BuildVisibilityGrids();
+        _visibility_grids_dirty = false;
+    }
+
     for(uint32 i = 0; i < _flat_ground_objects.size(); ++i)
-        _flat_ground_objects[i]->Update();
+        _UpdateObject(_flat_ground_objects[i], _flat_ground_grid);
     for(uint32 i = 0; i < _ground_objects.size(); ++i)
-        _ground_objects[i]->Update();
+        _UpdateObject(_ground_objects[i], _ground_grid);
     // Update save point animation and activeness.
     _UpdateSavePoints();
     for(uint32 i = 0; i < _pass_objects.size(); ++i)
-        _pass_objects[i]->Update();
+        _UpdateObject(_pass_objects[i], _pass_grid);
     for(uint32 i = 0; i < _sky_objects.size(); ++i)
-        _sky_objects[i]->Update();
+        _UpdateObject(_sky_objects[i], _sky_grid);
     for(uint32 i = 0; i < _halos.size(); ++i)
-        _halos[i]->Update();
+        _UpdateObject(_halos[i], _halo_grid);
     for(uint32 i = 0; i < _lights.size(); ++i)
-        _lights[i]->Update();
+        _UpdateObject(_lights[i], _light_grid);
+    // Zones are always updated, as they handle the enemies spawning.
     for(uint32 i = 0; i < _zones.size(); ++i)
         _zones[i]->Update();
 
     _UpdateAmbientSounds();
 }
 
+void ObjectSupervisor::_UpdateActivityRegion()
+{
+    // The map frame has already been updated for this step.
+    _activity_region = MapMode::CurrentInstance()->GetMapFrame().screen_edges;
+    _activity_region.left -= _activity_region_margin;
+    _activity_region.right += _activity_region_margin;
+    _activity_region.top -= _activity_region_margin;
+    _activity_region.bottom += _activity_region_margin;
+}
+
+void ObjectSupervisor::_UpdateObject(MapObject *object, VisibilityGrid &grid)
+{
+    if(_activity_region_margin >= 0.0f && object->CanSleep()
+            && !MapRectangle::CheckIntersection(object->GetImageRectangle(), _activity_region)) {
+        object->Sleep(SystemManager->GetUpdateTime());
+        return;
+    }
+
+    object->WakeUp();
+    object->Update();
+
+    // Only the objects covering other cells than before are moved in the grid.
+    grid.Update(object);
+}
+
+void ObjectSupervisor::_SavePreviousPositions()
+{
+    for(uint32 i = 0; i < _flat_ground_objects.size(); ++i)
+        _flat_ground_objects[i]->SavePreviousPosition();
+    for(uint32 i = 0; i < _ground_objects.size(); ++i)
+        _ground_objects[i]->SavePreviousPosition();
+    for(uint32 i = 0; i < _pass_objects.size(); ++i)
+        _pass_objects[i]->SavePreviousPosition();
+    for(uint32 i = 0; i < _sky_objects.size(); ++i)
+        _sky_objects[i]->SavePreviousPosition();
+    _virtual_focus->SavePreviousPosition();
+}
+
 void ObjectSupervisor::DrawSavePoints()
 {
+    const MapRectangle &screen_edges = MapMode::CurrentInstance()->GetMapFrame().screen_edges;
     for(uint32 i = 0; i < _save_points.size(); ++i) {
-        _save_points[i]->Draw();
+        // The save points aren't part of the visible objects lists.
+        if(MapRectangle::CheckIntersection(_save_points[i]->GetImageRectangle(), screen_edges))
+            _save_points[i]->Draw();
     }
 }
 
 void ObjectSupervisor::DrawFlatGroundObjects()
 {
-    for(uint32 i = 0; i < _flat_ground_objects.size(); ++i) {
-        _flat_ground_objects[i]->Draw();
+    for(uint32 i = 0; i < _visible_flat_ground_objects.size(); ++i) {
+        _visible_flat_ground_objects[i]->Draw();
     }
 }
 
 void ObjectSupervisor::DrawGroundObjects(const bool second_pass)
 {
-    for(uint32 i = 0; i < _ground_objects.size(); i++) {
-        if(_ground_objects[i]->draw_on_second_pass == second_pass) {
-            _ground_objects[i]->Draw();
+    for(uint32 i = 0; i < _visible_ground_objects.size(); i++) {
+        if(_visible_ground_objects[i]->draw_on_second_pass == second_pass) {
+            _visible_ground_objects[i]->Draw();
         }
     }
 }
 
 void ObjectSupervisor::DrawPassObjects()
 {
-    for(uint32 i = 0; i < _pass_objects.size(); i++) {
-        _pass_objects[i]->Draw();
+    for(uint32 i = 0; i < _visible_pass_objects.size(); i++) {
+        _visible_pass_objects[i]->Draw();
     }
 }
 
 void ObjectSupervisor::DrawSkyObjects()
 {
-    for(uint32 i = 0; i < _sky_objects.size(); i++) {
-        _sky_objects[i]->Draw();
+    for(uint32 i = 0; i < _visible_sky_objects.size(); i++) {
+        _visible_sky_objects[i]->Draw();
     }
 }
 
 void ObjectSupervisor::DrawLights()
 {
-    for(uint32 i = 0; i < _halos.size(); ++i)
-        _halos[i]->Draw();
-    for(uint32 i = 0; i < _lights.size(); ++i)
-        _lights[i]->Draw();
+    // Halos come first in the list, as they are drawn below the lights.
+    for(uint32 i = 0; i < _visible_lights.size(); ++i)
+        _visible_lights[i]->Draw();
 }
 
 void ObjectSupervisor::DrawDialogIcons()
 {
     MapSprite *mapSprite;
-    for(uint32 i = 0; i < _ground_objects.size(); i++) {
-        if(_ground_objects[i]->GetObjectType() == SPRITE_TYPE) {
-            mapSprite = static_cast<MapSprite *>(_ground_objects[i]);
+    for(uint32 i = 0; i < _visible_ground_objects.size(); i++) {
+        if(_visible_ground_objects[i]->GetObjectType() == SPRITE_TYPE) {
+            mapSprite = static_cast<MapSprite *>(_visible_ground_objects[i]);
             mapSprite->DrawDialog();
         }
     }
 }
 
+void ObjectSupervisor::UpdateVisibleObjects(const MapFrame &frame)
+{
+    // Objects may have been added since the last update step.
+    if(_visibility_grids_dirty) {
+        _BuildVisibilityGrids();
+        _visibility_grids_dirty = false;
+    }
+
+    _visible_flat_ground_objects.clear();
+    _visible_ground_objects.clear();
+    _visible_pass_objects.clear();
+    _visible_sky_objects.clear();
+    _visible_lights.clear();
+
+    _QueryVisibleObjects(_flat_ground_grid, frame.screen_edges, _visible_flat_ground_objects);
+    _QueryVisibleObjects(_ground_grid, frame.screen_edges, _visible_ground_objects);
+    _QueryVisibleObjects(_pass_grid, frame.screen_edges, _visible_pass_objects);
+    _QueryVisibleObjects(_sky_grid, frame.screen_edges, _visible_sky_objects);
+
+    // Only the few visible objects are put back in the draw order of their layer.
+    std::sort(_visible_flat_ground_objects.begin(), _visible_flat_ground_objects.end(), MapObject_Ptr_Less());
+    std::sort(_visible_ground_objects.begin(), _visible_ground_objects.end(), MapObject_Ptr_Less());
+    std::sort(_visible_pass_objects.begin(), _visible_pass_objects.end(), MapObject_Ptr_Less());
+    std::sort(_visible_sky_objects.begin(), _visible_sky_objects.end(), MapObject_Ptr_Less());
+
+    // The halos and lights are accumulated in the light map, so their order doesn't matter.
+    _QueryVisibleObjects(_halo_grid, frame.screen_edges, _visible_lights);
+    _QueryVisibleObjects(_light_grid, frame.screen_edges, _visible_lights);
+}
+
+void ObjectSupervisor::_BuildVisibilityGrids()
+{
+    _FillVisibilityGrid(_flat_ground_objects, _flat_ground_grid);
+    _FillVisibilityGrid(_ground_objects, _ground_grid);
+    _FillVisibilityGrid(_pass_objects, _pass_grid);
+    _FillVisibilityGrid(_sky_objects, _sky_grid);
+    _FillVisibilityGrid(_halos, _halo_grid);
+    _FillVisibilityGrid(_lights, _light_grid);
+}
+
+template <class T>
+void ObjectSupervisor::_FillVisibilityGrid(const std::vector<T *> &objects, VisibilityGrid &grid)
+{
+    grid.Reset(_num_grid_x_axis, _num_grid_y_axis);
+    for(uint32 i = 0; i < objects.size(); ++i) {
+        // Invisible objects may be shown again later, so they're indexed too.
+        grid.Insert(objects[i]);
+    }
+}
+
+void ObjectSupervisor::_QueryVisibleObjects(const VisibilityGrid &grid, const MapRectangle &screen_edges,
+                                            std::vector<MapObject *> &visible_objects)
+{
+    size_t first_candidate = visible_objects.size();
+    grid.Query(screen_edges, visible_objects);
+
+    // Keeps only the visible candidates, in place.
+    size_t visible_count = first_candidate;
+    for(size_t i = first_candidate; i < visible_objects.size(); ++i) {
+        MapObject *object = visible_objects[i];
+        if(object->IsVisible() && MapRectangle::CheckIntersection(object->GetImageRectangle(), screen_edges))
+            visible_objects[visible_count++] = object;
+    }
+    visible_objects.resize(visible_count);
+}
+
 void ObjectSupervisor::_UpdateSavePoints()
 {
     VirtualSprite *sprite = MapMode::CurrentInstance()->GetCamera();
@@ -1408,6 +1617,34 @@ Path ObjectSupervisor::FindPath(VirtualSprite *sprite, const MapPosition &destin
         return path;
     }
 
+    // The region graph only knows about walls, so it's of no use for sprites going through them.
+    if(_hierarchical_pathfinding && !sprite->sky_object && (sprite->collision_mask & WALL_COLLISION)) {
+        _UpdateStaticObstacles();
+
+        switch(_region_graph.FindRoute(source_node.tile_x, source_node.tile_y,
+                                       dest.tile_x, dest.tile_y, sprite->collision_mask)) {
+        case ROUTE_NONE:
+            IF_PRINT_WARNING(MAP_DEBUG) << "could not find path to destination" << std::endl;
+            return path;
+        case ROUTE_FOUND:
+            path = _FindPath(sprite, source_node, dest, destination, true);
+            // Other sprites, or the sprite size, may block the corridor. Search the whole map then.
+            if(!path.empty())
+                return path;
+            break;
+        default:
+            break;
+        }
+    }
+
+    return _FindPath(sprite, source_node, dest, destination, false);
+} // Path ObjectSupervisor::FindPath(const VirtualSprite* sprite, const MapPosition& destination)
+
+Path ObjectSupervisor::_FindPath(VirtualSprite *sprite, const PathNode &source_node, const PathNode &dest,
+                                 const MapPosition &destination, bool in_corridor)
+{
+    Path path;
+
     std::vector<PathNode> open_list;
     std::vector<PathNode> closed_list;
 
@@ -1468,6 +1705,10 @@ Path ObjectSupervisor::FindPath(VirtualSprite *sprite, const MapPosition &destin
             if(collision_type == WALL_COLLISION)
                 continue;
 
+            // Stay in the region graph corridor when asked to.
+            if(in_corridor && !_region_graph.IsInCorridor(nodes[i].tile_x, nodes[i].tile_y))
+                continue;
+
             // ---------- (B): Check if the node is already in the closed list
             if(find(closed_list.begin(), closed_list.end(), nodes[i]) != closed_list.end())
                 continue;
@@ -1544,7 +1785,58 @@ Path ObjectSupervisor::FindPath(VirtualSprite *sprite, const MapPosition &destin
     std::reverse(path.begin(), path.end());
 
     return path;
-} // Path ObjectSupervisor::FindPath(const VirtualSprite* sprite, const MapPosition& destination)
+} // Path ObjectSupervisor::_FindPath(...)
+
+bool ObjectSupervisor::GetChaseDirection(const VirtualSprite *sprite, uint16 &direction)
+{
+    VirtualSprite *camera = MapMode::CurrentInstance()->GetCamera();
+    if(!sprite || !camera || !_region_graph.IsBuilt())
+        return false;
+
+    // The flow field only knows about walls.
+    if(sprite->sky_object || !(sprite->collision_mask & WALL_COLLISION))
+        return false;
+
+    // The obstacle changes must reach the graph version before the field is checked against it.
+    _UpdateStaticObstacles();
+    _region_graph.Refresh();
+
+    int16 target_x = static_cast<int16>(camera->GetXPosition());
+    int16 target_y = static_cast<int16>(camera->GetYPosition());
+    if(!_chase_flow_field.IsUpToDate(target_x, target_y, _region_graph))
+        _chase_flow_field.Compute(_region_graph, target_x, target_y);
+
+    int16 delta_x, delta_y;
+    if(!_chase_flow_field.GetDirection(static_cast<int16>(sprite->GetXPosition()),
+                                       static_cast<int16>(sprite->GetYPosition()), delta_x, delta_y))
+        return false;
+
+    if(delta_x == 0)
+        direction = (delta_y < 0) ? NORTH : SOUTH;
+    else if(delta_y == 0)
+        direction = (delta_x < 0) ? WEST : EAST;
+    else if(delta_y < 0)
+        direction = (delta_x < 0) ? MOVING_NORTHWEST : MOVING_NORTHEAST;
+    else
+        direction = (delta_x < 0) ? MOVING_SOUTHWEST : MOVING_SOUTHEAST;
+    return true;
+}
+
+void ObjectSupervisor::_UpdateStaticObstacles()
+{
+    if(!_static_obstacles_dirty)
+        return;
+    _static_obstacles_dirty = false;
+
+    for(uint32 i = 0; i < _ground_objects.size(); ++i) {
+        MapObject *object = _ground_objects[i];
+        if(GetCollisionFromObjectType(object) != WALL_COLLISION)
+            continue;
+
+        _region_graph.UpdateObstacle(object, object->GetCollisionRectangle(),
+                                     object->collision_mask != NO_COLLISION);
+    }
+}
 
 void ObjectSupervisor::ReloadVisiblePartyMember()
 {
@@ -1630,6 +1922,39 @@ bool ObjectSupervisor::IsStaticCollision(uint32 x, uint32 y)
     return false;
 }
 
+void ObjectSupervisor::GetStaticCollisionGrid(std::vector<uint8> &grid) const
+{
+    grid.assign(_num_grid_x_axis * _num_grid_y_axis, 0);
+
+    for(uint32 y = 0; y < _num_grid_y_axis; ++y) {
+        for(uint32 x = 0; x < _num_grid_x_axis; ++x) {
+            if(_collision_grid[y][x] > 0)
+                grid[y * _num_grid_x_axis + x] = 1;
+        }
+    }
+
+    // Marks the cells covered by the physical objects, like IsStaticCollision() does.
+    for(uint32 i = 0; i < _ground_objects.size(); ++i) {
+        MapObject *collision_object = _ground_objects[i];
+        if(!collision_object || collision_object->collision_mask == NO_COLLISION)
+            continue;
+
+        if(collision_object->GetObjectType() != PHYSICAL_TYPE)
+            continue;
+
+        MapRectangle rect = collision_object->GetCollisionRectangle();
+        int32 left = std::max(0, static_cast<int32>(ceilf(rect.left)));
+        int32 right = std::min(static_cast<int32>(_num_grid_x_axis) - 1, static_cast<int32>(floorf(rect.right)));
+        int32 top = std::max(0, static_cast<int32>(ceilf(rect.top)));
+        int32 bottom = std::min(static_cast<int32>(_num_grid_y_axis) - 1, static_cast<int32>(floorf(rect.bottom)));
+
+        for(int32 y = top; y <= bottom; ++y) {
+            for(int32 x = left; x <= right; ++x)
+                grid[y * _num_grid_x_axis + x] = 1;
+        }
+    }
+}
+
 } // namespace private_map
 
 } // namespace vt_map
@@ -19,6 +19,7 @@
 #define __MAP_OBJECTS_HEADER__
 
 #include "modes/map/map_treasure.h"
+#include "modes/map/map_pathfinding.h"
 
 namespace vt_script {
 class ReadScriptDescriptor;
@@ -41,6 +42,7 @@ namespace private_map
 {
 
 class ContextZone;
+class MapChunkFile;
 class MapSprite;
 class MapZone;
 class VirtualSprite;
@@ -151,8 +153,16 @@ public:
     *** in the pass layer can be both walked over and walked under by sprites in the ground layer.
     **/
     bool draw_on_second_pass;
+
+    /** \brief When true, the object is never put to sleep, even when it is far from the camera (default == false).
+    *** Scripts should pin the objects which must keep on moving or animating while off-screen.
+    **/
+    bool pinned;
     //@}
 
+    //! \brief The cells of its layer visibility grid the object is indexed in, kept by the grid.
+    VisibilityCellRange visibility_cells;
+
     // ---------- Methods
 
     /** \brief Updates the state of an object.
@@ -176,12 +186,51 @@ public:
     *** \note This function also moves the draw cursor to the proper position if the object should be drawn
     ***
     *** This method performs the common drawing operations of identifying whether or not the object
-    *** is visible on the screen and moving the drawing cursor to its location. The children classes
-    *** of this class may choose to make use of it (or not).
+    *** is visible and moving the drawing cursor to its location. The children classes of this class
+    *** may choose to make use of it (or not).
+    *** \note Whether the object is on screen isn't tested again, as only the objects found on screen
+    *** by ObjectSupervisor::UpdateVisibleObjects() are drawn.
     **/
     bool ShouldDraw();
     //@}
 
+    /** \brief Tells whether the object may be put to sleep when it is out of the map activity region.
+    *** \note Sprites controlled by scripted events override this so that scenes can't be stalled.
+    **/
+    virtual bool CanSleep() const {
+        return !pinned;
+    }
+
+    /** \brief Puts the object to sleep for the current update step.
+    *** A sleeping object isn't updated. The update time is only accumulated so that the object
+    *** can catch up with its animations and timers when waking up.
+    **/
+    void Sleep(uint32 update_time) {
+        _sleeping = true;
+        _sleep_time += update_time;
+    }
+
+    //! \brief Wakes the object up, fast-forwarding its animations and timers by the time it slept.
+    void WakeUp();
+
+    bool IsSleeping() const {
+        return _sleeping;
+    }
+
+    /** \brief Keeps the current position as the previous update step position.
+    *** The object supervisor calls this before each update step, so that the objects
+    *** can be drawn between their previous and current positions.
+    **/
+    void SavePreviousPosition() {
+        _previous_position = position;
+    }
+
+    /** \brief Returns the position at which the object should be drawn.
+    *** When the game uses a fixed update step, the position is interpolated between the previous
+    *** update step position and the current one, which keeps the movements smooth whatever the frame rate.
+    **/
+    MapPosition GetInterpolatedPosition() const;
+
     //! \brief Retrieves the object type identifier
     MAP_OBJECT_TYPE GetObjectType() const {
         return _object_type;
@@ -223,14 +272,17 @@ public:
     void SetPosition(float x, float y) {
         position.x = x;
         position.y = y;
+        _NotifyCollisionChange();
     }
 
     void SetXPosition(float x) {
         position.x = x;
+        _NotifyCollisionChange();
     }
 
     void SetYPosition(float y) {
         position.y = y;
+        _NotifyCollisionChange();
     }
 
     void SetImgHalfWidth(float width) {
@@ -243,10 +295,12 @@ public:
 
     void SetCollHalfWidth(float collision) {
         coll_half_width = collision;
+        _NotifyCollisionChange();
     }
 
     void SetCollHeight(float collision) {
         coll_height = collision;
+        _NotifyCollisionChange();
     }
 
     void SetUpdatable(bool update) {
@@ -260,12 +314,17 @@ public:
     // Use a set of COLLISION_TYPE bitmask values
     void SetCollisionMask(uint32 collision_types) {
         collision_mask = collision_types;
+        _NotifyCollisionChange();
     }
 
     void SetDrawOnSecondPass(bool pass) {
         draw_on_second_pass = pass;
     }
 
+    void SetPinned(bool pin) {
+        pinned = pin;
+    }
+
     int16 GetObjectID() const {
         return object_id;
     }
@@ -314,6 +373,10 @@ public:
         return draw_on_second_pass;
     }
 
+    bool IsPinned() const {
+        return pinned;
+    }
+
     MAP_OBJECT_TYPE GetType() const {
         return _object_type;
     }
@@ -333,6 +396,9 @@ protected:
     //! \brief This is used to identify the type of map object for inheriting classes.
     MAP_OBJECT_TYPE _object_type;
 
+    //! \brief The object position at the previous update step.
+    MapPosition _previous_position;
+
     //! \brief the emote animation to play
     vt_video::AnimatedImage *_emote_animation;
 
@@ -343,11 +409,27 @@ protected:
     //! \brief the time the emote animatio will last in milliseconds,
     int32 _emote_time;
 
+    //! \brief Tells whether the object is currently sleeping, out of the map activity region.
+    bool _sleeping;
+
+    //! \brief The number of milliseconds the object has been sleeping for.
+    uint32 _sleep_time;
+
     //! \brief Takes care of updating the emote animation and state.
     void _UpdateEmote();
 
+    /** \brief Catches up with the time spent sleeping.
+    *** \param elapsed_time The number of milliseconds the object slept for.
+    *** Only cheap operations, such as advancing animations and timers, should be done there.
+    *** Movements aren't replayed: sprites simply resume from where they fell asleep.
+    **/
+    virtual void _FastForward(uint32 elapsed_time);
+
     //! \brief Takes care of drawing the emote animation.
     void _DrawEmote();
+
+    //! \brief Tells the object supervisor when a static obstacle collision area or mask changed.
+    void _NotifyCollisionChange();
 }; // class MapObject
 
 
@@ -446,6 +528,10 @@ public:
     }
     //@}
 
+protected:
+    //! \brief Fast-forwards the current animation.
+    void _FastForward(uint32 elapsed_time);
+
 private:
     //! \brief The event id triggered when talking to the sprite.
     std::string _event_when_talking;
@@ -540,6 +626,9 @@ public:
     //! \note the actual image resources is handled by the main map object.
     void Draw();
 
+protected:
+    //! \brief Fast-forwards the halo animation.
+    void _FastForward(uint32 elapsed_time);
 
 private:
     //! \brief A reference to the current map save animation.
@@ -579,6 +668,11 @@ public:
     *** \param rect A MapRectangle object storing the image rectangle data
     **/
     MapRectangle GetImageRectangle() const;
+
+protected:
+    //! \brief Fast-forwards the light animations.
+    void _FastForward(uint32 elapsed_time);
+
 private:
     //! Updates the angle and distance from the camera viewpoint
     void _UpdateLightAngle();
@@ -873,9 +967,28 @@ public:
     **/
     bool Load(vt_script::ReadScriptDescriptor &map_file);
 
+    /** \brief Loads the collision grid from a packed map data file
+    *** \param chunk_file The opened packed map data file
+    *** \return Whether the collision data loading was successful.
+    **/
+    bool Load(MapChunkFile &chunk_file);
+
     //! \brief Updates the state of all map zones and objects
     void Update();
 
+    /** \brief Builds the lists of objects to draw for the given map frame.
+    *** \param frame The map frame about to be drawn.
+    *** This must be called once per frame, before any of the draw functions below.
+    *** Only the objects whose image rectangle intersects the screen edges are kept,
+    *** in their layer draw order, so that the draw functions don't test it again.
+    **/
+    void UpdateVisibleObjects(const MapFrame &frame);
+
+    //! \brief Tells whether any halo or light is visible this frame.
+    bool HasVisibleLights() const {
+        return !_visible_lights.empty();
+    }
+
     /** \brief Draws the various object layers to the screen
     *** \param frame A pointer to the information required to draw this frame
     *** \note These functions do not reset the coordinate system and hence depend that the proper coordinate system
@@ -956,10 +1069,40 @@ public:
     *** This function ignores the position of all other objects and only concerns itself with
     *** which map grid elements are walkable.
     ***
+    *** The region graph is first searched to find the clusters the path goes through,
+    *** and the A* search is limited to them when possible.
+    ***
     *** \note If an error is detected or a path could not be found, the function will empty the path vector before returning
     **/
     Path FindPath(private_map::VirtualSprite *sprite, const MapPosition &destination);
 
+    /** \brief Gives the direction a sprite should take to chase the map camera around obstacles.
+    *** \param sprite The chasing sprite.
+    *** \param direction Set to the direction to take, when found.
+    *** \return false when the sprite should simply head toward the camera: when it is next to it,
+    *** too far away, or when it isn't blocked by walls.
+    ***
+    *** The answer comes from a flow field shared by all the chasing sprites, computed again
+    *** only when the camera enters a new collision cell.
+    **/
+    bool GetChaseDirection(const VirtualSprite *sprite, uint16 &direction);
+
+    /** \brief Enables or disables the use of the region graph when finding paths (default == true).
+    *** When disabled, the whole map is searched for each path.
+    **/
+    void SetHierarchicalPathfinding(bool enabled) {
+        _hierarchical_pathfinding = enabled;
+    }
+
+    bool IsHierarchicalPathfindingEnabled() const {
+        return _hierarchical_pathfinding;
+    }
+
+    //! \brief Tells that the static obstacles must be given to the region graph again before the next search.
+    void InvalidateStaticObstacles() {
+        _static_obstacles_dirty = true;
+    }
+
     /** \brief Returns the pointer to the virtual focus.
     **/
     private_map::VirtualSprite *VirtualFocus() {
@@ -1014,15 +1157,35 @@ public:
     //! \return whether the location would be a "wall" for the party or not
     bool IsStaticCollision(uint32 x, uint32 y);
 
+    //! \brief Gives the IsStaticCollision() result of every cell of the collision grid at once.
+    //! \param grid Filled with 1 for the static collisions and 0 elsewhere, stored row by row
+    void GetStaticCollisionGrid(std::vector<uint8> &grid) const;
+
     //! \brief checks if the location on the grid has a simple map collision. This is different from
     //! IsStaticCollision, int hat it DOES NOT check static objects, but only the collision value for the map
     bool IsMapCollision(uint32 x, uint32 y)
     { return (_collision_grid[y][x] > 0); }
 
+    //! returns a const reference to the collision grid, stored as grid[y][x]
+    const std::vector<std::vector<uint32> >& GetCollisionGrid() const
+    { return _collision_grid; }
+
     //! returns a const reference to the ground objects in
     const std::vector<MapObject *>& GetGroundObjects() const
     { return _ground_objects; }
 
+    /** \brief Sets how far beyond the screen edges the map objects keep on being updated, in map grid units.
+    *** Objects out of this activity region are put to sleep until they get back into it.
+    *** A negative margin keeps every object awake.
+    **/
+    void SetActivityRegionMargin(float margin) {
+        _activity_region_margin = margin;
+    }
+
+    float GetActivityRegionMargin() const {
+        return _activity_region_margin;
+    }
+
 private:
     //! \brief Returns the nearest save point. Used by FindNearestObject.
     private_map::MapObject *_FindNearestSavePoint(const VirtualSprite *sprite);
@@ -1033,6 +1196,39 @@ private:
     //! \brief Updates the ambient sounds volume according to the camera distance.
     void _UpdateAmbientSounds();
 
+    //! \brief Keeps the objects positions before the update step, for draw interpolation.
+    void _SavePreviousPositions();
+
+    //! \brief Computes the activity region from the current map frame.
+    void _UpdateActivityRegion();
+
+    /** \brief Updates the given object, or puts it to sleep when it is out of the activity region.
+    *** \param grid The visibility grid of the object layer, in which the object is moved when needed.
+    **/
+    void _UpdateObject(MapObject *object, VisibilityGrid &grid);
+
+    /** \brief Searches a path with A*, between two collision grid cells.
+    *** \param in_corridor Whether the search must stay in the corridor of the last region graph route.
+    **/
+    Path _FindPath(VirtualSprite *sprite, const PathNode &source_node, const PathNode &dest,
+                   const MapPosition &destination, bool in_corridor);
+
+    /** \brief Tells the region graph about the current state of the physical objects and treasures.
+    *** Nothing is done unless an obstacle was added or changed since the last call.
+    **/
+    void _UpdateStaticObstacles();
+
+    //! \brief Indexes the objects of every layer in their visibility grid.
+    void _BuildVisibilityGrids();
+
+    //! \brief Indexes the given layer objects by their image rectangle.
+    template <class T>
+    void _FillVisibilityGrid(const std::vector<T *> &objects, VisibilityGrid &grid);
+
+    //! \brief Appends the layer objects intersecting the screen to the given list, in no particular order.
+    void _QueryVisibleObjects(const VisibilityGrid &grid, const MapRectangle &screen_edges,
+                              std::vector<MapObject *> &visible_objects);
+
     //! \brief Debug: Draws the map zones in orange
     void _DrawMapZones();
 
@@ -1114,6 +1310,39 @@ private:
 
     //! \brief Container for all zones used in this map
     std::vector<MapZone *> _zones;
+
+    //! \brief How far beyond the screen edges objects are updated, in map grid units. Negative to disable sleeping.
+    float _activity_region_margin;
+
+    //! \brief The map area in which objects are updated, computed at the beginning of each update step.
+    MapRectangle _activity_region;
+
+    //! \brief Tells whether objects were added and the visibility grids must be rebuilt.
+    bool _visibility_grids_dirty;
+
+    //! \brief Spatial indices of each layer objects, by image rectangle.
+    VisibilityGrid _flat_ground_grid, _ground_grid, _pass_grid, _sky_grid, _halo_grid, _light_grid;
+
+    /** \brief The objects to draw in the current frame, built by UpdateVisibleObjects().
+    *** \note _visible_lights contains the visible halos followed by the visible lights.
+    **/
+    std::vector<MapObject *> _visible_flat_ground_objects;
+    std::vector<MapObject *> _visible_ground_objects;
+    std::vector<MapObject *> _visible_pass_objects;
+    std::vector<MapObject *> _visible_sky_objects;
+    std::vector<MapObject *> _visible_lights;
+
+    //! \brief Whether the region graph is used to speed up path finding.
+    bool _hierarchical_pathfinding;
+
+    //! \brief Whether static obstacles were added or changed since they were last given to the region graph.
+    bool _static_obstacles_dirty;
+
+    //! \brief The graph of the map walkable regions, built when loading the collision grid.
+    RegionGraph _region_graph;
+
+    //! \brief The distance field leading to the map camera, used by the chasing sprites.
+    FlowField _chase_flow_field;
 }; // class ObjectSupervisor
 
 } // namespace private_map
@@ -0,0 +1,518 @@
+////////////////////////////////////////////////////////////////////////////////
+//            Copyright (C) 2013 by Bertram (Valyria Tear)
+//                         All Rights Reserved
+//
+// This code is licensed under the GNU GPL version 2. It is free software
+// and you may modify it and/or redistribute it under the terms of this license.
+// See http://www.gnu.org/copyleft/gpl.html for details.
+////////////////////////////////////////////////////////////////////////////////
+
+/** ****************************************************************************
+*** \file    map_pathfinding.cpp
+*** \author  Yohann Ferreira, yohann ferreira orange fr
+*** \brief   Source file for the map hierarchical pathfinding code
+*** ***************************************************************************/
+
+#include "modes/map/map_pathfinding.h"
+
+#include <algorithm>
+#include <functional>
+#include <queue>
+
+namespace vt_map
+{
+
+namespace private_map
+{
+
+//! \brief The region index of blocked cells.
+static const uint8 NO_REGION = 255;
+
+//! \brief The region key returned for blocked cells.
+static const uint32 NO_REGION_KEY = 0xFFFFFFFF;
+
+//! \brief The flow field distance of the cells the search didn't reach.
+static const uint16 UNREACHED_DISTANCE = 0xFFFF;
+
+RegionGraph::RegionGraph() :
+    _collision_grid(0),
+    _num_grid_x_axis(0),
+    _num_grid_y_axis(0),
+    _num_clusters_x(0),
+    _num_clusters_y(0),
+    _dirty(false),
+    _version(0)
+{}
+
+void RegionGraph::Build(const std::vector<std::vector<uint32> > &collision_grid)
+{
+    Clear();
+    if(collision_grid.empty() || collision_grid[0].empty())
+        return;
+
+    _collision_grid = &collision_grid;
+    _num_grid_y_axis = collision_grid.size();
+    _num_grid_x_axis = collision_grid[0].size();
+    _num_clusters_x = (_num_grid_x_axis + REGION_CLUSTER_SIZE - 1) / REGION_CLUSTER_SIZE;
+    _num_clusters_y = (_num_grid_y_axis + REGION_CLUSTER_SIZE - 1) / REGION_CLUSTER_SIZE;
+
+    _clusters.resize(_num_clusters_x * _num_clusters_y);
+    _cell_regions.resize(_num_grid_x_axis * _num_grid_y_axis, NO_REGION);
+    _dirty = true;
+    Refresh();
+}
+
+void RegionGraph::Clear()
+{
+    _collision_grid = 0;
+    _num_grid_x_axis = 0;
+    _num_grid_y_axis = 0;
+    _num_clusters_x = 0;
+    _num_clusters_y = 0;
+    _clusters.clear();
+    _cell_regions.clear();
+    _obstacles.clear();
+    _route_cache.clear();
+    _corridor.clear();
+    _dirty = false;
+}
+
+void RegionGraph::UpdateObstacle(const MapObject *object, const MapRectangle &rect, bool blocking)
+{
+    std::map<const MapObject *, MapRectangle>::iterator it = _obstacles.find(object);
+    if(it == _obstacles.end()) {
+        if(!blocking)
+            return;
+        _obstacles.insert(std::make_pair(object, rect));
+        _InvalidateArea(rect);
+        return;
+    }
+
+    if(!blocking) {
+        _InvalidateArea(it->second);
+        _obstacles.erase(it);
+        return;
+    }
+
+    MapRectangle &old_rect = it->second;
+    if(old_rect.left == rect.left && old_rect.right == rect.right
+            && old_rect.top == rect.top && old_rect.bottom == rect.bottom)
+        return;
+
+    _InvalidateArea(old_rect);
+    _InvalidateArea(rect);
+    old_rect = rect;
+}
+
+ROUTE_RESULT RegionGraph::FindRoute(int16 source_x, int16 source_y, int16 dest_x, int16 dest_y, uint32 collision_mask)
+{
+    if(!IsBuilt())
+        return ROUTE_UNKNOWN;
+
+    Refresh();
+
+    // The sprite may be stuck in a wall: let the caller deal with it.
+    uint32 source = _GetRegionKey(source_x, source_y);
+    if(source == NO_REGION_KEY)
+        return ROUTE_UNKNOWN;
+
+    uint32 destination = _GetRegionKey(dest_x, dest_y);
+    if(destination == NO_REGION_KEY)
+        return ROUTE_NONE;
+
+    RouteKey key;
+    key.source = source;
+    key.destination = destination;
+    key.collision_mask = collision_mask;
+
+    std::map<RouteKey, std::vector<uint32> >::const_iterator it = _route_cache.find(key);
+    if(it == _route_cache.end()) {
+        std::vector<uint32> clusters;
+        if(!_SearchRoute(source, destination, static_cast<float>(dest_x), static_cast<float>(dest_y), clusters))
+            return ROUTE_NONE;
+
+        if(_route_cache.size() >= MAX_CACHED_ROUTES)
+            _route_cache.clear();
+        it = _route_cache.insert(std::make_pair(key, clusters)).first;
+    }
+
+    _corridor.assign(_clusters.size(), false);
+    for(uint32 i = 0; i < it->second.size(); ++i)
+        _corridor[it->second[i]] = true;
+
+    return ROUTE_FOUND;
+}
+
+bool RegionGraph::IsInCorridor(int16 x, int16 y) const
+{
+    if(x < 0 || y < 0 || x >= _num_grid_x_axis || y >= _num_grid_y_axis || _corridor.empty())
+        return false;
+
+    return _corridor[_GetClusterIndex(x, y)];
+}
+
+void RegionGraph::_InvalidateArea(const MapRectangle &rect)
+{
+    if(!IsBuilt())
+        return;
+
+    int32 left = static_cast<int32>(rect.left) / REGION_CLUSTER_SIZE;
+    int32 right = static_cast<int32>(rect.right) / REGION_CLUSTER_SIZE;
+    int32 top = static_cast<int32>(rect.top) / REGION_CLUSTER_SIZE;
+    int32 bottom = static_cast<int32>(rect.bottom) / REGION_CLUSTER_SIZE;
+
+    left = std::max(0, std::min(left, static_cast<int32>(_num_clusters_x) - 1));
+    right = std::max(0, std::min(right, static_cast<int32>(_num_clusters_x) - 1));
+    top = std::max(0, std::min(top, static_cast<int32>(_num_clusters_y) - 1));
+    bottom = std::max(0, std::min(bottom, static_cast<int32>(_num_clusters_y) - 1));
+
+    for(int32 y = top; y <= bottom; ++y) {
+        for(int32 x = left; x <= right; ++x)
+            _clusters[y * _num_clusters_x + x].dirty = true;
+    }
+    _dirty = true;
+}
+
+void RegionGraph::Refresh()
+{
+    if(!_dirty)
+        return;
+
+    // The links of the neighbours of a rebuilt cluster refer to its old regions.
+    std::vector<bool> relink(_clusters.size(), false);
+    for(uint32 i = 0; i < _clusters.size(); ++i) {
+        if(!_clusters[i].dirty)
+            continue;
+
+        _BuildClusterRegions(i);
+        _clusters[i].dirty = false;
+
+        int32 cluster_x = i % _num_clusters_x;
+        int32 cluster_y = i / _num_clusters_x;
+        for(int32 y = cluster_y - 1; y <= cluster_y + 1; ++y) {
+            for(int32 x = cluster_x - 1; x <= cluster_x + 1; ++x) {
+                if(x >= 0 && y >= 0 && x < static_cast<int32>(_num_clusters_x) && y < static_cast<int32>(_num_clusters_y))
+                    relink[y * _num_clusters_x + x] = true;
+            }
+        }
+    }
+
+    for(uint32 i = 0; i < _clusters.size(); ++i) {
+        if(relink[i])
+            _BuildClusterLinks(i);
+    }
+
+    _route_cache.clear();
+    _dirty = false;
+    ++_version;
+}
+
+bool RegionGraph::IsWalkable(int16 x, int16 y) const
+{
+    return _GetRegionKey(x, y) != NO_REGION_KEY;
+}
+
+void RegionGraph::_BuildClusterRegions(uint32 cluster_index)
+{
+    int16 x_start = (cluster_index % _num_clusters_x) * REGION_CLUSTER_SIZE;
+    int16 y_start = (cluster_index / _num_clusters_x) * REGION_CLUSTER_SIZE;
+    int16 x_end = std::min<int16>(x_start + REGION_CLUSTER_SIZE, _num_grid_x_axis);
+    int16 y_end = std::min<int16>(y_start + REGION_CLUSTER_SIZE, _num_grid_y_axis);
+
+    // Only keep the obstacles overlapping the cluster.
+    MapRectangle cluster_rect(x_start, x_end, y_start, y_end);
+    std::vector<MapRectangle> obstacles;
+    for(std::map<const MapObject *, MapRectangle>::const_iterator it = _obstacles.begin();
+            it != _obstacles.end(); ++it) {
+        if(MapRectangle::CheckIntersection(it->second, cluster_rect))
+            obstacles.push_back(it->second);
+    }
+
+    // Mark the walkable cells with a temporary index, and the blocked ones with NO_REGION.
+    const uint8 UNVISITED = NO_REGION - 1;
+    for(int16 y = y_start; y < y_end; ++y) {
+        for(int16 x = x_start; x < x_end; ++x) {
+            bool blocked = (*_collision_grid)[y][x] > 0;
+            // A cell is blocked by an obstacle only when fully covered by it,
+            // as no sprite can stand anywhere in that cell then.
+            for(uint32 i = 0; !blocked && i < obstacles.size(); ++i) {
+                const MapRectangle &rect = obstacles[i];
+                blocked = rect.left <= x && x + 1 <= rect.right && rect.top <= y && y + 1 <= rect.bottom;
+            }
+            _cell_regions[y * _num_grid_x_axis + x] = blocked ? NO_REGION : UNVISITED;
+        }
+    }
+
+    // Flood fill the 8-connected walkable cells of the cluster.
+    std::vector<Region> &regions = _clusters[cluster_index].regions;
+    regions.clear();
+    std::vector<std::pair<int16, int16> > open_cells;
+    for(int16 y = y_start; y < y_end; ++y) {
+        for(int16 x = x_start; x < x_end; ++x) {
+            if(_cell_regions[y * _num_grid_x_axis + x] != UNVISITED)
+                continue;
+
+            // Merge the extra regions into the last one rather than losing them:
+            // the graph must stay optimistic.
+            uint8 region_index = static_cast<uint8>(std::min<uint32>(regions.size(), UNVISITED - 1));
+            if(region_index == regions.size()) {
+                regions.push_back(Region());
+                regions.back().center_x = 0.0f;
+                regions.back().center_y = 0.0f;
+            }
+
+            float sum_x = 0.0f;
+            float sum_y = 0.0f;
+            uint32 num_cells = 0;
+            open_cells.push_back(std::make_pair(x, y));
+            _cell_regions[y * _num_grid_x_axis + x] = region_index;
+            while(!open_cells.empty()) {
+                int16 cell_x = open_cells.back().first;
+                int16 cell_y = open_cells.back().second;
+                open_cells.pop_back();
+                sum_x += cell_x;
+                sum_y += cell_y;
+                ++num_cells;
+
+                for(int16 ny = std::max<int16>(cell_y - 1, y_start); ny <= std::min<int16>(cell_y + 1, y_end - 1); ++ny) {
+                    for(int16 nx = std::max<int16>(cell_x - 1, x_start); nx <= std::min<int16>(cell_x + 1, x_end - 1); ++nx) {
+                        uint8 &cell_region = _cell_regions[ny * _num_grid_x_axis + nx];
+                        if(cell_region != UNVISITED)
+                            continue;
+                        cell_region = region_index;
+                        open_cells.push_back(std::make_pair(nx, ny));
+                    }
+                }
+            }
+
+            regions[region_index].center_x = sum_x / num_cells;
+            regions[region_index].center_y = sum_y / num_cells;
+        }
+    }
+}
+
+void RegionGraph::_BuildClusterLinks(uint32 cluster_index)
+{
+    std::vector<Region> &regions = _clusters[cluster_index].regions;
+    for(uint32 i = 0; i < regions.size(); ++i) {
+        regions[i].neighbours.clear();
+        regions[i].costs.clear();
+    }
+
+    int16 x_start = (cluster_index % _num_clusters_x) * REGION_CLUSTER_SIZE;
+    int16 y_start = (cluster_index / _num_clusters_x) * REGION_CLUSTER_SIZE;
+    int16 x_end = std::min<int16>(x_start + REGION_CLUSTER_SIZE, _num_grid_x_axis);
+    int16 y_end = std::min<int16>(y_start + REGION_CLUSTER_SIZE, _num_grid_y_axis);
+
+    for(int16 y = y_start; y < y_end; ++y) {
+        for(int16 x = x_start; x < x_end; ++x) {
+            // Only the cells on the cluster border have neighbours in other clusters.
+            if(x != x_start && x != x_end - 1 && y != y_start && y != y_end - 1)
+                continue;
+
+            uint8 region_index = _cell_regions[y * _num_grid_x_axis + x];
+            if(region_index == NO_REGION)
+                continue;
+            Region &region = regions[region_index];
+
+            for(int16 ny = y - 1; ny <= y + 1; ++ny) {
+                for(int16 nx = x - 1; nx <= x + 1; ++nx) {
+                    if(nx < 0 || ny < 0 || nx >= _num_grid_x_axis || ny >= _num_grid_y_axis)
+                        continue;
+                    if(nx >= x_start && nx < x_end && ny >= y_start && ny < y_end)
+                        continue;
+
+                    uint32 neighbour = _GetRegionKey(nx, ny);
+                    if(neighbour == NO_REGION_KEY)
+                        continue;
+                    if(std::find(region.neighbours.begin(), region.neighbours.end(), neighbour) != region.neighbours.end())
+                        continue;
+
+                    const Region &neighbour_region = _GetRegion(neighbour);
+                    float delta_x = neighbour_region.center_x - region.center_x;
+                    float delta_y = neighbour_region.center_y - region.center_y;
+                    region.neighbours.push_back(neighbour);
+                    region.costs.push_back(sqrtf(delta_x * delta_x + delta_y * delta_y));
+                }
+            }
+        }
+    }
+}
+
+bool RegionGraph::_SearchRoute(uint32 source, uint32 destination, float dest_x, float dest_y,
+                               std::vector<uint32> &clusters)
+{
+    clusters.clear();
+
+    // The open list is ordered by the lowest f score first.
+    typedef std::pair<float, uint32> OpenNode;
+    std::priority_queue<OpenNode, std::vector<OpenNode>, std::greater<OpenNode> > open_list;
+    std::map<uint32, float> g_scores;
+    std::map<uint32, uint32> parents;
+
+    g_scores[source] = 0.0f;
+    open_list.push(std::make_pair(0.0f, source));
+
+    bool found = false;
+    while(!open_list.empty()) {
+        uint32 current = open_list.top().second;
+        float f_score = open_list.top().first;
+        open_list.pop();
+
+        if(current == destination) {
+            found = true;
+            break;
+        }
+
+        const Region &region = _GetRegion(current);
+        float g_score = g_scores[current];
+
+        // Skip the outdated open list entries.
+        float delta_x = dest_x - region.center_x;
+        float delta_y = dest_y - region.center_y;
+        if(f_score > g_score + sqrtf(delta_x * delta_x + delta_y * delta_y) + 0.001f)
+            continue;
+
+        for(uint32 i = 0; i < region.neighbours.size(); ++i) {
+            uint32 neighbour = region.neighbours[i];
+            float new_g_score = g_score + region.costs[i];
+
+            std::map<uint32, float>::iterator it = g_scores.find(neighbour);
+            if(it != g_scores.end() && it->second <= new_g_score)
+                continue;
+
+            g_scores[neighbour] = new_g_score;
+            parents[neighbour] = current;
+
+            const Region &neighbour_region = _GetRegion(neighbour);
+            delta_x = dest_x - neighbour_region.center_x;
+            delta_y = dest_y - neighbour_region.center_y;
+            open_list.push(std::make_pair(new_g_score + sqrtf(delta_x * delta_x + delta_y * delta_y), neighbour));
+        }
+    }
+
+    if(!found)
+        return false;
+
+    // Go back from the destination to collect the route clusters.
+    uint32 current = destination;
+    clusters.push_back(current >> 8);
+    while(current != source) {
+        current = parents[current];
+        if((current >> 8) != clusters.back())
+            clusters.push_back(current >> 8);
+    }
+    return true;
+}
+
+uint32 RegionGraph::_GetRegionKey(int16 x, int16 y) const
+{
+    if(x < 0 || y < 0 || x >= _num_grid_x_axis || y >= _num_grid_y_axis)
+        return NO_REGION_KEY;
+
+    uint8 region_index = _cell_regions[y * _num_grid_x_axis + x];
+    if(region_index == NO_REGION)
+        return NO_REGION_KEY;
+
+    return (_GetClusterIndex(x, y) << 8) | region_index;
+}
+
+FlowField::FlowField() :
+    _num_grid_x_axis(0),
+    _num_grid_y_axis(0),
+    _target_x(-1),
+    _target_y(-1),
+    _graph_version(0)
+{}
+
+void FlowField::Compute(RegionGraph &graph, int16 target_x, int16 target_y)
+{
+    graph.Refresh();
+
+    _num_grid_x_axis = graph.GetNumGridXAxis();
+    _num_grid_y_axis = graph.GetNumGridYAxis();
+    _target_x = target_x;
+    _target_y = target_y;
+    _graph_version = graph.GetVersion();
+    _distances.assign(_num_grid_x_axis * _num_grid_y_axis, UNREACHED_DISTANCE);
+
+    if(target_x < 0 || target_y < 0 || target_x >= _num_grid_x_axis || target_y >= _num_grid_y_axis)
+        return;
+
+    static const int16 offsets[4][2] = { { -1, 0 }, { 1, 0 }, { 0, -1 }, { 0, 1 } };
+
+    // The cells are visited by increasing distance, so each one is reached only once.
+    std::vector<uint32> open_cells;
+    open_cells.push_back(target_y * _num_grid_x_axis + target_x);
+    _distances[open_cells.back()] = 0;
+    for(uint32 i = 0; i < open_cells.size(); ++i) {
+        int16 x = open_cells[i] % _num_grid_x_axis;
+        int16 y = open_cells[i] / _num_grid_x_axis;
+        uint16 distance = _distances[open_cells[i]];
+        if(distance >= MAX_FLOW_FIELD_DISTANCE)
+            continue;
+
+        for(uint32 j = 0; j < 4; ++j) {
+            int16 nx = x + offsets[j][0];
+            int16 ny = y + offsets[j][1];
+            if(!graph.IsWalkable(nx, ny))
+                continue;
+
+            uint32 index = ny * _num_grid_x_axis + nx;
+            if(_distances[index] != UNREACHED_DISTANCE)
+                continue;
+
+            _distances[index] = distance + 1;
+            open_cells.push_back(index);
+        }
+    }
+}
+
+bool FlowField::GetDirection(int16 x, int16 y, int16 &delta_x, int16 &delta_y) const
+{
+    uint16 best_distance = _GetDistance(x, y);
+    if(best_distance == UNREACHED_DISTANCE || best_distance == 0)
+        return false;
+
+    bool found = false;
+    for(int16 dy = -1; dy <= 1; ++dy) {
+        for(int16 dx = -1; dx <= 1; ++dx) {
+            if(dx == 0 && dy == 0)
+                continue;
+
+            uint16 distance = _GetDistance(x + dx, y + dy);
+            if(distance >= best_distance)
+                continue;
+
+            // Don't cut corners, as sprites would get stuck on them.
+            if(dx != 0 && dy != 0 && (_GetDistance(x + dx, y) == UNREACHED_DISTANCE
+                                      || _GetDistance(x, y + dy) == UNREACHED_DISTANCE))
+                continue;
+
+            best_distance = distance;
+            delta_x = dx;
+            delta_y = dy;
+            found = true;
+        }
+    }
+    return found;
+}
+
+void FlowField::Clear()
+{
+    _distances.clear();
+    _target_x = -1;
+    _target_y = -1;
+}
+
+uint16 FlowField::_GetDistance(int16 x, int16 y) const
+{
+    if(x < 0 || y < 0 || x >= _num_grid_x_axis || y >= _num_grid_y_axis || _distances.empty())
+        return UNREACHED_DISTANCE;
+
+    return _distances[y * _num_grid_x_axis + x];
+}
+
+} // namespace private_map
+
+} // namespace vt_map
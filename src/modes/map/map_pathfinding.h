@@ -0,0 +1,284 @@
+////////////////////////////////////////////////////////////////////////////////
+//            Copyright (C) 2013 by Bertram (Valyria Tear)
+//                         All Rights Reserved
+//
+// This code is licensed under the GNU GPL version 2. It is free software
+// and you may modify it and/or redistribute it under the terms of this license.
+// See http://www.gnu.org/copyleft/gpl.html for details.
+////////////////////////////////////////////////////////////////////////////////
+
+/** ****************************************************************************
+*** \file    map_pathfinding.h
+*** \author  Yohann Ferreira, yohann ferreira orange fr
+*** \brief   Header file for the map hierarchical pathfinding code
+***
+*** The collision grid is split into square clusters, and each cluster into
+*** regions of connected walkable cells. Searching the small graph formed by
+*** those regions first tells which clusters a path goes through, so that the
+*** cell based A* search only has to look into that corridor.
+*** ***************************************************************************/
+
+#ifndef __MAP_PATHFINDING_HEADER__
+#define __MAP_PATHFINDING_HEADER__
+
+#include "modes/map/map_utils.h"
+
+#include <map>
+
+namespace vt_map
+{
+
+namespace private_map
+{
+
+class MapObject;
+
+//! \brief The width and height of the region graph clusters, in map grid units.
+const uint16 REGION_CLUSTER_SIZE = 16;
+
+//! \brief The maximum number of routes kept by the region graph before its cache is emptied.
+const uint32 MAX_CACHED_ROUTES = 512;
+
+//! \brief Tells what the region graph knows about a route between two cells.
+enum ROUTE_RESULT {
+    ROUTE_UNKNOWN = 0, //!< The graph can't tell, the whole map has to be searched.
+    ROUTE_FOUND   = 1, //!< A route exists and the clusters it goes through are known.
+    ROUTE_NONE    = 2  //!< The destination can't be reached.
+};
+
+/** ****************************************************************************
+*** \brief An abstract graph of the map walkable regions, used to speed up long path searches.
+***
+*** Each cluster of REGION_CLUSTER_SIZE x REGION_CLUSTER_SIZE collision cells is split
+*** into regions of 8-connected walkable cells. Regions of neighbour clusters touching
+*** each other are linked. A route found in this graph gives the corridor of clusters
+*** a sprite has to walk through.
+***
+*** A cell is considered walkable unless the collision grid blocks it or a static
+*** obstacle fully covers it, so that the graph never misses a route. The routes it
+*** finds may still be blocked for a given sprite, because of its size or of other
+*** sprites, in which case the whole map has to be searched.
+***
+*** \note Static obstacles are the physical objects and treasures with a collision mask.
+*** When one of them changes, only the clusters it overlaps are rebuilt, before the next query.
+*** ***************************************************************************/
+class RegionGraph
+{
+public:
+    RegionGraph();
+
+    /** \brief Builds the graph from the map collision grid.
+    *** \param collision_grid The map collision grid, which must outlive the graph.
+    **/
+    void Build(const std::vector<std::vector<uint32> > &collision_grid);
+
+    //! \brief Frees the graph data.
+    void Clear();
+
+    //! \brief Tells whether the graph was built.
+    bool IsBuilt() const {
+        return _collision_grid != 0;
+    }
+
+    /** \brief Tells the graph about the current state of a static obstacle.
+    *** \param object The obstacle, only used as a key.
+    *** \param rect The obstacle collision rectangle.
+    *** \param blocking Whether the obstacle currently blocks walls colliding sprites.
+    *** Nothing is done when the obstacle didn't change since the last call.
+    **/
+    void UpdateObstacle(const MapObject *object, const MapRectangle &rect, bool blocking);
+
+    /** \brief Finds the corridor of clusters leading from a cell to another.
+    *** \param source_x, source_y The source cell.
+    *** \param dest_x, dest_y The destination cell.
+    *** \param collision_mask The collision mask of the sprite looking for a path.
+    *** \return What the graph knows about the route. When ROUTE_FOUND is returned,
+    *** IsInCorridor() tells the cells the path should go through.
+    **/
+    ROUTE_RESULT FindRoute(int16 source_x, int16 source_y, int16 dest_x, int16 dest_y, uint32 collision_mask);
+
+    //! \brief Tells whether the given cell is in the corridor of the last route found.
+    bool IsInCorridor(int16 x, int16 y) const;
+
+    //! \brief Rebuilds the clusters changed by the static obstacles since the last call, and the links around them.
+    void Refresh();
+
+    /** \brief Tells whether a cell is walkable for sprites colliding with walls.
+    *** \note Call Refresh() first to take the latest obstacle changes in account.
+    **/
+    bool IsWalkable(int16 x, int16 y) const;
+
+    //! \brief Returns a number changing each time the graph is rebuilt, even partially.
+    uint32 GetVersion() const {
+        return _version;
+    }
+
+    uint16 GetNumGridXAxis() const {
+        return _num_grid_x_axis;
+    }
+
+    uint16 GetNumGridYAxis() const {
+        return _num_grid_y_axis;
+    }
+
+private:
+    //! \brief A set of connected walkable cells inside a cluster.
+    struct Region {
+        //! \brief The average position of the region cells.
+        float center_x, center_y;
+
+        //! \brief The keys of the linked regions in neighbour clusters, and the cost to reach them.
+        std::vector<uint32> neighbours;
+        std::vector<float> costs;
+    };
+
+    //! \brief The regions of a cluster.
+    struct Cluster {
+        Cluster() :
+            dirty(true)
+        {}
+
+        std::vector<Region> regions;
+
+        //! \brief Whether the cluster regions must be rebuilt before the next query.
+        bool dirty;
+    };
+
+    //! \brief The key of a cached route.
+    struct RouteKey {
+        uint32 source, destination, collision_mask;
+
+        bool operator<(const RouteKey &that) const {
+            if(source != that.source)
+                return source < that.source;
+            if(destination != that.destination)
+                return destination < that.destination;
+            return collision_mask < that.collision_mask;
+        }
+    };
+
+    //! \brief The map collision grid, stored as _collision_grid[y][x].
+    const std::vector<std::vector<uint32> > *_collision_grid;
+
+    //! \brief The map size, in collision cells.
+    uint16 _num_grid_x_axis, _num_grid_y_axis;
+
+    //! \brief The number of clusters on the x and y axes.
+    uint32 _num_clusters_x, _num_clusters_y;
+
+    //! \brief The map clusters, stored row by row.
+    std::vector<Cluster> _clusters;
+
+    //! \brief The region index of every cell in its cluster, stored row by row. NO_REGION for blocked cells.
+    std::vector<uint8> _cell_regions;
+
+    //! \brief The collision rectangles of the blocking static obstacles.
+    std::map<const MapObject *, MapRectangle> _obstacles;
+
+    //! \brief Whether any cluster is dirty.
+    bool _dirty;
+
+    //! \brief Incremented each time clusters are rebuilt.
+    uint32 _version;
+
+    //! \brief The clusters of the routes already found.
+    std::map<RouteKey, std::vector<uint32> > _route_cache;
+
+    //! \brief Tells which clusters are in the corridor of the last route found.
+    std::vector<bool> _corridor;
+
+    //! \brief Marks the clusters overlapped by the given rectangle as dirty.
+    void _InvalidateArea(const MapRectangle &rect);
+
+    //! \brief Splits a cluster into regions of connected walkable cells.
+    void _BuildClusterRegions(uint32 cluster_index);
+
+    //! \brief Links the regions of a cluster to the regions of its neighbour clusters.
+    void _BuildClusterLinks(uint32 cluster_index);
+
+    /** \brief Searches the region graph with A*.
+    *** \param source, destination The source and destination region keys.
+    *** \param dest_x, dest_y The destination cell, used by the search heuristic.
+    *** \param clusters Filled with the clusters the route goes through.
+    *** \return Whether a route was found.
+    **/
+    bool _SearchRoute(uint32 source, uint32 destination, float dest_x, float dest_y,
+                      std::vector<uint32> &clusters);
+
+    //! \brief Returns the region key of a cell, or NO_REGION_KEY when the cell is blocked.
+    uint32 _GetRegionKey(int16 x, int16 y) const;
+
+    //! \brief Returns the region corresponding to the given key.
+    const Region &_GetRegion(uint32 key) const {
+        return _clusters[key >> 8].regions[key & 0xFF];
+    }
+
+    uint32 _GetClusterIndex(int16 x, int16 y) const {
+        return (y / REGION_CLUSTER_SIZE) * _num_clusters_x + (x / REGION_CLUSTER_SIZE);
+    }
+}; // class RegionGraph
+
+
+//! \brief The maximum distance, in collision cells, a flow field spreads from its target.
+const uint16 MAX_FLOW_FIELD_DISTANCE = 96;
+
+/** ****************************************************************************
+*** \brief A distance field leading every walkable cell to a common target.
+***
+*** The field is computed with a breadth-first search from the target cell,
+*** over the cells the region graph tells walkable. Any number of sprites
+*** chasing the same target can then find their way by looking at the
+*** distances of their neighbour cells, without any search of their own.
+***
+*** \note Cells farther than MAX_FLOW_FIELD_DISTANCE from the target are left
+*** unreached, and the sprites there should simply head toward the target.
+*** ***************************************************************************/
+class FlowField
+{
+public:
+    FlowField();
+
+    /** \brief Computes the distances of every cell to the given target.
+    *** \param graph The region graph telling the walkable cells, refreshed first.
+    *** \param target_x, target_y The target cell.
+    **/
+    void Compute(RegionGraph &graph, int16 target_x, int16 target_y);
+
+    //! \brief Tells whether the field leads to the given cell and the graph didn't change since.
+    bool IsUpToDate(int16 target_x, int16 target_y, const RegionGraph &graph) const {
+        return !_distances.empty() && _target_x == target_x && _target_y == target_y
+               && _graph_version == graph.GetVersion();
+    }
+
+    /** \brief Gives the neighbour cell to move to, to get closer to the target.
+    *** \param x, y The cell to move from.
+    *** \param delta_x, delta_y Set to the offsets of the neighbour cell, between -1 and 1.
+    *** \return false when the cell is unreached, or is the target.
+    **/
+    bool GetDirection(int16 x, int16 y, int16 &delta_x, int16 &delta_y) const;
+
+    //! \brief Frees the field data.
+    void Clear();
+
+private:
+    //! \brief The map size, in collision cells.
+    uint16 _num_grid_x_axis, _num_grid_y_axis;
+
+    //! \brief The current target cell.
+    int16 _target_x, _target_y;
+
+    //! \brief The region graph version the field was computed with.
+    uint32 _graph_version;
+
+    //! \brief The distance of each cell to the target, stored row by row. UNREACHED_DISTANCE when unknown.
+    std::vector<uint16> _distances;
+
+    //! \brief Returns the distance of a cell to the target, or UNREACHED_DISTANCE out of the map.
+    uint16 _GetDistance(int16 x, int16 y) const;
+}; // class FlowField
+
+} // namespace private_map
+
+} // namespace vt_map
+
+#endif // __MAP_PATHFINDING_HEADER__
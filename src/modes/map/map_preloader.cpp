@@ -0,0 +1,315 @@
+////////////////////////////////////////////////////////////////////////////////
+//            Copyright (C) 2013 by Bertram (Valyria Tear)
+//                         All Rights Reserved
+//
+// This code is licensed under the GNU GPL version 2. It is free software
+// and you may modify it and/or redistribute it under the terms of this license.
+// See http://www.gnu.org/copyleft/gpl.html for details.
+////////////////////////////////////////////////////////////////////////////////
+
+/** ****************************************************************************
+*** \file    map_preloader.cpp
+*** \author  Yohann Ferreira, yohann ferreira orange fr
+*** \brief   Source file for the preloading of the maps reachable from the current one
+*** ***************************************************************************/
+
+#include "modes/map/map_preloader.h"
+
+#include "modes/map/map_chunks.h"
+#include "modes/map/map_events.h"
+
+#include "engine/audio/audio.h"
+#include "engine/script/script.h"
+#include "engine/video/video.h"
+
+using namespace vt_utils;
+using namespace vt_audio;
+using namespace vt_script;
+using namespace vt_video;
+using namespace vt_video::private_video;
+
+namespace vt_map
+{
+
+namespace private_map
+{
+
+//! \brief Appends the chunks given by lua_dump() to a string.
+static int _WriteBytecode(lua_State * /*state*/, const void *data, size_t size, void *bytecode)
+{
+    static_cast<std::string *>(bytecode)->append(static_cast<const char *>(data), size);
+    return 0;
+}
+
+//! \brief Reads a string field of a global table, or returns an empty string.
+static std::string _ReadGlobalTableString(lua_State *state, const std::string &table, const char *field)
+{
+    std::string value;
+    lua_getglobal(state, table.c_str());
+    if(lua_istable(state, -1)) {
+        lua_getfield(state, -1, field);
+        if(lua_type(state, -1) == LUA_TSTRING)
+            value = lua_tostring(state, -1);
+        lua_pop(state, 1);
+    }
+    lua_pop(state, 1);
+    return value;
+}
+
+MapPreloader::MapPreloader(vt_mode_manager::GameMode *owner) :
+    _owner(owner),
+    _preload_thread(NULL),
+    _preload_lock(NULL),
+    _stop_requested(false),
+    _preload_done(false),
+    _preloaded_memory(0)
+{}
+
+MapPreloader::~MapPreloader()
+{
+    _Stop();
+}
+
+void MapPreloader::Start(const std::vector<MapTransitionEvent *> &events)
+{
+    _Stop();
+
+    // Whatever was preloaded for the previous map has been used to load this one by now.
+    ScriptManager->ClearPrecompiledScripts();
+    TextureManager->ClearPreloadedImages();
+
+    _target_maps.clear();
+    std::set<std::string> data_filenames;
+    for(uint32 i = 0; i < events.size(); ++i) {
+        const std::string &data_filename = events[i]->GetMapDataFilename();
+        const std::string &script_filename = events[i]->GetMapScriptFilename();
+        if(data_filename.empty() || script_filename.empty())
+            continue;
+        if(data_filenames.insert(data_filename).second)
+            _target_maps.push_back(std::make_pair(data_filename, script_filename));
+    }
+
+    if(_target_maps.empty())
+        return;
+
+    _stop_requested = false;
+    _preload_done = false;
+    _preloaded_memory = 0;
+    _preloaded_files.clear();
+
+    _preload_lock = vt_system::SystemManager->CreateSemaphore(1);
+    _preload_thread = vt_system::SystemManager->SpawnThread(&MapPreloader::_Preload, this);
+    if(!_preload_thread) {
+        PRINT_WARNING << "Couldn't start the map preload thread" << std::endl;
+        vt_system::SystemManager->DestroySemaphore(_preload_lock);
+        _preload_lock = NULL;
+    }
+}
+
+void MapPreloader::Update()
+{
+    if(_preload_lock) {
+        std::vector<PreloadedScript> scripts;
+        std::vector<PreloadedImage> images;
+        bool done = false;
+
+        vt_system::SystemManager->LockThread(_preload_lock);
+        scripts.swap(_scripts);
+        images.swap(_images);
+        for(uint32 i = 0; i < _music_filenames.size(); ++i)
+            _pending_music.push_back(_music_filenames[i]);
+        _music_filenames.clear();
+        done = _preload_done;
+        vt_system::SystemManager->UnlockThread(_preload_lock);
+
+        for(uint32 i = 0; i < scripts.size(); ++i)
+            ScriptManager->AddPrecompiledScript(scripts[i].filename, scripts[i].bytecode);
+        for(uint32 i = 0; i < images.size(); ++i)
+            TextureManager->AddPreloadedImage(images[i].filename, images[i].image);
+
+        if(done) {
+            vt_system::SystemManager->WaitForThread(_preload_thread);
+            _preload_thread = NULL;
+            vt_system::SystemManager->DestroySemaphore(_preload_lock);
+            _preload_lock = NULL;
+        }
+    }
+
+    // Only one music file is opened per update, to keep the frame rate steady.
+    while(!_pending_music.empty()) {
+        std::string music_filename = _pending_music.back();
+        _pending_music.pop_back();
+        if(!_loaded_music.insert(music_filename).second)
+            continue;
+
+        if(!AudioManager->LoadMusic(music_filename, _owner))
+            PRINT_WARNING << "Couldn't preload the map music: " << music_filename << std::endl;
+        break;
+    }
+}
+
+void MapPreloader::_Preload()
+{
+    lua_State *state = luaL_newstate();
+    if(state) {
+        luaL_openlibs(state);
+
+        for(uint32 i = 0; i < _target_maps.size(); ++i) {
+            if(_preloaded_memory >= MAX_PRELOAD_MEMORY || _IsStopRequested())
+                break;
+
+            const std::string &data_filename = _target_maps[i].first;
+            const std::string &script_filename = _target_maps[i].second;
+
+            // The map script, run to know the map music
+            if(_PreloadScript(state, script_filename)) {
+                std::string music_filename = _ReadGlobalTableString(state, ScriptEngine::GetTableSpace(script_filename),
+                                                                    "music_filename");
+                if(!music_filename.empty()) {
+                    vt_system::SystemManager->LockThread(_preload_lock);
+                    _music_filenames.push_back(music_filename);
+                    vt_system::SystemManager->UnlockThread(_preload_lock);
+                }
+            }
+
+            // The map data file isn't run by the map mode when its packed file is up to date.
+            std::vector<std::string> tileset_filenames;
+            uint32 data_hash = 0;
+            MapChunkFile chunk_file;
+            if(chunk_file.Open(MapChunkFile::GetPackedFilename(data_filename, data_hash), data_hash)) {
+                tileset_filenames = chunk_file.GetTilesetFilenames();
+                chunk_file.Close();
+            }
+            else if(_PreloadScript(state, data_filename)) {
+                lua_getglobal(state, "map_data");
+                if(lua_istable(state, -1)) {
+                    lua_getfield(state, -1, "tileset_filenames");
+                    for(int32 j = 1; lua_istable(state, -1); ++j) {
+                        lua_rawgeti(state, -1, j);
+                        bool found = (lua_type(state, -1) == LUA_TSTRING);
+                        if(found)
+                            tileset_filenames.push_back(lua_tostring(state, -1));
+                        lua_pop(state, 1);
+                        if(!found)
+                            break;
+                    }
+                    lua_pop(state, 1);
+                }
+                lua_pop(state, 1);
+            }
+
+            for(uint32 j = 0; j < tileset_filenames.size(); ++j) {
+                if(_IsStopRequested() || !_PreloadScript(state, tileset_filenames[j]))
+                    continue;
+
+                std::string image_filename = _ReadGlobalTableString(state, "tileset", "image");
+                if(!image_filename.empty())
+                    _PreloadImage(image_filename);
+            }
+
+            // Don't keep the previous map tables around
+            lua_gc(state, LUA_GCCOLLECT, 0);
+        }
+
+        lua_close(state);
+    }
+
+    vt_system::SystemManager->LockThread(_preload_lock);
+    _preload_done = true;
+    vt_system::SystemManager->UnlockThread(_preload_lock);
+}
+
+bool MapPreloader::_PreloadScript(lua_State *state, const std::string &filename)
+{
+    if(!DoesFileExist(filename) || luaL_loadfile(state, filename.c_str()) != 0) {
+        lua_settop(state, 0);
+        return false;
+    }
+
+    if(_preloaded_files.insert(filename).second && _preloaded_memory < MAX_PRELOAD_MEMORY) {
+        PreloadedScript script;
+        script.filename = filename;
+        lua_dump(state, _WriteBytecode, &script.bytecode);
+        _preloaded_memory += script.bytecode.size();
+
+        vt_system::SystemManager->LockThread(_preload_lock);
+        _scripts.push_back(script);
+        vt_system::SystemManager->UnlockThread(_preload_lock);
+    }
+
+    // Runs the file, so that the data it declares can be read.
+    if(lua_pcall(state, 0, 0, 0) != 0) {
+        lua_settop(state, 0);
+        return false;
+    }
+    return true;
+}
+
+bool MapPreloader::_PreloadImage(const std::string &filename)
+{
+    if(!_preloaded_files.insert(filename).second)
+        return true;
+
+    if(_preloaded_memory >= MAX_PRELOAD_MEMORY || !DoesFileExist(filename))
+        return false;
+
+    PreloadedImage image;
+    image.filename = filename;
+    if(!image.image.DecodeImage(filename))
+        return false;
+
+    uint32 image_size = image.image.width * image.image.height * 4;
+    if(_preloaded_memory + image_size > MAX_PRELOAD_MEMORY) {
+        free(image.image.pixels);
+        image.image.pixels = NULL;
+        _preloaded_memory = MAX_PRELOAD_MEMORY;
+        return false;
+    }
+    _preloaded_memory += image_size;
+
+    vt_system::SystemManager->LockThread(_preload_lock);
+    _images.push_back(image);
+    vt_system::SystemManager->UnlockThread(_preload_lock);
+
+    // The pixels are now owned by the copy.
+    image.image.pixels = NULL;
+    return true;
+}
+
+bool MapPreloader::_IsStopRequested()
+{
+    vt_system::SystemManager->LockThread(_preload_lock);
+    bool stop_requested = _stop_requested;
+    vt_system::SystemManager->UnlockThread(_preload_lock);
+    return stop_requested;
+}
+
+void MapPreloader::_Stop()
+{
+    if(_preload_thread) {
+        vt_system::SystemManager->LockThread(_preload_lock);
+        _stop_requested = true;
+        vt_system::SystemManager->UnlockThread(_preload_lock);
+
+        vt_system::SystemManager->WaitForThread(_preload_thread);
+        _preload_thread = NULL;
+    }
+
+    if(_preload_lock) {
+        vt_system::SystemManager->DestroySemaphore(_preload_lock);
+        _preload_lock = NULL;
+    }
+
+    for(uint32 i = 0; i < _images.size(); ++i) {
+        free(_images[i].image.pixels);
+        _images[i].image.pixels = NULL;
+    }
+    _scripts.clear();
+    _images.clear();
+    _music_filenames.clear();
+    _pending_music.clear();
+}
+
+} // namespace private_map
+
+} // namespace vt_map
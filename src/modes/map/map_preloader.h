@@ -0,0 +1,150 @@
+////////////////////////////////////////////////////////////////////////////////
+//            Copyright (C) 2013 by Bertram (Valyria Tear)
+//                         All Rights Reserved
+//
+// This code is licensed under the GNU GPL version 2. It is free software
+// and you may modify it and/or redistribute it under the terms of this license.
+// See http://www.gnu.org/copyleft/gpl.html for details.
+////////////////////////////////////////////////////////////////////////////////
+
+/** ****************************************************************************
+*** \file    map_preloader.h
+*** \author  Yohann Ferreira, yohann ferreira orange fr
+*** \brief   Header file for the preloading of the maps reachable from the current one
+***
+*** Once a map is loaded, the maps its transition events lead to are prepared
+*** in a background thread: their scripts are compiled to bytecode and their
+*** tileset images are decoded, so that loading them later on doesn't have to
+*** parse nor decode those files anymore.
+*** ***************************************************************************/
+
+#ifndef __MAP_PRELOADER_HEADER__
+#define __MAP_PRELOADER_HEADER__
+
+#include "engine/video/image_base.h"
+#include "engine/system.h"
+
+#include <set>
+
+struct lua_State;
+
+namespace vt_mode_manager
+{
+class GameMode;
+}
+
+namespace vt_map
+{
+
+namespace private_map
+{
+
+class MapTransitionEvent;
+
+//! \brief The maximum memory size, in bytes, of the script bytecode and image data preloaded.
+const uint32 MAX_PRELOAD_MEMORY = 32 * 1024 * 1024;
+
+/** ****************************************************************************
+*** \brief Prepares the maps reachable through the map transition events.
+***
+*** The preload thread compiles the map data, map script and tileset definition
+*** files of each target map with its own Lua state, and decodes the tileset images.
+*** The results are handed over to the script and texture engines by Update(),
+*** since those can only be used from the main thread. The target maps music is
+*** loaded there too, owned by the current map mode so that it's freed along with
+*** it when it isn't used by the next map.
+***
+*** \note The preloading stops once MAX_PRELOAD_MEMORY is reached, and the data
+*** preloaded for the previous map is freed when a new preloading starts.
+*** ***************************************************************************/
+class MapPreloader
+{
+public:
+    //! \param owner The game mode owning the preloaded music.
+    MapPreloader(vt_mode_manager::GameMode *owner);
+
+    //! \brief Stops the preload thread.
+    ~MapPreloader();
+
+    /** \brief Starts preloading the target maps of the given events in the background.
+    *** \param events The map transition events of the current map.
+    **/
+    void Start(const std::vector<MapTransitionEvent *> &events);
+
+    //! \brief Hands over the preloaded data to the engines. Must be called from the main thread.
+    void Update();
+
+private:
+    //! \brief The bytecode of a compiled script file.
+    struct PreloadedScript {
+        std::string filename;
+        std::string bytecode;
+    };
+
+    //! \brief The decoded data of an image file.
+    struct PreloadedImage {
+        std::string filename;
+        vt_video::private_video::ImageMemory image;
+    };
+
+    //! \brief The game mode owning the preloaded music.
+    vt_mode_manager::GameMode *_owner;
+
+    //! \brief The data and script filenames of the maps to preload. Read by the preload thread.
+    std::vector<std::pair<std::string, std::string> > _target_maps;
+
+    //! \brief The preload thread, or NULL when not running.
+    Thread *_preload_thread;
+
+    //! \brief Protects the members below, shared with the preload thread.
+    Semaphore *_preload_lock;
+
+    //! \brief Tells the preload thread to stop as soon as possible.
+    bool _stop_requested;
+
+    //! \brief Set by the preload thread once it's done.
+    bool _preload_done;
+
+    //! \brief The preloaded data not handed over yet.
+    std::vector<PreloadedScript> _scripts;
+    std::vector<PreloadedImage> _images;
+    std::vector<std::string> _music_filenames;
+
+    //! \brief The music files to load and the ones already loaded, only used by the main thread.
+    std::vector<std::string> _pending_music;
+    std::set<std::string> _loaded_music;
+
+    //! \brief The files already handled by the preload thread, only used by it.
+    std::set<std::string> _preloaded_files;
+
+    //! \brief The memory size of the data preloaded, only used by the preload thread.
+    uint32 _preloaded_memory;
+
+    //! \brief Preloads the target maps. Runs in the preload thread.
+    void _Preload();
+
+    /** \brief Compiles a script file, keeps its bytecode and runs it. Runs in the preload thread.
+    *** \param state The preload thread Lua state.
+    *** \param filename The script file to compile.
+    *** \return Whether the file could be run, so that the data it declares can be read.
+    *** The bytecode isn't kept when the file was already preloaded or the memory limit is reached.
+    **/
+    bool _PreloadScript(lua_State *state, const std::string &filename);
+
+    /** \brief Decodes a tileset image and keeps its data. Runs in the preload thread.
+    *** \return false when the memory limit is reached.
+    **/
+    bool _PreloadImage(const std::string &filename);
+
+    //! \brief Tells whether the preloading should stop.
+    bool _IsStopRequested();
+
+    //! \brief Stops the preload thread and frees the data not handed over.
+    void _Stop();
+}; // class MapPreloader
+
+} // namespace private_map
+
+} // namespace vt_map
+
+#endif // __MAP_PRELOADER_HEADER__
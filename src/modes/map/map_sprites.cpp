@@ -20,6 +20,7 @@
 #include "modes/map/map_events.h"
 
 #include "modes/battle/battle.h"
+#include "modes/battle/battle_resources.h"
 #include "common/global/global.h"
 
 using namespace vt_utils;
@@ -110,6 +111,14 @@ void VirtualSprite::Update()
     _SetNextPosition();
 } // void VirtualSprite::Update()
 
+bool VirtualSprite::CanSleep() const
+{
+    if(control_event && control_event->GetEventType() != RANDOM_MOVE_SPRITE_EVENT)
+        return false;
+
+    return MapObject::CanSleep();
+}
+
 void VirtualSprite::_SetNextPosition()
 {
 
@@ -869,6 +878,20 @@ void MapSprite::LoadFacePortrait(const std::string &filename)
     }
 }
 
+void MapSprite::_FastForward(uint32 elapsed_time)
+{
+    VirtualSprite::_FastForward(elapsed_time);
+
+    if(_custom_animation_on && _current_custom_animation) {
+        _custom_animation_time -= static_cast<int32>(elapsed_time);
+        _current_custom_animation->Update(elapsed_time);
+        return;
+    }
+
+    if(_animation && _current_anim_direction < _animation->size())
+        _animation->at(_current_anim_direction).Update(elapsed_time);
+}
+
 void MapSprite::Update()
 {
     // Stores the last value of moved_position to determine when a change in sprite movement between calls to this function occurs
@@ -1217,6 +1240,16 @@ const std::vector<BattleEnemyInfo>& EnemySprite::RetrieveRandomParty()
 
 
 
+void EnemySprite::PrepareBattleResources() const
+{
+    for(uint32 i = 0; i < _enemy_parties.size(); ++i) {
+        for(uint32 j = 0; j < _enemy_parties[i].size(); ++j)
+            vt_battle::BattleResources->PrepareEnemy(_enemy_parties[i][j].enemy_id);
+    }
+}
+
+
+
 void EnemySprite::ChangeStateHostile()
 {
     updatable = true;
@@ -1229,6 +1262,16 @@ void EnemySprite::ChangeStateHostile()
 
 
 
+void EnemySprite::_FastForward(uint32 elapsed_time)
+{
+    if(_state == SPAWNING || _state == HOSTILE)
+        _time_elapsed += elapsed_time;
+
+    MapSprite::_FastForward(elapsed_time);
+}
+
+
+
 void EnemySprite::Update()
 {
     switch(_state) {
@@ -1286,7 +1329,12 @@ void EnemySprite::Update()
             // the NULL check MUST come before the rest or a null pointer exception could happen if no zone is registered
             if(MapMode::CurrentInstance()->AttackAllowed()
                     && (_zone == NULL || (can_get_out_of_zone || _zone->IsInsideZone(camera_x, camera_y)))) {
-                if(xdelta > -0.5 && xdelta < 0.5 && ydelta < 0)
+                // Follow the shared flow field around the obstacles when it knows the way,
+                // and head straight to the camera otherwise.
+                uint16 chase_direction;
+                if(MapMode::CurrentInstance()->GetObjectSupervisor()->GetChaseDirection(this, chase_direction))
+                    SetDirection(chase_direction);
+                else if(xdelta > -0.5 && xdelta < 0.5 && ydelta < 0)
                     SetDirection(SOUTH);
                 else if(xdelta > -0.5 && xdelta < 0.5 && ydelta > 0)
                     SetDirection(NORTH);
@@ -105,6 +105,11 @@ public:
     virtual void Draw()
     {}
 
+    /** \brief Sprites controlled by an event are kept awake, so that scripted scenes are never stalled.
+    *** Random moves are the exception as they don't lead anywhere.
+    **/
+    virtual bool CanSleep() const;
+
     /** \note This method takes into account the current direction when setting the new direction
     *** in the case of diagonal movement. For example, if the sprite is currently facing north
     *** and this function indicates that the sprite should move northwest, it will face north
@@ -486,6 +491,9 @@ protected:
 
     //! \brief Draws debug information, used for pathfinding mostly.
     void _DrawDebugInfo();
+
+    //! \brief Fast-forwards the current and custom animations.
+    virtual void _FastForward(uint32 elapsed_time);
 }; // class MapSprite : public VirtualSprite
 
 //! \brief Data used to load an place enemies on battle grounds
@@ -573,6 +581,9 @@ public:
     //! \brief Returns a reference to a random party of enemies
     const std::vector<BattleEnemyInfo>& RetrieveRandomParty();
 
+    //! \brief Prepares the battle resources of all the enemies the sprite may lead to
+    void PrepareBattleResources() const;
+
     //! \name Class Member Access Functions
     //@{
     float GetAggroRange() const {
@@ -699,6 +710,9 @@ private:
     *** The numbers contained within this member are ID numbers for the enemy.
     **/
     std::vector<std::vector<BattleEnemyInfo> > _enemy_parties;
+
+    //! \brief Fast-forwards the spawning and direction change timers.
+    void _FastForward(uint32 elapsed_time);
 }; // class EnemySprite : public MapSprite
 
 } // namespace private_map
@@ -17,10 +17,14 @@
 
 #include "modes/map/map_tiles.h"
 
+#include "modes/map/map_chunks.h"
 #include "modes/map/map_mode.h"
 
 #include "engine/video/video.h"
 
+#include <algorithm>
+#include <cstdlib>
+
 using namespace vt_utils;
 using namespace vt_script;
 using namespace vt_video;
@@ -33,7 +37,10 @@ namespace private_map
 
 TileSupervisor::TileSupervisor() :
     _num_tile_on_x_axis(0),
-    _num_tile_on_y_axis(0)
+    _num_tile_on_y_axis(0),
+    _chunk_file(NULL),
+    _chunks_update_count(0),
+    _has_previous_screen_edges(false)
 {}
 
 TileSupervisor::~TileSupervisor()
@@ -46,6 +53,9 @@ TileSupervisor::~TileSupervisor()
     _tile_grid.clear();
     _tile_images.clear();
     _animated_tile_images.clear();
+
+    _loaded_chunks.clear();
+    delete _chunk_file;
 }
 
 static LAYER_TYPE getLayerType(const std::string &type)
@@ -64,47 +74,9 @@ bool TileSupervisor::Load(ReadScriptDescriptor &map_file)
     _num_tile_on_y_axis = map_file.ReadInt("num_tile_rows");
     _num_tile_on_x_axis = map_file.ReadInt("num_tile_cols");
 
-    // Load all of the tileset images that are used by this map
-
     // Contains all of the tileset filenames used (string does not contain path information or file extensions)
-    std::vector<std::string> tileset_filenames;
-    // Temporarily retains all tile images loaded for each tileset. Each inner vector contains 256 StillImage objects
-    std::vector<std::vector<StillImage> > tileset_images;
-
-    map_file.ReadStringVector("tileset_filenames", tileset_filenames);
-
-    for(uint32 i = 0; i < tileset_filenames.size(); i++) {
-        std::string tileset_file = tileset_filenames[i];
-
-        ReadScriptDescriptor tileset_script;
-        if (!tileset_script.OpenFile(tileset_file)) {
-            PRINT_ERROR << "Couldn't open the tileset definition file: " << tileset_file << std::endl;
-            return false;
-        }
-
-        if (!tileset_script.OpenTable("tileset")) {
-            PRINT_ERROR << "Couldn't open the 'tileset' table from file: " << tileset_file << std::endl;
-            tileset_script.CloseFile();
-            return false;
-        }
-
-        std::string image_filename = tileset_script.ReadString("image");
-        tileset_script.CloseFile();
-
-        tileset_images.push_back(std::vector<StillImage>(TILES_PER_TILESET));
-
-        // Each tileset image is 512x512 pixels, yielding 16 * 16 (== 256) 32x32 pixel tiles each
-        if(!ImageDescriptor::LoadMultiImageFromElementGrid(tileset_images[i], image_filename, 16, 16)) {
-            PRINT_ERROR << "failed to load tileset image: " << image_filename << std::endl;
-            return false;
-        }
-
-        // The map mode coordinate system used corresponds to a tile size of (2.0, 2.0)
-        for(uint32 j = 0; j < TILES_PER_TILESET; j++) {
-            tileset_images[i][j].SetDimensions(2.0f, 2.0f);
-            tileset_images[i][j].Smooth(VideoManager->ShouldSmoothPixelArt());
-        }
-    }
+    _tileset_filenames.clear();
+    map_file.ReadStringVector("tileset_filenames", _tileset_filenames);
 
     if(!map_file.DoesTableExist("layers")) {
         PRINT_ERROR << "No 'layers' table in the map file." << std::endl;
@@ -187,7 +159,7 @@ bool TileSupervisor::Load(ReadScriptDescriptor &map_file)
     // Used to determine whether each tile is used by the map or not. An entry of -1 indicates that particular tile is not used
     std::vector<int16> tile_references;
     // Set size to be equal to the total number of tiles and initialize all entries to -1 (unreferenced)
-    tile_references.assign(tileset_filenames.size() * TILES_PER_TILESET, -1);
+    tile_references.assign(_tileset_filenames.size() * TILES_PER_TILESET, -1);
 
     // For each layer
     for(uint32 layer_id = 0; layer_id < layers_number; ++layer_id) {
@@ -209,10 +181,12 @@ bool TileSupervisor::Load(ReadScriptDescriptor &map_file)
     // Keeps track of the next translated index number to assign
     uint32 next_index = 0;
 
+    _referenced_tiles.clear();
     for(uint32 i = 0; i < tile_references.size(); ++i) {
         if(tile_references[i] >= 0) {
             tile_references[i] = next_index;
             next_index++;
+            _referenced_tiles.push_back(i);
         }
     }
 
@@ -228,6 +202,105 @@ bool TileSupervisor::Load(ReadScriptDescriptor &map_file)
         }
     }
 
+    return _LoadTileImages(tile_references);
+} // bool TileSupervisor::Load(ReadScriptDescriptor& map_file)
+
+bool TileSupervisor::Load(MapChunkFile *chunk_file)
+{
+    delete _chunk_file;
+    _chunk_file = chunk_file;
+    _loaded_chunks.clear();
+    _has_previous_screen_edges = false;
+
+    _num_tile_on_x_axis = chunk_file->GetNumTileXAxis();
+    _num_tile_on_y_axis = chunk_file->GetNumTileYAxis();
+    _tileset_filenames = chunk_file->GetTilesetFilenames();
+    _referenced_tiles = chunk_file->GetReferencedTiles();
+
+    // The tiles themselves are read chunk by chunk when needed.
+    const std::vector<LAYER_TYPE> &layer_types = chunk_file->GetLayerTypes();
+    _tile_grid.clear();
+    _tile_grid.resize(layer_types.size());
+    for(uint32 layer_id = 0; layer_id < layer_types.size(); ++layer_id)
+        _tile_grid[layer_id].layer_type = layer_types[layer_id];
+
+    std::vector<int16> tile_references(_tileset_filenames.size() * TILES_PER_TILESET, -1);
+    for(uint32 i = 0; i < _referenced_tiles.size(); ++i) {
+        if(_referenced_tiles[i] < tile_references.size())
+            tile_references[_referenced_tiles[i]] = i;
+    }
+
+    if(!_LoadTileImages(tile_references)) {
+        // Nothing can be streamed without the tilesets: free the file right away.
+        delete _chunk_file;
+        _chunk_file = NULL;
+        return false;
+    }
+    return true;
+}
+
+bool TileSupervisor::WriteChunkFile(const std::string &filename, uint32 data_hash,
+                                    const std::vector<std::vector<uint32> > &collision_grid) const
+{
+    // Streamed tiles are already packed.
+    if(_chunk_file)
+        return false;
+
+    return MapChunkFile::Write(filename, data_hash, _tileset_filenames, _referenced_tiles,
+                               _num_tile_on_x_axis, _num_tile_on_y_axis, _tile_grid, collision_grid);
+}
+
+void TileSupervisor::StreamFromChunkFile(MapChunkFile *chunk_file)
+{
+    delete _chunk_file;
+    _chunk_file = chunk_file;
+    _loaded_chunks.clear();
+    _has_previous_screen_edges = false;
+
+    for(uint32 layer_id = 0; layer_id < _tile_grid.size(); ++layer_id)
+        std::vector<std::vector<int16> >().swap(_tile_grid[layer_id].tiles);
+}
+
+bool TileSupervisor::_LoadTileImages(const std::vector<int16> &tile_references)
+{
+    // Load all of the tileset images that are used by this map
+
+    // Temporarily retains all tile images loaded for each tileset. Each inner vector contains 256 StillImage objects
+    std::vector<std::vector<StillImage> > tileset_images;
+
+    for(uint32 i = 0; i < _tileset_filenames.size(); i++) {
+        std::string tileset_file = _tileset_filenames[i];
+
+        ReadScriptDescriptor tileset_script;
+        if (!tileset_script.OpenFile(tileset_file)) {
+            PRINT_ERROR << "Couldn't open the tileset definition file: " << tileset_file << std::endl;
+            return false;
+        }
+
+        if (!tileset_script.OpenTable("tileset")) {
+            PRINT_ERROR << "Couldn't open the 'tileset' table from file: " << tileset_file << std::endl;
+            tileset_script.CloseFile();
+            return false;
+        }
+
+        std::string image_filename = tileset_script.ReadString("image");
+        tileset_script.CloseFile();
+
+        tileset_images.push_back(std::vector<StillImage>(TILES_PER_TILESET));
+
+        // Each tileset image is 512x512 pixels, yielding 16 * 16 (== 256) 32x32 pixel tiles each
+        if(!ImageDescriptor::LoadMultiImageFromElementGrid(tileset_images[i], image_filename, 16, 16)) {
+            PRINT_ERROR << "failed to load tileset image: " << image_filename << std::endl;
+            return false;
+        }
+
+        // The map mode coordinate system used corresponds to a tile size of (2.0, 2.0)
+        for(uint32 j = 0; j < TILES_PER_TILESET; j++) {
+            tileset_images[i][j].SetDimensions(2.0f, 2.0f);
+            tileset_images[i][j].Smooth(VideoManager->ShouldSmoothPixelArt());
+        }
+    }
+
     // Parse all of the tileset definition files and create any animated tile images that will be used
 
     // Used to access the tileset definition file
@@ -237,16 +310,16 @@ bool TileSupervisor::Load(ReadScriptDescriptor &map_file)
     // Temporarily holds all animated tile images. The map key is the value of the tile index, before reference translation is done in the next step
     std::map<uint32, AnimatedImage *> tile_animations;
 
-    for(uint32 i = 0; i < tileset_filenames.size(); i++) {
-        if (!tileset_script.OpenFile(tileset_filenames[i])) {
+    for(uint32 i = 0; i < _tileset_filenames.size(); i++) {
+        if (!tileset_script.OpenFile(_tileset_filenames[i])) {
             PRINT_ERROR << "map failed to load because it could not open a tileset definition file: "
-                << tileset_filenames[i] << std::endl;
+                << _tileset_filenames[i] << std::endl;
             return false;
         }
 
         if (!tileset_script.OpenTable("tileset")) {
             PRINT_ERROR << "map failed to load because it could not open the 'tileset' table from file: "
-                << tileset_filenames[i] << std::endl;
+                << _tileset_filenames[i] << std::endl;
             tileset_script.CloseFile();
             return false;
         }
@@ -280,7 +353,7 @@ bool TileSupervisor::Load(ReadScriptDescriptor &map_file)
 
         tileset_script.CloseTable();
         tileset_script.CloseFile();
-    } // for (uint32 i = 0; i < tileset_filenames.size(); i++)
+    } // for (uint32 i = 0; i < _tileset_filenames.size(); i++)
 
     // Add all referenced tiles to the _tile_images vector, in the proper order
 
@@ -312,7 +385,7 @@ bool TileSupervisor::Load(ReadScriptDescriptor &map_file)
     tileset_images.clear();
 
     return true;
-} // bool TileSupervisor::Load(ReadScriptDescriptor& map_file)
+} // bool TileSupervisor::_LoadTileImages(const std::vector<int16>& tile_references)
 
 
 
@@ -323,6 +396,87 @@ void TileSupervisor::Update()
     }
 }
 
+void TileSupervisor::UpdateChunks(const MapFrame &frame)
+{
+    if(!_chunk_file)
+        return;
+
+    ++_chunks_update_count;
+
+    // The tiles drawn with this frame
+    int32 x_start = frame.tile_x_start;
+    int32 y_start = frame.tile_y_start;
+    int32 x_end = x_start + frame.num_draw_x_axis;
+    int32 y_end = y_start + frame.num_draw_y_axis;
+    _LoadChunks(x_start, y_start, x_end, y_end);
+
+    // The tiles the camera is heading to. The screen edges are in collision grid units,
+    // which are half a tile, and the camera jumps are ignored as they can't be predicted.
+    if(_has_previous_screen_edges) {
+        float delta_x = (frame.screen_edges.left - _previous_screen_edges.left) * TILE_CHUNK_PREFETCH_UPDATES / 2.0f;
+        float delta_y = (frame.screen_edges.top - _previous_screen_edges.top) * TILE_CHUNK_PREFETCH_UPDATES / 2.0f;
+        int32 offset_x = static_cast<int32>(delta_x);
+        int32 offset_y = static_cast<int32>(delta_y);
+
+        if((offset_x != 0 || offset_y != 0)
+                && std::abs(offset_x) <= TILE_CHUNK_SIZE * 2 && std::abs(offset_y) <= TILE_CHUNK_SIZE * 2)
+            _LoadChunks(x_start + offset_x, y_start + offset_y, x_end + offset_x, y_end + offset_y);
+    }
+    _previous_screen_edges = frame.screen_edges;
+    _has_previous_screen_edges = true;
+
+    // Free the chunks needed the longest time ago, but never the ones needed right now.
+    while(_loaded_chunks.size() > MAX_LOADED_TILE_CHUNKS) {
+        std::map<uint32, TileChunk>::iterator oldest = _loaded_chunks.begin();
+        for(std::map<uint32, TileChunk>::iterator it = _loaded_chunks.begin(); it != _loaded_chunks.end(); ++it) {
+            if(it->second.last_needed < oldest->second.last_needed)
+                oldest = it;
+        }
+
+        if(oldest->second.last_needed == _chunks_update_count)
+            break;
+        _loaded_chunks.erase(oldest);
+    }
+}
+
+void TileSupervisor::_LoadChunks(int32 tile_x_start, int32 tile_y_start, int32 tile_x_end, int32 tile_y_end)
+{
+    tile_x_start = std::max(0, tile_x_start);
+    tile_y_start = std::max(0, tile_y_start);
+    tile_x_end = std::min(static_cast<int32>(_num_tile_on_x_axis), tile_x_end);
+    tile_y_end = std::min(static_cast<int32>(_num_tile_on_y_axis), tile_y_end);
+    if(tile_x_start >= tile_x_end || tile_y_start >= tile_y_end)
+        return;
+
+    for(int32 chunk_y = tile_y_start / TILE_CHUNK_SIZE; chunk_y <= (tile_y_end - 1) / TILE_CHUNK_SIZE; ++chunk_y) {
+        for(int32 chunk_x = tile_x_start / TILE_CHUNK_SIZE; chunk_x <= (tile_x_end - 1) / TILE_CHUNK_SIZE; ++chunk_x)
+            _GetChunk(chunk_x, chunk_y).last_needed = _chunks_update_count;
+    }
+}
+
+TileSupervisor::TileChunk &TileSupervisor::_GetChunk(uint16 chunk_x, uint16 chunk_y)
+{
+    uint32 chunk_index = chunk_y * _chunk_file->GetNumChunkXAxis() + chunk_x;
+    std::map<uint32, TileChunk>::iterator it = _loaded_chunks.find(chunk_index);
+    if(it != _loaded_chunks.end())
+        return it->second;
+
+    TileChunk &chunk = _loaded_chunks[chunk_index];
+    chunk.last_needed = _chunks_update_count;
+
+    // A chunk that can't be read is left empty rather than stopping the game.
+    const uint32 chunk_tiles = _tile_grid.size() * TILE_CHUNK_SIZE * TILE_CHUNK_SIZE;
+    if(!_chunk_file->ReadChunk(chunk_x, chunk_y, chunk.tiles) || chunk.tiles.size() != chunk_tiles)
+        chunk.tiles.assign(chunk_tiles, -1);
+
+    // Never trust the tile indeces read from the disk.
+    for(uint32 i = 0; i < chunk.tiles.size(); ++i) {
+        if(chunk.tiles[i] >= static_cast<int32>(_tile_images.size()))
+            chunk.tiles[i] = -1;
+    }
+    return chunk;
+}
+
 
 void TileSupervisor::DrawLayers(const MapFrame *frame, const LAYER_TYPE &layer_type)
 {
@@ -347,10 +501,26 @@ void TileSupervisor::DrawLayers(const MapFrame *frame, const LAYER_TYPE &layer_t
         VideoManager->Move(frame->tile_x_offset - 1.0f, frame->tile_y_offset - 2.0f);
 
         for(uint32 y = static_cast<uint32>(frame->tile_y_start); y < y_end; ++y) {
+            // The streamed tiles of the current row, in the current chunk
+            const int16 *chunk_row = NULL;
+            uint32 chunk_x = 0;
+
             for(uint32 x = static_cast<uint32>(frame->tile_x_start); x < x_end; ++x) {
+                int16 tile;
+                if(_chunk_file) {
+                    if(!chunk_row || x / TILE_CHUNK_SIZE != chunk_x) {
+                        chunk_x = x / TILE_CHUNK_SIZE;
+                        const TileChunk &chunk = _GetChunk(chunk_x, y / TILE_CHUNK_SIZE);
+                        chunk_row = &chunk.tiles[(layer_id * TILE_CHUNK_SIZE + y % TILE_CHUNK_SIZE) * TILE_CHUNK_SIZE];
+                    }
+                    tile = chunk_row[x % TILE_CHUNK_SIZE];
+                } else {
+                    tile = layer.tiles[y][x];
+                }
+
                 // Draw a tile image if it exists at this location
-                if(layer.tiles[y][x] >= 0)
-                    _tile_images[ layer.tiles[y][x] ]->Draw();
+                if(tile >= 0)
+                    _tile_images[tile]->Draw();
 
                 VideoManager->MoveRelative(2.0f, 0.0f);
             } // x
@@ -25,6 +25,8 @@
 
 #include "engine/script/script_read.h"
 
+#include <map>
+
 namespace vt_video {
 class ImageDescriptor;
 class AnimatedImage;
@@ -38,6 +40,14 @@ class MapMode;
 namespace private_map
 {
 
+class MapChunkFile;
+
+//! \brief The maximum number of tile chunks kept in memory when the tiles are streamed.
+const uint32 MAX_LOADED_TILE_CHUNKS = 64;
+
+//! \brief How many updates ahead the camera movement is followed to load the tile chunks in advance.
+const uint32 TILE_CHUNK_PREFETCH_UPDATES = 30;
+
 //! \brief Layer types: Drawn before, along, or after the map objects according to their types.
 enum LAYER_TYPE {
     GROUND_LAYER = 0,
@@ -66,6 +76,10 @@ public:
 ***
 *** Maps have a minimum size of 24 rows and 32 columns of tiles. Theoretically
 *** there is no upper limit on size.
+***
+*** When the map data comes from a packed map data file, the tiles are streamed:
+*** only the chunks around the camera are kept in memory, and the chunks the
+*** camera is heading to are loaded in advance.
 *** ***************************************************************************/
 class TileSupervisor
 {
@@ -82,9 +96,34 @@ public:
     **/
     bool Load(vt_script::ReadScriptDescriptor &map_file);
 
+    /** \brief Loads the tilesets from a packed map data file, and streams the tiles from it.
+    *** \param chunk_file The opened packed file. The tile supervisor takes ownership of it,
+    *** and frees it when the load fails.
+    **/
+    bool Load(MapChunkFile *chunk_file);
+
+    /** \brief Writes the map tiles, loaded from the map data file, to a packed map data file.
+    *** \param filename The packed file to write.
+    *** \param data_hash The hash of the map data file.
+    *** \param collision_grid The map collision grid, written along.
+    **/
+    bool WriteChunkFile(const std::string &filename, uint32 data_hash,
+                        const std::vector<std::vector<uint32> > &collision_grid) const;
+
+    /** \brief Frees the fully loaded tiles, and streams them from the given packed file from now on.
+    *** \param chunk_file The packed file just written from the same tiles. The tile supervisor takes ownership of it.
+    **/
+    void StreamFromChunkFile(MapChunkFile *chunk_file);
+
     //! \brief Updates all animated tile images
     void Update();
 
+    /** \brief Loads the tile chunks around the screen and where the camera is heading to,
+    *** and frees the chunks far from there. Does nothing when the tiles aren't streamed.
+    *** \param frame The map frame of the current update.
+    **/
+    void UpdateChunks(const MapFrame &frame);
+
     /** \brief Draws the various tile layers to the screen
     *** \param frame A pointer to the computed information required to draw this frame
     ***
@@ -110,9 +149,34 @@ private:
     **/
     uint16 _num_tile_on_y_axis;
 
-    //! \brief The map tile layers
+    //! \brief The map tile layers. Their tiles are left empty when streamed.
     std::vector<Layer> _tile_grid;
 
+    //! \brief The tileset definition files used by the map.
+    std::vector<std::string> _tileset_filenames;
+
+    //! \brief The tileset tile indeces used by the map, in the order of the _tile_images vector.
+    std::vector<uint32> _referenced_tiles;
+
+    //! \brief The tiles of every layer in a chunk, and the last update it was needed at.
+    struct TileChunk {
+        std::vector<int16> tiles;
+        uint32 last_needed;
+    };
+
+    //! \brief The packed file the tiles are streamed from, or NULL when they are all in memory.
+    MapChunkFile *_chunk_file;
+
+    //! \brief The chunks currently in memory, with their index as key.
+    std::map<uint32, TileChunk> _loaded_chunks;
+
+    //! \brief Incremented at each chunks update.
+    uint32 _chunks_update_count;
+
+    //! \brief The screen edges at the previous chunks update, used to know where the camera is heading.
+    MapRectangle _previous_screen_edges;
+    bool _has_previous_screen_edges;
+
     //! \brief Contains the image objects for all map tiles, both still and animated.
     std::vector<vt_video::ImageDescriptor *> _tile_images;
 
@@ -121,6 +185,17 @@ private:
     *** _tile_images vector, which contains both still and animated images.
     **/
     std::vector<vt_video::AnimatedImage *> _animated_tile_images;
+
+    /** \brief Loads the tileset images, and creates the images of the tiles used by the map.
+    *** \param tile_references The _tile_images index of every tileset tile, or -1 for the unused ones.
+    **/
+    bool _LoadTileImages(const std::vector<int16> &tile_references);
+
+    //! \brief Returns the tiles of a chunk, reading it from the packed file when it isn't in memory yet.
+    TileChunk &_GetChunk(uint16 chunk_x, uint16 chunk_y);
+
+    //! \brief Loads the chunks overlapping the given tile area, and marks them as needed for this update.
+    void _LoadChunks(int32 tile_x_start, int32 tile_y_start, int32 tile_x_end, int32 tile_y_end);
 }; // class TileSupervisor
 
 } // namespace private_map
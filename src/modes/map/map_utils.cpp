@@ -17,6 +17,11 @@
 
 #include "map_utils.h"
 
+#include "map_objects.h"
+
+#include <algorithm>
+#include <fstream>
+
 namespace vt_map
 {
 
@@ -36,6 +41,129 @@ bool MapRectangle::CheckIntersection(const MapRectangle &first, const MapRectang
         return true;
 }
 
+void VisibilityGrid::Reset(uint16 num_grid_x_axis, uint16 num_grid_y_axis)
+{
+    uint32 num_cells_x = static_cast<uint32>(std::ceil(num_grid_x_axis / VISIBILITY_GRID_CELL_SIZE));
+    uint32 num_cells_y = static_cast<uint32>(std::ceil(num_grid_y_axis / VISIBILITY_GRID_CELL_SIZE));
+    if(num_cells_x == 0)
+        num_cells_x = 1;
+    if(num_cells_y == 0)
+        num_cells_y = 1;
+
+    // Keep the cells memory when the size didn't change.
+    if(num_cells_x != _num_cells_x || num_cells_y != _num_cells_y) {
+        _num_cells_x = num_cells_x;
+        _num_cells_y = num_cells_y;
+        _cells.clear();
+        _cells.resize(_num_cells_x * _num_cells_y);
+        return;
+    }
+
+    for(uint32 i = 0; i < _cells.size(); ++i)
+        _cells[i].clear();
+}
+
+void VisibilityGrid::Insert(MapObject *object)
+{
+    if(_cells.empty())
+        return;
+
+    VisibilityCellRange &range = object->visibility_cells;
+    range = _GetCellRange(object->GetImageRectangle());
+    for(uint32 y = range.y_start; y <= range.y_end; ++y) {
+        for(uint32 x = range.x_start; x <= range.x_end; ++x)
+            _cells[y * _num_cells_x + x].push_back(object);
+    }
+}
+
+void VisibilityGrid::Remove(MapObject *object)
+{
+    if(_cells.empty())
+        return;
+
+    const VisibilityCellRange &range = object->visibility_cells;
+    for(uint32 y = range.y_start; y <= range.y_end; ++y) {
+        for(uint32 x = range.x_start; x <= range.x_end; ++x) {
+            // The order of the objects in a cell doesn't matter.
+            std::vector<MapObject *> &cell = _cells[y * _num_cells_x + x];
+            std::vector<MapObject *>::iterator it = std::find(cell.begin(), cell.end(), object);
+            if(it != cell.end()) {
+                *it = cell.back();
+                cell.pop_back();
+            }
+        }
+    }
+}
+
+void VisibilityGrid::Update(MapObject *object)
+{
+    if(_cells.empty())
+        return;
+
+    if(_GetCellRange(object->GetImageRectangle()) == object->visibility_cells)
+        return;
+
+    Remove(object);
+    Insert(object);
+}
+
+void VisibilityGrid::Query(const MapRectangle &rect, std::vector<MapObject *> &objects) const
+{
+    if(_cells.empty())
+        return;
+
+    VisibilityCellRange range = _GetCellRange(rect);
+    for(uint32 y = range.y_start; y <= range.y_end; ++y) {
+        for(uint32 x = range.x_start; x <= range.x_end; ++x) {
+            const std::vector<MapObject *> &cell = _cells[y * _num_cells_x + x];
+            for(uint32 i = 0; i < cell.size(); ++i) {
+                // An object overlapping several queried cells is only kept in the first one.
+                const VisibilityCellRange &cells = cell[i]->visibility_cells;
+                if(x == std::max(cells.x_start, range.x_start) && y == std::max(cells.y_start, range.y_start))
+                    objects.push_back(cell[i]);
+            }
+        }
+    }
+}
+
+VisibilityCellRange VisibilityGrid::_GetCellRange(const MapRectangle &rect) const
+{
+    float left = std::floor(rect.left / VISIBILITY_GRID_CELL_SIZE);
+    float right = std::floor(rect.right / VISIBILITY_GRID_CELL_SIZE);
+    float top = std::floor(rect.top / VISIBILITY_GRID_CELL_SIZE);
+    float bottom = std::floor(rect.bottom / VISIBILITY_GRID_CELL_SIZE);
+
+    float max_x = static_cast<float>(_num_cells_x - 1);
+    float max_y = static_cast<float>(_num_cells_y - 1);
+
+    VisibilityCellRange range;
+    range.x_start = static_cast<uint32>(std::max(0.0f, std::min(left, max_x)));
+    range.x_end = static_cast<uint32>(std::max(0.0f, std::min(right, max_x)));
+    range.y_start = static_cast<uint32>(std::max(0.0f, std::min(top, max_y)));
+    range.y_end = static_cast<uint32>(std::max(0.0f, std::min(bottom, max_y)));
+    return range;
+}
+
+uint32 HashData(uint32 hash, const uint8 *data, size_t size)
+{
+    for(size_t i = 0; i < size; ++i) {
+        hash ^= data[i];
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+uint32 HashFile(uint32 hash, const std::string &filename)
+{
+    std::ifstream file(filename.c_str(), std::ios::in | std::ios::binary);
+    char buffer[4096];
+    while(file) {
+        file.read(buffer, sizeof(buffer));
+        hash = HashData(hash, reinterpret_cast<const uint8 *>(buffer), file.gcount());
+    }
+    return hash;
+}
+
 } // namespace private_map
 
 } // namespace vt_map
@@ -120,6 +120,19 @@ const float FAST_SPEED       = 110.0f;
 const float VERY_FAST_SPEED  = 75.0f;
 //@}
 
+/** \brief The maximum distance, in map grid units, an object can travel during one update step and still be drawn interpolated.
+*** Bigger moves are considered as teleports and are drawn directly at the new position.
+**/
+const float MAX_INTERPOLATED_DISTANCE = 2.0f;
+
+/** \brief The default distance beyond the screen edges within which map objects are updated, in map grid units.
+*** Objects further away are put to sleep. \see ObjectSupervisor::SetActivityRegionMargin()
+**/
+const float DEFAULT_ACTIVITY_REGION_MARGIN = 16.0f;
+
+//! \brief The size of the visibility grid cells used to find the objects on screen, in map grid units.
+const float VISIBILITY_GRID_CELL_SIZE = 8.0f;
+
 /** \name Sprite Direction Constants
 *** \brief Constants used for determining sprite directions
 *** Sprites are allowed to travel in eight different directions, however the sprite itself
@@ -260,6 +273,84 @@ public:
 }; // class MapRectangle
 
 
+class MapObject;
+
+//! \brief The range of visibility grid cells covered by an object, bounds included.
+struct VisibilityCellRange {
+    VisibilityCellRange() :
+        x_start(0),
+        x_end(0),
+        y_start(0),
+        y_end(0)
+    {}
+
+    bool operator==(const VisibilityCellRange &other) const {
+        return x_start == other.x_start && x_end == other.x_end
+               && y_start == other.y_start && y_end == other.y_end;
+    }
+
+    uint32 x_start, x_end, y_start, y_end;
+};
+
+/** ****************************************************************************
+*** \brief A uniform grid indexing map objects by their image rectangles.
+***
+*** The grid covers the whole map, split into cells of VISIBILITY_GRID_CELL_SIZE
+*** map grid units. Each cell stores the objects whose image rectangle overlaps
+*** it, so that the objects lying in a given area, typically the screen, can be
+*** found without testing every object of a layer.
+***
+*** The grid is built once, and the objects are only moved to other cells when
+*** their image rectangle covers other cells than before. Each object keeps the
+*** range of cells it is indexed in, so it must be indexed in one grid only.
+***
+*** \note Rectangles partly or fully out of the map are clamped to the border cells.
+*** The query only returns candidates: their rectangles must still be checked
+*** against the queried area.
+*** ***************************************************************************/
+class VisibilityGrid
+{
+public:
+    VisibilityGrid() :
+        _num_cells_x(0),
+        _num_cells_y(0)
+    {}
+
+    /** \brief Empties the grid and fits it to the given map size.
+    *** \param num_grid_x_axis The map width, in map grid units.
+    *** \param num_grid_y_axis The map height, in map grid units.
+    **/
+    void Reset(uint16 num_grid_x_axis, uint16 num_grid_y_axis);
+
+    //! \brief Registers an object in every cell its image rectangle overlaps.
+    void Insert(MapObject *object);
+
+    //! \brief Unregisters an object from the cells it was indexed in.
+    void Remove(MapObject *object);
+
+    /** \brief Moves an object to the cells its image rectangle now overlaps.
+    *** Nothing is done when the object still covers the same cells.
+    **/
+    void Update(MapObject *object);
+
+    /** \brief Appends the objects whose rectangle may intersect the given area.
+    *** \param rect The area to look into, such as the screen edges.
+    *** \param objects The list the candidate objects are appended to, each only once, in no particular order.
+    **/
+    void Query(const MapRectangle &rect, std::vector<MapObject *> &objects) const;
+
+private:
+    //! \brief The number of cells on the x and y axes.
+    uint32 _num_cells_x, _num_cells_y;
+
+    //! \brief The objects stored per cell, row by row: _cells[y * _num_cells_x + x]
+    std::vector<std::vector<MapObject *> > _cells;
+
+    //! \brief Computes the range of cells covered by the given rectangle, clamped to the grid.
+    VisibilityCellRange _GetCellRange(const MapRectangle &rect) const;
+}; // class VisibilityGrid
+
+
 /** ****************************************************************************
 *** \brief Retains information about how the next map frame should be drawn.
 ***
@@ -291,6 +382,11 @@ public:
     *** cursor positions, but rather are map grid coordinates indicating where the screen edges lie.
     **/
     MapRectangle screen_edges;
+
+    /** \brief The X and Y length values that correspond to a single pixel in the map coordinate system.
+    *** They are computed once per frame and used to align the map objects on pixel boundaries.
+    **/
+    float x_pixel_length, y_pixel_length;
 }; // class MapFrame
 
 
@@ -373,6 +469,19 @@ typedef MapVector MapPosition;
 
 typedef std::vector<MapPosition> Path;
 
+//! \brief The initial value of the hashes computed by HashData() and HashFile().
+const uint32 HASH_SEED = 2166136261u;
+
+/** \brief Mixes the given data into a FNV-1a hash.
+*** Used to tell whether the map files changed since some data was cached on disk.
+*** \param hash The hash to update, HASH_SEED at first.
+*** \return The updated hash.
+**/
+uint32 HashData(uint32 hash, const uint8 *data, size_t size);
+
+//! \brief Mixes the whole content of a file into a FNV-1a hash. A missing file leaves the hash untouched.
+uint32 HashFile(uint32 hash, const std::string &filename);
+
 } // namespace private_map
 
 } // namespace vt_map
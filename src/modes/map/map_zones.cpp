@@ -19,6 +19,8 @@
 
 #include "modes/map/map_sprites.h"
 
+#include "modes/battle/battle_resources.h"
+
 using namespace vt_utils;
 
 namespace vt_map
@@ -165,6 +167,7 @@ EnemyZone::EnemyZone() :
     _roaming_restrained(true),
     _agression_roaming_restrained(false),
     _active_enemies(0),
+    _enemies_prepared(0),
     _spawns_left(-1), // Inifite spawns permitted.
     _spawn_timer(STANDARD_ENEMY_FIRST_SPAWN_TIME),
     _dead_timer(STANDARD_ENEMY_DEAD_TIME),
@@ -182,6 +185,7 @@ EnemyZone::EnemyZone(uint16 left_col, uint16 right_col,
     _roaming_restrained(true),
     _agression_roaming_restrained(false),
     _active_enemies(0),
+    _enemies_prepared(0),
     _spawns_left(-1), // Inifite spawns permitted.
     _spawn_timer(STANDARD_ENEMY_FIRST_SPAWN_TIME),
     _dead_timer(STANDARD_ENEMY_DEAD_TIME),
@@ -198,6 +202,7 @@ EnemyZone::EnemyZone(const EnemyZone &copy) :
     _agression_roaming_restrained = copy._agression_roaming_restrained;
     _spawns_left = copy._spawns_left;
     _active_enemies = copy._active_enemies;
+    _enemies_prepared = 0;
     _spawn_timer = copy._spawn_timer;
     _dead_timer = copy._dead_timer;
     if(copy._spawn_zone == NULL)
@@ -220,6 +225,7 @@ EnemyZone &EnemyZone::operator=(const EnemyZone &copy)
     _agression_roaming_restrained = copy._agression_roaming_restrained;
     _spawns_left = copy._spawns_left;
     _active_enemies = copy._active_enemies;
+    _enemies_prepared = 0;
     _spawn_timer = copy._spawn_timer;
     _dead_timer = copy._dead_timer;
     if(copy._spawn_zone == NULL)
@@ -322,6 +328,14 @@ void EnemyZone::Update()
     if (_enemies.empty())
         return;
 
+    // Prepare the battles of the zone ahead, one enemy per update,
+    // so that the encounters don't have to load their resources.
+    if (_enemies_prepared < _enemies.size()) {
+        if (_enemies_prepared == 0)
+            vt_battle::BattleResources->PrepareCharacters();
+        _enemies[_enemies_prepared++]->PrepareBattleResources();
+    }
+
     // Update timers
     _spawn_timer.Update();
     _dead_timer.Update();
@@ -333,6 +333,9 @@ private:
     //! \brief The number of enemies that are currently not in the DEAD state
     uint8 _active_enemies;
 
+    //! \brief The number of enemies whose battle resources were prepared
+    uint32 _enemies_prepared;
+
     //! \brief The number of times an enemy can (re)spawn in this enemy zone.
     //! By default, this value is equal to -1 meaning an infinite amount of time.
     //! This permits to set special spawn points where enemies can only be seen once,
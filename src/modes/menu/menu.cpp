@@ -22,6 +22,7 @@
 
 #include "engine/system.h"
 #include "engine/input.h"
+#include "engine/profiler.h"
 #include "engine/audio/audio.h"
 #include "modes/pause.h"
 
@@ -940,6 +941,7 @@ void MenuMode::Update()
         return;
     }
 
+    PROFILE_SCOPE("MenuMode state update");
     _current_menu_state->Update();
 
 } // void MenuMode::Update()
@@ -1128,6 +1130,7 @@ void MenuMode::UpdateEquipmentInfo(GlobalCharacter *character, GlobalObject *obj
 
 void MenuMode::Draw()
 {
+    PROFILE_SCOPE("MenuMode::Draw");
     _current_menu_state->Draw();
 
     if(_message_window)
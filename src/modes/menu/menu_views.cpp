@@ -131,8 +131,11 @@ InventoryWindow::InventoryWindow() :
     _object_type(vt_global::GLOBAL_OBJECT_INVALID),
     _character(NULL),
     _is_equipment(false),
-    _can_equip(false)
+    _can_equip(false),
+    _item_list_outdated(true)
 {
+    GlobalManager->AddInventoryListener(this);
+
     _InitCategory();
     _UpdateItemText();
     _InitInventoryItems();
@@ -149,6 +152,11 @@ InventoryWindow::InventoryWindow() :
 
 } // void InventoryWindow::InventoryWindow
 
+InventoryWindow::~InventoryWindow()
+{
+    GlobalManager->RemoveInventoryListener(this);
+}
+
 //Initializes the list of items
 void InventoryWindow::_InitInventoryItems()
 {
@@ -250,7 +258,7 @@ void InventoryWindow::Update()
 {
     GlobalMedia& media = GlobalManager->Media();
 
-    if(GlobalManager->GetInventory()->empty()) {
+    if(GlobalManager->IsInventoryEmpty()) {
         // no more items in inventory, exit inventory window
         Activate(false);
         return;
@@ -523,7 +531,7 @@ void InventoryWindow::Update()
 void InventoryWindow::_UpdateSelection()
 {
     // Update the item list
-    _UpdateItemText();
+    _RefreshItemText();
 
     _object = _item_objects[ _inventory_items.GetSelection() ];
     _object_type = _object->GetObjectType();
@@ -586,13 +594,10 @@ void InventoryWindow::_UpdateItemText()
 
     ITEM_CATEGORY current_selected_category = static_cast<ITEM_CATEGORY>(_item_categories.GetSelection());
     switch(current_selected_category) {
-        case ITEM_ALL: {
-            std::map<uint32, GlobalObject *>* inv = GlobalManager->GetInventory();
-            for(std::map<uint32, GlobalObject *>::iterator it = inv->begin(); it != inv->end(); ++it) {
-                _item_objects.push_back(it->second);
-            }
+        case ITEM_ALL:
+            GlobalManager->GetInventoryObjects(_item_objects);
             break;
-        }
+
         case ITEM_ITEM:
             _item_objects = _GetItemVector(GlobalManager->GetInventoryItems());
             break;
@@ -618,10 +623,11 @@ void InventoryWindow::_UpdateItemText()
             break;
 
         case ITEM_KEY: {
-            std::map<uint32, GlobalObject *>* inv = GlobalManager->GetInventory();
-            for(std::map<uint32, GlobalObject *>::iterator it = inv->begin(); it != inv->end(); ++it) {
-                if (it->second->IsKeyItem())
-                    _item_objects.push_back(it->second);
+            std::vector<GlobalObject *> inv;
+            GlobalManager->GetInventoryObjects(inv);
+            for(uint32 i = 0; i < inv.size(); ++i) {
+                if (inv[i]->IsKeyItem())
+                    _item_objects.push_back(inv[i]);
             }
             break;
         }
@@ -629,13 +635,10 @@ void InventoryWindow::_UpdateItemText()
             break;
         }
 
-    ustring text;
     std::vector<ustring> inv_names;
 
     for(size_t ctr = 0; ctr < _item_objects.size(); ctr++) {
-        text = MakeUnicodeString("<" + _item_objects[ctr]->GetIconImage().GetFilename() + "><20>     ") +
-               _item_objects[ctr]->GetName() + MakeUnicodeString("<R><350>" + NumberToString(_item_objects[ctr]->GetCount()) + "   ");
-        inv_names.push_back(text);
+        inv_names.push_back(_GetItemText(_item_objects[ctr]));
     }
 
     _inventory_items.SetOptions(inv_names);
@@ -652,8 +655,49 @@ void InventoryWindow::_UpdateItemText()
         //reset the top viewing inventory item
         _inventory_items.ResetViewableOption();
     }
+
+    _changed_objects.clear();
+    _item_list_outdated = false;
 } // void InventoryWindow::UpdateItemText()
 
+void InventoryWindow::_RefreshItemText()
+{
+    ITEM_CATEGORY current_selected_category = static_cast<ITEM_CATEGORY>(_item_categories.GetSelection());
+    if(_item_list_outdated || current_selected_category != _previous_category) {
+        _UpdateItemText();
+        return;
+    }
+
+    for(std::set<uint32>::const_iterator it = _changed_objects.begin(); it != _changed_objects.end(); ++it) {
+        GlobalObject *object = GlobalManager->GetInventoryObject(*it);
+
+        uint32 index = 0;
+        while(index < _item_objects.size() && _item_objects[index]->GetID() != *it)
+            ++index;
+
+        // An object removed from the list, or added to it, changes the other entries.
+        if(index == _item_objects.size() && object == NULL)
+            continue;
+        if(index == _item_objects.size() || _item_objects[index] != object) {
+            _UpdateItemText();
+            return;
+        }
+
+        // Otherwise, only the count of the object changed.
+        _inventory_items.SetOptionText(index, _GetItemText(object));
+        StillImage *image = _inventory_items.GetEmbeddedImage(index);
+        if (image)
+            image->SetWidthKeepRatio(32);
+    }
+    _changed_objects.clear();
+}
+
+ustring InventoryWindow::_GetItemText(GlobalObject *object)
+{
+    return MakeUnicodeString("<" + object->GetIconImage().GetFilename() + "><20>     ") +
+           object->GetName() + MakeUnicodeString("<R><350>" + NumberToString(object->GetCount()) + "   ");
+}
+
 
 
 void InventoryWindow::Draw()
@@ -686,7 +730,7 @@ void InventoryWindow::_DrawSpecialItemDescription(vt_video::StillImage* special_
 void InventoryWindow::_DrawBottomInfo()
 {
     //if we are out of items, the bottom view should do no work
-    if(GlobalManager->GetInventory()->empty() || _item_objects.empty())
+    if(GlobalManager->IsInventoryEmpty() || _item_objects.empty())
         return;
 
     MenuMode* menu = MenuMode::CurrentInstance();
@@ -30,6 +30,8 @@
 #include "common/gui/menu_window.h"
 #include "common/gui/option.h"
 
+#include <set>
+
 namespace vt_menu
 {
 
@@ -155,7 +157,7 @@ public:
 ***
 *** This handles item use.  You can also view all items by category.
 *** ***************************************************************************/
-class InventoryWindow : public vt_gui::MenuWindow
+class InventoryWindow : public vt_gui::MenuWindow, public vt_global::GlobalInventoryListener
 {
     friend class vt_menu::MenuMode;
     friend class InventoryState;
@@ -163,8 +165,7 @@ class InventoryWindow : public vt_gui::MenuWindow
 public:
     InventoryWindow();
 
-    ~InventoryWindow()
-    {}
+    ~InventoryWindow();
 
     /** \brief Toggles the inventory window being in the active context for the player
     *** \param new_status Activates the inventory window when true, de-activates it when false
@@ -192,6 +193,16 @@ public:
     */
     void Draw();
 
+    //! \brief Notes the changed object, so that only its entry is updated.
+    void InventoryChanged(uint32 obj_id) {
+        _changed_objects.insert(obj_id);
+    }
+
+    //! \brief Notes that the item list has to be built again.
+    void InventoryCleared() {
+        _item_list_outdated = true;
+    }
+
 private:
     //! Used for char portraits in bottom menu
     std::vector<vt_video::StillImage> _portraits;
@@ -220,6 +231,12 @@ private:
     //! holds previous category. we were looking at
     ITEM_CATEGORY _previous_category;
 
+    //! The ids of the objects changed in the inventory since the item list was updated
+    std::set<uint32> _changed_objects;
+
+    //! Tells whether the whole item list has to be built again
+    bool _item_list_outdated;
+
     //! The currently selected object
     vt_global::GlobalObject* _object;
 
@@ -240,8 +257,17 @@ private:
     */
     void _UpdateItemText();
 
+    /*!
+    * \brief Updates the entries of the changed objects only, or the whole item list
+    * when the category or the list of objects changed.
+    */
+    void _RefreshItemText();
+
+    //! \brief Returns the item list entry text of an object
+    vt_utils::ustring _GetItemText(vt_global::GlobalObject *object);
+
     //! \brief updates the selected item and character
-    //! \note this also updates calls _UpdateItemText();
+    //! \note this also updates calls _RefreshItemText();
     void _UpdateSelection();
 
     /*!
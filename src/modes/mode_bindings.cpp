@@ -172,6 +172,9 @@ void BindModeCode()
             .def("GetObjectByIndex", &ObjectSupervisor::GetObjectByIndex)
             .def("GetObject", &ObjectSupervisor::GetObject)
             .def("SetPartyMemberVisibleSprite", &ObjectSupervisor::SetPartyMemberVisibleSprite)
+            .def("SetActivityRegionMargin", &ObjectSupervisor::SetActivityRegionMargin)
+            .def("GetActivityRegionMargin", &ObjectSupervisor::GetActivityRegionMargin)
+            .def("SetHierarchicalPathfinding", &ObjectSupervisor::SetHierarchicalPathfinding)
         ];
 
         luabind::module(vt_script::ScriptManager->GetGlobalState(), "vt_map")
@@ -189,6 +192,7 @@ void BindModeCode()
             .def("SetVisible", &MapObject::SetVisible)
             .def("SetCollisionMask", &MapObject::SetCollisionMask)
             .def("SetDrawOnSecondPass", &MapObject::SetDrawOnSecondPass)
+            .def("SetPinned", &MapObject::SetPinned)
             .def("GetObjectID", &MapObject::GetObjectID)
             .def("GetXPosition", &MapObject::GetXPosition)
             .def("GetYPosition", &MapObject::GetYPosition)
@@ -198,6 +202,7 @@ void BindModeCode()
             .def("GetCollHeight", &MapObject::GetCollHeight)
             .def("IsUpdatable", &MapObject::IsUpdatable)
             .def("IsVisible", &MapObject::IsVisible)
+            .def("IsPinned", &MapObject::IsPinned)
             .def("GetCollisionMask", &MapObject::GetCollisionMask)
             .def("IsDrawOnSecondPass", &MapObject::IsDrawOnSecondPass)
             .def("Emote", &MapObject::Emote)
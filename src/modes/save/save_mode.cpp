@@ -41,6 +41,11 @@ namespace vt_save
 
 bool SAVE_DEBUG = false;
 
+//! \brief The width of the screen thumbnails stored along with the saved games, in pixels.
+const uint32 SAVE_THUMBNAIL_WIDTH = 256;
+
+private_save::SaveSlotCache SaveMode::_slot_cache;
+
 //! \name Save Options Constants
 //@{
 const uint8 SAVE_GAME           = 0;
@@ -105,8 +110,11 @@ SaveMode::SaveMode(bool save_mode, uint32 x_position, uint32 y_position) :
     _character_window[3].SetPosition(355.0f, 438.0f);
 
     // Initialize the save options box
+    // The map transitions autosave is listed after the save slots, and can only be loaded.
+    uint32 slot_count = _save_mode ? AUTOSAVE_SLOT_ID : AUTOSAVE_SLOT_ID + 1;
     _file_list.SetPosition(315.0f, 384.0f);
-    _file_list.SetDimensions(150.0f, 500.0f, 1, 6, 1, 6);
+    // The rows get smaller when the autosave is listed, so that they still fit in the left window.
+    _file_list.SetDimensions(150.0f, 500.0f, 1, slot_count, 1, slot_count);
     _file_list.SetTextStyle(TextStyle("title22"));
 
     _file_list.SetAlignment(VIDEO_X_CENTER, VIDEO_Y_CENTER);
@@ -120,6 +128,12 @@ SaveMode::SaveMode(bool save_mode, uint32 x_position, uint32 y_position) :
     _file_list.AddOption(UTranslate("Slot 4"));
     _file_list.AddOption(UTranslate("Slot 5"));
     _file_list.AddOption(UTranslate("Slot 6"));
+    if(!_save_mode)
+        _file_list.AddOption(UTranslate("Autosave"));
+
+    // Every entry, the autosave included, must be reachable by the cursor and drawn.
+    if(static_cast<int32>(_file_list.GetNumberOptions()) > _file_list.GetNumberRows())
+        PRINT_ERROR << "The save file list has more entries than rows: " << _file_list.GetNumberOptions() << std::endl;
 
     // Restore the cursor position to the last load/save position.
     uint32 slot_id = GlobalManager->GetGameSlotId();
@@ -182,6 +196,8 @@ SaveMode::SaveMode(bool save_mode, uint32 x_position, uint32 y_position) :
     _drunes_textbox.SetTextAlignment(VIDEO_X_LEFT, VIDEO_Y_CENTER);
     _drunes_textbox.SetDisplayText(" ");
 
+    _LoadCharacterPreviews();
+
     if(_save_mode) {
         _current_state = SAVE_MODE_SAVING;
     } else {
@@ -241,6 +257,20 @@ void SaveMode::Update()
         return;
     }
 
+    // Keeps the images decoded in the background, and refreshes the preview waiting for them.
+    std::vector<std::string> loaded_images;
+    _image_loader.Update(loaded_images);
+    if(!loaded_images.empty()) {
+        for(uint32 i = 0; i < loaded_images.size(); ++i) {
+            StillImage image;
+            if(image.Load(loaded_images[i]))
+                _preview_images[loaded_images[i]] = image;
+        }
+        if((_current_state == SAVE_MODE_SAVING || _current_state == SAVE_MODE_LOADING)
+                && _file_list.GetSelection() > -1)
+            _PreviewGame(_file_list.GetSelection());
+    }
+
     _file_list.Update();
     _confirm_save_optionbox.Update();
 
@@ -258,11 +288,17 @@ void SaveMode::Update()
                 // note: using int here, because uint8 will NOT work
                 // do not change unless you understand this and can test it properly!
                 uint32 id = (uint32)_file_list.GetSelection();
-                std::ostringstream f;
-                f << GetUserDataPath() + "saved_game_" << id << ".lua";
-                std::string filename = f.str();
+                std::string filename = GetSaveGameFilename(id);
                 // now, attempt to save the game.  If failure, we need to tell the user that!
                 if(GlobalManager->SaveGame(filename, id, _x_position, _y_position)) {
+                    // The screen the save menu was opened from is kept as the save thumbnail.
+                    std::string thumbnail_filename = GetSaveGameThumbnailFilename(id);
+                    _ForgetPreviewImage(thumbnail_filename);
+                    uint32 downscale_factor = static_cast<uint32>(_screen_capture.GetWidth()) / SAVE_THUMBNAIL_WIDTH;
+                    if(!_screen_capture.Save(thumbnail_filename, downscale_factor))
+                        DeleteFile(thumbnail_filename);
+                    _slot_cache.Invalidate(id);
+
                     _current_state = SAVE_MODE_SAVE_COMPLETE;
                     AudioManager->PlaySound("snd/save_successful_nick_bowler_oga.wav");
                 } else {
@@ -411,15 +447,15 @@ void SaveMode::DrawPostEffects()
 
 bool SaveMode::_LoadGame(uint32 id)
 {
-    std::ostringstream f;
-    f << GetUserDataPath() + "saved_game_" << id << ".lua";
-    std::string filename = f.str();
+    std::string filename = FindSaveGameFilename(id);
 
-    if(DoesFileExist(filename)) {
+    if(!filename.empty()) {
         _current_state = SAVE_MODE_FADING_OUT;
         AudioManager->StopAllMusic();
 
-        GlobalManager->LoadGame(filename, id);
+        // The autosave keeps the slot the game was saved to or loaded from before.
+        uint32 slot_id = (id == AUTOSAVE_SLOT_ID) ? GlobalManager->GetGameSlotId() : id;
+        GlobalManager->LoadGame(filename, slot_id);
 
         // Create a new map mode, and fade out and in
         ModeManager->PopAll();
@@ -437,8 +473,8 @@ bool SaveMode::_LoadGame(uint32 id)
         }
         return true;
     } else {
-        PRINT_ERROR << "BOOT: No saved game file exists, can not load game: "
-                    << filename << std::endl;
+        PRINT_ERROR << "BOOT: No saved game file exists, can not load game slot: "
+                    << id << std::endl;
         return false;
     }
 }
@@ -454,117 +490,45 @@ void SaveMode::_ClearSaveData(bool selected_file_exists)
     _drunes_textbox.SetDisplayText(" ");
     _location_image.Clear();
     for (uint32 i = 0; i < 4; ++i)
-        _character_window[i].SetCharacter(NULL);
+        _character_window[i].ClearCharacter();
 }
 
 
 bool SaveMode::_PreviewGame(uint32 id)
 {
-    std::ostringstream f;
-    f << GetUserDataPath() + "saved_game_" << id << ".lua";
-    std::string filename = f.str();
+    // The slot data is only read again when its file changed.
+    const private_save::SaveSlotInfo &info = _slot_cache.GetSlotInfo(id);
 
     // Check for the file existence, prevents a useless warning
-    if(!vt_utils::DoesFileExist(filename)) {
+    if(info.filename.empty()) {
         _ClearSaveData(false);
         return false;
     }
 
-    ReadScriptDescriptor file;
-
-    // Clear out the save data namespace to avoid loading false information
-    // when dealing with a save game that has an invalid namespace
-    ScriptManager->DropGlobalTable("save_game1");
-
-    if(!file.OpenFile(filename)) {
-        _ClearSaveData(true);
-        return false;
-    }
-
-    if(!file.DoesTableExist("save_game1")) {
-        file.CloseFile();
-        _ClearSaveData(true);
-        return false;
-    }
-
-    // open the namespace that the save game is encapsulated in.
-    file.OpenTable("save_game1");
-
-    // The map file, tested after the save game is closed.
-    // DEPRECATED: Old way, will be removed in one release.
-    std::string map_script_filename;
-    std::string map_data_filename;
-    if (file.DoesStringExist("map_filename")) {
-        map_script_filename = file.ReadString("map_filename");
-        map_data_filename = file.ReadString("map_filename");
-    }
-    else {
-        map_script_filename = file.ReadString("map_script_filename");
-        map_data_filename = file.ReadString("map_data_filename");
-    }
-
-    // DEPRECATED: Remove in one release
-    // Hack to permit the split of last map data and scripts.
-    if (!map_script_filename.empty() && map_data_filename == map_script_filename) {
-        std::string map_common_name = map_data_filename.substr(0, map_data_filename.length() - 4);
-        map_data_filename = map_common_name + "_map.lua";
-        map_script_filename = map_common_name + "_script.lua";
-    }
-
-    // Used to store temp data to populate text boxes
-    int32 hours = file.ReadInt("play_hours");
-    int32 minutes = file.ReadInt("play_minutes");
-    int32 seconds = file.ReadInt("play_seconds");
-    int32 drunes = file.ReadInt("drunes");
-
-    if(!file.DoesTableExist("characters")) {
-        file.CloseTable(); // save_game1
-        file.CloseFile();
+    if(!info.valid) {
         _ClearSaveData(true);
         return false;
     }
 
-    file.OpenTable("characters");
-    std::vector<uint32> char_ids;
-    file.ReadUIntVector("order", char_ids);
-    GlobalCharacter *character[4];
+    const SaveGameHeader &header = info.header;
+    uint32 hours = header.play_hours;
+    uint32 minutes = header.play_minutes;
+    uint32 seconds = header.play_seconds;
+    uint32 drunes = header.drunes;
 
     // Loads only up to the first four slots (Visible battle characters)
-    for(uint32 i = 0; i < 4 && i < char_ids.size(); ++i) {
-        // Create a new GlobalCharacter object using the provided id
-        // This loads all of the character's "static" data, such as their name, etc.
-        character[i] = new GlobalCharacter(char_ids[i], false);
-
-        if(!file.DoesTableExist(char_ids[i]))
+    for(uint32 i = 0; i < 4; ++i) {
+        if(i >= header.characters.size()) {
+            _character_window[i].ClearCharacter();
             continue;
+        }
 
-        file.OpenTable(char_ids[i]);
-
-        // Read in all of the character's stats data
-        character[i]->SetExperienceLevel(file.ReadUInt("experience_level"));
-        character[i]->SetExperiencePoints(file.ReadUInt("experience_points"));
-
-        character[i]->SetMaxHitPoints(file.ReadUInt("max_hit_points"));
-        character[i]->SetHitPoints(file.ReadUInt("hit_points"));
-        character[i]->SetMaxSkillPoints(file.ReadUInt("max_skill_points"));
-        character[i]->SetSkillPoints(file.ReadUInt("skill_points"));
-
-        file.CloseTable(); // character id
-    }
-    file.CloseTable(); // characters
-
-    // Report any errors detected from the previous read operations
-    if(file.IsErrorDetected()) {
-        PRINT_WARNING << "One or more errors occurred while reading the save game file - they are listed below:"
-            << std::endl << file.GetErrorMessages() << std::endl;
-            file.ClearErrors();
-    }
-
-    file.CloseTable(); // save_game1
-    file.CloseFile();
-
-    for(uint32 i = 0; i < 4 && i < char_ids.size(); ++i) {
-        _character_window[i].SetCharacter(character[i]);
+        const SaveGameCharacter &character = header.characters[i];
+        CharacterPreview &preview = _character_previews[character.id];
+        // The portrait is shown once loaded.
+        StillImage portrait;
+        _GetPreviewImage(preview.portrait_filename, portrait);
+        _character_window[i].SetCharacter(character, preview.name, portrait);
     }
 
     std::ostringstream time_text;
@@ -584,40 +548,76 @@ bool SaveMode::_PreviewGame(uint32 id)
 
     _drunes_textbox.SetDisplayText(drunes_ustr);
 
-    // Test the map file
+    // The in-game location of the save
+    _map_name_textbox.SetDisplayText(UTranslate(info.map_hud_name));
 
-    // Tests the map file and gets the untranslated map hud name from it.
-    ReadScriptDescriptor map_file;
-    if(!map_file.OpenFile(map_script_filename)) {
-        _ClearSaveData(true);
-        return false;
+    // Shows the screen thumbnail of the save when there is one, or the map location image otherwise.
+    const std::string &image_filename = info.thumbnail_filename.empty() ?
+                                        info.map_image_filename : info.thumbnail_filename;
+    if(_GetPreviewImage(image_filename, _location_image))
+        _location_image.SetWidthKeepRatio(340.0f);
+    else
+        _location_image.Clear();
+
+    return true;
+} // bool SaveMode::_PreviewGame(string& filename)
+
+void SaveMode::_LoadCharacterPreviews()
+{
+    _character_previews.clear();
+
+    // Only the data shown is read, rather than creating the whole characters.
+    std::string filename = "dat/actors/characters.lua";
+    ReadScriptDescriptor char_script;
+    if(!char_script.OpenFile(filename)) {
+        PRINT_WARNING << "Couldn't open the characters file: " << filename << std::endl;
+        return;
     }
 
-    if (map_file.OpenTablespace().empty()) {
-        _ClearSaveData(true);
-        map_file.CloseFile();
-        return false;
+    if(!char_script.OpenTable("characters")) {
+        char_script.CloseFile();
+        return;
     }
 
-    // Read the in-game location of the save
-    std::string map_hud_name = map_file.ReadString("map_name");
-    _map_name_textbox.SetDisplayText(UTranslate(map_hud_name));
+    std::vector<uint32> character_ids;
+    char_script.ReadTableKeys(character_ids);
+    for(uint32 i = 0; i < character_ids.size(); ++i) {
+        if(!char_script.OpenTable(character_ids[i]))
+            continue;
 
-    // Loads the potential location image
-    std::string map_image_filename = map_file.ReadString("map_image_filename");
-    if (map_image_filename.empty()) {
-        _location_image.Clear();
-    }
-    else {
-        if (_location_image.Load(map_image_filename))
-            _location_image.SetWidthKeepRatio(340.0f);
+        CharacterPreview &preview = _character_previews[character_ids[i]];
+        preview.name = MakeUnicodeString(char_script.ReadString("name"));
+        preview.portrait_filename = char_script.ReadString("portrait");
+        char_script.CloseTable(); // character id
     }
 
-    map_file.CloseTable(); // Tablespace
-    map_file.CloseFile();
+    char_script.CloseTable(); // characters
+    char_script.CloseFile();
+}
 
+bool SaveMode::_GetPreviewImage(const std::string &filename, StillImage &image)
+{
+    if(filename.empty())
+        return false;
+
+    std::map<std::string, StillImage>::const_iterator it = _preview_images.find(filename);
+    if(it == _preview_images.end()) {
+        _image_loader.Request(filename);
+        return false;
+    }
+
+    image = it->second;
     return true;
-} // bool SaveMode::_PreviewGame(string& filename)
+}
+
+void SaveMode::_ForgetPreviewImage(const std::string &filename)
+{
+    // The image must not be referenced anymore, so that the file is read again.
+    if(_location_image.GetFilename() == filename)
+        _location_image.Clear();
+    _preview_images.erase(filename);
+    _image_loader.Forget(filename);
+}
 
 bool SaveMode::_CheckSavesValidity() {
     // check all available slots
@@ -642,23 +642,18 @@ bool SaveMode::_CheckSavesValidity() {
 // SmallCharacterWindow Class
 ////////////////////////////////////////////////////////////////////////////////
 
-SmallCharacterWindow::~SmallCharacterWindow()
+void SmallCharacterWindow::SetCharacter(const SaveGameCharacter &character, const ustring &name,
+                                        const StillImage &portrait)
 {
-    delete _character;
-}
-
-void SmallCharacterWindow::SetCharacter(GlobalCharacter *character)
-{
-    delete _character;
+    _has_character = true;
     _character = character;
+    _name = name;
 
-    if(character) {
-        _portrait = character->GetPortrait();
-        // Only size up valid portraits
-        if(!_portrait.GetFilename().empty())
-            _portrait.SetDimensions(100.0f, 100.0f);
-    }
-} // void SmallCharacterWindow::SetCharacter(GlobalCharacter *character)
+    _portrait = portrait;
+    // Only size up valid portraits
+    if(!_portrait.GetFilename().empty())
+        _portrait.SetDimensions(100.0f, 100.0f);
+} // void SmallCharacterWindow::SetCharacter(...)
 
 
 
@@ -669,10 +664,10 @@ void SmallCharacterWindow::Draw()
     MenuWindow::Draw();
 
     // check to see if this window is an actual character
-    if(_character == NULL)
+    if(!_has_character)
         return;
 
-    if(_character->GetID() == vt_global::GLOBAL_CHARACTER_INVALID)
+    if(_character.id == vt_global::GLOBAL_CHARACTER_INVALID)
         return;
 
     // Get the window metrics
@@ -684,25 +679,26 @@ void SmallCharacterWindow::Draw()
 
     //Draw character portrait
     VideoManager->Move(x + 50, y + 110);
-    _portrait.Draw();
+    if(!_portrait.GetFilename().empty())
+        _portrait.Draw();
 
     // Write character name
     VideoManager->MoveRelative(125, -75);
-    VideoManager->Text()->Draw(_character->GetName(), TextStyle("title22"));
+    VideoManager->Text()->Draw(_name, TextStyle("title22"));
 
     // Level
     VideoManager->MoveRelative(0, 20);
-    VideoManager->Text()->Draw(UTranslate("Lv: ") + MakeUnicodeString(NumberToString(_character->GetExperienceLevel())), TextStyle("text20"));
+    VideoManager->Text()->Draw(UTranslate("Lv: ") + MakeUnicodeString(NumberToString(_character.experience_level)), TextStyle("text20"));
 
     // HP
     VideoManager->MoveRelative(0, 20);
-    VideoManager->Text()->Draw(UTranslate("HP: ") + MakeUnicodeString(NumberToString(_character->GetHitPoints()) +
-                               " / " + NumberToString(_character->GetMaxHitPoints())), TextStyle("text20"));
+    VideoManager->Text()->Draw(UTranslate("HP: ") + MakeUnicodeString(NumberToString(_character.hit_points) +
+                               " / " + NumberToString(_character.max_hit_points)), TextStyle("text20"));
 
     // SP
     VideoManager->MoveRelative(0, 20);
-    VideoManager->Text()->Draw(UTranslate("SP: ") + MakeUnicodeString(NumberToString(_character->GetSkillPoints()) +
-                               " / " + NumberToString(_character->GetMaxSkillPoints())), TextStyle("text20"));
+    VideoManager->Text()->Draw(UTranslate("SP: ") + MakeUnicodeString(NumberToString(_character.skill_points) +
+                               " / " + NumberToString(_character.max_skill_points)), TextStyle("text20"));
 
     return;
 }
@@ -26,9 +26,7 @@
 #include "common/gui/textbox.h"
 #include "common/gui/option.h"
 
-namespace vt_global {
-class GlobalCharacter;
-}
+#include "modes/save/save_slots.h"
 
 //! \brief All calls to save mode are wrapped in this namespace.
 namespace vt_save
@@ -47,23 +45,36 @@ extern bool SAVE_DEBUG;
 class SmallCharacterWindow : public vt_gui::MenuWindow
 {
 private:
-    //! The name of the character that this window corresponds) to
-    vt_global::GlobalCharacter *_character;
+    //! Whether a character is shown in this window
+    bool _has_character;
+
+    //! The saved data of the character shown
+    vt_global::SaveGameCharacter _character;
+
+    //! The name of the character
+    vt_utils::ustring _name;
 
     //! The image of the character
     vt_video::StillImage _portrait;
 
 public:
     SmallCharacterWindow():
-        _character(NULL)
+        _has_character(false)
     {}
 
-    ~SmallCharacterWindow();
-
     /** \brief Set the character for this window
-    *** \param character the character to associate with this window
+    *** \param character the saved data of the character to show
+    *** \param name the character name
+    *** \param portrait the character portrait, which may not be loaded yet
     **/
-    void SetCharacter(vt_global::GlobalCharacter *character);
+    void SetCharacter(const vt_global::SaveGameCharacter &character, const vt_utils::ustring &name,
+                      const vt_video::StillImage &portrait);
+
+    //! \brief Removes the character shown in this window
+    void ClearCharacter() {
+        _has_character = false;
+        _portrait.Clear();
+    }
 
     /** \brief render this window to the screen
     *** \return success/failure
@@ -115,6 +126,37 @@ private:
     //! \returns whether at least one save is valid.
     bool _CheckSavesValidity();
 
+    //! \brief Reads the name and portrait filename of all the characters.
+    void _LoadCharacterPreviews();
+
+    /** \brief Gets a preview image, or requests it to be loaded in the background
+    *** \param filename The image file.
+    *** \param image Set to the image when it is loaded.
+    *** \return false when the image isn't loaded yet, in which case the preview is refreshed once it is.
+    **/
+    bool _GetPreviewImage(const std::string &filename, vt_video::StillImage &image);
+
+    //! \brief Releases a preview image, so that it is read again the next time it's needed.
+    void _ForgetPreviewImage(const std::string &filename);
+
+    //! \brief The name and portrait filename of a character, shown in the save previews.
+    struct CharacterPreview {
+        vt_utils::ustring name;
+        std::string portrait_filename;
+    };
+
+    //! \brief The characters shown in the save previews, by character id.
+    std::map<uint32, CharacterPreview> _character_previews;
+
+    //! \brief The preview images loaded, kept until the mode is left so that the slots previews are instant.
+    std::map<std::string, vt_video::StillImage> _preview_images;
+
+    //! \brief Decodes the preview images in the background.
+    private_save::PreviewImageLoader _image_loader;
+
+    //! \brief The save slots preview data, kept between the save mode uses.
+    static private_save::SaveSlotCache _slot_cache;
+
     //! \brief The MenuWindow for the backdrop
     vt_gui::MenuWindow _window;
 
@@ -0,0 +1,230 @@
+////////////////////////////////////////////////////////////////////////////////
+//            Copyright (C) 2013 by Bertram (Valyria Tear)
+//                         All Rights Reserved
+//
+// This code is licensed under the GNU GPL version 2. It is free software
+// and you may modify it and/or redistribute it under the terms of this license.
+// See http://www.gnu.org/copyleft/gpl.html for details.
+////////////////////////////////////////////////////////////////////////////////
+
+/** ****************************************************************************
+*** \file    save_slots.cpp
+*** \author  Yohann Ferreira, yohann ferreira orange fr
+*** \brief   Source file for the save slots preview data
+*** ***************************************************************************/
+
+#include "modes/save/save_slots.h"
+
+#include "common/global/global.h"
+#include "engine/script/script_read.h"
+#include "engine/video/video.h"
+
+using namespace vt_utils;
+using namespace vt_script;
+using namespace vt_video;
+using namespace vt_video::private_video;
+using namespace vt_global;
+
+namespace vt_save
+{
+
+namespace private_save
+{
+
+// -----------------------------------------------------------------------------
+// SaveSlotCache class
+// -----------------------------------------------------------------------------
+
+const SaveSlotInfo &SaveSlotCache::GetSlotInfo(uint32 slot_id)
+{
+    // The autosave file can be rewritten within the same second, which the
+    // modification time wouldn't tell.
+    uint32 autosave_write_count = GlobalManager->GetAutoSaveWriteCount();
+    if(autosave_write_count != _autosave_write_count) {
+        _autosave_write_count = autosave_write_count;
+        Invalidate(AUTOSAVE_SLOT_ID);
+    }
+
+    std::map<uint32, SaveSlotInfo>::iterator it = _slots.find(slot_id);
+    if(it != _slots.end()) {
+        // Only checks whether the file changed since it was read.
+        const SaveSlotInfo &info = it->second;
+        std::string filename = FindSaveGameFilename(slot_id);
+        if(filename == info.filename
+                && (filename.empty() || GetFileModificationTime(filename) == info.modification_time))
+            return info;
+    }
+
+    SaveSlotInfo &info = _slots[slot_id];
+    _ReadSlotInfo(slot_id, info);
+    return info;
+}
+
+void SaveSlotCache::_ReadSlotInfo(uint32 slot_id, SaveSlotInfo &info)
+{
+    info = SaveSlotInfo();
+    info.filename = FindSaveGameFilename(slot_id);
+    if(info.filename.empty())
+        return;
+
+    info.modification_time = GetFileModificationTime(info.filename);
+
+    // Only the preview header of the binary saved games is read.
+    if(!ReadSaveGameHeader(info.filename, info.header))
+        return;
+
+    const MapInfo &map_info = _GetMapInfo(info.header.map_script_filename);
+    if(!map_info.valid)
+        return;
+
+    info.map_hud_name = map_info.hud_name;
+    info.map_image_filename = map_info.image_filename;
+
+    std::string thumbnail_filename = GetSaveGameThumbnailFilename(slot_id);
+    if(DoesFileExist(thumbnail_filename))
+        info.thumbnail_filename = thumbnail_filename;
+
+    info.valid = true;
+}
+
+const SaveSlotCache::MapInfo &SaveSlotCache::_GetMapInfo(const std::string &map_script_filename)
+{
+    std::map<std::string, MapInfo>::iterator it = _maps.find(map_script_filename);
+    if(it != _maps.end())
+        return it->second;
+
+    MapInfo &map_info = _maps[map_script_filename];
+    map_info.valid = false;
+
+    // Tests the map file and gets the untranslated map hud name from it.
+    ReadScriptDescriptor map_file;
+    if(!map_file.OpenFile(map_script_filename))
+        return map_info;
+
+    if(map_file.OpenTablespace().empty()) {
+        map_file.CloseFile();
+        return map_info;
+    }
+
+    map_info.hud_name = map_file.ReadString("map_name");
+    map_info.image_filename = map_file.ReadString("map_image_filename");
+    map_info.valid = true;
+
+    map_file.CloseTable(); // Tablespace
+    map_file.CloseFile();
+    return map_info;
+}
+
+// -----------------------------------------------------------------------------
+// PreviewImageLoader class
+// -----------------------------------------------------------------------------
+
+PreviewImageLoader::PreviewImageLoader() :
+    _load_thread(NULL),
+    _load_lock(NULL),
+    _loading(false),
+    _stop_requested(false)
+{}
+
+PreviewImageLoader::~PreviewImageLoader()
+{
+    if(_load_thread) {
+        vt_system::SystemManager->LockThread(_load_lock);
+        _stop_requested = true;
+        vt_system::SystemManager->UnlockThread(_load_lock);
+
+        vt_system::SystemManager->WaitForThread(_load_thread);
+        _load_thread = NULL;
+    }
+
+    if(_load_lock)
+        vt_system::SystemManager->DestroySemaphore(_load_lock);
+
+    for(uint32 i = 0; i < _decoded_images.size(); ++i) {
+        free(_decoded_images[i].image.pixels);
+        _decoded_images[i].image.pixels = NULL;
+    }
+}
+
+void PreviewImageLoader::Request(const std::string &filename)
+{
+    if(filename.empty() || !_requested_files.insert(filename).second)
+        return;
+
+    if(!_load_lock)
+        _load_lock = vt_system::SystemManager->CreateSemaphore(1);
+
+    vt_system::SystemManager->LockThread(_load_lock);
+    _pending_files.push_back(filename);
+    bool loading = _loading;
+    _loading = true;
+    vt_system::SystemManager->UnlockThread(_load_lock);
+
+    // The running load thread handles the file before returning.
+    if(loading)
+        return;
+
+    // The previous load thread is done, and only needs to be joined.
+    if(_load_thread) {
+        vt_system::SystemManager->WaitForThread(_load_thread);
+        _load_thread = NULL;
+    }
+
+    _load_thread = vt_system::SystemManager->SpawnThread(&PreviewImageLoader::_Load, this);
+    if(!_load_thread) {
+        PRINT_WARNING << "Couldn't start the preview images load thread, loading them right away" << std::endl;
+        _Load();
+    }
+}
+
+void PreviewImageLoader::Update(std::vector<std::string> &filenames)
+{
+    filenames.clear();
+    if(!_load_lock)
+        return;
+
+    std::vector<DecodedImage> images;
+    vt_system::SystemManager->LockThread(_load_lock);
+    images.swap(_decoded_images);
+    vt_system::SystemManager->UnlockThread(_load_lock);
+
+    for(uint32 i = 0; i < images.size(); ++i) {
+        TextureManager->AddPreloadedImage(images[i].filename, images[i].image);
+        filenames.push_back(images[i].filename);
+    }
+}
+
+void PreviewImageLoader::_Load()
+{
+    while(true) {
+        std::string filename;
+
+        vt_system::SystemManager->LockThread(_load_lock);
+        if(_pending_files.empty() || _stop_requested) {
+            _loading = false;
+            vt_system::SystemManager->UnlockThread(_load_lock);
+            return;
+        }
+        filename = _pending_files.front();
+        _pending_files.pop_front();
+        vt_system::SystemManager->UnlockThread(_load_lock);
+
+        DecodedImage image;
+        image.filename = filename;
+        if(!DoesFileExist(filename) || !image.image.DecodeImage(filename)) {
+            PRINT_WARNING << "Couldn't decode the preview image: " << filename << std::endl;
+            continue;
+        }
+
+        vt_system::SystemManager->LockThread(_load_lock);
+        _decoded_images.push_back(image);
+        vt_system::SystemManager->UnlockThread(_load_lock);
+
+        // The pixels are now owned by the copy.
+        image.image.pixels = NULL;
+    }
+}
+
+} // namespace private_save
+
+} // namespace vt_save
@@ -0,0 +1,178 @@
+////////////////////////////////////////////////////////////////////////////////
+//            Copyright (C) 2013 by Bertram (Valyria Tear)
+//                         All Rights Reserved
+//
+// This code is licensed under the GNU GPL version 2. It is free software
+// and you may modify it and/or redistribute it under the terms of this license.
+// See http://www.gnu.org/copyleft/gpl.html for details.
+////////////////////////////////////////////////////////////////////////////////
+
+/** ****************************************************************************
+*** \file    save_slots.h
+*** \author  Yohann Ferreira, yohann ferreira orange fr
+*** \brief   Header file for the save slots preview data
+***
+*** The preview data of the save slots is kept between the save mode uses, and
+*** only read again when a saved game file changes. The preview images are
+*** decoded in a background thread, so that browsing the slots never waits
+*** for the image files.
+*** ***************************************************************************/
+
+#ifndef __SAVE_SLOTS_HEADER__
+#define __SAVE_SLOTS_HEADER__
+
+#include "common/global/global_save.h"
+#include "engine/video/image_base.h"
+
+#include <map>
+#include <set>
+
+namespace vt_save
+{
+
+namespace private_save
+{
+
+//! \brief The preview data of a save slot, read from its saved game file and from its map script file.
+struct SaveSlotInfo {
+    SaveSlotInfo() :
+        modification_time(0),
+        valid(false)
+    {}
+
+    //! \brief The saved game file of the slot, or an empty string when the slot is empty.
+    std::string filename;
+
+    //! \brief The modification time of the saved game file when it was read.
+    time_t modification_time;
+
+    //! \brief Whether the saved game and its map could be read.
+    bool valid;
+
+    vt_global::SaveGameHeader header;
+
+    //! \brief The untranslated location name of the map.
+    std::string map_hud_name;
+
+    //! \brief The location image of the map, if any.
+    std::string map_image_filename;
+
+    //! \brief The screen thumbnail stored along with the saved game, if any.
+    std::string thumbnail_filename;
+};
+
+/** ****************************************************************************
+*** \brief Keeps the preview data of the save slots.
+***
+*** The data of a slot is read again only when its saved game file was
+*** replaced, removed or modified since it was cached, or when the autosave
+*** was written in the background since then. The map script files
+*** are only read once, since they don't change while the game is running.
+*** ***************************************************************************/
+class SaveSlotCache
+{
+public:
+    SaveSlotCache() :
+        _autosave_write_count(0)
+    {}
+
+    /** \brief Returns the up to date preview data of a save slot
+    *** \param slot_id The save slot id.
+    *** \note The returned reference is only valid until the next call.
+    **/
+    const SaveSlotInfo &GetSlotInfo(uint32 slot_id);
+
+    //! \brief Forgets the cached data of a slot, e.g. after writing it.
+    void Invalidate(uint32 slot_id) {
+        _slots.erase(slot_id);
+    }
+
+private:
+    //! \brief The location data read from a map script file.
+    struct MapInfo {
+        bool valid;
+        std::string hud_name;
+        std::string image_filename;
+    };
+
+    //! \brief The cached data of the save slots, by slot id.
+    std::map<uint32, SaveSlotInfo> _slots;
+
+    //! \brief The cached data of the map script files, by filename.
+    std::map<std::string, MapInfo> _maps;
+
+    //! \brief The number of autosave files written when the cache was last checked.
+    uint32 _autosave_write_count;
+
+    //! \brief Reads the preview data of a save slot.
+    void _ReadSlotInfo(uint32 slot_id, SaveSlotInfo &info);
+
+    //! \brief Returns the location data of a map script file, read the first time only.
+    const MapInfo &_GetMapInfo(const std::string &map_script_filename);
+}; // class SaveSlotCache
+
+/** ****************************************************************************
+*** \brief Decodes the preview images in a background thread.
+***
+*** The decoded images are handed over to the texture manager by Update(),
+*** which must be called from the main thread, so that loading them is then
+*** only a matter of uploading them to the texture memory.
+*** ***************************************************************************/
+class PreviewImageLoader
+{
+public:
+    PreviewImageLoader();
+
+    //! \brief Stops the load thread and frees the images not handed over.
+    ~PreviewImageLoader();
+
+    //! \brief Queues an image file to be decoded, unless it was already requested.
+    void Request(const std::string &filename);
+
+    /** \brief Hands over the images decoded since the last call to the texture manager
+    *** \param filenames Filled with the files of the images handed over.
+    **/
+    void Update(std::vector<std::string> &filenames);
+
+    //! \brief Permits requesting an image file again, e.g. after it was written again.
+    void Forget(const std::string &filename) {
+        _requested_files.erase(filename);
+    }
+
+private:
+    //! \brief The decoded data of an image file.
+    struct DecodedImage {
+        std::string filename;
+        vt_video::private_video::ImageMemory image;
+    };
+
+    //! \brief The image files already requested, only used by the main thread.
+    std::set<std::string> _requested_files;
+
+    //! \brief The image files to decode, shared with the load thread.
+    std::deque<std::string> _pending_files;
+
+    //! \brief The decoded images not handed over yet, shared with the load thread.
+    std::vector<DecodedImage> _decoded_images;
+
+    //! \brief The load thread, or NULL when none was started.
+    Thread *_load_thread;
+
+    //! \brief Protects the members shared with the load thread.
+    Semaphore *_load_lock;
+
+    //! \brief Whether the load thread is running, cleared by it once the queue is empty.
+    bool _loading;
+
+    //! \brief Tells the load thread to stop as soon as possible.
+    bool _stop_requested;
+
+    //! \brief Decodes the queued images until none is left. Runs in the load thread.
+    void _Load();
+}; // class PreviewImageLoader
+
+} // namespace private_save
+
+} // namespace vt_save
+
+#endif // __SAVE_SLOTS_HEADER__
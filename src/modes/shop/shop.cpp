@@ -941,11 +941,14 @@ ShopMode::ShopMode() :
     _root_interface(NULL),
     _buy_interface(NULL),
     _sell_interface(NULL),
-    _trade_interface(NULL)
+    _trade_interface(NULL),
+    _available_sell_outdated(true)
 {
     mode_type = MODE_MANAGER_SHOP_MODE;
     _current_instance = this;
 
+    GlobalManager->AddInventoryListener(this);
+
     // Create the menu windows and set their properties
     _top_window.Create(800.0f, 96.0f, ~VIDEO_MENU_EDGE_BOTTOM);
     _top_window.SetPosition(112.0f, 84.0f);
@@ -1017,6 +1020,8 @@ ShopMode::ShopMode() :
 
 ShopMode::~ShopMode()
 {
+    GlobalManager->RemoveInventoryListener(this);
+
     delete _shop_media;
     delete _object_viewer;
     delete _root_interface;
@@ -1076,32 +1081,52 @@ void ShopMode::Initialize()
 
 void ShopMode::_UpdateAvailableObjectsToSell()
 {
-    // Reinit the data
-    _available_sell.clear();
+    if(_available_sell_outdated) {
+        // Reinit the data
+        _available_sell.clear();
 
-    std::map<uint32, GlobalObject *>* inventory = GlobalManager->GetInventory();
-    for(std::map<uint32, GlobalObject *>::iterator it = inventory->begin(); it != inventory->end(); ++it) {
-        // Don't consider 0 worth objects.
-        if(it->second->GetPrice() == 0)
-            continue;
+        std::vector<GlobalObject *> inventory;
+        GlobalManager->GetInventoryObjects(inventory);
+        for(uint32 i = 0; i < inventory.size(); ++i)
+            _UpdateAvailableObjectToSell(inventory[i]->GetID());
+    }
+    else {
+        for(std::set<uint32>::const_iterator it = _changed_objects.begin(); it != _changed_objects.end(); ++it)
+            _UpdateAvailableObjectToSell(*it);
+    }
 
-        // Don't show key items either.
-        if(it->second->IsKeyItem())
-            continue;
+    _changed_objects.clear();
+    _available_sell_outdated = false;
+}
 
-        // Check if the object already exists in the shop list and if so, set its ownership count
-        std::map<uint32, ShopObject *>::iterator shop_obj_iter = _available_sell.find(it->second->GetID());
-        if(shop_obj_iter != _available_sell.end()) {
-            shop_obj_iter->second->IncrementOwnCount(it->second->GetCount());
-        }
-        // Otherwise, add the shop object to the list
-        else {
-            ShopObject *new_shop_object = new ShopObject(it->second);
-            new_shop_object->IncrementOwnCount(it->second->GetCount());
-            new_shop_object->SetPricing(GetBuyPriceLevel(), GetSellPriceLevel());
-            _available_sell.insert(std::make_pair(it->second->GetID(), new_shop_object));
-        }
+
+void ShopMode::_UpdateAvailableObjectToSell(uint32 object_id)
+{
+    GlobalObject *object = GlobalManager->GetInventoryObject(object_id);
+    std::map<uint32, ShopObject *>::iterator shop_obj_iter = _available_sell.find(object_id);
+
+    // Don't consider objects no longer owned, 0 worth objects, nor key items.
+    if(object == NULL || object->GetPrice() == 0 || object->IsKeyItem()) {
+        if(shop_obj_iter != _available_sell.end())
+            _available_sell.erase(shop_obj_iter);
+        return;
     }
+
+    // If the object already exists in the shop list, only set its ownership count
+    if(shop_obj_iter != _available_sell.end() && shop_obj_iter->second->GetObject() == object) {
+        ShopObject *shop_object = shop_obj_iter->second;
+        if(shop_object->GetOwnCount() < object->GetCount())
+            shop_object->IncrementOwnCount(object->GetCount() - shop_object->GetOwnCount());
+        else if(shop_object->GetOwnCount() > object->GetCount())
+            shop_object->DecrementOwnCount(shop_object->GetOwnCount() - object->GetCount());
+        return;
+    }
+
+    // Otherwise, add the shop object to the list
+    ShopObject *new_shop_object = new ShopObject(object);
+    new_shop_object->IncrementOwnCount(object->GetCount());
+    new_shop_object->SetPricing(GetBuyPriceLevel(), GetSellPriceLevel());
+    _available_sell[object_id] = new_shop_object;
 }
 
 
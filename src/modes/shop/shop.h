@@ -30,6 +30,8 @@
 
 #include "shop_utils.h"
 
+#include <set>
+
 namespace vt_audio {
 class SoundDescriptor;
 }
@@ -345,7 +347,7 @@ private:
 *** -# AddObject() for each object to be sold
 *** -# Wait for the Reset() method to be automatically called, which will finalize shop initialization
 *** ***************************************************************************/
-class ShopMode : public vt_mode_manager::GameMode
+class ShopMode : public vt_mode_manager::GameMode, public vt_global::GlobalInventoryListener
 {
 public:
     ShopMode();
@@ -601,13 +603,28 @@ public:
     }
     //@}
 
+    //! \brief Notes the changed object, so that only its sell data is updated.
+    void InventoryChanged(uint32 obj_id) {
+        _changed_objects.insert(obj_id);
+    }
+
+    //! \brief Notes that all the sell data has to be created again.
+    void InventoryCleared() {
+        _available_sell_outdated = true;
+    }
+
 private:
     //! \brief update (enable, disable) the available shop options (buy, sell, ...)
     void _UpdateAvailableShopOptions();
 
-    //! \brief updates the available items the user can sell
+    /** \brief updates the available items the user can sell
+    *** Only the objects changed in the inventory since the last call are updated.
+    **/
     void _UpdateAvailableObjectsToSell();
 
+    //! \brief updates the sell data of a single object, from its inventory data.
+    void _UpdateAvailableObjectToSell(uint32 object_id);
+
     /** \brief A reference to the current instance of ShopMode
     *** This is used by other shop clases to be able to refer to the shop that they exist in. This member
     *** is NULL when no shop is active
@@ -642,6 +659,12 @@ private:
     std::map<uint32, private_shop::ShopObject *> _available_sell;
     std::map<uint32, private_shop::ShopObject *> _available_trade;
 
+    //! \brief The ids of the objects changed in the inventory since the sell data was updated.
+    std::set<uint32> _changed_objects;
+
+    //! \brief Tells whether all the sell data has to be created again.
+    bool _available_sell_outdated;
+
     /** \brief Holds pointers to all objects that the player plans to purchase
     *** The integer key to this map is the global object ID represented by the ShopObject.
     **/
@@ -36,6 +36,7 @@
 #include <cmath>
 #include <stdexcept>
 #include <algorithm>
+#include <deque>
 
 namespace vt_utils
 {
@@ -381,6 +382,85 @@ bool IsStringNumeric(const std::string &text)
     return true;
 } // bool IsStringNumeric(const string& text)
 
+//! \brief The interned strings, indexed by their symbols. A deque never moves its elements.
+static std::deque<std::string> _interned_strings;
+
+//! \brief The hashes of the interned strings, indexed by their symbols.
+static std::vector<uint32> _interned_hashes;
+
+//! \brief The open addressing table of the interned strings, holding their symbols plus one, or zero for empty slots.
+static std::vector<uint32> _interned_slots;
+
+//! \brief Computes the FNV-1a hash of a string.
+static uint32 _HashString(const std::string &text)
+{
+    uint32 hash = 2166136261u;
+    for(size_t i = 0; i < text.size(); ++i) {
+        hash ^= static_cast<uint8>(text[i]);
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+//! \brief Returns the slot holding the given string, or the empty slot where it would be inserted.
+static uint32 _FindInternedSlot(const std::string &text, uint32 hash)
+{
+    const uint32 mask = _interned_slots.size() - 1;
+    uint32 slot = hash & mask;
+    while(_interned_slots[slot] != 0) {
+        uint32 symbol = _interned_slots[slot] - 1;
+        if(_interned_hashes[symbol] == hash && _interned_strings[symbol] == text)
+            break;
+        slot = (slot + 1) & mask;
+    }
+    return slot;
+}
+
+uint32 InternString(const std::string &text)
+{
+    uint32 hash = _HashString(text);
+
+    if(!_interned_slots.empty()) {
+        uint32 slot = _FindInternedSlot(text, hash);
+        if(_interned_slots[slot] != 0)
+            return _interned_slots[slot] - 1;
+    }
+
+    // The table is kept at most half full.
+    if((_interned_strings.size() + 1) * 2 > _interned_slots.size()) {
+        _interned_slots.assign(_interned_slots.empty() ? 256 : _interned_slots.size() * 2, 0);
+        const uint32 mask = _interned_slots.size() - 1;
+        for(uint32 symbol = 0; symbol < _interned_strings.size(); ++symbol) {
+            uint32 slot = _interned_hashes[symbol] & mask;
+            while(_interned_slots[slot] != 0)
+                slot = (slot + 1) & mask;
+            _interned_slots[slot] = symbol + 1;
+        }
+    }
+
+    uint32 symbol = _interned_strings.size();
+    _interned_strings.push_back(text);
+    _interned_hashes.push_back(hash);
+    _interned_slots[_FindInternedSlot(text, hash)] = symbol + 1;
+    return symbol;
+}
+
+uint32 FindStringSymbol(const std::string &text)
+{
+    if(_interned_slots.empty())
+        return INVALID_SYMBOL;
+
+    uint32 slot = _FindInternedSlot(text, _HashString(text));
+    return _interned_slots[slot] == 0 ? INVALID_SYMBOL : _interned_slots[slot] - 1;
+}
+
+const std::string &GetSymbolString(uint32 symbol)
+{
+    if(symbol >= _interned_strings.size())
+        return _empty_string;
+    return _interned_strings[symbol];
+}
+
 #if SDL_BYTEORDER == SDL_LIL_ENDIAN
 #define UTF_16_ICONV_NAME "UTF-16LE"
 #else
@@ -626,8 +706,11 @@ bool DoesFileExist(const std::string &file_name)
 
 bool MoveFile(const std::string &source_name, const std::string &destination_name)
 {
+    // rename() atomically replaces the destination file, except on Windows where it fails instead.
+#ifdef _WIN32
     if(DoesFileExist(destination_name))
         remove(destination_name.c_str());
+#endif
     return (rename(source_name.c_str(), destination_name.c_str()) == 0);
 }
 
@@ -857,6 +940,14 @@ bool DeleteFile(const std::string &filename)
     return false;
 }
 
+time_t GetFileModificationTime(const std::string &filename)
+{
+    struct stat buf;
+    if(stat(filename.c_str(), &buf) != 0)
+        return 0;
+    return buf.st_mtime;
+}
+
 // Copy old save files from ~/.valyriatear to new path on unices
 // And from the personal folder to the destination on Windows.
 //! \DEPRECATED: Remove this in one or two releases.
@@ -57,6 +57,7 @@
 #include <string>
 #include <sstream>
 #include <vector>
+#include <ctime>
 
 // We include SDL_config.h, which compensates for non ISO C99 compilers.
 // SDL_config.h defines the int??_t types for non ISO C99 compilers,
@@ -639,6 +640,152 @@ void InsertionSort(std::vector<T>& swap_vec)
 } // void InsertionSort(std::vector<T>& swap_vec)
 //@}
 
+//! \name String Interning Functions
+//@{
+//! \brief The symbol returned when a string was never interned.
+const uint32 INVALID_SYMBOL = 0xFFFFFFFF;
+
+/** \brief Gives the symbol of a string, interning it first when needed
+*** \param text The string to intern
+*** \return A number identifying the string, which stays the same until the game exits.
+*** Symbols are given in increasing order from zero, in the order strings are interned.
+*** \note The string table is not protected against concurrent accesses: it must only be used from the main thread.
+**/
+uint32 InternString(const std::string &text);
+
+/** \brief Gives the symbol of a string without interning it
+*** \param text The string to look for
+*** \return The string symbol, or INVALID_SYMBOL if the string was never interned
+**/
+uint32 FindStringSymbol(const std::string &text);
+
+/** \brief Gives the string corresponding to a symbol
+*** \return The interned string, or an empty string when the symbol is unknown
+**/
+const std::string &GetSymbolString(uint32 symbol);
+//@}
+
+/** ****************************************************************************
+*** \brief A flat hash map keyed by string symbols.
+***
+*** The values are stored contiguously in insertion order, and indexed by an
+*** open addressing table with linear probing. Looking up a symbol thus costs
+*** a multiplication and, most of the time, a single probe.
+***
+*** \note Entries can't be removed one by one, only the whole map can be cleared.
+*** Inserting entries may move the values, so pointers to them must not be kept.
+*** ***************************************************************************/
+template <typename T> class SymbolMap
+{
+public:
+    SymbolMap() :
+        _shift(32)
+    {}
+
+    //! \brief Returns the value of a symbol, or NULL if the symbol isn't in the map.
+    T *Find(uint32 symbol) {
+        uint32 slot = _FindSlot(symbol);
+        return (slot == INVALID_SYMBOL || _slots[slot] == 0) ? NULL : &_entries[_slots[slot] - 1].second;
+    }
+
+    const T *Find(uint32 symbol) const {
+        uint32 slot = _FindSlot(symbol);
+        return (slot == INVALID_SYMBOL || _slots[slot] == 0) ? NULL : &_entries[_slots[slot] - 1].second;
+    }
+
+    /** \brief Adds a symbol to the map
+    *** \return False if the symbol was already in the map, in which case its value isn't changed.
+    **/
+    bool Insert(uint32 symbol, const T &value) {
+        if(Find(symbol) != NULL)
+            return false;
+        _Get(symbol) = value;
+        return true;
+    }
+
+    //! \brief Returns the value of a symbol, adding it with a default value when needed.
+    T &operator[](uint32 symbol) {
+        T *value = Find(symbol);
+        return value ? *value : _Get(symbol);
+    }
+
+    void Clear() {
+        _entries.clear();
+        _slots.clear();
+        _shift = 32;
+    }
+
+    //! \brief Returns the number of entries in the map.
+    uint32 Size() const {
+        return _entries.size();
+    }
+
+    bool Empty() const {
+        return _entries.empty();
+    }
+
+    //! \brief Gives the symbol and value of the entries in insertion order, with index in [0, Size()).
+    //@{
+    uint32 GetSymbol(uint32 index) const {
+        return _entries[index].first;
+    }
+
+    T &GetValue(uint32 index) {
+        return _entries[index].second;
+    }
+
+    const T &GetValue(uint32 index) const {
+        return _entries[index].second;
+    }
+    //@}
+
+private:
+    //! \brief The symbols and values of the entries, in insertion order.
+    std::vector<std::pair<uint32, T> > _entries;
+
+    //! \brief The open addressing table, holding the entry indeces plus one, or zero for empty slots.
+    std::vector<uint32> _slots;
+
+    //! \brief 32 minus the base 2 logarithm of the table size, to keep the upper bits of the hash.
+    uint32 _shift;
+
+    /** \brief Returns the slot holding the given symbol, or the empty slot where it would be inserted.
+    *** \return INVALID_SYMBOL when the table wasn't allocated yet.
+    **/
+    uint32 _FindSlot(uint32 symbol) const {
+        if(_slots.empty())
+            return INVALID_SYMBOL;
+
+        // Fibonacci hashing spreads the sequential symbols over the whole table.
+        // The upper bits of the product are kept, since they depend on all the symbol bits.
+        const uint32 mask = _slots.size() - 1;
+        uint32 slot = (symbol * 0x9E3779B9u) >> _shift;
+        while(_slots[slot] != 0 && _entries[_slots[slot] - 1].first != symbol)
+            slot = (slot + 1) & mask;
+        return slot;
+    }
+
+    //! \brief Adds a symbol which isn't in the map yet, and returns its value.
+    T &_Get(uint32 symbol) {
+        // The table is kept at most half full.
+        if((_entries.size() + 1) * 2 > _slots.size()) {
+            if(_slots.empty()) {
+                _slots.assign(16, 0);
+                _shift = 28;
+            } else {
+                _slots.assign(_slots.size() * 2, 0);
+                --_shift;
+            }
+            for(uint32 i = 0; i < _entries.size(); ++i)
+                _slots[_FindSlot(_entries[i].first)] = i + 1;
+        }
+
+        _slots[_FindSlot(symbol)] = _entries.size() + 1;
+        _entries.push_back(std::make_pair(symbol, T()));
+        return _entries.back().second;
+    }
+}; // template <typename T> class SymbolMap
+
 //! \name Directory and File Manipulation Functions
 //@{
 /** \brief Checks if a file exists on the system or not
@@ -696,6 +843,12 @@ std::vector<std::string> ListDirectory(const std::string &dir_name, const std::s
 **/
 bool DeleteFile(const std::string &filename);
 
+/** \brief Gets the last modification time of a file
+*** \param filename The name of the file
+*** \return The modification time, or 0 when the file doesn't exist
+**/
+time_t GetFileModificationTime(const std::string &filename);
+
 //! \name User directory and settings paths
 //@{
 //! \brief Gives the OS specific directory path to save and retrieve user data